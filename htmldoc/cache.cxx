@@ -0,0 +1,898 @@
+/*
+ * Parsed document cache for HTMLDOC, a HTML document processing program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+/*
+ * Include necessary headers.
+ */
+
+#include "htmldoc.h"
+#include "cache.h"
+#include "md5-private.h"
+#include <sys/stat.h>
+
+#ifdef WIN32
+#  include <direct.h>
+#  include <process.h>
+#  define getpid	_getpid
+#  define mkdir(d,m)	_mkdir(d)
+#else
+#  include <unistd.h>
+#endif // WIN32
+
+
+//
+// The cache holds one ".tree" file per input document, named using the MD5
+// hash of the document content and every setting that affects the parsed
+// tree.  (The ".layout" files for book chapters are written by ps-pdf.cxx
+// using the same helpers.)  Each ".tree" file contains:
+//
+//   "HDTREE1\n"
+//   num-dependencies, then the filename, size, and modification time of each
+//     image whose dimensions were used by the parser
+//   num-nodes, then for each node in document order: the parent node number
+//     (0 for the file node), markup (offset from MARKUP_FILE), packed
+//     attribute bits, color, width, height, linked node number, text, and
+//     variables
+//
+// Numbers are stored as variable-length unsigned integers, strings as a
+// length (0 for NULL, otherwise the length plus 1) followed by the bytes, and
+// the width and height as raw floats (the byte order and float size are part
+// of the hash).  Text and variable values are stored as UTF-8 because the
+// 8-bit values of characters outside the base character set depend on the
+// order in which they were first seen (see 'cache_add_text()').  Files are
+// written under a temporary name and then renamed, so concurrent builds can
+// share a cache directory.
+//
+
+#define CACHE_MAGIC	"HDTREE2\n"	// File header
+
+
+/*
+ * Local globals...
+ */
+
+static hd_mutex_t	cache_mutex = HD_MUTEX_INITIALIZER;
+					// Lock for temporary file numbers
+static int		cache_temps = 0;// Number of temporary files
+
+
+//
+// 'cache_add_bytes()' - Add bytes to an output buffer.
+//
+
+void
+cache_add_bytes(cache_buf_t *buf,	// I - Output buffer
+                const void  *data,	// I - Bytes
+                size_t      bytes)	// I - Number of bytes
+{
+  if (buf->error || bytes == 0)
+    return;
+
+  if (buf->used + bytes > buf->alloc)
+  {
+    size_t		alloc;		// New allocation
+    unsigned char	*temp;		// New buffer
+
+    for (alloc = buf->alloc ? buf->alloc * 2 : 65536; alloc < buf->used + bytes; alloc *= 2);
+
+    if ((temp = (unsigned char *)realloc(buf->data, alloc)) == NULL)
+    {
+      buf->error = 1;
+      return;
+    }
+
+    buf->data  = temp;
+    buf->alloc = alloc;
+  }
+
+  memcpy(buf->data + buf->used, data, bytes);
+  buf->used += bytes;
+}
+
+
+//
+// 'cache_add_number()' - Add a variable-length number to an output buffer.
+//
+
+void
+cache_add_number(cache_buf_t        *buf,// I - Output buffer
+                 unsigned long long number)
+					// I - Number
+{
+  unsigned char	bytes[10];		// Encoded number
+  size_t	count = 0;		// Number of bytes
+
+
+  do
+  {
+    bytes[count] = (unsigned char)(number & 127);
+    number >>= 7;
+
+    if (number)
+      bytes[count] |= 128;
+
+    count ++;
+  }
+  while (number);
+
+  cache_add_bytes(buf, bytes, count);
+}
+
+
+//
+// 'cache_add_string()' - Add a string to an output buffer.
+//
+
+void
+cache_add_string(cache_buf_t *buf,	// I - Output buffer
+                 const uchar *s)	// I - String or NULL
+{
+  if (s)
+  {
+    size_t	len = strlen((char *)s);// Length of string
+
+    cache_add_number(buf, len + 1);
+    cache_add_bytes(buf, s, len);
+  }
+  else
+    cache_add_number(buf, 0);
+}
+
+
+//
+// 'cache_add_text()' - Add document text to an output buffer.
+//
+// Characters above 0x7f are added as UTF-8 using their Unicode values, since
+// the 8-bit values of UTF-8 text and extra characters are assigned as they are
+// first seen ('htmlMapUnicode()' and 'iso8859()') and differ from run to run.
+//
+
+void
+cache_add_text(cache_buf_t *buf,	// I - Output buffer
+               const uchar *s)		// I - Text or NULL
+{
+  const uchar	*ptr,			// Pointer into text
+		*start;			// Start of ASCII run
+  size_t	len;			// Length of encoded text
+  int		ch;			// Unicode character
+  uchar		utf8[3];		// Encoded character
+
+
+  if (!s)
+  {
+    cache_add_number(buf, 0);
+    return;
+  }
+
+  for (len = 0, ptr = s; *ptr; ptr ++)
+  {
+    if (*ptr < 0x80)
+      len ++;
+    else if ((ch = _htmlUnicode[*ptr]) > 0 && ch < 0x800)
+      len += 2;
+    else
+      len += 3;
+  }
+
+  cache_add_number(buf, len + 1);
+
+  for (ptr = s; *ptr;)
+  {
+    for (start = ptr; *ptr && *ptr < 0x80; ptr ++);
+
+    cache_add_bytes(buf, start, (size_t)(ptr - start));
+
+    for (; *ptr >= 0x80; ptr ++)
+    {
+      // Characters without a Unicode value become U+FFFD...
+      if ((ch = _htmlUnicode[*ptr]) <= 0 || ch > 0xffff)
+        ch = 0xfffd;
+
+      if (ch < 0x800)
+      {
+        utf8[0] = (uchar)(0xc0 | (ch >> 6));
+        utf8[1] = (uchar)(0x80 | (ch & 0x3f));
+        cache_add_bytes(buf, utf8, 2);
+      }
+      else
+      {
+        utf8[0] = (uchar)(0xe0 | (ch >> 12));
+        utf8[1] = (uchar)(0x80 | ((ch >> 6) & 0x3f));
+        utf8[2] = (uchar)(0x80 | (ch & 0x3f));
+        cache_add_bytes(buf, utf8, 3);
+      }
+    }
+  }
+}
+
+
+//
+// 'cache_get_bytes()' - Get bytes from an input buffer.
+//
+
+unsigned char *				// O - Bytes or NULL on error
+cache_get_bytes(cache_in_t *in,		// I - Input buffer
+                size_t     bytes)	// I - Number of bytes
+{
+  const unsigned char	*ptr = in->ptr;	// Bytes
+
+
+  if (in->error || bytes > (size_t)(in->end - in->ptr))
+  {
+    in->error = 1;
+    return (NULL);
+  }
+
+  in->ptr += bytes;
+
+  return ((unsigned char *)ptr);
+}
+
+
+//
+// 'cache_get_number()' - Get a variable-length number from an input buffer.
+//
+
+unsigned long long			// O - Number
+cache_get_number(cache_in_t *in)	// I - Input buffer
+{
+  unsigned long long	number = 0;	// Number
+  int			shift = 0;	// Bit shift
+
+
+  while (!in->error)
+  {
+    if (in->ptr >= in->end || shift > 63)
+    {
+      in->error = 1;
+      break;
+    }
+
+    number |= (unsigned long long)(*(in->ptr) & 127) << shift;
+    shift  += 7;
+
+    if (!(*(in->ptr)++ & 128))
+      break;
+  }
+
+  return (in->error ? 0 : number);
+}
+
+
+//
+// 'cache_get_string()' - Get a string from an input buffer.
+//
+
+uchar *					// O - Pooled string or NULL
+cache_get_string(cache_in_t *in)	// I - Input buffer
+{
+  unsigned long long	len;		// Length of string plus 1
+  unsigned char		*bytes;		// String bytes
+  char			*s;		// Nul-terminated string
+  uchar			*pooled;	// Pooled string
+
+
+  if ((len = cache_get_number(in)) == 0 || (bytes = cache_get_bytes(in, (size_t)(len - 1))) == NULL)
+    return (NULL);
+
+  if ((s = (char *)malloc((size_t)len)) == NULL)
+  {
+    in->error = 1;
+    return (NULL);
+  }
+
+  memcpy(s, bytes, (size_t)(len - 1));
+  s[len - 1] = '\0';
+
+  pooled = (uchar *)hd_strdup(s);
+  free(s);
+
+  return (pooled);
+}
+
+
+//
+// 'cache_get_text()' - Get document text from an input buffer.
+//
+// The Unicode characters added by 'cache_add_text()' are mapped to the 8-bit
+// values used by this run.
+//
+
+uchar *					// O - Pooled text or NULL
+cache_get_text(cache_in_t *in)		// I - Input buffer
+{
+  unsigned long long	len;		// Length of text plus 1
+  const unsigned char	*bytes,		// Text bytes
+			*end;		// End of text bytes
+  uchar			*s,		// Nul-terminated text
+			*sptr,		// Pointer into text
+			*pooled;	// Pooled text
+  int			ch;		// Unicode character
+  char			name[16];	// Character reference
+
+
+  if ((len = cache_get_number(in)) == 0 || (bytes = cache_get_bytes(in, (size_t)(len - 1))) == NULL)
+    return (NULL);
+
+  if ((s = (uchar *)malloc((size_t)len)) == NULL)
+  {
+    in->error = 1;
+    return (NULL);
+  }
+
+  for (end = bytes + len - 1, sptr = s; bytes < end;)
+  {
+    if (*bytes < 0x80)
+    {
+      *sptr++ = *bytes++;
+      continue;
+    }
+    else if ((*bytes & 0xe0) == 0xc0 && (end - bytes) >= 2 && (bytes[1] & 0xc0) == 0x80)
+    {
+      ch    = ((bytes[0] & 0x1f) << 6) | (bytes[1] & 0x3f);
+      bytes += 2;
+    }
+    else if ((*bytes & 0xf0) == 0xe0 && (end - bytes) >= 3 && (bytes[1] & 0xc0) == 0x80 && (bytes[2] & 0xc0) == 0x80)
+    {
+      ch    = ((bytes[0] & 0x0f) << 12) | ((bytes[1] & 0x3f) << 6) | (bytes[2] & 0x3f);
+      bytes += 3;
+    }
+    else
+    {
+      in->error = 1;
+      break;
+    }
+
+    // Map the character just like a numeric character reference, dropping
+    // it if there is no room left in the character set...
+    snprintf(name, sizeof(name), "#%d", ch);
+
+    if ((*sptr = iso8859((uchar *)name)) != 0)
+      sptr ++;
+  }
+
+  *sptr = '\0';
+
+  pooled = in->error ? NULL : (uchar *)hd_strdup((char *)s);
+  free(s);
+
+  return (pooled);
+}
+
+
+//
+// 'cache_key()' - Compute the cache key for a document.
+//
+// The key covers the document content, its location, and all of the options
+// that change the parsed tree.  The file is rewound afterwards.
+//
+
+int					// O - 1 on success, 0 on failure
+cache_key(FILE       *fp,		// I - Document file
+          const char *filename,		// I - Document filename/URL
+          const char *base,		// I - Base directory
+          int        markdown,		// I - Markdown document?
+          char       *key,		// O - Key string
+          size_t     keysize)		// I - Size of key string
+{
+  _cups_md5_state_t md5;		// MD5 state
+  unsigned char	digest[16];		// MD5 digest
+  unsigned char	buffer[16384];		// Read buffer
+  size_t	bytes;			// Bytes read
+  int		i;			// Looping var
+  char		settings[4096];		// Parsing settings
+  unsigned	order = 0x01020304;	// Byte order check
+
+
+  if (keysize < HD_CACHE_KEY_SIZE)
+    return (0);
+
+  snprintf(settings, sizeof(settings), "%s%s\n%s\n%s\n%d\n%s\n%s\n%s\n%d,%d,%d,%d,%s\n%g,%g\n", CACHE_MAGIC, SVERSION, filename, base ? base : "", markdown, Path, _htmlData, _htmlCharSet, StrictHTML, _htmlGrayscale, (int)_htmlBodyFont, (int)_htmlHeadingFont, (char *)_htmlTextColor, _htmlPPI, _htmlBrowserWidth);
+
+  _cupsMD5Init(&md5);
+  _cupsMD5Append(&md5, (unsigned char *)settings, (int)strlen(settings));
+  _cupsMD5Append(&md5, (unsigned char *)&order, (int)sizeof(order));
+  _cupsMD5Append(&md5, (unsigned char *)_htmlSizes, (int)(8 * sizeof(float)));
+  _cupsMD5Append(&md5, (unsigned char *)_htmlSpacings, (int)(8 * sizeof(float)));
+
+  rewind(fp);
+
+  while ((bytes = fread(buffer, 1, sizeof(buffer), fp)) > 0)
+    _cupsMD5Append(&md5, buffer, (int)bytes);
+
+  if (ferror(fp))
+  {
+    rewind(fp);
+    return (0);
+  }
+
+  rewind(fp);
+
+  _cupsMD5Finish(&md5, digest);
+
+  for (i = 0; i < 16; i ++)
+    snprintf(key + 2 * i, keysize - (size_t)(2 * i), "%02x", digest[i]);
+
+  return (1);
+}
+
+
+//
+// 'cache_load()' - Load a document tree from the cache.
+//
+// The nodes are added as children of the parent (file) node.  Nothing is
+// added if the document is not in the cache or if an image it uses has
+// changed.
+//
+
+int					// O - 1 on success, 0 on failure
+cache_load(const char *key,		// I - Cache key
+           tree_t     *parent)		// I - Parent node
+{
+  unsigned char	*data;			// File contents
+  size_t	datalen;		// Length of file
+  cache_in_t	in;			// Input buffer
+  size_t	i,			// Looping var
+		j,			// Looping var
+		count,			// Number of dependencies/nodes
+		number;			// Node number
+  tree_t	**nodes = NULL,		// Nodes by number
+		*t,			// Current node
+		*tparent;		// Parent of current node
+  unsigned long long bits;		// Packed attributes
+  unsigned char	*bytes;			// Raw bytes
+  uchar		*s;			// Dependency filename
+
+
+  if (!key || !parent || (data = cache_read(key, "tree", &datalen)) == NULL)
+    return (0);
+
+  in.ptr   = data;
+  in.end   = data + datalen;
+  in.error = 0;
+
+  if ((bytes = cache_get_bytes(&in, strlen(CACHE_MAGIC))) == NULL || memcmp(bytes, CACHE_MAGIC, strlen(CACHE_MAGIC)))
+  {
+    free(data);
+    return (0);
+  }
+
+  // Make sure the images used for the layout have not changed...
+  for (count = (size_t)cache_get_number(&in), i = 0; i < count && !in.error; i ++)
+  {
+    struct stat	depinfo;		// Dependency information
+    unsigned long long size,		// Size of file
+		mtime;			// Modification time of file
+
+    s     = cache_get_string(&in);
+    size  = cache_get_number(&in);
+    mtime = cache_get_number(&in);
+
+    if (in.error || !s || stat((char *)s, &depinfo) || (unsigned long long)depinfo.st_size != size || (unsigned long long)depinfo.st_mtime != mtime)
+    {
+      free(data);
+      return (0);
+    }
+  }
+
+  // Rebuild the nodes...
+  count = (size_t)cache_get_number(&in);
+
+  if (in.error || count == 0 || count > (size_t)(in.end - in.ptr) || (nodes = (tree_t **)calloc(count, sizeof(tree_t *))) == NULL)
+  {
+    free(data);
+    return (0);
+  }
+
+  for (i = 0; i < count && !in.error; i ++)
+  {
+    if ((t = (tree_t *)calloc(1, sizeof(tree_t))) == NULL)
+    {
+      in.error = 1;
+      break;
+    }
+
+    stats_count(HD_COUNT_NODES, 1);
+
+    // Add the node to its parent...
+    if ((number = (size_t)cache_get_number(&in)) > i)
+    {
+      free(t);
+      in.error = 1;
+      break;
+    }
+
+    tparent   = number ? nodes[number - 1] : parent;
+    t->parent = tparent;
+
+    if (tparent->last_child)
+    {
+      tparent->last_child->next = t;
+      t->prev                   = tparent->last_child;
+    }
+    else
+      tparent->child = t;
+
+    tparent->last_child = t;
+    nodes[i]            = t;
+
+    // Then the node attributes...
+    if ((number = (size_t)cache_get_number(&in)) > (size_t)(MARKUP_WBR - MARKUP_FILE))
+    {
+      in.error = 1;
+      break;
+    }
+
+    t->markup        = (markup_t)((int)number + MARKUP_FILE);
+    bits             = cache_get_number(&in);
+    t->halignment    = (unsigned)(bits & 3);
+    t->valignment    = (unsigned)((bits >> 2) & 3);
+    t->typeface      = (unsigned)((bits >> 4) & 7);
+    t->size          = (unsigned)((bits >> 7) & 7);
+    t->style         = (unsigned)((bits >> 10) & 3);
+    t->underline     = (unsigned)((bits >> 12) & 1);
+    t->strikethrough = (unsigned)((bits >> 13) & 1);
+    t->subscript     = (unsigned)((bits >> 14) & 1);
+    t->superscript   = (unsigned)((bits >> 15) & 1);
+    t->preformatted  = (unsigned)((bits >> 16) & 1);
+    t->indent        = (unsigned)((bits >> 17) & 15);
+
+    if ((bytes = cache_get_bytes(&in, 3 + 2 * sizeof(float))) == NULL)
+      break;
+
+    t->red   = bytes[0];
+    t->green = bytes[1];
+    t->blue  = bytes[2];
+    memcpy(&t->width, bytes + 3, sizeof(float));
+    memcpy(&t->height, bytes + 3 + sizeof(float), sizeof(float));
+
+    if ((number = (size_t)cache_get_number(&in)) > i + 1)
+    {
+      in.error = 1;
+      break;
+    }
+
+    t->link = number ? nodes[number - 1] : NULL;
+    t->data = cache_get_text(&in);
+
+    // And finally the variables, which are already sorted...
+    if ((number = (size_t)cache_get_number(&in)) > 0)
+    {
+      if (number > (size_t)(in.end - in.ptr) || (t->vars = (var_t *)calloc(number, sizeof(var_t))) == NULL)
+      {
+        in.error = 1;
+        break;
+      }
+
+      t->nvars = (int)number;
+
+      for (j = 0; j < number; j ++)
+      {
+        t->vars[j].name  = cache_get_string(&in);
+        t->vars[j].value = cache_get_text(&in);
+
+        if (!t->vars[j].name)
+          in.error = 1;
+      }
+    }
+  }
+
+  if (in.error || in.ptr != in.end)
+  {
+    // Bad cache file, remove the partial tree...
+    htmlDeleteTree(parent->child);
+    parent->child      = NULL;
+    parent->last_child = NULL;
+
+    free(nodes);
+    free(data);
+
+    return (0);
+  }
+
+  // Repeat the side effects of parsing that the layout code depends on,
+  // namely the loaded images, font widths, metadata index, and STYLE
+  // properties...
+  if (parent->markup == MARKUP_FILE)
+    htmlIndexNode(parent);
+
+  for (i = 0; i < count; i ++)
+  {
+    t = nodes[i];
+
+    if (t->markup == MARKUP_IMG && (s = htmlGetVariable(t, (uchar *)"REALSRC")) != NULL)
+      image_load((char *)s, _htmlGrayscale);
+    else if (t->markup == MARKUP_NONE && t->data && !hd_atomic_get(&_htmlWidthsLoaded[t->typeface][t->style]))
+      htmlLoadFontWidths(t->typeface, t->style);
+    else if (t->markup == MARKUP_META || t->markup == MARKUP_HTML)
+      htmlIndexNode(t);
+
+    if (t->nvars > 0)
+      htmlParseStyle(t);
+  }
+
+  free(nodes);
+  free(data);
+
+  stats_count(HD_COUNT_CACHE_HITS, 1);
+
+  return (1);
+}
+
+
+//
+// 'cache_read()' - Read a file from the cache.
+//
+// The returned data must be freed with free().
+//
+
+unsigned char *				// O - File contents or NULL
+cache_read(const char *key,		// I - Cache key
+           const char *ext,		// I - Filename extension
+           size_t     *datalen)		// O - Length of file
+{
+  char		filename[1024];		// Cache filename
+  FILE		*fp;			// Cache file
+  struct stat	fileinfo;		// File information
+  unsigned char	*data = NULL;		// File contents
+
+
+  *datalen = 0;
+
+  if (!CacheDir[0])
+    return (NULL);
+
+  snprintf(filename, sizeof(filename), "%s/%s.%s", CacheDir, key, ext);
+
+  if ((fp = fopen(filename, "rb")) == NULL)
+    return (NULL);
+
+  if (fstat(fileno(fp), &fileinfo) || fileinfo.st_size <= 0 || (data = (unsigned char *)malloc((size_t)fileinfo.st_size)) == NULL || fread(data, 1, (size_t)fileinfo.st_size, fp) != (size_t)fileinfo.st_size)
+  {
+    free(data);
+    fclose(fp);
+    return (NULL);
+  }
+
+  fclose(fp);
+
+  *datalen = (size_t)fileinfo.st_size;
+
+  return (data);
+}
+
+
+//
+// 'cache_save()' - Save a document tree to the cache.
+//
+// Documents whose links or images cannot be saved are silently skipped.
+//
+
+void
+cache_save(const char *key,		// I - Cache key
+           tree_t     *parent)		// I - Parent node
+{
+  cache_buf_t	buf,			// Output buffer
+		deps;			// Dependencies
+  size_t	count = 0,		// Number of nodes
+		num_deps = 0,		// Number of dependencies
+		depth = 0,		// Current depth
+		alloc_stack = 0;	// Allocated stack entries
+  tree_t	*t,			// Current node
+		**stack = NULL;		// Ancestors of current node
+  size_t	*numbers = NULL,	// Ancestor node numbers
+		i,			// Looping var
+		link;			// Linked node number
+  int		j;			// Looping var
+  unsigned long long bits;		// Packed attributes
+  unsigned char	bytes[3 + 2 * sizeof(float)];
+					// Color and size
+  uchar		*src;			// Image filename
+  cache_buf_t	bufs[4];		// Buffers to write
+
+
+  if (!key || !parent || !parent->child)
+    return;
+
+  memset(&buf, 0, sizeof(buf));
+  memset(&deps, 0, sizeof(deps));
+
+  // Encode the nodes in document order, keeping track of the ancestors so
+  // that parent and link pointers can be saved as node numbers...
+  for (t = parent->child; t && !buf.error;)
+  {
+    count ++;
+
+    if (depth >= alloc_stack)
+    {
+      tree_t	**tstack;		// New ancestor stack
+      size_t	*tnumbers;		// New number stack
+
+      if ((tstack = (tree_t **)realloc(stack, (alloc_stack + 64) * sizeof(tree_t *))) == NULL)
+      {
+        buf.error = 1;
+        break;
+      }
+
+      stack = tstack;
+
+      if ((tnumbers = (size_t *)realloc(numbers, (alloc_stack + 64) * sizeof(size_t))) == NULL)
+      {
+        buf.error = 1;
+        break;
+      }
+
+      numbers     = tnumbers;
+      alloc_stack += 64;
+    }
+
+    stack[depth]   = t;
+    numbers[depth] = count;
+
+    // The parser only links nodes to themselves or an ancestor...
+    for (link = 0, i = depth + 1; t->link && i > 0; i --)
+    {
+      if (stack[i - 1] == t->link)
+      {
+        link = numbers[i - 1];
+        break;
+      }
+    }
+
+    if (t->link && !link)
+    {
+      buf.error = 1;
+      break;
+    }
+
+    bits = (unsigned long long)t->halignment |
+           ((unsigned long long)t->valignment << 2) |
+           ((unsigned long long)t->typeface << 4) |
+           ((unsigned long long)t->size << 7) |
+           ((unsigned long long)t->style << 10) |
+           ((unsigned long long)t->underline << 12) |
+           ((unsigned long long)t->strikethrough << 13) |
+           ((unsigned long long)t->subscript << 14) |
+           ((unsigned long long)t->superscript << 15) |
+           ((unsigned long long)t->preformatted << 16) |
+           ((unsigned long long)t->indent << 17);
+
+    bytes[0] = t->red;
+    bytes[1] = t->green;
+    bytes[2] = t->blue;
+    memcpy(bytes + 3, &t->width, sizeof(float));
+    memcpy(bytes + 3 + sizeof(float), &t->height, sizeof(float));
+
+    cache_add_number(&buf, depth > 0 ? numbers[depth - 1] : 0);
+    cache_add_number(&buf, (unsigned long long)(t->markup - MARKUP_FILE));
+    cache_add_number(&buf, bits);
+    cache_add_bytes(&buf, bytes, sizeof(bytes));
+    cache_add_number(&buf, link);
+    cache_add_text(&buf, t->data);
+    cache_add_number(&buf, (unsigned long long)t->nvars);
+
+    for (j = 0; j < t->nvars; j ++)
+    {
+      cache_add_string(&buf, t->vars[j].name);
+      cache_add_text(&buf, t->vars[j].value);
+    }
+
+    // Image sizes come from the image files...
+    if (t->markup == MARKUP_IMG && (src = htmlGetVariable(t, (uchar *)"REALSRC")) != NULL)
+    {
+      struct stat fileinfo;		// Image file information
+
+      if (stat((char *)src, &fileinfo))
+      {
+        buf.error = 1;
+        break;
+      }
+
+      cache_add_string(&deps, src);
+      cache_add_number(&deps, (unsigned long long)fileinfo.st_size);
+      cache_add_number(&deps, (unsigned long long)fileinfo.st_mtime);
+      num_deps ++;
+    }
+
+    // Move to the next node...
+    if (t->child)
+    {
+      depth ++;
+      t = t->child;
+    }
+    else
+    {
+      while (!t->next && depth > 0)
+      {
+        depth --;
+        t = stack[depth];
+      }
+
+      t = t->next;
+    }
+  }
+
+  free(stack);
+  free(numbers);
+
+  if (buf.error || deps.error)
+  {
+    free(buf.data);
+    free(deps.data);
+    return;
+  }
+
+  // Write the header, dependencies, and nodes...
+  memset(bufs, 0, sizeof(bufs));
+
+  cache_add_bytes(bufs + 0, CACHE_MAGIC, strlen(CACHE_MAGIC));
+  cache_add_number(bufs + 0, num_deps);
+  bufs[1] = deps;
+  cache_add_number(bufs + 2, count);
+  bufs[3] = buf;
+
+  cache_write(key, "tree", bufs, 4);
+
+  free(bufs[0].data);
+  free(bufs[2].data);
+  free(buf.data);
+  free(deps.data);
+}
+
+
+//
+// 'cache_write()' - Write a file to the cache.
+//
+// The buffers are written in order under a temporary name and the file is
+// then renamed, so concurrent builds can share a cache directory.  Nothing is
+// written if any of the buffers had an allocation failure.
+//
+
+void
+cache_write(const char  *key,		// I - Cache key
+            const char  *ext,		// I - Filename extension
+            cache_buf_t *bufs,		// I - Buffers to write
+            int         num_bufs)	// I - Number of buffers
+{
+  int		i;			// Looping var
+  char		filename[1024],		// Cache filename
+		tempname[1024];		// Temporary filename
+  FILE		*fp;			// Cache file
+  int		temp;			// Temporary file number
+
+
+  if (!CacheDir[0])
+    return;
+
+  for (i = 0; i < num_bufs; i ++)
+    if (bufs[i].error)
+      return;
+
+  hd_mutex_lock(&cache_mutex);
+  temp = ++ cache_temps;
+  hd_mutex_unlock(&cache_mutex);
+
+  snprintf(filename, sizeof(filename), "%s/%s.%s", CacheDir, key, ext);
+  snprintf(tempname, sizeof(tempname), "%s/%s.%ld.%d", CacheDir, key, (long)getpid(), temp);
+
+  if ((fp = fopen(tempname, "wb")) == NULL && errno == ENOENT && !mkdir(CacheDir, 0777))
+    fp = fopen(tempname, "wb");
+
+  if (!fp)
+    return;
+
+  for (i = 0; i < num_bufs; i ++)
+    if (bufs[i].used > 0)
+      fwrite(bufs[i].data, 1, bufs[i].used, fp);
+
+  if (fclose(fp))
+    unlink(tempname);
+  else if (rename(tempname, filename))
+    unlink(tempname);
+}
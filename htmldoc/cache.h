@@ -0,0 +1,72 @@
+/*
+ * Parsed document cache definitions for HTMLDOC, a HTML document processing
+ * program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+#ifndef _CACHE_H_
+#  define _CACHE_H_
+
+#  include "html.h"
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif /* __cplusplus */
+
+
+/*
+ * Constants...
+ */
+
+#  define HD_CACHE_KEY_SIZE	33	/* Size of a cache key string */
+
+
+/*
+ * Types...
+ */
+
+typedef struct				/**** Output buffer ****/
+{
+  unsigned char	*data;			/* Buffer data */
+  size_t	used,			/* Bytes used */
+		alloc;			/* Bytes allocated */
+  int		error;			/* Non-zero on allocation failure */
+} cache_buf_t;
+
+typedef struct				/**** Input buffer ****/
+{
+  const unsigned char *ptr,		/* Current position */
+		*end;			/* End of data */
+  int		error;			/* Non-zero on bad data */
+} cache_in_t;
+
+
+/*
+ * Prototypes...
+ */
+
+extern void	cache_add_bytes(cache_buf_t *buf, const void *data, size_t bytes);
+extern void	cache_add_number(cache_buf_t *buf, unsigned long long number);
+extern void	cache_add_string(cache_buf_t *buf, const uchar *s);
+extern void	cache_add_text(cache_buf_t *buf, const uchar *s);
+extern unsigned char *cache_get_bytes(cache_in_t *in, size_t bytes);
+extern unsigned long long cache_get_number(cache_in_t *in);
+extern uchar	*cache_get_string(cache_in_t *in);
+extern uchar	*cache_get_text(cache_in_t *in);
+extern int	cache_key(FILE *fp, const char *filename, const char *base,
+		          int markdown, char *key, size_t keysize);
+extern int	cache_load(const char *key, tree_t *parent);
+extern unsigned char *cache_read(const char *key, const char *ext, size_t *datalen);
+extern void	cache_save(const char *key, tree_t *parent);
+extern void	cache_write(const char *key, const char *ext, cache_buf_t *bufs,
+		            int num_bufs);
+
+#  ifdef __cplusplus
+}
+#  endif /* __cplusplus */
+
+#endif /* !_CACHE_H_ */
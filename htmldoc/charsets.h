@@ -0,0 +1,1211 @@
+//
+// Built-in character set tables for HTMLDOC, an HTML document processing
+// program.
+//
+// This file is generated by "tools/makecharsets.py" - do not edit!
+//
+// Copyright 2026 by Michael R Sweet.
+//
+// This program is free software.  Distribution and use rights are outlined in
+// the file "COPYING".
+//
+
+#ifndef _HTMLDOC_CHARSETS_H_
+#  define _HTMLDOC_CHARSETS_H_
+
+
+//
+// Types...
+//
+
+typedef struct hd_glyph_s		// Glyph name for a Unicode character
+{
+  unsigned short	unicode,		// Unicode character
+			name;			// Offset of name in hd_glyph_names[]
+} hd_glyph_t;
+
+typedef struct hd_charset_s		// Built-in character set
+{
+  const char		*name;			// Name of character set
+  const unsigned short	*unicode;		// Unicode value for each character
+} hd_charset_t;
+
+
+// Glyph names from "data/psglyphs" (1051 glyphs, 9599 bytes)
+static const char hd_glyph_names[] =
+  "space\0" "exclam\0" "quotedbl\0" "numbersign\0" "dollar\0" "percent\0"
+  "ampersand\0" "quotesingle\0" "parenleft\0" "parenright\0" "asterisk\0" "plus\0"
+  "comma\0" "hyphen\0" "period\0" "slash\0" "zero\0" "one\0"
+  "two\0" "three\0" "four\0" "five\0" "six\0" "seven\0"
+  "eight\0" "nine\0" "colon\0" "semicolon\0" "less\0" "equal\0"
+  "greater\0" "question\0" "at\0" "A\0" "B\0" "C\0"
+  "D\0" "E\0" "F\0" "G\0" "H\0" "I\0"
+  "J\0" "K\0" "L\0" "M\0" "N\0" "O\0"
+  "P\0" "Q\0" "R\0" "S\0" "T\0" "U\0"
+  "V\0" "W\0" "X\0" "Y\0" "Z\0" "bracketleft\0"
+  "backslash\0" "bracketright\0" "asciicircum\0" "underscore\0" "grave\0" "a\0"
+  "b\0" "c\0" "d\0" "e\0" "f\0" "g\0"
+  "h\0" "i\0" "j\0" "k\0" "l\0" "m\0"
+  "n\0" "o\0" "p\0" "q\0" "r\0" "s\0"
+  "t\0" "u\0" "v\0" "w\0" "x\0" "y\0"
+  "z\0" "braceleft\0" "bar\0" "braceright\0" "asciitilde\0" "exclamdown\0"
+  "cent\0" "sterling\0" "currency\0" "yen\0" "brokenbar\0" "section\0"
+  "dieresis\0" "copyright\0" "ordfeminine\0" "guillemotleft\0" "logicalnot\0" "minus\0"
+  "registered\0" "macron\0" "degree\0" "plusminus\0" "twosuperior\0" "threesuperior\0"
+  "acute\0" "mu\0" "paragraph\0" "periodcentered\0" "cedilla\0" "onesuperior\0"
+  "ordmasculine\0" "guillemotright\0" "onequarter\0" "onehalf\0" "threequarters\0" "questiondown\0"
+  "Agrave\0" "Aacute\0" "Acircumflex\0" "Atilde\0" "Adieresis\0" "Aring\0"
+  "AE\0" "Ccedilla\0" "Egrave\0" "Eacute\0" "Ecircumflex\0" "Edieresis\0"
+  "Igrave\0" "Iacute\0" "Icircumflex\0" "Idieresis\0" "Eth\0" "Ntilde\0"
+  "Ograve\0" "Oacute\0" "Ocircumflex\0" "Otilde\0" "Odieresis\0" "multiply\0"
+  "Oslash\0" "Ugrave\0" "Uacute\0" "Ucircumflex\0" "Udieresis\0" "Yacute\0"
+  "Thorn\0" "germandbls\0" "agrave\0" "aacute\0" "acircumflex\0" "atilde\0"
+  "adieresis\0" "aring\0" "ae\0" "ccedilla\0" "egrave\0" "eacute\0"
+  "ecircumflex\0" "edieresis\0" "igrave\0" "iacute\0" "icircumflex\0" "idieresis\0"
+  "eth\0" "ntilde\0" "ograve\0" "oacute\0" "ocircumflex\0" "otilde\0"
+  "odieresis\0" "divide\0" "oslash\0" "ugrave\0" "uacute\0" "ucircumflex\0"
+  "udieresis\0" "yacute\0" "thorn\0" "ydieresis\0" "Amacron\0" "amacron\0"
+  "Abreve\0" "abreve\0" "Aogonek\0" "aogonek\0" "Cacute\0" "cacute\0"
+  "Ccircumflex\0" "ccircumflex\0" "Cdotaccent\0" "cdotaccent\0" "Ccaron\0" "ccaron\0"
+  "Dcaron\0" "dcaron\0" "Dcroat\0" "dcroat\0" "Emacron\0" "emacron\0"
+  "Ebreve\0" "ebreve\0" "Edotaccent\0" "edotaccent\0" "Eogonek\0" "eogonek\0"
+  "Ecaron\0" "ecaron\0" "Gcircumflex\0" "gcircumflex\0" "Gbreve\0" "gbreve\0"
+  "Gdotaccent\0" "gdotaccent\0" "Gcommaaccent\0" "gcommaaccent\0" "Hcircumflex\0" "hcircumflex\0"
+  "Hbar\0" "hbar\0" "Itilde\0" "itilde\0" "Imacron\0" "imacron\0"
+  "Ibreve\0" "ibreve\0" "Iogonek\0" "iogonek\0" "Idotaccent\0" "dotlessi\0"
+  "IJ\0" "ij\0" "Jcircumflex\0" "jcircumflex\0" "Kcommaaccent\0" "kcommaaccent\0"
+  "kgreenlandic\0" "Lacute\0" "lacute\0" "Lcommaaccent\0" "lcommaaccent\0" "Lcaron\0"
+  "lcaron\0" "Ldot\0" "ldot\0" "Lslash\0" "lslash\0" "Nacute\0"
+  "nacute\0" "Ncommaaccent\0" "ncommaaccent\0" "Ncaron\0" "ncaron\0" "napostrophe\0"
+  "Eng\0" "eng\0" "Omacron\0" "omacron\0" "Obreve\0" "obreve\0"
+  "Ohungarumlaut\0" "ohungarumlaut\0" "OE\0" "oe\0" "Racute\0" "racute\0"
+  "Rcommaaccent\0" "rcommaaccent\0" "Rcaron\0" "rcaron\0" "Sacute\0" "sacute\0"
+  "Scircumflex\0" "scircumflex\0" "Scedilla\0" "scedilla\0" "Scaron\0" "scaron\0"
+  "Tcommaaccent\0" "tcommaaccent\0" "Tcaron\0" "tcaron\0" "Tbar\0" "tbar\0"
+  "Utilde\0" "utilde\0" "Umacron\0" "umacron\0" "Ubreve\0" "ubreve\0"
+  "Uring\0" "uring\0" "Uhungarumlaut\0" "uhungarumlaut\0" "Uogonek\0" "uogonek\0"
+  "Wcircumflex\0" "wcircumflex\0" "Ycircumflex\0" "ycircumflex\0" "Ydieresis\0" "Zacute\0"
+  "zacute\0" "Zdotaccent\0" "zdotaccent\0" "Zcaron\0" "zcaron\0" "longs\0"
+  "florin\0" "Ohorn\0" "ohorn\0" "Uhorn\0" "uhorn\0" "Gcaron\0"
+  "gcaron\0" "Aringacute\0" "aringacute\0" "AEacute\0" "aeacute\0" "Oslashacute\0"
+  "oslashacute\0" "Scommaaccent\0" "scommaaccent\0" "afii57929\0" "afii64937\0" "circumflex\0"
+  "caron\0" "breve\0" "dotaccent\0" "ring\0" "ogonek\0" "tilde\0"
+  "hungarumlaut\0" "gravecomb\0" "acutecomb\0" "tildecomb\0" "hookabovecomb\0" "dotbelowcomb\0"
+  "tonos\0" "dieresistonos\0" "Alphatonos\0" "anoteleia\0" "Epsilontonos\0" "Etatonos\0"
+  "Iotatonos\0" "Omicrontonos\0" "Upsilontonos\0" "Omegatonos\0" "iotadieresistonos\0" "Alpha\0"
+  "Beta\0" "Gamma\0" "Delta\0" "Epsilon\0" "Zeta\0" "Eta\0"
+  "Theta\0" "Iota\0" "Kappa\0" "Lambda\0" "Mu\0" "Nu\0"
+  "Xi\0" "Omicron\0" "Pi\0" "Rho\0" "Sigma\0" "Tau\0"
+  "Upsilon\0" "Phi\0" "Chi\0" "Psi\0" "Omega\0" "Iotadieresis\0"
+  "Upsilondieresis\0" "alphatonos\0" "epsilontonos\0" "etatonos\0" "iotatonos\0" "upsilondieresistonos\0"
+  "alpha\0" "beta\0" "gamma\0" "delta\0" "epsilon\0" "zeta\0"
+  "eta\0" "theta\0" "iota\0" "kappa\0" "lambda\0" "nu\0"
+  "xi\0" "omicron\0" "pi\0" "rho\0" "sigma1\0" "sigma\0"
+  "tau\0" "upsilon\0" "phi\0" "chi\0" "psi\0" "omega\0"
+  "iotadieresis\0" "upsilondieresis\0" "omicrontonos\0" "upsilontonos\0" "omegatonos\0" "theta1\0"
+  "Upsilon1\0" "phi1\0" "omega1\0" "afii10023\0" "afii10051\0" "afii10052\0"
+  "afii10053\0" "afii10054\0" "afii10055\0" "afii10056\0" "afii10057\0" "afii10058\0"
+  "afii10059\0" "afii10060\0" "afii10061\0" "afii10062\0" "afii10145\0" "afii10017\0"
+  "afii10018\0" "afii10019\0" "afii10020\0" "afii10021\0" "afii10022\0" "afii10024\0"
+  "afii10025\0" "afii10026\0" "afii10027\0" "afii10028\0" "afii10029\0" "afii10030\0"
+  "afii10031\0" "afii10032\0" "afii10033\0" "afii10034\0" "afii10035\0" "afii10036\0"
+  "afii10037\0" "afii10038\0" "afii10039\0" "afii10040\0" "afii10041\0" "afii10042\0"
+  "afii10043\0" "afii10044\0" "afii10045\0" "afii10046\0" "afii10047\0" "afii10048\0"
+  "afii10049\0" "afii10065\0" "afii10066\0" "afii10067\0" "afii10068\0" "afii10069\0"
+  "afii10070\0" "afii10072\0" "afii10073\0" "afii10074\0" "afii10075\0" "afii10076\0"
+  "afii10077\0" "afii10078\0" "afii10079\0" "afii10080\0" "afii10081\0" "afii10082\0"
+  "afii10083\0" "afii10084\0" "afii10085\0" "afii10086\0" "afii10087\0" "afii10088\0"
+  "afii10089\0" "afii10090\0" "afii10091\0" "afii10092\0" "afii10093\0" "afii10094\0"
+  "afii10095\0" "afii10096\0" "afii10097\0" "afii10071\0" "afii10099\0" "afii10100\0"
+  "afii10101\0" "afii10102\0" "afii10103\0" "afii10104\0" "afii10105\0" "afii10106\0"
+  "afii10107\0" "afii10108\0" "afii10109\0" "afii10110\0" "afii10193\0" "afii10146\0"
+  "afii10194\0" "afii10147\0" "afii10195\0" "afii10148\0" "afii10196\0" "afii10050\0"
+  "afii10098\0" "afii10846\0" "afii57799\0" "afii57801\0" "afii57800\0" "afii57802\0"
+  "afii57793\0" "afii57794\0" "afii57795\0" "afii57798\0" "afii57797\0" "afii57806\0"
+  "afii57796\0" "afii57807\0" "afii57839\0" "afii57645\0" "afii57841\0" "afii57842\0"
+  "afii57804\0" "afii57803\0" "afii57658\0" "afii57664\0" "afii57665\0" "afii57666\0"
+  "afii57667\0" "afii57668\0" "afii57669\0" "afii57670\0" "afii57671\0" "afii57672\0"
+  "afii57673\0" "afii57674\0" "afii57675\0" "afii57676\0" "afii57677\0" "afii57678\0"
+  "afii57679\0" "afii57680\0" "afii57681\0" "afii57682\0" "afii57683\0" "afii57684\0"
+  "afii57685\0" "afii57686\0" "afii57687\0" "afii57688\0" "afii57689\0" "afii57690\0"
+  "afii57716\0" "afii57717\0" "afii57718\0" "afii57388\0" "afii57403\0" "afii57407\0"
+  "afii57409\0" "afii57410\0" "afii57411\0" "afii57412\0" "afii57413\0" "afii57414\0"
+  "afii57415\0" "afii57416\0" "afii57417\0" "afii57418\0" "afii57419\0" "afii57420\0"
+  "afii57421\0" "afii57422\0" "afii57423\0" "afii57424\0" "afii57425\0" "afii57426\0"
+  "afii57427\0" "afii57428\0" "afii57429\0" "afii57430\0" "afii57431\0" "afii57432\0"
+  "afii57433\0" "afii57434\0" "afii57440\0" "afii57441\0" "afii57442\0" "afii57443\0"
+  "afii57444\0" "afii57445\0" "afii57446\0" "afii57470\0" "afii57448\0" "afii57449\0"
+  "afii57450\0" "afii57451\0" "afii57452\0" "afii57453\0" "afii57454\0" "afii57455\0"
+  "afii57456\0" "afii57457\0" "afii57458\0" "afii57392\0" "afii57393\0" "afii57394\0"
+  "afii57395\0" "afii57396\0" "afii57397\0" "afii57398\0" "afii57399\0" "afii57400\0"
+  "afii57401\0" "afii57381\0" "afii63167\0" "afii57511\0" "afii57506\0" "afii57507\0"
+  "afii57512\0" "afii57513\0" "afii57508\0" "afii57505\0" "afii57509\0" "afii57514\0"
+  "afii57519\0" "afii57534\0" "Wgrave\0" "wgrave\0" "Wacute\0" "wacute\0"
+  "Wdieresis\0" "wdieresis\0" "Ygrave\0" "ygrave\0" "afii61664\0" "afii301\0"
+  "afii299\0" "afii300\0" "figuredash\0" "endash\0" "emdash\0" "afii00208\0"
+  "underscoredbl\0" "quoteleft\0" "quoteright\0" "quotesinglbase\0" "quotereversed\0" "quotedblleft\0"
+  "quotedblright\0" "quotedblbase\0" "dagger\0" "daggerdbl\0" "bullet\0" "onedotenleader\0"
+  "twodotenleader\0" "ellipsis\0" "afii61573\0" "afii61574\0" "afii61575\0" "perthousand\0"
+  "minute\0" "second\0" "guilsinglleft\0" "guilsinglright\0" "exclamdbl\0" "fraction\0"
+  "zerosuperior\0" "foursuperior\0" "fivesuperior\0" "sixsuperior\0" "sevensuperior\0" "eightsuperior\0"
+  "ninesuperior\0" "parenleftsuperior\0" "parenrightsuperior\0" "nsuperior\0" "zeroinferior\0" "oneinferior\0"
+  "twoinferior\0" "threeinferior\0" "fourinferior\0" "fiveinferior\0" "sixinferior\0" "seveninferior\0"
+  "eightinferior\0" "nineinferior\0" "parenleftinferior\0" "parenrightinferior\0" "colonmonetary\0" "franc\0"
+  "lira\0" "peseta\0" "afii57636\0" "dong\0" "Euro\0" "afii61248\0"
+  "Ifraktur\0" "afii61289\0" "afii61352\0" "weierstrass\0" "Rfraktur\0" "prescription\0"
+  "trademark\0" "estimated\0" "aleph\0" "onethird\0" "twothirds\0" "oneeighth\0"
+  "threeeighths\0" "fiveeighths\0" "seveneighths\0" "arrowleft\0" "arrowup\0" "arrowright\0"
+  "arrowdown\0" "arrowboth\0" "arrowupdn\0" "arrowupdnbse\0" "carriagereturn\0" "arrowdblleft\0"
+  "arrowdblup\0" "arrowdblright\0" "arrowdbldown\0" "arrowdblboth\0" "universal\0" "partialdiff\0"
+  "existential\0" "emptyset\0" "gradient\0" "element\0" "notelement\0" "suchthat\0"
+  "product\0" "summation\0" "asteriskmath\0" "radical\0" "proportional\0" "infinity\0"
+  "orthogonal\0" "angle\0" "logicaland\0" "logicalor\0" "intersection\0" "union\0"
+  "integral\0" "therefore\0" "similar\0" "congruent\0" "approxequal\0" "notequal\0"
+  "equivalence\0" "lessequal\0" "greaterequal\0" "propersubset\0" "propersuperset\0" "notsubset\0"
+  "reflexsubset\0" "reflexsuperset\0" "circleplus\0" "circlemultiply\0" "perpendicular\0" "dotmath\0"
+  "house\0" "revlogicalnot\0" "integraltp\0" "integralbt\0" "angleleft\0" "angleright\0"
+  "SF100000\0" "SF110000\0" "SF010000\0" "SF030000\0" "SF020000\0" "SF040000\0"
+  "SF080000\0" "SF090000\0" "SF060000\0" "SF070000\0" "SF050000\0" "SF430000\0"
+  "SF240000\0" "SF510000\0" "SF520000\0" "SF390000\0" "SF220000\0" "SF210000\0"
+  "SF250000\0" "SF500000\0" "SF490000\0" "SF380000\0" "SF280000\0" "SF270000\0"
+  "SF260000\0" "SF360000\0" "SF370000\0" "SF420000\0" "SF190000\0" "SF200000\0"
+  "SF230000\0" "SF470000\0" "SF480000\0" "SF410000\0" "SF450000\0" "SF460000\0"
+  "SF400000\0" "SF540000\0" "SF530000\0" "SF440000\0" "upblock\0" "dnblock\0"
+  "block\0" "lfblock\0" "rtblock\0" "ltshade\0" "shade\0" "dkshade\0"
+  "filledbox\0" "H22073\0" "H18543\0" "H18551\0" "filledrect\0" "triagup\0"
+  "triagrt\0" "triagdn\0" "triaglf\0" "lozenge\0" "circle\0" "H18533\0"
+  "invbullet\0" "invcircle\0" "openbullet\0" "smileface\0" "invsmileface\0" "sun\0"
+  "female\0" "male\0" "spade\0" "club\0" "heart\0" "diamond\0"
+  "musicalnote\0" "musicalnotedbl\0" "dotlessj\0" "LL\0" "ll\0" "commaaccent\0"
+  "afii10063\0" "afii10064\0" "afii10192\0" "afii10831\0" "afii10832\0" "Acute\0"
+  "Caron\0" "Dieresis\0" "DieresisAcute\0" "DieresisGrave\0" "Grave\0" "Hungarumlaut\0"
+  "Macron\0" "cyrBreve\0" "cyrFlex\0" "dblGrave\0" "cyrbreve\0" "cyrflex\0"
+  "dblgrave\0" "dieresisacute\0" "dieresisgrave\0" "copyrightserif\0" "registerserif\0" "trademarkserif\0"
+  "onefitted\0" "rupiah\0" "threequartersemdash\0" "centinferior\0" "centsuperior\0" "commainferior\0"
+  "commasuperior\0" "dollarinferior\0" "dollarsuperior\0" "hypheninferior\0" "hyphensuperior\0" "periodinferior\0"
+  "periodsuperior\0" "asuperior\0" "bsuperior\0" "dsuperior\0" "esuperior\0" "isuperior\0"
+  "lsuperior\0" "msuperior\0" "osuperior\0" "rsuperior\0" "ssuperior\0" "tsuperior\0"
+  "Brevesmall\0" "Caronsmall\0" "Circumflexsmall\0" "Dotaccentsmall\0" "Hungarumlautsmall\0" "Lslashsmall\0"
+  "OEsmall\0" "Ogoneksmall\0" "Ringsmall\0" "Scaronsmall\0" "Tildesmall\0" "Zcaronsmall\0"
+  "exclamsmall\0" "dollaroldstyle\0" "ampersandsmall\0" "zerooldstyle\0" "oneoldstyle\0" "twooldstyle\0"
+  "threeoldstyle\0" "fouroldstyle\0" "fiveoldstyle\0" "sixoldstyle\0" "sevenoldstyle\0" "eightoldstyle\0"
+  "nineoldstyle\0" "questionsmall\0" "Gravesmall\0" "Asmall\0" "Bsmall\0" "Csmall\0"
+  "Dsmall\0" "Esmall\0" "Fsmall\0" "Gsmall\0" "Hsmall\0" "Ismall\0"
+  "Jsmall\0" "Ksmall\0" "Lsmall\0" "Msmall\0" "Nsmall\0" "Osmall\0"
+  "Psmall\0" "Qsmall\0" "Rsmall\0" "Ssmall\0" "Tsmall\0" "Usmall\0"
+  "Vsmall\0" "Wsmall\0" "Xsmall\0" "Ysmall\0" "Zsmall\0" "exclamdownsmall\0"
+  "centoldstyle\0" "Dieresissmall\0" "Macronsmall\0" "Acutesmall\0" "Cedillasmall\0" "questiondownsmall\0"
+  "Agravesmall\0" "Aacutesmall\0" "Acircumflexsmall\0" "Atildesmall\0" "Adieresissmall\0" "Aringsmall\0"
+  "AEsmall\0" "Ccedillasmall\0" "Egravesmall\0" "Eacutesmall\0" "Ecircumflexsmall\0" "Edieresissmall\0"
+  "Igravesmall\0" "Iacutesmall\0" "Icircumflexsmall\0" "Idieresissmall\0" "Ethsmall\0" "Ntildesmall\0"
+  "Ogravesmall\0" "Oacutesmall\0" "Ocircumflexsmall\0" "Otildesmall\0" "Odieresissmall\0" "Oslashsmall\0"
+  "Ugravesmall\0" "Uacutesmall\0" "Ucircumflexsmall\0" "Udieresissmall\0" "Yacutesmall\0" "Thornsmall\0"
+  "Ydieresissmall\0" "radicalex\0" "arrowvertex\0" "arrowhorizex\0" "registersans\0" "copyrightsans\0"
+  "trademarksans\0" "parenlefttp\0" "parenleftex\0" "parenleftbt\0" "bracketlefttp\0" "bracketleftex\0"
+  "bracketleftbt\0" "bracelefttp\0" "braceleftmid\0" "braceleftbt\0" "braceex\0" "integralex\0"
+  "parenrighttp\0" "parenrightex\0" "parenrightbt\0" "bracketrighttp\0" "bracketrightex\0" "bracketrightbt\0"
+  "bracerighttp\0" "bracerightmid\0" "bracerightbt\0" "ff\0" "fi\0" "fl\0"
+  "ffi\0" "ffl\0" "afii57705\0" "afii57694\0" "afii57695\0" "afii57723\0"
+  "afii57700\0";
+
+static const hd_glyph_t hd_glyphs[1051] =
+{
+  { 0x0020, 0 }, { 0x0021, 6 }, { 0x0022, 13 }, { 0x0023, 22 }, { 0x0024, 33 }, { 0x0025, 40 }, { 0x0026, 48 }, { 0x0027, 58 },
+  { 0x0028, 70 }, { 0x0029, 80 }, { 0x002a, 91 }, { 0x002b, 100 }, { 0x002c, 105 }, { 0x002d, 111 }, { 0x002e, 118 }, { 0x002f, 125 },
+  { 0x0030, 131 }, { 0x0031, 136 }, { 0x0032, 140 }, { 0x0033, 144 }, { 0x0034, 150 }, { 0x0035, 155 }, { 0x0036, 160 }, { 0x0037, 164 },
+  { 0x0038, 170 }, { 0x0039, 176 }, { 0x003a, 181 }, { 0x003b, 187 }, { 0x003c, 197 }, { 0x003d, 202 }, { 0x003e, 208 }, { 0x003f, 216 },
+  { 0x0040, 225 }, { 0x0041, 228 }, { 0x0042, 230 }, { 0x0043, 232 }, { 0x0044, 234 }, { 0x0045, 236 }, { 0x0046, 238 }, { 0x0047, 240 },
+  { 0x0048, 242 }, { 0x0049, 244 }, { 0x004a, 246 }, { 0x004b, 248 }, { 0x004c, 250 }, { 0x004d, 252 }, { 0x004e, 254 }, { 0x004f, 256 },
+  { 0x0050, 258 }, { 0x0051, 260 }, { 0x0052, 262 }, { 0x0053, 264 }, { 0x0054, 266 }, { 0x0055, 268 }, { 0x0056, 270 }, { 0x0057, 272 },
+  { 0x0058, 274 }, { 0x0059, 276 }, { 0x005a, 278 }, { 0x005b, 280 }, { 0x005c, 292 }, { 0x005d, 302 }, { 0x005e, 315 }, { 0x005f, 327 },
+  { 0x0060, 338 }, { 0x0061, 344 }, { 0x0062, 346 }, { 0x0063, 348 }, { 0x0064, 350 }, { 0x0065, 352 }, { 0x0066, 354 }, { 0x0067, 356 },
+  { 0x0068, 358 }, { 0x0069, 360 }, { 0x006a, 362 }, { 0x006b, 364 }, { 0x006c, 366 }, { 0x006d, 368 }, { 0x006e, 370 }, { 0x006f, 372 },
+  { 0x0070, 374 }, { 0x0071, 376 }, { 0x0072, 378 }, { 0x0073, 380 }, { 0x0074, 382 }, { 0x0075, 384 }, { 0x0076, 386 }, { 0x0077, 388 },
+  { 0x0078, 390 }, { 0x0079, 392 }, { 0x007a, 394 }, { 0x007b, 396 }, { 0x007c, 406 }, { 0x007d, 410 }, { 0x007e, 421 }, { 0x00a0, 0 },
+  { 0x00a1, 432 }, { 0x00a2, 443 }, { 0x00a3, 448 }, { 0x00a4, 457 }, { 0x00a5, 466 }, { 0x00a6, 470 }, { 0x00a7, 480 }, { 0x00a8, 488 },
+  { 0x00a9, 497 }, { 0x00aa, 507 }, { 0x00ab, 519 }, { 0x00ac, 533 }, { 0x00ad, 544 }, { 0x00ae, 550 }, { 0x00af, 561 }, { 0x00b0, 568 },
+  { 0x00b1, 575 }, { 0x00b2, 585 }, { 0x00b3, 597 }, { 0x00b4, 611 }, { 0x00b5, 617 }, { 0x00b6, 620 }, { 0x00b7, 630 }, { 0x00b8, 645 },
+  { 0x00b9, 653 }, { 0x00ba, 665 }, { 0x00bb, 678 }, { 0x00bc, 693 }, { 0x00bd, 704 }, { 0x00be, 712 }, { 0x00bf, 726 }, { 0x00c0, 739 },
+  { 0x00c1, 746 }, { 0x00c2, 753 }, { 0x00c3, 765 }, { 0x00c4, 772 }, { 0x00c5, 782 }, { 0x00c6, 788 }, { 0x00c7, 791 }, { 0x00c8, 800 },
+  { 0x00c9, 807 }, { 0x00ca, 814 }, { 0x00cb, 826 }, { 0x00cc, 836 }, { 0x00cd, 843 }, { 0x00ce, 850 }, { 0x00cf, 862 }, { 0x00d0, 872 },
+  { 0x00d1, 876 }, { 0x00d2, 883 }, { 0x00d3, 890 }, { 0x00d4, 897 }, { 0x00d5, 909 }, { 0x00d6, 916 }, { 0x00d7, 926 }, { 0x00d8, 935 },
+  { 0x00d9, 942 }, { 0x00da, 949 }, { 0x00db, 956 }, { 0x00dc, 968 }, { 0x00dd, 978 }, { 0x00de, 985 }, { 0x00df, 991 }, { 0x00e0, 1002 },
+  { 0x00e1, 1009 }, { 0x00e2, 1016 }, { 0x00e3, 1028 }, { 0x00e4, 1035 }, { 0x00e5, 1045 }, { 0x00e6, 1051 }, { 0x00e7, 1054 }, { 0x00e8, 1063 },
+  { 0x00e9, 1070 }, { 0x00ea, 1077 }, { 0x00eb, 1089 }, { 0x00ec, 1099 }, { 0x00ed, 1106 }, { 0x00ee, 1113 }, { 0x00ef, 1125 }, { 0x00f0, 1135 },
+  { 0x00f1, 1139 }, { 0x00f2, 1146 }, { 0x00f3, 1153 }, { 0x00f4, 1160 }, { 0x00f5, 1172 }, { 0x00f6, 1179 }, { 0x00f7, 1189 }, { 0x00f8, 1196 },
+  { 0x00f9, 1203 }, { 0x00fa, 1210 }, { 0x00fb, 1217 }, { 0x00fc, 1229 }, { 0x00fd, 1239 }, { 0x00fe, 1246 }, { 0x00ff, 1252 }, { 0x0100, 1262 },
+  { 0x0101, 1270 }, { 0x0102, 1278 }, { 0x0103, 1285 }, { 0x0104, 1292 }, { 0x0105, 1300 }, { 0x0106, 1308 }, { 0x0107, 1315 }, { 0x0108, 1322 },
+  { 0x0109, 1334 }, { 0x010a, 1346 }, { 0x010b, 1357 }, { 0x010c, 1368 }, { 0x010d, 1375 }, { 0x010e, 1382 }, { 0x010f, 1389 }, { 0x0110, 1396 },
+  { 0x0111, 1403 }, { 0x0112, 1410 }, { 0x0113, 1418 }, { 0x0114, 1426 }, { 0x0115, 1433 }, { 0x0116, 1440 }, { 0x0117, 1451 }, { 0x0118, 1462 },
+  { 0x0119, 1470 }, { 0x011a, 1478 }, { 0x011b, 1485 }, { 0x011c, 1492 }, { 0x011d, 1504 }, { 0x011e, 1516 }, { 0x011f, 1523 }, { 0x0120, 1530 },
+  { 0x0121, 1541 }, { 0x0122, 1552 }, { 0x0123, 1565 }, { 0x0124, 1578 }, { 0x0125, 1590 }, { 0x0126, 1602 }, { 0x0127, 1607 }, { 0x0128, 1612 },
+  { 0x0129, 1619 }, { 0x012a, 1626 }, { 0x012b, 1634 }, { 0x012c, 1642 }, { 0x012d, 1649 }, { 0x012e, 1656 }, { 0x012f, 1664 }, { 0x0130, 1672 },
+  { 0x0131, 1683 }, { 0x0132, 1692 }, { 0x0133, 1695 }, { 0x0134, 1698 }, { 0x0135, 1710 }, { 0x0136, 1722 }, { 0x0137, 1735 }, { 0x0138, 1748 },
+  { 0x0139, 1761 }, { 0x013a, 1768 }, { 0x013b, 1775 }, { 0x013c, 1788 }, { 0x013d, 1801 }, { 0x013e, 1808 }, { 0x013f, 1815 }, { 0x0140, 1820 },
+  { 0x0141, 1825 }, { 0x0142, 1832 }, { 0x0143, 1839 }, { 0x0144, 1846 }, { 0x0145, 1853 }, { 0x0146, 1866 }, { 0x0147, 1879 }, { 0x0148, 1886 },
+  { 0x0149, 1893 }, { 0x014a, 1905 }, { 0x014b, 1909 }, { 0x014c, 1913 }, { 0x014d, 1921 }, { 0x014e, 1929 }, { 0x014f, 1936 }, { 0x0150, 1943 },
+  { 0x0151, 1957 }, { 0x0152, 1971 }, { 0x0153, 1974 }, { 0x0154, 1977 }, { 0x0155, 1984 }, { 0x0156, 1991 }, { 0x0157, 2004 }, { 0x0158, 2017 },
+  { 0x0159, 2024 }, { 0x015a, 2031 }, { 0x015b, 2038 }, { 0x015c, 2045 }, { 0x015d, 2057 }, { 0x015e, 2069 }, { 0x015f, 2078 }, { 0x0160, 2087 },
+  { 0x0161, 2094 }, { 0x0162, 2101 }, { 0x0163, 2114 }, { 0x0164, 2127 }, { 0x0165, 2134 }, { 0x0166, 2141 }, { 0x0167, 2146 }, { 0x0168, 2151 },
+  { 0x0169, 2158 }, { 0x016a, 2165 }, { 0x016b, 2173 }, { 0x016c, 2181 }, { 0x016d, 2188 }, { 0x016e, 2195 }, { 0x016f, 2201 }, { 0x0170, 2207 },
+  { 0x0171, 2221 }, { 0x0172, 2235 }, { 0x0173, 2243 }, { 0x0174, 2251 }, { 0x0175, 2263 }, { 0x0176, 2275 }, { 0x0177, 2287 }, { 0x0178, 2299 },
+  { 0x0179, 2309 }, { 0x017a, 2316 }, { 0x017b, 2323 }, { 0x017c, 2334 }, { 0x017d, 2345 }, { 0x017e, 2352 }, { 0x017f, 2359 }, { 0x0192, 2365 },
+  { 0x01a0, 2372 }, { 0x01a1, 2378 }, { 0x01af, 2384 }, { 0x01b0, 2390 }, { 0x01e6, 2396 }, { 0x01e7, 2403 }, { 0x01fa, 2410 }, { 0x01fb, 2421 },
+  { 0x01fc, 2432 }, { 0x01fd, 2440 }, { 0x01fe, 2448 }, { 0x01ff, 2460 }, { 0x0218, 2472 }, { 0x0219, 2485 }, { 0x021a, 2101 }, { 0x021b, 2114 },
+  { 0x02bc, 2498 }, { 0x02bd, 2508 }, { 0x02c6, 2518 }, { 0x02c7, 2529 }, { 0x02c9, 561 }, { 0x02d8, 2535 }, { 0x02d9, 2541 }, { 0x02da, 2551 },
+  { 0x02db, 2556 }, { 0x02dc, 2563 }, { 0x02dd, 2569 }, { 0x0300, 2582 }, { 0x0301, 2592 }, { 0x0303, 2602 }, { 0x0309, 2612 }, { 0x0323, 2626 },
+  { 0x0384, 2639 }, { 0x0385, 2645 }, { 0x0386, 2659 }, { 0x0387, 2670 }, { 0x0388, 2680 }, { 0x0389, 2693 }, { 0x038a, 2702 }, { 0x038c, 2712 },
+  { 0x038e, 2725 }, { 0x038f, 2738 }, { 0x0390, 2749 }, { 0x0391, 2767 }, { 0x0392, 2773 }, { 0x0393, 2778 }, { 0x0394, 2784 }, { 0x0395, 2790 },
+  { 0x0396, 2798 }, { 0x0397, 2803 }, { 0x0398, 2807 }, { 0x0399, 2813 }, { 0x039a, 2818 }, { 0x039b, 2824 }, { 0x039c, 2831 }, { 0x039d, 2834 },
+  { 0x039e, 2837 }, { 0x039f, 2840 }, { 0x03a0, 2848 }, { 0x03a1, 2851 }, { 0x03a3, 2855 }, { 0x03a4, 2861 }, { 0x03a5, 2865 }, { 0x03a6, 2873 },
+  { 0x03a7, 2877 }, { 0x03a8, 2881 }, { 0x03a9, 2885 }, { 0x03aa, 2891 }, { 0x03ab, 2904 }, { 0x03ac, 2920 }, { 0x03ad, 2931 }, { 0x03ae, 2944 },
+  { 0x03af, 2953 }, { 0x03b0, 2963 }, { 0x03b1, 2984 }, { 0x03b2, 2990 }, { 0x03b3, 2995 }, { 0x03b4, 3001 }, { 0x03b5, 3007 }, { 0x03b6, 3015 },
+  { 0x03b7, 3020 }, { 0x03b8, 3024 }, { 0x03b9, 3030 }, { 0x03ba, 3035 }, { 0x03bb, 3041 }, { 0x03bc, 617 }, { 0x03bd, 3048 }, { 0x03be, 3051 },
+  { 0x03bf, 3054 }, { 0x03c0, 3062 }, { 0x03c1, 3065 }, { 0x03c2, 3069 }, { 0x03c3, 3076 }, { 0x03c4, 3082 }, { 0x03c5, 3086 }, { 0x03c6, 3094 },
+  { 0x03c7, 3098 }, { 0x03c8, 3102 }, { 0x03c9, 3106 }, { 0x03ca, 3112 }, { 0x03cb, 3125 }, { 0x03cc, 3141 }, { 0x03cd, 3154 }, { 0x03ce, 3167 },
+  { 0x03d1, 3178 }, { 0x03d2, 3185 }, { 0x03d5, 3194 }, { 0x03d6, 3199 }, { 0x0401, 3206 }, { 0x0402, 3216 }, { 0x0403, 3226 }, { 0x0404, 3236 },
+  { 0x0405, 3246 }, { 0x0406, 3256 }, { 0x0407, 3266 }, { 0x0408, 3276 }, { 0x0409, 3286 }, { 0x040a, 3296 }, { 0x040b, 3306 }, { 0x040c, 3316 },
+  { 0x040e, 3326 }, { 0x040f, 3336 }, { 0x0410, 3346 }, { 0x0411, 3356 }, { 0x0412, 3366 }, { 0x0413, 3376 }, { 0x0414, 3386 }, { 0x0415, 3396 },
+  { 0x0416, 3406 }, { 0x0417, 3416 }, { 0x0418, 3426 }, { 0x0419, 3436 }, { 0x041a, 3446 }, { 0x041b, 3456 }, { 0x041c, 3466 }, { 0x041d, 3476 },
+  { 0x041e, 3486 }, { 0x041f, 3496 }, { 0x0420, 3506 }, { 0x0421, 3516 }, { 0x0422, 3526 }, { 0x0423, 3536 }, { 0x0424, 3546 }, { 0x0425, 3556 },
+  { 0x0426, 3566 }, { 0x0427, 3576 }, { 0x0428, 3586 }, { 0x0429, 3596 }, { 0x042a, 3606 }, { 0x042b, 3616 }, { 0x042c, 3626 }, { 0x042d, 3636 },
+  { 0x042e, 3646 }, { 0x042f, 3656 }, { 0x0430, 3666 }, { 0x0431, 3676 }, { 0x0432, 3686 }, { 0x0433, 3696 }, { 0x0434, 3706 }, { 0x0435, 3716 },
+  { 0x0436, 3726 }, { 0x0437, 3736 }, { 0x0438, 3746 }, { 0x0439, 3756 }, { 0x043a, 3766 }, { 0x043b, 3776 }, { 0x043c, 3786 }, { 0x043d, 3796 },
+  { 0x043e, 3806 }, { 0x043f, 3816 }, { 0x0440, 3826 }, { 0x0441, 3836 }, { 0x0442, 3846 }, { 0x0443, 3856 }, { 0x0444, 3866 }, { 0x0445, 3876 },
+  { 0x0446, 3886 }, { 0x0447, 3896 }, { 0x0448, 3906 }, { 0x0449, 3916 }, { 0x044a, 3926 }, { 0x044b, 3936 }, { 0x044c, 3946 }, { 0x044d, 3956 },
+  { 0x044e, 3966 }, { 0x044f, 3976 }, { 0x0451, 3986 }, { 0x0452, 3996 }, { 0x0453, 4006 }, { 0x0454, 4016 }, { 0x0455, 4026 }, { 0x0456, 4036 },
+  { 0x0457, 4046 }, { 0x0458, 4056 }, { 0x0459, 4066 }, { 0x045a, 4076 }, { 0x045b, 4086 }, { 0x045c, 4096 }, { 0x045e, 4106 }, { 0x045f, 4116 },
+  { 0x0462, 4126 }, { 0x0463, 4136 }, { 0x0472, 4146 }, { 0x0473, 4156 }, { 0x0474, 4166 }, { 0x0475, 4176 }, { 0x0490, 4186 }, { 0x0491, 4196 },
+  { 0x04d9, 4206 }, { 0x05b0, 4216 }, { 0x05b1, 4226 }, { 0x05b2, 4236 }, { 0x05b3, 4246 }, { 0x05b4, 4256 }, { 0x05b5, 4266 }, { 0x05b6, 4276 },
+  { 0x05b7, 4286 }, { 0x05b8, 4296 }, { 0x05b9, 4306 }, { 0x05bb, 4316 }, { 0x05bc, 4326 }, { 0x05bd, 4336 }, { 0x05be, 4346 }, { 0x05bf, 4356 },
+  { 0x05c0, 4366 }, { 0x05c1, 4376 }, { 0x05c2, 4386 }, { 0x05c3, 4396 }, { 0x05d0, 4406 }, { 0x05d1, 4416 }, { 0x05d2, 4426 }, { 0x05d3, 4436 },
+  { 0x05d4, 4446 }, { 0x05d5, 4456 }, { 0x05d6, 4466 }, { 0x05d7, 4476 }, { 0x05d8, 4486 }, { 0x05d9, 4496 }, { 0x05da, 4506 }, { 0x05db, 4516 },
+  { 0x05dc, 4526 }, { 0x05dd, 4536 }, { 0x05de, 4546 }, { 0x05df, 4556 }, { 0x05e0, 4566 }, { 0x05e1, 4576 }, { 0x05e2, 4586 }, { 0x05e3, 4596 },
+  { 0x05e4, 4606 }, { 0x05e5, 4616 }, { 0x05e6, 4626 }, { 0x05e7, 4636 }, { 0x05e8, 4646 }, { 0x05e9, 4656 }, { 0x05ea, 4666 }, { 0x05f0, 4676 },
+  { 0x05f1, 4686 }, { 0x05f2, 4696 }, { 0x060c, 4706 }, { 0x061b, 4716 }, { 0x061f, 4726 }, { 0x0621, 4736 }, { 0x0622, 4746 }, { 0x0623, 4756 },
+  { 0x0624, 4766 }, { 0x0625, 4776 }, { 0x0626, 4786 }, { 0x0627, 4796 }, { 0x0628, 4806 }, { 0x0629, 4816 }, { 0x062a, 4826 }, { 0x062b, 4836 },
+  { 0x062c, 4846 }, { 0x062d, 4856 }, { 0x062e, 4866 }, { 0x062f, 4876 }, { 0x0630, 4886 }, { 0x0631, 4896 }, { 0x0632, 4906 }, { 0x0633, 4916 },
+  { 0x0634, 4926 }, { 0x0635, 4936 }, { 0x0636, 4946 }, { 0x0637, 4956 }, { 0x0638, 4966 }, { 0x0639, 4976 }, { 0x063a, 4986 }, { 0x0640, 4996 },
+  { 0x0641, 5006 }, { 0x0642, 5016 }, { 0x0643, 5026 }, { 0x0644, 5036 }, { 0x0645, 5046 }, { 0x0646, 5056 }, { 0x0647, 5066 }, { 0x0648, 5076 },
+  { 0x0649, 5086 }, { 0x064a, 5096 }, { 0x064b, 5106 }, { 0x064c, 5116 }, { 0x064d, 5126 }, { 0x064e, 5136 }, { 0x064f, 5146 }, { 0x0650, 5156 },
+  { 0x0651, 5166 }, { 0x0652, 5176 }, { 0x0660, 5186 }, { 0x0661, 5196 }, { 0x0662, 5206 }, { 0x0663, 5216 }, { 0x0664, 5226 }, { 0x0665, 5236 },
+  { 0x0666, 5246 }, { 0x0667, 5256 }, { 0x0668, 5266 }, { 0x0669, 5276 }, { 0x066a, 5286 }, { 0x066d, 5296 }, { 0x0679, 5306 }, { 0x067e, 5316 },
+  { 0x0686, 5326 }, { 0x0688, 5336 }, { 0x0691, 5346 }, { 0x0698, 5356 }, { 0x06a4, 5366 }, { 0x06af, 5376 }, { 0x06ba, 5386 }, { 0x06d2, 5396 },
+  { 0x06d5, 5406 }, { 0x1e80, 5416 }, { 0x1e81, 5423 }, { 0x1e82, 5430 }, { 0x1e83, 5437 }, { 0x1e84, 5444 }, { 0x1e85, 5454 }, { 0x1ef2, 5464 },
+  { 0x1ef3, 5471 }, { 0x200c, 5478 }, { 0x200d, 5488 }, { 0x200e, 5496 }, { 0x200f, 5504 }, { 0x2012, 5512 }, { 0x2013, 5523 }, { 0x2014, 5530 },
+  { 0x2015, 5537 }, { 0x2017, 5547 }, { 0x2018, 5561 }, { 0x2019, 5571 }, { 0x201a, 5582 }, { 0x201b, 5597 }, { 0x201c, 5611 }, { 0x201d, 5624 },
+  { 0x201e, 5638 }, { 0x2020, 5651 }, { 0x2021, 5658 }, { 0x2022, 5668 }, { 0x2024, 5675 }, { 0x2025, 5690 }, { 0x2026, 5705 }, { 0x202c, 5714 },
+  { 0x202d, 5724 }, { 0x202e, 5734 }, { 0x2030, 5744 }, { 0x2032, 5756 }, { 0x2033, 5763 }, { 0x2039, 5770 }, { 0x203a, 5784 }, { 0x203c, 5799 },
+  { 0x2044, 5809 }, { 0x2070, 5818 }, { 0x2074, 5831 }, { 0x2075, 5844 }, { 0x2076, 5857 }, { 0x2077, 5869 }, { 0x2078, 5883 }, { 0x2079, 5897 },
+  { 0x207d, 5910 }, { 0x207e, 5928 }, { 0x207f, 5947 }, { 0x2080, 5957 }, { 0x2081, 5970 }, { 0x2082, 5982 }, { 0x2083, 5994 }, { 0x2084, 6008 },
+  { 0x2085, 6021 }, { 0x2086, 6034 }, { 0x2087, 6046 }, { 0x2088, 6060 }, { 0x2089, 6074 }, { 0x208d, 6087 }, { 0x208e, 6105 }, { 0x20a1, 6124 },
+  { 0x20a3, 6138 }, { 0x20a4, 6144 }, { 0x20a7, 6149 }, { 0x20aa, 6156 }, { 0x20ab, 6166 }, { 0x20ac, 6171 }, { 0x2105, 6176 }, { 0x2111, 6186 },
+  { 0x2113, 6195 }, { 0x2116, 6205 }, { 0x2118, 6215 }, { 0x211c, 6227 }, { 0x211e, 6236 }, { 0x2122, 6249 }, { 0x2126, 2885 }, { 0x212e, 6259 },
+  { 0x2135, 6269 }, { 0x2153, 6275 }, { 0x2154, 6284 }, { 0x215b, 6294 }, { 0x215c, 6304 }, { 0x215d, 6317 }, { 0x215e, 6329 }, { 0x2190, 6342 },
+  { 0x2191, 6352 }, { 0x2192, 6360 }, { 0x2193, 6371 }, { 0x2194, 6381 }, { 0x2195, 6391 }, { 0x21a8, 6401 }, { 0x21b5, 6414 }, { 0x21d0, 6429 },
+  { 0x21d1, 6442 }, { 0x21d2, 6453 }, { 0x21d3, 6467 }, { 0x21d4, 6480 }, { 0x2200, 6493 }, { 0x2202, 6503 }, { 0x2203, 6515 }, { 0x2205, 6527 },
+  { 0x2206, 2784 }, { 0x2207, 6536 }, { 0x2208, 6545 }, { 0x2209, 6553 }, { 0x220b, 6564 }, { 0x220f, 6573 }, { 0x2211, 6581 }, { 0x2212, 544 },
+  { 0x2215, 5809 }, { 0x2217, 6591 }, { 0x2219, 630 }, { 0x221a, 6604 }, { 0x221d, 6612 }, { 0x221e, 6625 }, { 0x221f, 6634 }, { 0x2220, 6645 },
+  { 0x2227, 6651 }, { 0x2228, 6662 }, { 0x2229, 6672 }, { 0x222a, 6685 }, { 0x222b, 6691 }, { 0x2234, 6700 }, { 0x223c, 6710 }, { 0x2245, 6718 },
+  { 0x2248, 6728 }, { 0x2260, 6740 }, { 0x2261, 6749 }, { 0x2264, 6761 }, { 0x2265, 6771 }, { 0x2282, 6784 }, { 0x2283, 6797 }, { 0x2284, 6812 },
+  { 0x2286, 6822 }, { 0x2287, 6835 }, { 0x2295, 6850 }, { 0x2297, 6861 }, { 0x22a5, 6876 }, { 0x22c5, 6890 }, { 0x2302, 6898 }, { 0x2310, 6904 },
+  { 0x2320, 6918 }, { 0x2321, 6929 }, { 0x2329, 6940 }, { 0x232a, 6950 }, { 0x2500, 6961 }, { 0x2502, 6970 }, { 0x250c, 6979 }, { 0x2510, 6988 },
+  { 0x2514, 6997 }, { 0x2518, 7006 }, { 0x251c, 7015 }, { 0x2524, 7024 }, { 0x252c, 7033 }, { 0x2534, 7042 }, { 0x253c, 7051 }, { 0x2550, 7060 },
+  { 0x2551, 7069 }, { 0x2552, 7078 }, { 0x2553, 7087 }, { 0x2554, 7096 }, { 0x2555, 7105 }, { 0x2556, 7114 }, { 0x2557, 7123 }, { 0x2558, 7132 },
+  { 0x2559, 7141 }, { 0x255a, 7150 }, { 0x255b, 7159 }, { 0x255c, 7168 }, { 0x255d, 7177 }, { 0x255e, 7186 }, { 0x255f, 7195 }, { 0x2560, 7204 },
+  { 0x2561, 7213 }, { 0x2562, 7222 }, { 0x2563, 7231 }, { 0x2564, 7240 }, { 0x2565, 7249 }, { 0x2566, 7258 }, { 0x2567, 7267 }, { 0x2568, 7276 },
+  { 0x2569, 7285 }, { 0x256a, 7294 }, { 0x256b, 7303 }, { 0x256c, 7312 }, { 0x2580, 7321 }, { 0x2584, 7329 }, { 0x2588, 7337 }, { 0x258c, 7343 },
+  { 0x2590, 7351 }, { 0x2591, 7359 }, { 0x2592, 7367 }, { 0x2593, 7373 }, { 0x25a0, 7381 }, { 0x25a1, 7391 }, { 0x25aa, 7398 }, { 0x25ab, 7405 },
+  { 0x25ac, 7412 }, { 0x25b2, 7423 }, { 0x25ba, 7431 }, { 0x25bc, 7439 }, { 0x25c4, 7447 }, { 0x25ca, 7455 }, { 0x25cb, 7463 }, { 0x25cf, 7470 },
+  { 0x25d8, 7477 }, { 0x25d9, 7487 }, { 0x25e6, 7497 }, { 0x263a, 7508 }, { 0x263b, 7518 }, { 0x263c, 7531 }, { 0x2640, 7535 }, { 0x2642, 7542 },
+  { 0x2660, 7547 }, { 0x2663, 7553 }, { 0x2665, 7558 }, { 0x2666, 7564 }, { 0x266a, 7572 }, { 0x266b, 7584 }, { 0xf6be, 7599 }, { 0xf6bf, 7608 },
+  { 0xf6c0, 7611 }, { 0xf6c1, 2069 }, { 0xf6c2, 2078 }, { 0xf6c3, 7614 }, { 0xf6c4, 7626 }, { 0xf6c5, 7636 }, { 0xf6c6, 7646 }, { 0xf6c7, 7656 },
+  { 0xf6c8, 7666 }, { 0xf6c9, 7676 }, { 0xf6ca, 7682 }, { 0xf6cb, 7688 }, { 0xf6cc, 7697 }, { 0xf6cd, 7711 }, { 0xf6ce, 7725 }, { 0xf6cf, 7731 },
+  { 0xf6d0, 7744 }, { 0xf6d1, 7751 }, { 0xf6d2, 7760 }, { 0xf6d3, 7768 }, { 0xf6d4, 7777 }, { 0xf6d5, 7786 }, { 0xf6d6, 7794 }, { 0xf6d7, 7803 },
+  { 0xf6d8, 7817 }, { 0xf6d9, 7831 }, { 0xf6da, 7846 }, { 0xf6db, 7860 }, { 0xf6dc, 7875 }, { 0xf6dd, 7885 }, { 0xf6de, 7892 }, { 0xf6df, 7912 },
+  { 0xf6e0, 7925 }, { 0xf6e1, 7938 }, { 0xf6e2, 7952 }, { 0xf6e3, 7966 }, { 0xf6e4, 7981 }, { 0xf6e5, 7996 }, { 0xf6e6, 8011 }, { 0xf6e7, 8026 },
+  { 0xf6e8, 8041 }, { 0xf6e9, 8056 }, { 0xf6ea, 8066 }, { 0xf6eb, 8076 }, { 0xf6ec, 8086 }, { 0xf6ed, 8096 }, { 0xf6ee, 8106 }, { 0xf6ef, 8116 },
+  { 0xf6f0, 8126 }, { 0xf6f1, 8136 }, { 0xf6f2, 8146 }, { 0xf6f3, 8156 }, { 0xf6f4, 8166 }, { 0xf6f5, 8177 }, { 0xf6f6, 8188 }, { 0xf6f7, 8204 },
+  { 0xf6f8, 8219 }, { 0xf6f9, 8237 }, { 0xf6fa, 8249 }, { 0xf6fb, 8257 }, { 0xf6fc, 8269 }, { 0xf6fd, 8279 }, { 0xf6fe, 8291 }, { 0xf6ff, 8302 },
+  { 0xf721, 8314 }, { 0xf724, 8326 }, { 0xf726, 8341 }, { 0xf730, 8356 }, { 0xf731, 8369 }, { 0xf732, 8381 }, { 0xf733, 8393 }, { 0xf734, 8407 },
+  { 0xf735, 8420 }, { 0xf736, 8433 }, { 0xf737, 8445 }, { 0xf738, 8459 }, { 0xf739, 8473 }, { 0xf73f, 8486 }, { 0xf760, 8500 }, { 0xf761, 8511 },
+  { 0xf762, 8518 }, { 0xf763, 8525 }, { 0xf764, 8532 }, { 0xf765, 8539 }, { 0xf766, 8546 }, { 0xf767, 8553 }, { 0xf768, 8560 }, { 0xf769, 8567 },
+  { 0xf76a, 8574 }, { 0xf76b, 8581 }, { 0xf76c, 8588 }, { 0xf76d, 8595 }, { 0xf76e, 8602 }, { 0xf76f, 8609 }, { 0xf770, 8616 }, { 0xf771, 8623 },
+  { 0xf772, 8630 }, { 0xf773, 8637 }, { 0xf774, 8644 }, { 0xf775, 8651 }, { 0xf776, 8658 }, { 0xf777, 8665 }, { 0xf778, 8672 }, { 0xf779, 8679 },
+  { 0xf77a, 8686 }, { 0xf7a1, 8693 }, { 0xf7a2, 8709 }, { 0xf7a8, 8722 }, { 0xf7af, 8736 }, { 0xf7b4, 8748 }, { 0xf7b8, 8759 }, { 0xf7bf, 8772 },
+  { 0xf7e0, 8790 }, { 0xf7e1, 8802 }, { 0xf7e2, 8814 }, { 0xf7e3, 8831 }, { 0xf7e4, 8843 }, { 0xf7e5, 8858 }, { 0xf7e6, 8869 }, { 0xf7e7, 8877 },
+  { 0xf7e8, 8891 }, { 0xf7e9, 8903 }, { 0xf7ea, 8915 }, { 0xf7eb, 8932 }, { 0xf7ec, 8947 }, { 0xf7ed, 8959 }, { 0xf7ee, 8971 }, { 0xf7ef, 8988 },
+  { 0xf7f0, 9003 }, { 0xf7f1, 9012 }, { 0xf7f2, 9024 }, { 0xf7f3, 9036 }, { 0xf7f4, 9048 }, { 0xf7f5, 9065 }, { 0xf7f6, 9077 }, { 0xf7f8, 9092 },
+  { 0xf7f9, 9104 }, { 0xf7fa, 9116 }, { 0xf7fb, 9128 }, { 0xf7fc, 9145 }, { 0xf7fd, 9160 }, { 0xf7fe, 9172 }, { 0xf7ff, 9183 }, { 0xf8e5, 9198 },
+  { 0xf8e6, 9208 }, { 0xf8e7, 9220 }, { 0xf8e8, 9233 }, { 0xf8e9, 9246 }, { 0xf8ea, 9260 }, { 0xf8eb, 9274 }, { 0xf8ec, 9286 }, { 0xf8ed, 9298 },
+  { 0xf8ee, 9310 }, { 0xf8ef, 9324 }, { 0xf8f0, 9338 }, { 0xf8f1, 9352 }, { 0xf8f2, 9364 }, { 0xf8f3, 9377 }, { 0xf8f4, 9389 }, { 0xf8f5, 9397 },
+  { 0xf8f6, 9408 }, { 0xf8f7, 9421 }, { 0xf8f8, 9434 }, { 0xf8f9, 9447 }, { 0xf8fa, 9462 }, { 0xf8fb, 9477 }, { 0xf8fc, 9492 }, { 0xf8fd, 9505 },
+  { 0xf8fe, 9519 }, { 0xfb00, 9532 }, { 0xfb01, 9535 }, { 0xfb02, 9538 }, { 0xfb03, 9541 }, { 0xfb04, 9545 }, { 0xfb1f, 9549 }, { 0xfb2a, 9559 },
+  { 0xfb2b, 9569 }, { 0xfb35, 9579 }, { 0xfb4b, 9589 }
+};
+
+
+// Character set from "data/cp-874"
+static const unsigned short hd_charset_cp_874[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x0000, 0x0000, 0x0000, 0x2026, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0e01, 0x0e02, 0x0e03, 0x0e04, 0x0e05, 0x0e06, 0x0e07,
+  0x0e08, 0x0e09, 0x0e0a, 0x0e0b, 0x0e0c, 0x0e0d, 0x0e0e, 0x0e0f,
+  0x0e10, 0x0e11, 0x0e12, 0x0e13, 0x0e14, 0x0e15, 0x0e16, 0x0e17,
+  0x0e18, 0x0e19, 0x0e1a, 0x0e1b, 0x0e1c, 0x0e1d, 0x0e1e, 0x0e1f,
+  0x0e20, 0x0e21, 0x0e22, 0x0e23, 0x0e24, 0x0e25, 0x0e26, 0x0e27,
+  0x0e28, 0x0e29, 0x0e2a, 0x0e2b, 0x0e2c, 0x0e2d, 0x0e2e, 0x0e2f,
+  0x0e30, 0x0e31, 0x0e32, 0x0e33, 0x0e34, 0x0e35, 0x0e36, 0x0e37,
+  0x0e38, 0x0e39, 0x0e3a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0e3f,
+  0x0e40, 0x0e41, 0x0e42, 0x0e43, 0x0e44, 0x0e45, 0x0e46, 0x0e47,
+  0x0e48, 0x0e49, 0x0e4a, 0x0e4b, 0x0e4c, 0x0e4d, 0x0e4e, 0x0e4f,
+  0x0e50, 0x0e51, 0x0e52, 0x0e53, 0x0e54, 0x0e55, 0x0e56, 0x0e57,
+  0x0e58, 0x0e59, 0x0e5a, 0x0e5b, 0x0000, 0x0000, 0x0000, 0x0000
+};
+
+
+// Character set from "data/cp-1250"
+static const unsigned short hd_charset_cp_1250[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0000, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x0000, 0x2030, 0x0160, 0x2039, 0x015a, 0x0164, 0x017d, 0x0179,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x0000, 0x2122, 0x0161, 0x203a, 0x015b, 0x0165, 0x017e, 0x017a,
+  0x00a0, 0x02c7, 0x02d8, 0x0141, 0x00a4, 0x0104, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x015e, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x017b,
+  0x00b0, 0x00b1, 0x02db, 0x0142, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x0105, 0x015f, 0x00bb, 0x013d, 0x02dd, 0x013e, 0x017c,
+  0x0154, 0x00c1, 0x00c2, 0x0102, 0x00c4, 0x0139, 0x0106, 0x00c7,
+  0x010c, 0x00c9, 0x0118, 0x00cb, 0x011a, 0x00cd, 0x00ce, 0x010e,
+  0x0110, 0x0143, 0x0147, 0x00d3, 0x00d4, 0x0150, 0x00d6, 0x00d7,
+  0x0158, 0x016e, 0x00da, 0x0170, 0x00dc, 0x00dd, 0x0162, 0x00df,
+  0x0155, 0x00e1, 0x00e2, 0x0103, 0x00e4, 0x013a, 0x0107, 0x00e7,
+  0x010d, 0x00e9, 0x0119, 0x00eb, 0x011b, 0x00ed, 0x00ee, 0x010f,
+  0x0111, 0x0144, 0x0148, 0x00f3, 0x00f4, 0x0151, 0x00f6, 0x00f7,
+  0x0159, 0x016f, 0x00fa, 0x0171, 0x00fc, 0x00fd, 0x0163, 0x02d9
+};
+
+
+// Character set from "data/cp-1251"
+static const unsigned short hd_charset_cp_1251[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x0402, 0x0403, 0x201a, 0x0453, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x20ac, 0x2030, 0x0409, 0x2039, 0x040a, 0x040c, 0x040b, 0x040f,
+  0x0452, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x0000, 0x2122, 0x0459, 0x203a, 0x045a, 0x045c, 0x045b, 0x045f,
+  0x00a0, 0x040e, 0x045e, 0x0408, 0x00a4, 0x0490, 0x00a6, 0x00a7,
+  0x0401, 0x00a9, 0x0404, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x0407,
+  0x00b0, 0x00b1, 0x0406, 0x0456, 0x0491, 0x00b5, 0x00b6, 0x00b7,
+  0x0451, 0x2116, 0x0454, 0x00bb, 0x0458, 0x0405, 0x0455, 0x0457,
+  0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+  0x0418, 0x0419, 0x041a, 0x041b, 0x041c, 0x041d, 0x041e, 0x041f,
+  0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+  0x0428, 0x0429, 0x042a, 0x042b, 0x042c, 0x042d, 0x042e, 0x042f,
+  0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+  0x0438, 0x0439, 0x043a, 0x043b, 0x043c, 0x043d, 0x043e, 0x043f,
+  0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+  0x0448, 0x0449, 0x044a, 0x044b, 0x044c, 0x044d, 0x044e, 0x044f
+};
+
+
+// Character set from "data/cp-1252"
+static const unsigned short hd_charset_cp_1252[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x02c6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x017d, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x02dc, 0x2122, 0x0161, 0x203a, 0x0153, 0x0000, 0x017e, 0x0178,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+  0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x00d0, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x00de, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x00ff
+};
+
+
+// Character set from "data/cp-1253"
+static const unsigned short hd_charset_cp_1253[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x0000, 0x2030, 0x0000, 0x2039, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x0000, 0x2122, 0x0000, 0x203a, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0385, 0x0386, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x0000, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x2015,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x0384, 0x00b5, 0x00b6, 0x00b7,
+  0x0388, 0x0389, 0x038a, 0x00bb, 0x038c, 0x00bd, 0x038e, 0x038f,
+  0x0390, 0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397,
+  0x0398, 0x0399, 0x039a, 0x039b, 0x039c, 0x039d, 0x039e, 0x039f,
+  0x03a0, 0x03a1, 0x0000, 0x03a3, 0x03a4, 0x03a5, 0x03a6, 0x03a7,
+  0x03a8, 0x03a9, 0x03aa, 0x03ab, 0x03ac, 0x03ad, 0x03ae, 0x03af,
+  0x03b0, 0x03b1, 0x03b2, 0x03b3, 0x03b4, 0x03b5, 0x03b6, 0x03b7,
+  0x03b8, 0x03b9, 0x03ba, 0x03bb, 0x03bc, 0x03bd, 0x03be, 0x03bf,
+  0x03c0, 0x03c1, 0x03c2, 0x03c3, 0x03c4, 0x03c5, 0x03c6, 0x03c7,
+  0x03c8, 0x03c9, 0x03ca, 0x03cb, 0x03cc, 0x03cd, 0x03ce, 0x0000
+};
+
+
+// Character set from "data/cp-1254"
+static const unsigned short hd_charset_cp_1254[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x02c6, 0x2030, 0x0160, 0x2039, 0x0152, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x02dc, 0x2122, 0x0161, 0x203a, 0x0153, 0x0000, 0x0000, 0x0178,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+  0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x011e, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x0130, 0x015e, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x011f, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x0131, 0x015f, 0x00ff
+};
+
+
+// Character set from "data/cp-1255"
+static const unsigned short hd_charset_cp_1255[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x02c6, 0x2030, 0x0000, 0x2039, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x02dc, 0x2122, 0x0000, 0x203a, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x20aa, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00d7, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00f7, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+  0x05b0, 0x05b1, 0x05b2, 0x05b3, 0x05b4, 0x05b5, 0x05b6, 0x05b7,
+  0x05b8, 0x05b9, 0x0000, 0x05bb, 0x05bc, 0x05bd, 0x05be, 0x05bf,
+  0x05c0, 0x05c1, 0x05c2, 0x05c3, 0x05f0, 0x05f1, 0x05f2, 0x05f3,
+  0x05f4, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x05d0, 0x05d1, 0x05d2, 0x05d3, 0x05d4, 0x05d5, 0x05d6, 0x05d7,
+  0x05d8, 0x05d9, 0x05da, 0x05db, 0x05dc, 0x05dd, 0x05de, 0x05df,
+  0x05e0, 0x05e1, 0x05e2, 0x05e3, 0x05e4, 0x05e5, 0x05e6, 0x05e7,
+  0x05e8, 0x05e9, 0x05ea, 0x0000, 0x0000, 0x200e, 0x200f, 0x0000
+};
+
+
+// Character set from "data/cp-1256"
+static const unsigned short hd_charset_cp_1256[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x067e, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x02c6, 0x2030, 0x0679, 0x2039, 0x0152, 0x0686, 0x0698, 0x0688,
+  0x06af, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x06a9, 0x2122, 0x0691, 0x203a, 0x0153, 0x200c, 0x200d, 0x06ba,
+  0x00a0, 0x060c, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x06be, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x061b, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x061f,
+  0x06c1, 0x0621, 0x0622, 0x0623, 0x0624, 0x0625, 0x0626, 0x0627,
+  0x0628, 0x0629, 0x062a, 0x062b, 0x062c, 0x062d, 0x062e, 0x062f,
+  0x0630, 0x0631, 0x0632, 0x0633, 0x0634, 0x0635, 0x0636, 0x00d7,
+  0x0637, 0x0638, 0x0639, 0x063a, 0x0640, 0x0641, 0x0642, 0x0643,
+  0x00e0, 0x0644, 0x00e2, 0x0645, 0x0646, 0x0647, 0x0648, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x0649, 0x064a, 0x00ee, 0x00ef,
+  0x064b, 0x064c, 0x064d, 0x064e, 0x00f4, 0x064f, 0x0650, 0x00f7,
+  0x0651, 0x00f9, 0x0652, 0x00fb, 0x00fc, 0x200e, 0x200f, 0x06d2
+};
+
+
+// Character set from "data/cp-1257"
+static const unsigned short hd_charset_cp_1257[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0000, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x0000, 0x2030, 0x0000, 0x2039, 0x0000, 0x00a8, 0x02c7, 0x00b8,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x0000, 0x2122, 0x0000, 0x203a, 0x0000, 0x00af, 0x02db, 0x0000,
+  0x00a0, 0x0000, 0x00a2, 0x00a3, 0x00a4, 0x0000, 0x00a6, 0x00a7,
+  0x00d8, 0x00a9, 0x0156, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00c6,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00f8, 0x00b9, 0x0157, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00e6,
+  0x0104, 0x012e, 0x0100, 0x0106, 0x00c4, 0x00c5, 0x0118, 0x0112,
+  0x010c, 0x00c9, 0x0179, 0x0116, 0x0122, 0x0136, 0x012a, 0x013b,
+  0x0160, 0x0143, 0x0145, 0x00d3, 0x014c, 0x00d5, 0x00d6, 0x00d7,
+  0x0172, 0x0141, 0x015a, 0x016a, 0x00dc, 0x017b, 0x017d, 0x00df,
+  0x0105, 0x012f, 0x0101, 0x0107, 0x00e4, 0x00e5, 0x0119, 0x0113,
+  0x010d, 0x00e9, 0x017a, 0x0117, 0x0123, 0x0137, 0x012b, 0x013c,
+  0x0161, 0x0144, 0x0146, 0x00f3, 0x014d, 0x00f5, 0x00f6, 0x00f7,
+  0x0173, 0x0142, 0x015b, 0x016b, 0x00fc, 0x017c, 0x017e, 0x02d9
+};
+
+
+// Character set from "data/cp-1258"
+static const unsigned short hd_charset_cp_1258[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x007f,
+  0x20ac, 0x0000, 0x201a, 0x0192, 0x201e, 0x2026, 0x2020, 0x2021,
+  0x02c6, 0x2030, 0x0000, 0x2039, 0x0152, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x2018, 0x2019, 0x201c, 0x201d, 0x2022, 0x2013, 0x2014,
+  0x02dc, 0x2122, 0x0000, 0x203a, 0x0153, 0x0000, 0x0000, 0x0178,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+  0x00c0, 0x00c1, 0x00c2, 0x0102, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x0300, 0x00cd, 0x00ce, 0x00cf,
+  0x0110, 0x00d1, 0x0309, 0x00d3, 0x00d4, 0x01a0, 0x00d6, 0x00d7,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x01af, 0x0303, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x0103, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x0301, 0x00ed, 0x00ee, 0x00ef,
+  0x0111, 0x00f1, 0x0323, 0x00f3, 0x00f4, 0x01a1, 0x00f6, 0x00f7,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x01b0, 0x20ab, 0x00ff
+};
+
+
+// Character set from "data/iso-8859-1"
+static const unsigned short hd_charset_iso_8859_1[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+  0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x00d0, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x00de, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x00ff
+};
+
+
+// Character set from "data/iso-8859-2"
+static const unsigned short hd_charset_iso_8859_2[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0104, 0x02d8, 0x0141, 0x00a4, 0x013d, 0x015a, 0x00a7,
+  0x00a8, 0x0160, 0x015e, 0x0164, 0x0179, 0x00ad, 0x017d, 0x017b,
+  0x00b0, 0x0105, 0x02db, 0x0142, 0x00b4, 0x013e, 0x015b, 0x02c7,
+  0x00b8, 0x0161, 0x015f, 0x0165, 0x017a, 0x02dd, 0x017e, 0x017c,
+  0x0154, 0x00c1, 0x00c2, 0x0102, 0x00c4, 0x0139, 0x0106, 0x00c7,
+  0x010c, 0x00c9, 0x0118, 0x00cb, 0x011a, 0x00cd, 0x00ce, 0x010e,
+  0x0110, 0x0143, 0x0147, 0x00d3, 0x00d4, 0x0150, 0x00d6, 0x00d7,
+  0x0158, 0x016e, 0x00da, 0x0170, 0x00dc, 0x00dd, 0x0162, 0x00df,
+  0x0155, 0x00e1, 0x00e2, 0x0103, 0x00e4, 0x013a, 0x0107, 0x00e7,
+  0x010d, 0x00e9, 0x0119, 0x00eb, 0x011b, 0x00ed, 0x00ee, 0x010f,
+  0x0111, 0x0144, 0x0148, 0x00f3, 0x00f4, 0x0151, 0x00f6, 0x00f7,
+  0x0159, 0x016f, 0x00fa, 0x0171, 0x00fc, 0x00fd, 0x0163, 0x02d9
+};
+
+
+// Character set from "data/iso-8859-3"
+static const unsigned short hd_charset_iso_8859_3[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0126, 0x02d8, 0x00a3, 0x00a4, 0x0000, 0x0124, 0x00a7,
+  0x00a8, 0x0130, 0x015e, 0x011e, 0x0134, 0x00ad, 0x0000, 0x017b,
+  0x00b0, 0x0127, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x0125, 0x00b7,
+  0x00b8, 0x0131, 0x015f, 0x011f, 0x0135, 0x00bd, 0x0000, 0x017c,
+  0x00c0, 0x00c1, 0x00c2, 0x0000, 0x00c4, 0x010a, 0x0108, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x0000, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x0120, 0x00d6, 0x00d7,
+  0x011c, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x016c, 0x015c, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x0000, 0x00e4, 0x010b, 0x0109, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x0000, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x0121, 0x00f6, 0x00f7,
+  0x011d, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x016d, 0x015d, 0x02d9
+};
+
+
+// Character set from "data/iso-8859-4"
+static const unsigned short hd_charset_iso_8859_4[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0104, 0x0138, 0x0156, 0x00a4, 0x0128, 0x013b, 0x00a7,
+  0x00a8, 0x0160, 0x0112, 0x0122, 0x0166, 0x00ad, 0x017d, 0x00af,
+  0x00b0, 0x0105, 0x02db, 0x0157, 0x00b4, 0x0129, 0x013c, 0x02c7,
+  0x00b8, 0x0161, 0x0113, 0x0123, 0x0167, 0x014a, 0x017e, 0x014b,
+  0x0100, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x012e,
+  0x010c, 0x00c9, 0x0118, 0x00cb, 0x0116, 0x00cd, 0x00ce, 0x012a,
+  0x0110, 0x0145, 0x014c, 0x0136, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+  0x00d8, 0x0172, 0x00da, 0x00db, 0x00dc, 0x0168, 0x016a, 0x00df,
+  0x0101, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x012f,
+  0x010d, 0x00e9, 0x0119, 0x00eb, 0x0117, 0x00ed, 0x00ee, 0x012b,
+  0x0111, 0x0146, 0x014d, 0x0137, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+  0x00f8, 0x0173, 0x00fa, 0x00fb, 0x00fc, 0x0169, 0x016b, 0x02d9
+};
+
+
+// Character set from "data/iso-8859-5"
+static const unsigned short hd_charset_iso_8859_5[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0401, 0x0402, 0x0403, 0x0404, 0x0405, 0x0406, 0x0407,
+  0x0408, 0x0409, 0x040a, 0x040b, 0x040c, 0x00ad, 0x040e, 0x040f,
+  0x0410, 0x0411, 0x0412, 0x0413, 0x0414, 0x0415, 0x0416, 0x0417,
+  0x0418, 0x0419, 0x041a, 0x041b, 0x041c, 0x041d, 0x041e, 0x041f,
+  0x0420, 0x0421, 0x0422, 0x0423, 0x0424, 0x0425, 0x0426, 0x0427,
+  0x0428, 0x0429, 0x042a, 0x042b, 0x042c, 0x042d, 0x042e, 0x042f,
+  0x0430, 0x0431, 0x0432, 0x0433, 0x0434, 0x0435, 0x0436, 0x0437,
+  0x0438, 0x0439, 0x043a, 0x043b, 0x043c, 0x043d, 0x043e, 0x043f,
+  0x0440, 0x0441, 0x0442, 0x0443, 0x0444, 0x0445, 0x0446, 0x0447,
+  0x0448, 0x0449, 0x044a, 0x044b, 0x044c, 0x044d, 0x044e, 0x044f,
+  0x2116, 0x0451, 0x0452, 0x0453, 0x0454, 0x0455, 0x0456, 0x0457,
+  0x0458, 0x0459, 0x045a, 0x045b, 0x045c, 0x00a7, 0x045e, 0x045f
+};
+
+
+// Character set from "data/iso-8859-6"
+static const unsigned short hd_charset_iso_8859_6[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0660, 0x0661, 0x0662, 0x0663, 0x0664, 0x0665, 0x0666, 0x0667,
+  0x0668, 0x0669, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0000, 0x0000, 0x0000, 0x00a4, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x060c, 0x00ad, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x061b, 0x0000, 0x0000, 0x0000, 0x061f,
+  0x0000, 0x0621, 0x0622, 0x0623, 0x0624, 0x0625, 0x0626, 0x0627,
+  0x0628, 0x0629, 0x062a, 0x062b, 0x062c, 0x062d, 0x062e, 0x062f,
+  0x0630, 0x0631, 0x0632, 0x0633, 0x0634, 0x0635, 0x0636, 0x0637,
+  0x0638, 0x0639, 0x063a, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0640, 0x0641, 0x0642, 0x0643, 0x0644, 0x0645, 0x0646, 0x0647,
+  0x0648, 0x0649, 0x064a, 0x064b, 0x064c, 0x064d, 0x064e, 0x064f,
+  0x0650, 0x0651, 0x0652, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+};
+
+
+// Character set from "data/iso-8859-7"
+static const unsigned short hd_charset_iso_8859_7[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x02bd, 0x02bc, 0x00a3, 0x0000, 0x0000, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x0000, 0x00ab, 0x00ac, 0x00ad, 0x0000, 0x2015,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x0384, 0x0385, 0x0386, 0x00b7,
+  0x0388, 0x0389, 0x038a, 0x00bb, 0x038c, 0x00bd, 0x038e, 0x038f,
+  0x0390, 0x0391, 0x0392, 0x0393, 0x0394, 0x0395, 0x0396, 0x0397,
+  0x0398, 0x0399, 0x039a, 0x039b, 0x039c, 0x039d, 0x039e, 0x039f,
+  0x03a0, 0x03a1, 0x0000, 0x03a3, 0x03a4, 0x03a5, 0x03a6, 0x03a7,
+  0x03a8, 0x03a9, 0x03aa, 0x03ab, 0x03ac, 0x03ad, 0x03ae, 0x03af,
+  0x03b0, 0x03b1, 0x03b2, 0x03b3, 0x03b4, 0x03b5, 0x03b6, 0x03b7,
+  0x03b8, 0x03b9, 0x03ba, 0x03bb, 0x03bc, 0x03bd, 0x03be, 0x03bf,
+  0x03c0, 0x03c1, 0x03c2, 0x03c3, 0x03c4, 0x03c5, 0x03c6, 0x03c7,
+  0x03c8, 0x03c9, 0x03ca, 0x03cb, 0x03cc, 0x03cd, 0x03ce, 0x0000
+};
+
+
+// Character set from "data/iso-8859-8"
+static const unsigned short hd_charset_iso_8859_8[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x0000, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00d7, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x203e,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00f7, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x2017,
+  0x05d0, 0x05d1, 0x05d2, 0x05d3, 0x05d4, 0x05d5, 0x05d6, 0x05d7,
+  0x05d8, 0x05d9, 0x05da, 0x05db, 0x05dc, 0x05dd, 0x05de, 0x05df,
+  0x05e0, 0x05e1, 0x05e2, 0x05e3, 0x05e4, 0x05e5, 0x05e6, 0x05e7,
+  0x05e8, 0x05e9, 0x05ea, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000
+};
+
+
+// Character set from "data/iso-8859-9"
+static const unsigned short hd_charset_iso_8859_9[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x00a4, 0x00a5, 0x00a6, 0x00a7,
+  0x00a8, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x00b4, 0x00b5, 0x00b6, 0x00b7,
+  0x00b8, 0x00b9, 0x00ba, 0x00bb, 0x00bc, 0x00bd, 0x00be, 0x00bf,
+  0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x011e, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x0130, 0x015e, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x011f, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x0131, 0x015f, 0x00ff
+};
+
+
+// Character set from "data/iso-8859-14"
+static const unsigned short hd_charset_iso_8859_14[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x1e02, 0x1e03, 0x00a3, 0x010a, 0x010b, 0x1e0a, 0x00a7,
+  0x1e80, 0x00a9, 0x1e82, 0x1e0b, 0x1ef2, 0x00ad, 0x00ae, 0x0178,
+  0x1e1e, 0x1e1f, 0x0120, 0x0121, 0x1e40, 0x1e41, 0x00b6, 0x1e56,
+  0x1e81, 0x1e57, 0x1e83, 0x1e60, 0x1ef3, 0x1e84, 0x1e85, 0x1e61,
+  0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x0174, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x1e6a,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x0176, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x0175, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x1e6b,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x0177, 0x00ff
+};
+
+
+// Character set from "data/iso-8859-15"
+static const unsigned short hd_charset_iso_8859_15[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x00a0, 0x00a1, 0x00a2, 0x00a3, 0x20ac, 0x00a5, 0x0160, 0x00a7,
+  0x0161, 0x00a9, 0x00aa, 0x00ab, 0x00ac, 0x00ad, 0x00ae, 0x00af,
+  0x00b0, 0x00b1, 0x00b2, 0x00b3, 0x017d, 0x00b5, 0x00b6, 0x00b7,
+  0x017e, 0x00b9, 0x00ba, 0x00bb, 0x0152, 0x0153, 0x0178, 0x00bf,
+  0x00c0, 0x00c1, 0x00c2, 0x00c3, 0x00c4, 0x00c5, 0x00c6, 0x00c7,
+  0x00c8, 0x00c9, 0x00ca, 0x00cb, 0x00cc, 0x00cd, 0x00ce, 0x00cf,
+  0x00d0, 0x00d1, 0x00d2, 0x00d3, 0x00d4, 0x00d5, 0x00d6, 0x00d7,
+  0x00d8, 0x00d9, 0x00da, 0x00db, 0x00dc, 0x00dd, 0x00de, 0x00df,
+  0x00e0, 0x00e1, 0x00e2, 0x00e3, 0x00e4, 0x00e5, 0x00e6, 0x00e7,
+  0x00e8, 0x00e9, 0x00ea, 0x00eb, 0x00ec, 0x00ed, 0x00ee, 0x00ef,
+  0x00f0, 0x00f1, 0x00f2, 0x00f3, 0x00f4, 0x00f5, 0x00f6, 0x00f7,
+  0x00f8, 0x00f9, 0x00fa, 0x00fb, 0x00fc, 0x00fd, 0x00fe, 0x00ff
+};
+
+
+// Character set from "data/koi8-r"
+static const unsigned short hd_charset_koi8_r[256] =
+{
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027,
+  0x0028, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x002e, 0x002f,
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037,
+  0x0038, 0x0039, 0x003a, 0x003b, 0x003c, 0x003d, 0x003e, 0x003f,
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047,
+  0x0048, 0x0049, 0x004a, 0x004b, 0x004c, 0x004d, 0x004e, 0x004f,
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057,
+  0x0058, 0x0059, 0x005a, 0x005b, 0x005c, 0x005d, 0x005e, 0x005f,
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067,
+  0x0068, 0x0069, 0x006a, 0x006b, 0x006c, 0x006d, 0x006e, 0x006f,
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077,
+  0x0078, 0x0079, 0x007a, 0x007b, 0x007c, 0x007d, 0x007e, 0x0000,
+  0x2500, 0x2502, 0x250c, 0x2510, 0x2514, 0x2518, 0x251c, 0x2524,
+  0x252c, 0x2534, 0x253c, 0x2580, 0x2584, 0x2588, 0x258c, 0x2590,
+  0x2591, 0x2592, 0x2593, 0x2320, 0x25a0, 0x2219, 0x221a, 0x2248,
+  0x2264, 0x2265, 0x00a0, 0x2321, 0x00b0, 0x00b2, 0x00b7, 0x00f7,
+  0x2550, 0x2551, 0x2552, 0x0451, 0x2553, 0x2554, 0x2555, 0x2556,
+  0x2557, 0x2558, 0x2559, 0x255a, 0x255b, 0x255c, 0x255d, 0x255e,
+  0x255f, 0x2560, 0x2561, 0x0401, 0x2562, 0x2563, 0x2564, 0x2565,
+  0x2566, 0x2567, 0x2568, 0x2569, 0x256a, 0x256b, 0x256c, 0x00a9,
+  0x044e, 0x0430, 0x0431, 0x0446, 0x0434, 0x0435, 0x0444, 0x0433,
+  0x0445, 0x0438, 0x0439, 0x043a, 0x043b, 0x043c, 0x043d, 0x043e,
+  0x043f, 0x044f, 0x0440, 0x0441, 0x0442, 0x0443, 0x0436, 0x0432,
+  0x044c, 0x044b, 0x0437, 0x0448, 0x044d, 0x0449, 0x0447, 0x044a,
+  0x042e, 0x0410, 0x0411, 0x0426, 0x0414, 0x0415, 0x0424, 0x0413,
+  0x0425, 0x0418, 0x0419, 0x041a, 0x041b, 0x041c, 0x041d, 0x041e,
+  0x041f, 0x042f, 0x0420, 0x0421, 0x0422, 0x0423, 0x0416, 0x0412,
+  0x042c, 0x042b, 0x0417, 0x0428, 0x042d, 0x0429, 0x0427, 0x042a
+};
+
+
+// Built-in character sets
+static const hd_charset_t hd_charsets[22] =
+{
+  { "cp-874", hd_charset_cp_874 },
+  { "cp-1250", hd_charset_cp_1250 },
+  { "cp-1251", hd_charset_cp_1251 },
+  { "cp-1252", hd_charset_cp_1252 },
+  { "cp-1253", hd_charset_cp_1253 },
+  { "cp-1254", hd_charset_cp_1254 },
+  { "cp-1255", hd_charset_cp_1255 },
+  { "cp-1256", hd_charset_cp_1256 },
+  { "cp-1257", hd_charset_cp_1257 },
+  { "cp-1258", hd_charset_cp_1258 },
+  { "iso-8859-1", hd_charset_iso_8859_1 },
+  { "iso-8859-2", hd_charset_iso_8859_2 },
+  { "iso-8859-3", hd_charset_iso_8859_3 },
+  { "iso-8859-4", hd_charset_iso_8859_4 },
+  { "iso-8859-5", hd_charset_iso_8859_5 },
+  { "iso-8859-6", hd_charset_iso_8859_6 },
+  { "iso-8859-7", hd_charset_iso_8859_7 },
+  { "iso-8859-8", hd_charset_iso_8859_8 },
+  { "iso-8859-9", hd_charset_iso_8859_9 },
+  { "iso-8859-14", hd_charset_iso_8859_14 },
+  { "iso-8859-15", hd_charset_iso_8859_15 },
+  { "koi8-r", hd_charset_koi8_r }
+};
+
+#endif // !_HTMLDOC_CHARSETS_H_
@@ -26,6 +26,40 @@ typedef struct
 } link_t;
 
 
+/*
+ * Chapter structures...
+ */
+
+typedef struct
+{
+  char		filename[32];		/* Filename in container */
+  size_t	first,			/* First top-level node */
+		count;			/* Number of top-level nodes */
+  int		content;		/* Non-zero if the chapter has content */
+  zipc_file_t	*out;			/* Buffered chapter file */
+  int		status;			/* Write status */
+} chapter_t;
+
+typedef struct
+{
+  uchar		*title,			/* Title for document */
+		*author,		/* Author for document */
+		*copyright,		/* Copyright for document */
+		*docnumber;		/* ID number for document */
+} chapter_info_t;
+
+
+/*
+ * Compression work for the container...
+ */
+
+typedef struct
+{
+  zipc_work_cb_t cb;			/* Work function */
+  void		*data;			/* Work data */
+} compress_work_t;
+
+
 /*
  * Local globals...
  */
@@ -37,6 +71,11 @@ static link_t	*links;
 static size_t   num_images = 0,
                 alloc_images = 0;
 static char     **images = NULL;
+static size_t	num_chapters = 0;
+static chapter_t *chapters = NULL;
+static size_t	num_nodes = 0,
+		alloc_nodes = 0;
+static tree_t	**nodes = NULL;
 
 
 /*
@@ -47,15 +86,22 @@ extern "C" {
 typedef int	(*compare_func_t)(const void *, const void *);
 }
 
+static void	compress_file(void *data, int index);
+static void	compress_parallel(int count, zipc_work_cb_t cb, void *data);
 static int	write_header(zipc_file_t *out, uchar *title, uchar *author, uchar *copyright, uchar *docnumber, tree_t *t);
+static int	write_style(zipc_file_t *out);
 static int	write_title(zipc_file_t *out, tree_t *title_tree, uchar *title, uchar *author, uchar *copyright, uchar *docnumber);
 static int	write_all(zipc_file_t *out, tree_t *t);
+static void	write_chapter(void *data, int index);
 static int	write_node(zipc_file_t *out, tree_t *t);
 static int	write_nodeclose(zipc_file_t *out, tree_t *t);
 static int	write_toc(zipc_file_t *out, tree_t *t);
 static char     *get_iso_date(time_t t);
 static uchar	*get_title(tree_t *doc);
 
+static int	find_chapters(tree_t *t, int *split);
+static int	has_content(tree_t *t);
+
 static void	add_link(uchar *name, uchar *filename);
 static link_t	*find_link(uchar *name);
 static int	compare_links(link_t *n1, link_t *n2);
@@ -63,7 +109,7 @@ static int      compare_images(char **a, char **b);
 static int      copy_image(zipc_t *zipc, const char *filename);
 static int      copy_images(zipc_t *zipc, tree_t *t);
 static void	scan_links(tree_t *t, uchar *filename);
-static void	update_links(tree_t *t, uchar *filename);
+static void	update_links(tree_t *t);
 static tree_t   *walk_next(tree_t *t);
 static int      write_xhtml(zipc_file_t *out, uchar *s);
 static int      write_xhtmlf(zipc_file_t *out, const char *format, ...);
@@ -89,6 +135,10 @@ epub_export(tree_t *document,           /* I - Document to export */
   const char  *title_ext;               /* Extension of title image */
   tree_t      *title_tree = NULL;	/* Title file document tree */
   const char  *cover_image = NULL;      /* Do we have a cover image? */
+  int         level;                    /* Compression level */
+  size_t      i, j;                     /* Looping vars */
+  int         split;                    /* Start a new chapter? */
+  chapter_info_t info;                  /* Chapter header information */
   int         status = 0;               /* Return status */
   static const char *mimetype =		/* mimetype file as a string */
 		"application/epub+zip";
@@ -111,6 +161,20 @@ epub_export(tree_t *document,           /* I - Document to export */
     return (-1);
   }
 
+  stats_begin(HD_STATS_WRITE);
+
+ /*
+  * Set the compression level, and compress large files on multiple threads
+  * when we have them...
+  */
+
+  if ((level = EPUBCompression) > 9)
+    level = 9;
+  else if (level < 0)
+    level = 0;
+
+  zipcSetCompression(epub, level, hd_thread_count(), compress_parallel);
+
  /*
   * Add the mimetype file...
   */
@@ -127,7 +191,7 @@ epub_export(tree_t *document,           /* I - Document to export */
   * The META-INF/container.xml file...
   */
 
-  if ((epubf = zipcCreateFile(epub, "META-INF/container.xml", 1)) != NULL)
+  if ((epubf = zipcCreateFile(epub, "META-INF/container.xml", level > 0)) != NULL)
   {
     status |= zipcFilePuts(epubf, container_xml);
     status |= zipcFileFinish(epubf);
@@ -176,6 +240,7 @@ epub_export(tree_t *document,           /* I - Document to export */
       if ((title_file = file_find(Path, TitleImage)) == NULL)
       {
 	progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find title file '%s'.", TitleImage);
+	stats_end(HD_STATS_WRITE);
 	return (-1);
       }
 
@@ -183,6 +248,7 @@ epub_export(tree_t *document,           /* I - Document to export */
       if ((fp = fopen(title_file, "rb")) == NULL)
       {
 	progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open title file '%s': %s", TitleImage, strerror(errno));
+	stats_end(HD_STATS_WRITE);
 	return (-1);
       }
 
@@ -236,51 +302,135 @@ epub_export(tree_t *document,           /* I - Document to export */
     subject = (uchar *)"Unknown";
 
  /*
-  * Scan for all links in the document, and then update them...
+  * Split the document into chapters, one XHTML file per input file or
+  * top-level H1...
+  */
+
+  if ((chapters = (chapter_t *)calloc(MAX_CHAPTERS, sizeof(chapter_t))) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for chapters - %s", strerror(errno));
+    zipcClose(epub);
+    stats_end(HD_STATS_WRITE);
+    return (-1);
+  }
+
+  num_chapters = 0;
+  num_nodes    = 0;
+  alloc_nodes  = 0;
+  nodes        = NULL;
+  split        = 1;
+
+  status |= find_chapters(document, &split);
+
+  if (num_chapters == 0)
+    num_chapters = 1;			/* Always write at least one file */
+
+  for (i = 0; i < num_chapters; i ++)
+    snprintf(chapters[i].filename, sizeof(chapters[i].filename), "chapter%d.xhtml", (int)i + 1);
+
+ /*
+  * Scan for all links in the document, and then update them to point to the
+  * right chapter file...
   */
 
   num_links   = 0;
   alloc_links = 0;
   links       = NULL;
 
-  scan_links(document, NULL);
-  update_links(document, NULL);
-  update_links(toc, NULL);
+  for (i = 0; i < num_chapters; i ++)
+  {
+    for (j = chapters[i].first; j < (chapters[i].first + chapters[i].count); j ++)
+    {
+      uchar *name;			/* Name of link */
+
+      if (nodes[j]->markup == MARKUP_A && (name = htmlGetVariable(nodes[j], (uchar *)"NAME")) != NULL)
+        add_link(name, (uchar *)chapters[i].filename);
+
+      scan_links(nodes[j]->child, (uchar *)chapters[i].filename);
+    }
+  }
+
+  update_links(document);
+  update_links(toc);
 
  /*
-  * Write the document content...
+  * Write the stylesheet shared by the title page and chapters...
   */
 
-  if (!status && (epubf = zipcCreateFile(epub, "OEBPS/body.xhtml", 1)) != NULL)
+  if (!status)
   {
-    status |= write_header(epubf, title, author, copyright, docnumber, NULL);
-    if (TitlePage)
+    if ((epubf = zipcCreateFile(epub, "OEBPS/style.css", level > 0)) != NULL)
     {
-      progress_show("Copying title page to EPUB container...");
+      status |= write_style(epubf);
+      status |= zipcFileFinish(epubf);
+    }
+    else
+      status = -1;
+  }
+
+ /*
+  * Write the title page...
+  */
+
+  if (!status && TitlePage)
+  {
+    progress_show("Copying title page to EPUB container...");
 
+    if ((epubf = zipcCreateFile(epub, "OEBPS/title.xhtml", level > 0)) != NULL)
+    {
+      status |= write_header(epubf, title, author, copyright, docnumber, NULL);
       status |= write_title(epubf, title_tree, title, author, copyright, docnumber);
+      status |= zipcFilePuts(epubf, "</body>\n</html>\n");
+      status |= zipcFileFinish(epubf);
     }
+    else
+      status = -1;
+  }
+
+ /*
+  * Write the chapters in memory on multiple threads and then add them to the
+  * container in order...
+  */
 
-    while (document != NULL)
+  if (!status)
+  {
+    char	filename[256];		/* Filename in container */
+
+    progress_show("Copying %d chapters to EPUB container...", (int)num_chapters);
+
+    for (i = 0; i < num_chapters; i ++)
     {
-      progress_show("Copying \"%s\" to EPUB container...", (char *)htmlGetVariable(document, (uchar *)"_HD_FILENAME"));
+      snprintf(filename, sizeof(filename), "OEBPS/%s", chapters[i].filename);
 
-      status |= write_all(epubf, document->child);
+      if ((chapters[i].out = zipcCreateFileBuffer(epub, filename, level > 0)) == NULL)
+        status = -1;
+    }
 
-      document = document->next;
+    if (!status)
+    {
+      info.title     = title;
+      info.author    = author;
+      info.copyright = copyright;
+      info.docnumber = docnumber;
+
+      hd_parallel((int)num_chapters, write_chapter, &info);
     }
 
-    status |= zipcFilePuts(epubf, "</body>\n</html>\n");
-    status |= zipcFileFinish(epubf);
+    for (i = 0; i < num_chapters; i ++)
+    {
+      if (chapters[i].out)
+      {
+        status |= chapters[i].status;
+        status |= zipcFileCommit(chapters[i].out);
+      }
+    }
   }
-  else
-    status = -1;
 
  /*
   * Write the package manifest...
   */
 
-  if (!status && (epubf = zipcCreateFile(epub, "OEBPS/package.opf", 1)) != NULL)
+  if (!status && (epubf = zipcCreateFile(epub, "OEBPS/package.opf", level > 0)) != NULL)
   {
     const char *uid = docnumber ? (char *)docnumber : file_basename(OutputPath);
 
@@ -304,8 +454,12 @@ epub_export(tree_t *document,           /* I - Document to export */
                            "  </metadata>\n"
                            "  <manifest>\n"
                            "    <item id=\"nav\" href=\"nav.xhtml\" media-type=\"application/xhtml+xml\" properties=\"nav\" />\n"
-                           "    <item id=\"body\" href=\"body.xhtml\" media-type=\"application/xhtml+xml\" />\n");
-    for (size_t i = 0; !status && i < num_images; i ++)
+                           "    <item id=\"style\" href=\"style.css\" media-type=\"text/css\" />\n");
+    if (TitlePage)
+      status |= zipcFilePuts(epubf, "    <item id=\"title\" href=\"title.xhtml\" media-type=\"application/xhtml+xml\" />\n");
+    for (i = 0; !status && i < num_chapters; i ++)
+      status |= zipcFilePrintf(epubf, "    <item id=\"chapter%d\" href=\"%s\" media-type=\"application/xhtml+xml\" />\n", (int)i + 1, chapters[i].filename);
+    for (i = 0; !status && i < num_images; i ++)
     {
       const char *image_mimetype, *image_ext = file_extension(images[i]);
 
@@ -322,8 +476,12 @@ epub_export(tree_t *document,           /* I - Document to export */
     }
     status |= zipcFilePuts(epubf,
                            "  </manifest>\n"
-                           "  <spine>\n"
-                           "    <itemref idref=\"body\" />\n"
+                           "  <spine>\n");
+    if (TitlePage)
+      status |= zipcFilePuts(epubf, "    <itemref idref=\"title\" />\n");
+    for (i = 0; !status && i < num_chapters; i ++)
+      status |= zipcFilePrintf(epubf, "    <itemref idref=\"chapter%d\" />\n", (int)i + 1);
+    status |= zipcFilePuts(epubf,
                            "  </spine>\n"
                            "</package>\n");
     status |= zipcFileFinish(epubf);
@@ -333,7 +491,7 @@ epub_export(tree_t *document,           /* I - Document to export */
   * Finally the table-of-contents file...
   */
 
-  if ((epubf = zipcCreateFile(epub, "OEBPS/nav.xhtml", 1)) != NULL)
+  if ((epubf = zipcCreateFile(epub, "OEBPS/nav.xhtml", level > 0)) != NULL)
   {
     progress_show("Copying table of contents to EPUB container...");
 
@@ -362,7 +520,10 @@ epub_export(tree_t *document,           /* I - Document to export */
   status |= zipcClose(epub);
 
   if (!stat(OutputPath, &epubinfo))
+  {
     progress_error(HD_ERROR_NONE, "BYTES: %ld", (long)epubinfo.st_size);
+    stats_count(HD_COUNT_BYTES_OUT, (long long)epubinfo.st_size);
+  }
 
   if (title != NULL)
     free(title);
@@ -379,6 +540,17 @@ epub_export(tree_t *document,           /* I - Document to export */
     links       = NULL;
   }
 
+  free(chapters);
+  free(nodes);
+
+  num_chapters = 0;
+  chapters     = NULL;
+  num_nodes    = 0;
+  alloc_nodes  = 0;
+  nodes        = NULL;
+
+  stats_end(HD_STATS_WRITE);
+
   return (status);
 }
 
@@ -397,17 +569,6 @@ write_header(
     tree_t      *t)                     /* I - Current document file */
 {
   int status = 0;                       /* Write status */
-  static const char *families[] =       /* Typeface names */
-		{
-		  "monospace",
-		  "serif",
-		  "sans-serif",
-		  "monospace",
-		  "serif",
-		  "sans-serif",
-		  "symbol",
-		  "dingbats"
-		};
 
 
   status |= zipcFilePuts(out,
@@ -424,8 +585,36 @@ write_header(
   if (docnumber != NULL)
     status |= write_xhtmlf(out, "    <meta name=\"docnumber\" content=\"%s\" />\n", docnumber);
   status |= zipcFilePuts(out,
-                         "    <style type=\"text/css\"><![CDATA[\n"
-                         "body {\n");
+                         "    <link rel=\"stylesheet\" type=\"text/css\" href=\"style.css\" />\n"
+                         "  </head>\n"
+                         "  <body>\n");
+
+  return (status);
+}
+
+
+/*
+ * 'write_style()' - Write the stylesheet shared by all XHTML files.
+ */
+
+static int                              /* O - 0 on success, -1 on failure */
+write_style(zipc_file_t *out)           /* I - Output file */
+{
+  int status = 0;                       /* Write status */
+  static const char *families[] =       /* Typeface names */
+		{
+		  "monospace",
+		  "serif",
+		  "sans-serif",
+		  "monospace",
+		  "serif",
+		  "sans-serif",
+		  "symbol",
+		  "dingbats"
+		};
+
+
+  status |= zipcFilePuts(out, "body {\n");
 
   if (BodyImage[0])
     status |= write_xhtmlf(out, "  background: url(%s);\n", file_basename(BodyImage));
@@ -529,10 +718,6 @@ write_header(
                               "  text-align: center;\n"
                               "}\n");
 
-  status |= zipcFilePuts(out, "]]></style>\n"
-                              "  </head>\n"
-                              "  <body>\n");
-
   return (status);
 }
 
@@ -635,6 +820,87 @@ write_all(zipc_file_t *out,		/* I - Output file */
 }
 
 
+/*
+ * 'compress_file()' - Compress part of a file in a worker thread.
+ */
+
+static void
+compress_file(void *data,		/* I - Compression work */
+              int  index)		/* I - Work index */
+{
+  compress_work_t *work = (compress_work_t *)data;
+					/* Compression work */
+
+
+  stats_begin(HD_STATS_COMPRESS);
+  (work->cb)(work->data, index);
+  stats_end(HD_STATS_COMPRESS);
+}
+
+
+/*
+ * 'compress_parallel()' - Run compression work for the container on multiple
+ *                         threads.
+ */
+
+static void
+compress_parallel(int            count,	/* I - Number of work items */
+                  zipc_work_cb_t cb,	/* I - Work function */
+                  void           *data)	/* I - Work data */
+{
+  compress_work_t work;			/* Compression work */
+
+
+  work.cb   = cb;
+  work.data = data;
+
+  hd_parallel(count, compress_file, &work);
+}
+
+
+/*
+ * 'write_chapter()' - Write a chapter file in a worker thread.
+ */
+
+static void
+write_chapter(void *data,		/* I - Chapter header information */
+              int  index)		/* I - Chapter index */
+{
+  chapter_info_t *info = (chapter_info_t *)data;
+					/* Chapter header information */
+  chapter_t	*chapter = chapters + index;
+					/* Chapter */
+  zipc_file_t	*out = chapter->out;	/* Output file */
+  tree_t	*t;			/* Current node */
+  size_t	i;			/* Looping var */
+  int		status = 0;		/* Write status */
+
+
+  stats_begin(HD_STATS_WRITE);
+
+  status |= write_header(out, info->title, info->author, info->copyright, info->docnumber, NULL);
+
+  for (i = chapter->first; i < (chapter->first + chapter->count); i ++)
+  {
+    t = nodes[i];
+
+    status |= write_node(out, t);
+
+    if (t->markup != MARKUP_HEAD && t->markup != MARKUP_TITLE)
+      status |= write_all(out, t->child);
+
+    status |= write_nodeclose(out, t);
+  }
+
+  status |= zipcFilePuts(out, "</body>\n</html>\n");
+  status |= zipcFileFinish(out);
+
+  chapter->status = status ? -1 : 0;
+
+  stats_end(HD_STATS_WRITE);
+}
+
+
 /*
  * 'write_node()' - Write a single tree node.
  */
@@ -884,7 +1150,10 @@ write_toc(zipc_file_t *out,		/* I - Output file */
         case MARKUP_A :
             if ((href = htmlGetVariable(t, (uchar *)"HREF")) != NULL)
             {
-              status |= write_xhtmlf(out, "<a href=\"body.xhtml%s\">", href);
+              if (href[0] == '#')
+                status |= write_xhtmlf(out, "<a href=\"%s%s\">", chapters[0].filename, href);
+              else
+                status |= write_xhtmlf(out, "<a href=\"%s\">", href);
               status |= write_toc(out, t->child);
               status |= zipcFilePuts(out, "</a>");
             }
@@ -974,6 +1243,113 @@ get_title(tree_t *doc)	/* I - Document tree */
 }
 
 
+/*
+ * 'find_chapters()' - Split the document into chapters.
+ *
+ * Every input file and every H1 that is not nested inside other markup starts
+ * a new chapter.  The files and the HTML and BODY elements inside them produce
+ * no output, so each chapter is just a list of the top-level nodes inside them.
+ */
+
+static int				/* O - 0 on success, -1 on error */
+find_chapters(tree_t *t,		/* I - Document tree */
+              int    *split)		/* IO - Start a new chapter? */
+{
+  chapter_t	*chapter;		/* Current chapter */
+
+
+  for (; t != NULL; t = t->next)
+  {
+    if (t->markup == MARKUP_FILE || t->markup == MARKUP_HTML || t->markup == MARKUP_BODY)
+    {
+      if (t->markup == MARKUP_FILE)
+        *split = 1;
+
+      if (find_chapters(t->child, split))
+        return (-1);
+
+      continue;
+    }
+
+    if (t->markup == MARKUP_H1)
+      *split = 1;
+
+    if (num_chapters == 0 || (*split && chapters[num_chapters - 1].content && num_chapters < MAX_CHAPTERS))
+    {
+      chapter        = chapters + num_chapters;
+      chapter->first = num_nodes;
+      num_chapters ++;
+    }
+    else
+      chapter = chapters + num_chapters - 1;
+
+    if (num_nodes >= alloc_nodes)
+    {
+      tree_t	**temp;			/* New nodes */
+      size_t	temp_alloc = alloc_nodes ? 2 * alloc_nodes : 256;
+					/* New allocation */
+
+      if ((temp = (tree_t **)realloc(nodes, temp_alloc * sizeof(tree_t *))) == NULL)
+      {
+	progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d chapter nodes - %s", (int)temp_alloc, strerror(errno));
+	return (-1);
+      }
+
+      nodes       = temp;
+      alloc_nodes = temp_alloc;
+    }
+
+    nodes[num_nodes ++] = t;
+    chapter->count ++;
+
+    if (has_content(t))
+    {
+      chapter->content = 1;
+      *split           = 0;
+    }
+  }
+
+  return (0);
+}
+
+
+/*
+ * 'has_content()' - Determine whether a node produces visible output.
+ */
+
+static int				/* O - 1 if visible, 0 otherwise */
+has_content(tree_t *t)			/* I - Document tree node */
+{
+  uchar	*ptr;				/* Pointer into text */
+
+
+  switch (t->markup)
+  {
+    case MARKUP_NONE :
+        if (!t->data)
+          return (0);
+
+        for (ptr = t->data; *ptr; ptr ++)
+        {
+          if (!isspace(*ptr))
+            return (1);
+        }
+        return (0);
+
+    case MARKUP_COMMENT :
+    case MARKUP_DOCTYPE :
+    case MARKUP_HEAD :
+    case MARKUP_META :
+    case MARKUP_TITLE :
+    case MARKUP_UNKNOWN :
+        return (0);
+
+    default :
+        return (1);
+  }
+}
+
+
 /*
  * 'add_link()' - Add a named link...
  */
@@ -982,7 +1358,11 @@ static void
 add_link(uchar *name,		/* I - Name of link */
          uchar *filename)	/* I - File for link */
 {
-  link_t	*temp;		/* New name */
+  link_t	*temp,		/* New name */
+		key;		/* New link */
+  size_t	left,		/* Left side of search */
+		right,		/* Right side of search */
+		mid;		/* Middle of search */
 
 
   if ((temp = find_link(name)) != NULL)
@@ -1012,15 +1392,24 @@ add_link(uchar *name,		/* I - Name of link */
       links = temp;
     }
 
-    // Add a new link...
-    temp = links + num_links;
-    num_links ++;
+    // Add a new link after any with the same name, keeping the array
+    // sorted...
+    strlcpy((char *)key.name, (char *)name, sizeof(key.name));
+    key.filename = filename;
 
-    strlcpy((char *)temp->name, (char *)name, sizeof(temp->name));
-    temp->filename = filename;
+    for (left = 0, right = num_links; left < right;)
+    {
+      mid = (left + right) / 2;
+
+      if (compare_links(&key, links + mid) < 0)
+        right = mid;
+      else
+        left = mid + 1;
+    }
 
-    if (num_links > 1)
-      qsort(links, num_links, sizeof(link_t), (compare_func_t)compare_links);
+    memmove(links + left + 1, links + left, (num_links - left) * sizeof(link_t));
+    links[left] = key;
+    num_links ++;
   }
 }
 
@@ -1077,9 +1466,7 @@ scan_links(tree_t *t,		/* I - Document tree */
 
   while (t != NULL)
   {
-    if (t->markup == MARKUP_FILE)
-      scan_links(t->child, (uchar *)file_basename((char *)htmlGetVariable(t, (uchar *)"_HD_FILENAME")));
-    else if (t->markup == MARKUP_A &&
+    if (t->markup == MARKUP_A &&
              (name = htmlGetVariable(t, (uchar *)"NAME")) != NULL)
     {
       add_link(name, filename);
@@ -1094,135 +1481,38 @@ scan_links(tree_t *t,		/* I - Document tree */
 
 
 /*
- * 'update_links()' - Update links as needed.
+ * 'update_links()' - Update links to point to the chapter files.
  */
 
 static void
-update_links(tree_t *t,			/* I - Document tree */
-             uchar  *filename)		/* I - Current filename */
+update_links(tree_t *t)			/* I - Document tree */
 {
-  tree_t	*doc = t->parent;	/* Top of document */
+  tree_t	*doc = t ? t->parent : NULL;
+					/* Top of document */
   link_t	*link;			/* Link */
   uchar		*href;			/* Reference name */
   uchar		newhref[1024];		/* New reference name */
-  int		num_fstack = 0;		/* Number of filenames on the stack */
-  uchar		*fstack[100];		/* Stack of filenames */
 
 
-  filename = (uchar *)file_basename((char *)filename);
-
-  if (OutputFiles)
+  while (t != NULL)
   {
-   /*
-    * Need to preserve/add filenames.
-    */
-
-    while (t != NULL)
+    if (t->markup == MARKUP_A &&
+	(href = htmlGetVariable(t, (uchar *)"HREF")) != NULL)
     {
-      if (t->markup == MARKUP_A &&
-          (href = htmlGetVariable(t, (uchar *)"HREF")) != NULL)
-      {
-       /*
-        * Update this link as needed...
-	*/
-
-        if (href[0] == '#' &&
-	    (link = find_link(href)) != NULL)
-	{
-#if defined(WIN32) || defined(__EMX__)
-	  if (filename == NULL ||
-	      strcasecmp((char *)filename, (char *)link->filename) != 0)
-#else
-          if (filename == NULL ||
-	      strcmp((char *)filename, (char *)link->filename) != 0)
-#endif /* WIN32 || __EMX__ */
-	  {
-	    snprintf((char *)newhref, sizeof(newhref), "%s%s",
-	             link->filename, href);
-	    htmlSetVariable(t, (uchar *)"HREF", newhref);
-	  }
-	}
-      }
-      else if (t->markup == MARKUP_FILE && num_fstack < (int)(sizeof(fstack) / sizeof(fstack[0])))
-      {
-        fstack[num_fstack++] = filename;
-        filename             = (uchar *)file_basename((char *)htmlGetVariable(t, (uchar *)"_HD_FILENAME"));
-      }
-
-      // Walk to the next logical node in the tree...
-      if (t->child)
-      {
-	// Descend...
-	t = t->child;
-      }
-      else if (t == doc)
-      {
-	// At the top, stop...
-	t = NULL;
-      }
-      else if (t->next)
-      {
-	// Visit sibling...
-	t = t->next;
-      }
-      else if (t->parent && t->parent != doc)
-      {
-	// Ascend
-	t = t->parent;
-
-	while (t && !t->next)
-	{
-	  if (t->markup == MARKUP_FILE && num_fstack > 0)
-	  {
-	    // Restore previous base...
-	    num_fstack --;
-	    filename = fstack[num_fstack];
-	  }
-
-	  // Get the next parent...
-	  if (t->parent == doc || !t->parent)
-	    t = NULL;
-	  else
-	    t = t->parent;
-	}
+     /*
+      * Update this link as needed...
+      */
 
-	// If we still have a node, resume at its sibling...
-	if (t)
-	  t = t->next;
-      }
-      else
+      if (file_method((char *)href) == NULL &&
+	  (link = find_link(href)) != NULL)
       {
-	// No more...
-	t = NULL;
+	snprintf((char *)newhref, sizeof(newhref), "%s#%s", link->filename, link->name);
+	htmlSetVariable(t, (uchar *)"HREF", newhref);
       }
     }
-  }
-  else
-  {
-   /*
-    * Need to strip filenames.
-    */
 
-    while (t != NULL)
-    {
-      if (t->markup == MARKUP_A &&
-          (href = htmlGetVariable(t, (uchar *)"HREF")) != NULL)
-      {
-       /*
-        * Update this link as needed...
-	*/
-
-        if (href[0] != '#' && file_method((char *)href) == NULL &&
-	    (link = find_link(href)) != NULL)
-	{
-	  snprintf((char *)newhref, sizeof(newhref), "#%s", link->name);
-	  htmlSetVariable(t, (uchar *)"HREF", newhref);
-	}
-      }
-
-      // Advance to the next logical child...
-      t = htmlWalkNext(doc, t);
-    }
+    // Advance to the next logical child...
+    t = htmlWalkNext(doc, t);
   }
 }
 
@@ -1323,10 +1613,19 @@ copy_images(zipc_t *zipc,               /* I - ZIP container */
 
     if (t->markup == MARKUP_IMG && (src = htmlGetVariable(t, (uchar *)"SRC")) != NULL && (realsrc = htmlGetVariable(t, (uchar *)"REALSRC")) != NULL && file_method((char *)src) == NULL)
     {
-      if (copy_image(zipc, (char *)realsrc))
+      const char *filename = (char *)realsrc;
+					/* Local image file */
+
+      if (file_method(filename) && (filename = file_find(Path, filename)) == NULL)
+      {
+        progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find image file '%s'.", (char *)realsrc);
+        return (-1);
+      }
+
+      if (copy_image(zipc, filename))
         return (-1);
 
-      htmlSetVariable(t, (uchar *)"SRC", (uchar *)file_basename((char *)realsrc));
+      htmlSetVariable(t, (uchar *)"SRC", (uchar *)file_basename(filename));
     }
 
    /*
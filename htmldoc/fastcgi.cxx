@@ -0,0 +1,1065 @@
+/*
+ * FastCGI responder for HTMLDOC, a HTML document processing program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ *
+ * The "--fastcgi" option starts a pool of worker processes that accept
+ * FastCGI requests from the web server.  Each request is handled just like
+ * CGI mode, but the fonts and character set are only loaded once and each
+ * worker handles many requests.  The conversion state is reset before each
+ * request with convert_begin() and convert_end().  Output is collected into
+ * FCGI_STDOUT records of up to 64k.
+ */
+
+/*
+ * Include necessary headers.
+ */
+
+#include "htmldoc.h"
+
+#if defined(HAVE_LIBCUPS) && !defined(WIN32)
+#  include <netdb.h>
+#  include <signal.h>
+#  include <time.h>
+#  include <unistd.h>
+#  include <sys/socket.h>
+#  include <sys/stat.h>
+#  include <sys/un.h>
+#  include <sys/wait.h>
+
+
+/*
+ * FastCGI protocol constants...
+ */
+
+#  define FCGI_VERSION_1	1	// Protocol version
+#  define FCGI_HEADER_LEN	8	// Length of record header
+#  define FCGI_MAX_CONTENT	65535	// Maximum content length of a record
+#  define FCGI_MAX_PARAMS	262144	// Maximum length of request parameters
+
+#  define FCGI_BEGIN_REQUEST	1	// Record types
+#  define FCGI_ABORT_REQUEST	2
+#  define FCGI_END_REQUEST	3
+#  define FCGI_PARAMS		4
+#  define FCGI_STDIN		5
+#  define FCGI_STDOUT		6
+#  define FCGI_GET_VALUES	9
+#  define FCGI_GET_VALUES_RESULT	10
+#  define FCGI_UNKNOWN_TYPE	11
+
+#  define FCGI_KEEP_CONN	1	// Keep the connection open after request
+
+#  define FCGI_RESPONDER	1	// Responder role
+
+#  define FCGI_REQUEST_COMPLETE	0	// Protocol status values
+#  define FCGI_CANT_MPX_CONN	1
+#  define FCGI_UNKNOWN_ROLE	3
+
+
+/*
+ * Local types...
+ */
+
+typedef struct				// FastCGI request
+{
+  int		fd;			// Connection to web server
+  int		id;			// Request ID
+  int		keep_conn;		// Keep the connection open?
+  size_t	sent;			// Bytes of output sent or buffered
+  size_t	used;			// Bytes in output buffer
+  unsigned char	*buffer;		// Output buffer (FCGI_MAX_CONTENT bytes)
+  size_t	num_params,		// Length of parameters
+		alloc_params;		// Allocated length of parameters
+  unsigned char	*params;		// Name/value pairs
+} fcgi_request_t;
+
+
+/*
+ * Local globals...
+ */
+
+static char		fcgi_formats[5][4];
+					// Server header and footer formats
+static int		fcgi_num_workers = 0;
+					// Number of worker processes
+static char		fcgi_socket[256] = "";
+					// Domain socket, if any
+static volatile sig_atomic_t fcgi_stop = 0;
+					// Stop accepting requests?
+static const char * const fcgi_vars[] =	// CGI variables used for a request
+{
+  "HTTPS",
+  "HTTP_COOKIE",
+  "HTTP_REFERER",
+  "PATH_INFO",
+  "PATH_TRANSLATED",
+  "QUERY_STRING",
+  "SERVER_NAME",
+  "SERVER_PORT"
+};
+
+
+/*
+ * Local functions...
+ */
+
+static void	fcgi_add_pair(unsigned char *buffer, size_t *length, size_t bufsize, const char *name, const char *value);
+static int	fcgi_end_request(fcgi_request_t *req, int app_status, int protocol_status);
+static int	fcgi_flush(fcgi_request_t *req);
+static int	fcgi_get_length(const unsigned char **ptr, const unsigned char *end, size_t *length);
+static int	fcgi_get_param(fcgi_request_t *req, const char *name, char *value, size_t valuesize);
+static int	fcgi_get_values(int fd, const unsigned char *content, size_t length);
+static int	fcgi_listen(const char *address);
+static int	fcgi_output(void *data, const void *buffer, size_t bytes);
+static int	fcgi_read(int fd, void *buffer, size_t length);
+static int	fcgi_read_request(fcgi_request_t *req);
+static void	fcgi_respond(fcgi_request_t *req);
+static int	fcgi_send_status(fcgi_request_t *req, const char *status, const char *message);
+extern "C" {
+static void	fcgi_sigterm(int sig);
+}
+static pid_t	fcgi_start_worker(int listener);
+static void	fcgi_worker(int listener);
+static int	fcgi_write(int fd, const void *buffer, size_t length);
+static int	fcgi_write_record(int fd, int type, int id, const void *content, size_t length);
+
+
+/*
+ * 'fastcgi_run()' - Run a pool of FastCGI workers.
+ *
+ * The address is "host:port", "port", the path of a domain socket, or "-" to
+ * use the listening socket on the standard input that web servers provide to
+ * FastCGI applications they start.  Each worker formats one request at a
+ * time, and a workers value of 0 starts one worker per processor.
+ */
+
+int					// O - Exit status
+fastcgi_run(const char *address,	// I - Listen address
+            int        workers)		// I - Number of workers or 0 for automatic
+{
+  int			listener;	// Listening socket
+  int			i;		// Looping var
+  int			typeface,	// Current typeface
+			style;		// Current style
+  pid_t			pid,		// Worker process ID
+			*pids;		// Worker process IDs
+  time_t		*started;	// Time each worker was started
+  int			status;		// Exit status of worker
+  struct sigaction	action;		// Signal action
+
+
+  if ((listener = fcgi_listen(address)) < 0)
+    return (1);
+
+  if ((fcgi_num_workers = workers) <= 0)
+  {
+#  ifdef _SC_NPROCESSORS_ONLN
+    fcgi_num_workers = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#  endif // _SC_NPROCESSORS_ONLN
+
+    if (fcgi_num_workers < 1)
+      fcgi_num_workers = 1;
+  }
+
+  if ((pids = (pid_t *)calloc((size_t)fcgi_num_workers, sizeof(pid_t))) == NULL || (started = (time_t *)calloc((size_t)fcgi_num_workers, sizeof(time_t))) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d FastCGI workers.", fcgi_num_workers);
+    return (1);
+  }
+
+  // Load the glyphs and font widths once so that the workers share them...
+  if (!_htmlInitialized)
+    htmlSetCharSet("iso-8859-1");
+
+  for (typeface = TYPE_COURIER; typeface < TYPE_MAX; typeface ++)
+    for (style = STYLE_NORMAL; style < STYLE_MAX; style ++)
+      if (!hd_atomic_get(&_htmlWidthsLoaded[typeface][style]))
+        htmlLoadFontWidths(typeface, style);
+
+  // Remember the header and footer options, which are reset for each
+  // conversion...
+  strlcpy(fcgi_formats[0], get_fmt(Header), sizeof(fcgi_formats[0]));
+  strlcpy(fcgi_formats[1], get_fmt(Header1), sizeof(fcgi_formats[1]));
+  strlcpy(fcgi_formats[2], get_fmt(Footer), sizeof(fcgi_formats[2]));
+  strlcpy(fcgi_formats[3], get_fmt(TocHeader), sizeof(fcgi_formats[3]));
+  strlcpy(fcgi_formats[4], get_fmt(TocFooter), sizeof(fcgi_formats[4]));
+
+  // Stop the workers when we are terminated...
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = fcgi_sigterm;
+  sigemptyset(&action.sa_mask);
+  sigaction(SIGTERM, &action, NULL);
+  sigaction(SIGINT, &action, NULL);
+
+  progress_error(HD_ERROR_NONE, "INFO: HTMLDOC " SVERSION " starting %d FastCGI workers on '%s'.", fcgi_num_workers, address);
+
+  for (i = 0; i < fcgi_num_workers; i ++)
+  {
+    pids[i] = fcgi_start_worker(listener);
+    started[i] = time(NULL);
+  }
+
+  // Restart workers as they exit...
+  while (!fcgi_stop)
+  {
+    if ((pid = wait(&status)) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    for (i = 0; i < fcgi_num_workers; i ++)
+      if (pids[i] == pid)
+        break;
+
+    if (i >= fcgi_num_workers || fcgi_stop)
+      continue;
+
+    if (WIFSIGNALED(status))
+      progress_error(HD_ERROR_INTERNAL_ERROR, "FastCGI worker %d crashed on signal %d.", (int)pid, WTERMSIG(status));
+    else
+      progress_error(HD_ERROR_INTERNAL_ERROR, "FastCGI worker %d exited with status %d.", (int)pid, WEXITSTATUS(status));
+
+    // Don't restart workers in a tight loop...
+    if ((time(NULL) - started[i]) < 1)
+      sleep(1);
+
+    pids[i] = fcgi_start_worker(listener);
+    started[i] = time(NULL);
+  }
+
+  // Stop the workers, which finish any current request first...
+  for (i = 0; i < fcgi_num_workers; i ++)
+    if (pids[i] > 0)
+      kill(pids[i], SIGTERM);
+
+  while (wait(&status) > 0 || errno == EINTR);
+
+  close(listener);
+
+  if (fcgi_socket[0])
+    unlink(fcgi_socket);
+
+  free(pids);
+  free(started);
+
+  return (0);
+}
+
+
+/*
+ * 'fcgi_add_pair()' - Add a name/value pair to a buffer.
+ *
+ * Names and values are short, so one byte lengths are always used.
+ */
+
+static void
+fcgi_add_pair(unsigned char *buffer,	// I  - Buffer
+              size_t        *length,	// IO - Length of buffer data
+              size_t        bufsize,	// I  - Size of buffer
+              const char    *name,	// I  - Name
+              const char    *value)	// I  - Value
+{
+  size_t	namelen = strlen(name),	// Length of name
+		valuelen = strlen(value);
+					// Length of value
+
+
+  if ((*length + 2 + namelen + valuelen) > bufsize)
+    return;
+
+  buffer[(*length) ++] = (unsigned char)namelen;
+  buffer[(*length) ++] = (unsigned char)valuelen;
+
+  memcpy(buffer + *length, name, namelen);
+  *length += namelen;
+
+  memcpy(buffer + *length, value, valuelen);
+  *length += valuelen;
+}
+
+
+/*
+ * 'fcgi_end_request()' - Send the end of a request.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_end_request(
+    fcgi_request_t *req,		// I - Request
+    int            app_status,		// I - Application status
+    int            protocol_status)	// I - Protocol status
+{
+  unsigned char	body[8];		// FCGI_EndRequestBody
+
+
+  body[0] = (unsigned char)(app_status >> 24);
+  body[1] = (unsigned char)(app_status >> 16);
+  body[2] = (unsigned char)(app_status >> 8);
+  body[3] = (unsigned char)app_status;
+  body[4] = (unsigned char)protocol_status;
+  body[5] = 0;
+  body[6] = 0;
+  body[7] = 0;
+
+  return (fcgi_write_record(req->fd, FCGI_END_REQUEST, req->id, body, sizeof(body)));
+}
+
+
+/*
+ * 'fcgi_flush()' - Send any buffered output to the web server.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_flush(fcgi_request_t *req)		// I - Request
+{
+  size_t	used = req->used;	// Bytes in output buffer
+
+
+  req->used = 0;
+
+  if (used > 0 && !fcgi_write_record(req->fd, FCGI_STDOUT, req->id, req->buffer, used))
+  {
+    req->keep_conn = 0;
+    return (0);
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_get_length()' - Get the length of a name or value.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_get_length(
+    const unsigned char **ptr,		// IO - Pointer into pairs
+    const unsigned char *end,		// I  - End of pairs
+    size_t              *length)	// O  - Length
+{
+  const unsigned char	*p = *ptr;	// Pointer into pairs
+
+
+  if (p >= end)
+    return (0);
+
+  if (*p & 0x80)
+  {
+    // Four byte length...
+    if ((p + 4) > end)
+      return (0);
+
+    *length = ((size_t)(p[0] & 0x7f) << 24) | ((size_t)p[1] << 16) | ((size_t)p[2] << 8) | (size_t)p[3];
+    *ptr    = p + 4;
+  }
+  else
+  {
+    // One byte length...
+    *length = *p;
+    *ptr    = p + 1;
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_get_param()' - Get a request parameter.
+ */
+
+static int				// O - 1 if found, 0 otherwise
+fcgi_get_param(fcgi_request_t *req,	// I - Request
+               const char     *name,	// I - Parameter name
+               char           *value,	// I - Value buffer
+               size_t         valuesize)// I - Size of value buffer
+{
+  const unsigned char	*ptr,		// Pointer into parameters
+			*end;		// End of parameters
+  size_t		namelen,	// Length of name
+			valuelen;	// Length of value
+
+
+  for (ptr = req->params, end = req->params + req->num_params; ptr < end; ptr += namelen + valuelen)
+  {
+    if (!fcgi_get_length(&ptr, end, &namelen) || !fcgi_get_length(&ptr, end, &valuelen) || namelen > (size_t)(end - ptr) || valuelen > (size_t)(end - ptr - namelen))
+      break;
+
+    if (namelen == strlen(name) && !memcmp(ptr, name, namelen))
+    {
+      if (valuelen >= valuesize)
+        valuelen = valuesize - 1;
+
+      memcpy(value, ptr + namelen, valuelen);
+      value[valuelen] = '\0';
+
+      return (1);
+    }
+  }
+
+  return (0);
+}
+
+
+/*
+ * 'fcgi_get_values()' - Answer a FCGI_GET_VALUES management request.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_get_values(
+    int                 fd,		// I - Connection to web server
+    const unsigned char *content,	// I - Requested names
+    size_t              length)		// I - Length of requested names
+{
+  const unsigned char	*ptr,		// Pointer into names
+			*end;		// End of names
+  size_t		namelen,	// Length of name
+			valuelen;	// Length of value
+  char			name[256],	// Name
+			number[32];	// Number of workers
+  unsigned char		result[1024];	// Result pairs
+  size_t		resultlen = 0;	// Length of result pairs
+
+
+  snprintf(number, sizeof(number), "%d", fcgi_num_workers);
+
+  for (ptr = content, end = content + length; ptr < end; ptr += namelen + valuelen)
+  {
+    if (!fcgi_get_length(&ptr, end, &namelen) || !fcgi_get_length(&ptr, end, &valuelen) || namelen > (size_t)(end - ptr) || valuelen > (size_t)(end - ptr - namelen) || namelen >= sizeof(name))
+      break;
+
+    memcpy(name, ptr, namelen);
+    name[namelen] = '\0';
+
+    if (!strcmp(name, "FCGI_MAX_CONNS") || !strcmp(name, "FCGI_MAX_REQS"))
+      fcgi_add_pair(result, &resultlen, sizeof(result), name, number);
+    else if (!strcmp(name, "FCGI_MPXS_CONNS"))
+      fcgi_add_pair(result, &resultlen, sizeof(result), name, "0");
+  }
+
+  return (fcgi_write_record(fd, FCGI_GET_VALUES_RESULT, 0, result, resultlen));
+}
+
+
+/*
+ * 'fcgi_listen()' - Create the listening socket.
+ */
+
+static int				// O - Listening socket or -1 on error
+fcgi_listen(const char *address)	// I - Listen address
+{
+  int		fd = -1;		// Listening socket
+  int		val = 1;		// Socket option value
+
+
+  if (!strcmp(address, "-"))
+  {
+    // Use the socket the web server provides on the standard input...
+    return (0);
+  }
+  else if (address[0] == '/')
+  {
+    // Domain socket...
+    struct sockaddr_un	addr;		// Socket address
+    struct stat		fileinfo;	// Existing socket file
+
+    if (strlen(address) >= sizeof(addr.sun_path) || strlen(address) >= sizeof(fcgi_socket))
+    {
+      progress_error(HD_ERROR_INTERNAL_ERROR, "FastCGI socket path '%s' is too long.", address);
+      return (-1);
+    }
+
+    // Remove any socket left over from a previous run...
+    if (!lstat(address, &fileinfo) && S_ISSOCK(fileinfo.st_mode))
+      unlink(address);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strlcpy(addr.sun_path, address, sizeof(addr.sun_path));
+
+    if ((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 || bind(fd, (struct sockaddr *)&addr, sizeof(addr)))
+    {
+      progress_error(HD_ERROR_INTERNAL_ERROR, "Unable to bind FastCGI socket '%s': %s", address, strerror(errno));
+      if (fd >= 0)
+        close(fd);
+      return (-1);
+    }
+
+    strlcpy(fcgi_socket, address, sizeof(fcgi_socket));
+  }
+  else
+  {
+    // host:port or port...
+    char		host[256],	// Hostname
+			port[32];	// Port number
+    const char		*colon;		// Colon before port number
+    struct addrinfo	hints,		// Address hints
+			*addrlist,	// List of addresses
+			*addr;		// Current address
+    int			error;		// Lookup error
+
+    if ((colon = strrchr(address, ':')) != NULL)
+    {
+      strlcpy(host, address, sizeof(host));
+      if ((size_t)(colon - address) < sizeof(host))
+        host[colon - address] = '\0';
+
+      strlcpy(port, colon + 1, sizeof(port));
+    }
+    else
+    {
+      host[0] = '\0';
+      strlcpy(port, address, sizeof(port));
+    }
+
+    // Allow "[::1]:port" for IPv6 addresses...
+    if (host[0] == '[' && host[strlen(host) - 1] == ']')
+    {
+      host[strlen(host) - 1] = '\0';
+      memmove(host, host + 1, strlen(host));
+    }
+
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags    = AI_PASSIVE;
+
+    if ((error = getaddrinfo((host[0] && strcmp(host, "*")) ? host : NULL, port, &hints, &addrlist)) != 0)
+    {
+      progress_error(HD_ERROR_INTERNAL_ERROR, "Unable to lookup FastCGI address '%s': %s", address, gai_strerror(error));
+      return (-1);
+    }
+
+    for (addr = addrlist; addr; addr = addr->ai_next)
+    {
+      if ((fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol)) < 0)
+        continue;
+
+      setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &val, sizeof(val));
+
+      if (!bind(fd, addr->ai_addr, addr->ai_addrlen))
+        break;
+
+      close(fd);
+      fd = -1;
+    }
+
+    freeaddrinfo(addrlist);
+
+    if (fd < 0)
+    {
+      progress_error(HD_ERROR_INTERNAL_ERROR, "Unable to bind FastCGI address '%s': %s", address, strerror(errno));
+      return (-1);
+    }
+  }
+
+  if (listen(fd, 128))
+  {
+    progress_error(HD_ERROR_INTERNAL_ERROR, "Unable to listen on FastCGI address '%s': %s", address, strerror(errno));
+    close(fd);
+    return (-1);
+  }
+
+  return (fd);
+}
+
+
+/*
+ * 'fcgi_output()' - Send output to the web server.
+ *
+ * This is the output callback for the conversion.  The data is collected in
+ * the request's output buffer and sent in full FCGI_STDOUT records, since the
+ * conversion commits output in small pieces.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_output(void       *data,		// I - Request
+            const void *buffer,		// I - Data
+            size_t     bytes)		// I - Number of bytes
+{
+  fcgi_request_t	*req = (fcgi_request_t *)data;
+					// Request
+  const char		*ptr = (const char *)buffer;
+					// Pointer into data
+  size_t		length;		// Length of data to copy
+
+
+  while (bytes > 0)
+  {
+    if ((length = FCGI_MAX_CONTENT - req->used) > bytes)
+      length = bytes;
+
+    memcpy(req->buffer + req->used, ptr, length);
+
+    req->used += length;
+    req->sent += length;
+    ptr       += length;
+    bytes     -= length;
+
+    if (req->used >= FCGI_MAX_CONTENT && !fcgi_flush(req))
+      return (0);
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_read()' - Read bytes from the web server.
+ */
+
+static int				// O - 1 on success, 0 on error or EOF
+fcgi_read(int    fd,			// I - Connection to web server
+          void   *buffer,		// I - Buffer
+          size_t length)		// I - Number of bytes to read
+{
+  char		*ptr = (char *)buffer;	// Pointer into buffer
+  ssize_t	bytes;			// Bytes read
+
+
+  while (length > 0)
+  {
+    if ((bytes = read(fd, ptr, length)) < 0)
+    {
+      if (errno == EINTR && !fcgi_stop)
+        continue;
+      return (0);
+    }
+    else if (bytes == 0)
+      return (0);
+
+    ptr    += bytes;
+    length -= (size_t)bytes;
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_read_request()' - Read the next request from the web server.
+ *
+ * Requests are not multiplexed, so a second request on the same connection is
+ * refused until the current one has finished.  The request body is not used.
+ */
+
+static int				// O - 1 on success, 0 to close connection
+fcgi_read_request(fcgi_request_t *req)	// I - Request
+{
+  unsigned char	header[FCGI_HEADER_LEN],// Record header
+		content[FCGI_MAX_CONTENT + 256];
+					// Record content and padding
+  int		type,			// Record type
+		id;			// Request ID
+  size_t	length;			// Content length
+  int		have_params = 0,	// Have all parameters?
+		have_stdin = 0;		// Have the request body?
+
+
+  req->id         = 0;
+  req->keep_conn  = 0;
+  req->num_params = 0;
+
+  while (!req->id || !have_params || !have_stdin)
+  {
+    if (!fcgi_read(req->fd, header, sizeof(header)) || header[0] != FCGI_VERSION_1)
+      return (0);
+
+    type   = header[1];
+    id     = (header[2] << 8) | header[3];
+    length = (size_t)((header[4] << 8) | header[5]);
+
+    if (!fcgi_read(req->fd, content, length + header[6]))
+      return (0);
+
+    if (id == 0)
+    {
+      // Management record...
+      if (type == FCGI_GET_VALUES)
+      {
+        if (!fcgi_get_values(req->fd, content, length))
+          return (0);
+      }
+      else
+      {
+        unsigned char	body[8];	// FCGI_UnknownTypeBody
+
+        memset(body, 0, sizeof(body));
+        body[0] = (unsigned char)type;
+
+        if (!fcgi_write_record(req->fd, FCGI_UNKNOWN_TYPE, 0, body, sizeof(body)))
+          return (0);
+      }
+      continue;
+    }
+
+    switch (type)
+    {
+      case FCGI_BEGIN_REQUEST :
+          if (length < 8)
+            return (0);
+
+          if (req->id)
+          {
+            // Only one request at a time...
+            fcgi_request_t	other = *req;
+
+            other.id = id;
+            if (!fcgi_end_request(&other, 0, FCGI_CANT_MPX_CONN))
+              return (0);
+          }
+          else if (((content[0] << 8) | content[1]) != FCGI_RESPONDER)
+          {
+            // We are only a responder...
+            fcgi_request_t	other = *req;
+
+            other.id = id;
+            if (!fcgi_end_request(&other, 0, FCGI_UNKNOWN_ROLE) || !(content[2] & FCGI_KEEP_CONN))
+              return (0);
+          }
+          else
+          {
+            req->id        = id;
+            req->keep_conn = content[2] & FCGI_KEEP_CONN;
+            have_params    = 0;
+            have_stdin     = 0;
+          }
+          break;
+
+      case FCGI_ABORT_REQUEST :
+          if (id == req->id)
+          {
+            if (!fcgi_end_request(req, 0, FCGI_REQUEST_COMPLETE) || !req->keep_conn)
+              return (0);
+
+            req->id         = 0;
+            req->num_params = 0;
+          }
+          break;
+
+      case FCGI_PARAMS :
+          if (id != req->id)
+            break;
+
+          if (length == 0)
+          {
+            have_params = 1;
+            break;
+          }
+
+          if ((req->num_params + length) > FCGI_MAX_PARAMS)
+          {
+            progress_error(HD_ERROR_CONTENT_TOO_LARGE, "FastCGI request parameters are too large.");
+            return (0);
+          }
+
+          if ((req->num_params + length) > req->alloc_params)
+          {
+            unsigned char	*temp;	// New parameters
+
+            if ((temp = (unsigned char *)realloc(req->params, req->num_params + length)) == NULL)
+              return (0);
+
+            req->params       = temp;
+            req->alloc_params = req->num_params + length;
+          }
+
+          memcpy(req->params + req->num_params, content, length);
+          req->num_params += length;
+          break;
+
+      case FCGI_STDIN :
+          if (id == req->id && length == 0)
+            have_stdin = 1;
+          break;
+
+      default :
+          break;
+    }
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_respond()' - Convert the page for a request and send it.
+ *
+ * The conversion runs exactly like CGI mode with the standard output sent to
+ * the web server in FCGI_STDOUT records as it is produced.
+ */
+
+static void
+fcgi_respond(fcgi_request_t *req)	// I - Request
+{
+  size_t	i;			// Looping var
+  char		value[8192];		// Parameter value
+  tree_t	*document,		// Document tree
+		*toc;			// Table of contents
+  exportfunc_t	exportfunc;		// Export function
+  int		errors;			// Number of errors
+
+
+  // Set the CGI variables for this request...
+  for (i = 0; i < (sizeof(fcgi_vars) / sizeof(fcgi_vars[0])); i ++)
+  {
+    if (fcgi_get_param(req, fcgi_vars[i], value, sizeof(value)))
+      setenv(fcgi_vars[i], value, 1);
+    else
+      unsetenv(fcgi_vars[i]);
+  }
+
+  // Convert the page...
+  convert_begin(&exportfunc);
+
+  get_format(fcgi_formats[0], Header);
+  get_format(fcgi_formats[1], Header1);
+  get_format(fcgi_formats[2], Footer);
+  get_format(fcgi_formats[3], TocHeader);
+  get_format(fcgi_formats[4], TocFooter);
+
+  cgi_setup(&document, &exportfunc);
+
+  req->sent  = 0;
+  req->used  = 0;
+  OutputFunc = fcgi_output;
+  OutputData = req;
+
+  if (cgi_add_url())
+    read_files(&document);
+
+  if (document)
+  {
+    while (document->prev != NULL)
+      document = document->prev;
+
+    htmlFixLinks(document);
+
+    if (OutputType == OUTPUT_BOOK && TocLevels > 0)
+    {
+      toc = toc_build(document);
+    }
+    else
+    {
+      if (TocNumbers)
+        htmlDeleteTree(toc_build(document));
+
+      toc = NULL;
+    }
+
+    (*exportfunc)(document, toc);
+
+    htmlDeleteTree(document);
+    htmlDeleteTree(toc);
+  }
+
+  errors = Errors;
+
+  OutputFunc = NULL;
+  OutputData = NULL;
+
+  convert_end();
+
+  // Finish the response...
+  if (req->sent == 0)
+  {
+    if (!document)
+      fcgi_send_status(req, "404 Not Found", "Unable to read the page to convert.");
+    else
+      fcgi_send_status(req, "500 Internal Server Error", "Unable to convert the page.");
+    return;
+  }
+
+  if (!fcgi_flush(req) || !fcgi_write_record(req->fd, FCGI_STDOUT, req->id, NULL, 0) || !fcgi_end_request(req, errors > 0, FCGI_REQUEST_COMPLETE))
+    req->keep_conn = 0;
+}
+
+
+/*
+ * 'fcgi_send_status()' - Send an error response.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_send_status(fcgi_request_t *req,	// I - Request
+                 const char     *status,// I - HTTP status
+                 const char     *message)
+					// I - Message text
+{
+  char	buffer[1024];			// Response
+  int	length;				// Length of response
+
+
+  length = snprintf(buffer, sizeof(buffer), "Status: %s\r\nContent-Type: text/plain\r\n\r\n%s\n", status, message);
+
+  if (!fcgi_write_record(req->fd, FCGI_STDOUT, req->id, buffer, (size_t)length) || !fcgi_write_record(req->fd, FCGI_STDOUT, req->id, NULL, 0) || !fcgi_end_request(req, 1, FCGI_REQUEST_COMPLETE))
+  {
+    req->keep_conn = 0;
+    return (0);
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_sigterm()' - Stop accepting requests.
+ */
+
+static void
+fcgi_sigterm(int sig)			// I - Signal number
+{
+  (void)sig;
+
+  fcgi_stop = 1;
+}
+
+
+/*
+ * 'fcgi_start_worker()' - Start a worker process.
+ */
+
+static pid_t				// O - Process ID or -1 on error
+fcgi_start_worker(int listener)		// I - Listening socket
+{
+  pid_t	pid;				// Process ID
+
+
+  if ((pid = fork()) == 0)
+  {
+    fcgi_worker(listener);
+    exit(0);
+  }
+  else if (pid < 0)
+    progress_error(HD_ERROR_INTERNAL_ERROR, "Unable to start FastCGI worker: %s", strerror(errno));
+
+  return (pid);
+}
+
+
+/*
+ * 'fcgi_worker()' - Accept and respond to requests.
+ */
+
+static void
+fcgi_worker(int listener)		// I - Listening socket
+{
+  fcgi_request_t	req;		// Current request
+
+
+  signal(SIGPIPE, SIG_IGN);
+
+  memset(&req, 0, sizeof(req));
+
+  if ((req.buffer = (unsigned char *)malloc(FCGI_MAX_CONTENT)) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for FastCGI output.");
+    return;
+  }
+
+  while (!fcgi_stop)
+  {
+    if ((req.fd = accept(listener, NULL, NULL)) < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+        continue;
+
+      progress_error(HD_ERROR_INTERNAL_ERROR, "Unable to accept FastCGI connection: %s", strerror(errno));
+      break;
+    }
+
+    while (!fcgi_stop && fcgi_read_request(&req))
+    {
+      fcgi_respond(&req);
+
+      if (!req.keep_conn)
+        break;
+    }
+
+    close(req.fd);
+  }
+
+  free(req.buffer);
+  free(req.params);
+}
+
+
+/*
+ * 'fcgi_write()' - Write bytes to the web server.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_write(int        fd,		// I - Connection to web server
+           const void *buffer,		// I - Buffer
+           size_t     length)		// I - Number of bytes to write
+{
+  const char	*ptr = (const char *)buffer;
+					// Pointer into buffer
+  ssize_t	bytes;			// Bytes written
+
+
+  while (length > 0)
+  {
+    if ((bytes = write(fd, ptr, length)) < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return (0);
+    }
+
+    ptr    += bytes;
+    length -= (size_t)bytes;
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'fcgi_write_record()' - Write a record to the web server.
+ */
+
+static int				// O - 1 on success, 0 on error
+fcgi_write_record(int        fd,	// I - Connection to web server
+                  int        type,	// I - Record type
+                  int        id,	// I - Request ID
+                  const void *content,	// I - Content
+                  size_t     length)	// I - Length of content
+{
+  unsigned char	header[FCGI_HEADER_LEN];// Record header
+
+
+  header[0] = FCGI_VERSION_1;
+  header[1] = (unsigned char)type;
+  header[2] = (unsigned char)(id >> 8);
+  header[3] = (unsigned char)id;
+  header[4] = (unsigned char)(length >> 8);
+  header[5] = (unsigned char)length;
+  header[6] = 0;
+  header[7] = 0;
+
+  return (fcgi_write(fd, header, sizeof(header)) && (length == 0 || fcgi_write(fd, content, length)));
+}
+
+
+#else
+/*
+ * 'fastcgi_run()' - Run a pool of FastCGI workers.
+ *
+ * FastCGI mode requires the CUPS library and is not available on Windows.
+ */
+
+int					// O - Exit status
+fastcgi_run(const char *address,	// I - Listen address
+            int        workers)		// I - Number of workers or 0 for automatic
+{
+  (void)address;
+  (void)workers;
+
+  progress_error(HD_ERROR_INTERNAL_ERROR, "FastCGI mode is not supported.");
+
+  return (1);
+}
+#endif // HAVE_LIBCUPS && !WIN32
@@ -13,6 +13,8 @@
 #  include <cups/cups.h>
 #endif // HAVE_LIBCUPS
 #include "progress.h"
+#include "stats.h"
+#include "thread.h"
 #include "debug.h"
 
 #if defined(WIN32)
@@ -80,6 +82,7 @@ typedef struct		/* Cache for all temporary files */
 {
   char	*name;				/* Temporary filename */
   char	*url;				/* URL */
+  int	partial;			/* Only the start of the file? */
 } cache_t;
 
 
@@ -101,6 +104,16 @@ int	no_local = 0;			/* Non-zero to disable local files */
 size_t	web_files = 0,			/* Number of temporary files */
 	web_alloc = 0;			/* Number of allocated files */
 cache_t	*web_cache = NULL;		/* Cache array */
+static hd_mutex_t web_mutex = HD_MUTEX_INITIALIZER;
+					/* Lock for remote files and cache */
+
+
+/*
+ * Local functions...
+ */
+
+static const char	*file_find_check(const char *filename, size_t probe);
+static const char	*file_find_path(const char *path, const char *s, size_t probe);
 
 
 /*
@@ -111,7 +124,8 @@ const char *			/* O - Base filename */
 file_basename(const char *s)	/* I - Filename or URL */
 {
   const char	*basename;	/* Pointer to directory separator */
-  static char	buf[1024];	/* Buffer for files with targets */
+  static HD_THREAD_LOCAL char buf[1024];
+				/* Buffer for files with targets */
 
 
   if (s == NULL)
@@ -271,7 +285,8 @@ const char *				/* O - Directory for file */
 file_directory(const char *s)		/* I - Filename or URL */
 {
   char		*dir;			/* Pointer to directory separator */
-  static char	buf[1024];		/* Buffer for files with targets */
+  static HD_THREAD_LOCAL char buf[1024];
+					/* Buffer for files with targets */
 
 
   if (s == NULL || !strncmp(s, "data:", 5))
@@ -337,7 +352,8 @@ file_extension(const char *s)		/* I - Filename or URL */
 {
   const char	*extension;		/* Pointer to directory separator */
   char		*bufptr;		/* Pointer into buffer */
-  static char	buf[1024];		/* Buffer for files with targets */
+  static HD_THREAD_LOCAL char buf[1024];
+					/* Buffer for files with targets */
 
 
   if (s == NULL)
@@ -378,15 +394,27 @@ file_extension(const char *s)		/* I - Filename or URL */
 
 /*
  * 'file_find_check()' - Check to see if the specified file or URL exists...
+ *
+ * When "probe" is non-zero, only the first "probe" bytes of a remote file are
+ * retrieved if the server supports range requests.
  */
 
 static const char *			/* O - Pathname or NULL */
-file_find_check(const char *filename)	/* I - File or URL */
+file_find_check(const char *filename,	/* I - File or URL */
+                size_t     probe)	/* I - Bytes to retrieve or 0 for all */
 {
-  DEBUG_printf(("file_find_check(filename=\"%s\")\n", filename));
+  DEBUG_printf(("file_find_check(filename=\"%s\", probe=%d)\n", filename, (int)probe));
 
 #ifdef HAVE_LIBCUPS
   int		i;			/* Looping var */
+  int		cached;			/* Partial cache entry or -1 */
+  char		range[64];		/* Range for GET */
+  const char	*content_range;		/* Content-Range of response */
+  unsigned long	first,			/* First byte in response */
+		last,			/* Last byte in response */
+		length;			/* Length of file */
+  int		fields;			/* Number of Content-Range fields */
+  int		partial;		/* Only got the start of the file? */
   int		retry;			/* Current retry */
   char		scheme[1024],		/* Scheme */
 		username[1024],		/* Username:password */
@@ -451,6 +479,7 @@ file_find_check(const char *filename)	/* I - File or URL */
       if (web_cache[i].url && strcmp(web_cache[i].url, filename) == 0)
       {
         DEBUG_printf(("file_find_check: Returning \"%s\" for \"%s\".\n", web_cache[i].name, filename));
+        stats_count(HD_COUNT_CACHE_HITS, 1);
         return (web_cache[i].name);
       }
     }
@@ -486,11 +515,22 @@ file_find_check(const char *filename)	/* I - File or URL */
     * from the remote system...
     */
 
-    for (i = 0; i < (int)web_files; i ++)
+    for (i = 0, cached = -1; i < (int)web_files; i ++)
     {
       if (web_cache[i].url && strcmp(web_cache[i].url, filename) == 0)
       {
+        if (web_cache[i].partial && !probe)
+        {
+         /*
+          * Only have the start of the file, get the whole thing now...
+          */
+
+          cached = i;
+          break;
+        }
+
         DEBUG_printf(("file_find_check: Returning \"%s\" for \"%s\".\n", web_cache[i].name, filename));
+        stats_count(HD_COUNT_CACHE_HITS, 1);
         return (web_cache[i].name);
       }
     }
@@ -499,7 +539,7 @@ file_find_check(const char *filename)	/* I - File or URL */
                     username, sizeof(username), hostname, sizeof(hostname),
 		    &port, resource, sizeof(resource));
 
-    for (status = HTTP_STATUS_ERROR, retry = 0; status != HTTP_STATUS_OK && retry < 5; retry ++)
+    for (status = HTTP_STATUS_ERROR, retry = 0; status != HTTP_STATUS_OK && status != HTTP_STATUS_PARTIAL_CONTENT && retry < 5; retry ++)
     {
       if (proxy_port)
       {
@@ -558,6 +598,12 @@ file_find_check(const char *filename)	/* I - File or URL */
       if (cookies[0])
         httpSetCookie(http, cookies);
 
+      if (probe)
+      {
+        snprintf(range, sizeof(range), "bytes=0-%lu", (unsigned long)probe - 1);
+        httpSetField(http, HTTP_FIELD_RANGE, range);
+      }
+
 #  if CUPS_VERSION_MAJOR == 2
       if (!httpGet(http, connpath))
 #  else
@@ -575,6 +621,9 @@ file_find_check(const char *filename)	/* I - File or URL */
 	status = HTTP_STATUS_ERROR;
       }
 
+      if (probe && status == HTTP_STATUS_REQUESTED_RANGE)
+        break;				// Retry without the range below
+
       if (status >= HTTP_STATUS_MULTIPLE_CHOICES && status < HTTP_STATUS_BAD_REQUEST)
       {
         // Redirect status code, grab the new location...
@@ -594,7 +643,34 @@ file_find_check(const char *filename)	/* I - File or URL */
       }
     }
 
-    if (status != HTTP_STATUS_OK)
+    partial = status == HTTP_STATUS_PARTIAL_CONTENT;
+
+    if (partial)
+    {
+     /*
+      * See if the server sent the start of the file or all of it...
+      */
+
+      content_range = httpGetField(http, HTTP_FIELD_CONTENT_RANGE);
+      fields        = sscanf(content_range ? content_range : "", "bytes %lu-%lu/%lu", &first, &last, &length);
+
+      if (fields < 2 || first != 0)
+        status = HTTP_STATUS_REQUESTED_RANGE;
+      else if (fields == 3 && last + 1 >= length)
+        partial = 0;
+    }
+
+    if (status != HTTP_STATUS_OK && status != HTTP_STATUS_PARTIAL_CONTENT && probe)
+    {
+     /*
+      * Range request failed or was not satisfiable, try getting the whole
+      * file...
+      */
+
+      httpFlush(http);
+      return (file_find_check(filename, 0));
+    }
+    else if (status != HTTP_STATUS_OK && status != HTTP_STATUS_PARTIAL_CONTENT)
     {
       progress_hide();
       progress_error((HDerror)status, "%s (%s)", httpStatusString(status), filename);
@@ -602,7 +678,19 @@ file_find_check(const char *filename)	/* I - File or URL */
       return (NULL);
     }
 
-    if ((fp = file_temp(tempname, sizeof(tempname))) == NULL)
+    if (cached >= 0)
+    {
+     /*
+      * Replace the start of the file we got earlier...
+      */
+
+      strlcpy(tempname, web_cache[cached].name, sizeof(tempname));
+      fp = fopen(tempname, "wb");
+    }
+    else
+      fp = file_temp(tempname, sizeof(tempname));
+
+    if (!fp)
     {
       progress_hide();
       progress_error(HD_ERROR_WRITE_ERROR,
@@ -627,11 +715,17 @@ file_find_check(const char *filename)	/* I - File or URL */
 
     fclose(fp);
 
-    web_cache[web_files - 1].url = strdup(filename);
+    if (cached < 0)
+    {
+      cached                = (int)web_files - 1;
+      web_cache[cached].url = strdup(filename);
+    }
+
+    web_cache[cached].partial = partial;
 
     DEBUG_printf(("file_find_check: Returning \"%s\" for \"%s\".\n", tempname, filename));
 
-    return (web_cache[web_files - 1].name);
+    return (web_cache[cached].name);
   }
 #endif // HAVE_LIBCUPS
 
@@ -646,13 +740,36 @@ file_find_check(const char *filename)	/* I - File or URL */
 const char *				/* O - Pathname or NULL */
 file_find(const char *path,		/* I - Path "dir;dir;dir" */
           const char *s)		/* I - File to find */
+{
+  const char	*realname;		/* Real filename */
+
+
+  stats_begin(HD_STATS_FETCH);
+  hd_mutex_lock(&web_mutex);
+  realname = file_find_path(path, s, 0);
+  hd_mutex_unlock(&web_mutex);
+  stats_end(HD_STATS_FETCH);
+
+  return (realname);
+}
+
+
+/*
+ * 'file_find_path()' - Find a file or URL, downloading it as needed.
+ */
+
+static const char *			/* O - Pathname or NULL */
+file_find_path(const char *path,	/* I - Path "dir;dir;dir" */
+               const char *s,		/* I - File to find */
+               size_t     probe)	/* I - Bytes to retrieve or 0 for all */
 {
   char		*temp;			/* Current position in filename */
   const char	*sptr;			/* Pointer into "s" */
   int		ch;			/* Quoted character */
   char		basename[1024];		/* Base (unquoted) filename */
   const char	*realname;		/* Real filename */
-  static char	filename[1024];		/* Current filename */
+  static HD_THREAD_LOCAL char filename[1024];
+					/* Current filename */
 
 
  /*
@@ -662,7 +779,7 @@ file_find(const char *path,		/* I - Path "dir;dir;dir" */
   if (s == NULL)
     return (NULL);
 
-  DEBUG_printf(("file_find(path=\"%s\", s=\"%s\")\n", path ? path : "(null)", s));
+  DEBUG_printf(("file_find_path(path=\"%s\", s=\"%s\")\n", path ? path : "(null)", s));
 
 #ifdef HAVE_CUPS
  /*
@@ -673,12 +790,12 @@ file_find(const char *path,		/* I - Path "dir;dir;dir" */
   {
     if (strcmp(s, web_cache[i].name) == 0)
     {
-      DEBUG_printf(("file_find: Returning cache file \"%s\"!\n", s));
+      DEBUG_printf(("file_find_path: Returning cache file \"%s\"!\n", s));
       return (web_cache[i].name);
     }
   }
 
-  DEBUG_printf(("file_find: \"%s\" not in web cache of %d files...\n", s, (int)web_files));
+  DEBUG_printf(("file_find_path: \"%s\" not in web cache of %d files...\n", s, (int)web_files));
 #endif // HAVE_LIBCUPS
 
  /*
@@ -727,7 +844,7 @@ file_find(const char *path,		/* I - Path "dir;dir;dir" */
 
   if (path != NULL && !path[0])
   {
-    DEBUG_puts("file_find: Resetting path to NULL since path is empty...");
+    DEBUG_puts("file_find_path: Resetting path to NULL since path is empty...");
     path = NULL;
   }
 
@@ -735,7 +852,7 @@ file_find(const char *path,		/* I - Path "dir;dir;dir" */
       strncmp(s, "https:", 6) == 0 ||
       strncmp(s, "//", 2) == 0)
   {
-    DEBUG_puts("file_find: Resetting path to NULL since filename is a URL...");
+    DEBUG_puts("file_find_path: Resetting path to NULL since filename is a URL...");
     path = NULL;
   }
 
@@ -775,12 +892,12 @@ file_find(const char *path,		/* I - Path "dir;dir;dir" */
       * See if the file or URL exists...
       */
 
-      if ((realname = file_find_check(filename)) != NULL)
+      if ((realname = file_find_check(filename, probe)) != NULL)
 	return (realname);
     }
   }
 
-  return (file_find_check(s));
+  return (file_find_check(s, probe));
 }
 
 
@@ -872,6 +989,17 @@ file_gets(char  *buf,		/* I - Line buffer */
 }
 
 
+/*
+ * 'file_local()' - Enable access to local files.
+ */
+
+void
+file_local(void)
+{
+  no_local = 0;
+}
+
+
 /*
  * 'file_localize()' - Localize a filename for the new working directory.
  */
@@ -999,6 +1127,33 @@ file_nolocal(void)
 }
 
 
+/*
+ * 'file_probe()' - Find a file or URL, downloading only the start of it.
+ *
+ * Remote files are retrieved with a range request for the first "bytes"
+ * bytes, falling back to the whole file if the server does not support range
+ * requests.  A later call to file_find() for the same URL retrieves the
+ * whole file.
+ */
+
+const char *				/* O - Pathname or NULL */
+file_probe(const char *path,		/* I - Path "dir;dir;dir" */
+           const char *s,		/* I - File to find */
+           size_t     bytes)		/* I - Number of bytes needed */
+{
+  const char	*realname;		/* Real filename */
+
+
+  stats_begin(HD_STATS_FETCH);
+  hd_mutex_lock(&web_mutex);
+  realname = file_find_path(path, s, bytes);
+  hd_mutex_unlock(&web_mutex);
+  stats_end(HD_STATS_FETCH);
+
+  return (realname);
+}
+
+
 /*
  * 'file_proxy()' - Set the proxy host for all HTTP requests.
  */
@@ -1065,21 +1220,29 @@ file_rlookup(const char *filename)	/* I - Filename */
 #ifdef HAVE_LIBCUPS
   int		i;			/* Looping var */
   cache_t	*wc;			/* Current cache file */
+  const char	*url = filename;	/* URL */
 
 
+  hd_mutex_lock(&web_mutex);
+
   for (i = web_files, wc = web_cache; i > 0; i --, wc ++)
   {
     if (!strcmp(wc->name, filename))
     {
       if (!strncmp(wc->url, "data:", 5))
-        return ("data URL");
+        url = "data URL";
       else
-        return (wc->url);
+        url = wc->url;
+      break;
     }
   }
-#endif // HAVE_LIBCUPS
 
+  hd_mutex_unlock(&web_mutex);
+
+  return (url);
+#else
   return (filename);
+#endif // HAVE_LIBCUPS
 }
 
 
@@ -1158,8 +1321,9 @@ file_temp(char *name,			/* O - Filename */
 
   temp = web_cache + web_files;
 
-  temp->name = NULL;
-  temp->url  = NULL;
+  temp->name    = NULL;
+  temp->url     = NULL;
+  temp->partial = 0;
   web_files ++;
 
 #ifdef WIN32
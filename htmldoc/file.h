@@ -33,9 +33,11 @@ extern const char	*file_directory(const char *s);
 extern const char	*file_extension(const char *s);
 extern const char	*file_find(const char *path, const char *s);
 extern char		*file_gets(char *buf, int buflen, FILE *fp);
+extern void		file_local(void);
 extern const char	*file_localize(const char *filename, const char *newcwd);
 extern const char	*file_method(const char *s);
 extern void		file_nolocal(void);
+extern const char	*file_probe(const char *path, const char *s, size_t bytes);
 extern void		file_proxy(const char *url);
 extern void		file_referer(const char *referer);
 extern const char	*file_rlookup(const char *filename);
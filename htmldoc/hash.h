@@ -0,0 +1,171 @@
+//
+// Perfect hash tables for HTMLDOC, an HTML document processing program.
+//
+// This file is generated by "tools/makehash.py" - do not edit!
+//
+// Copyright 2026 by Michael R Sweet.
+//
+// This program is free software.  Distribution and use rights are outlined in
+// the file "COPYING".
+//
+
+#ifndef _HTMLDOC_HASH_H_
+#  define _HTMLDOC_HASH_H_
+
+
+//
+// 'hd_hash()' - Hash a name, optionally ignoring the case of ASCII letters.
+//
+
+static inline unsigned			// O - Hash value
+hd_hash(const char *name,		// I - Name
+        unsigned   seed,		// I - Seed (bucket displacement)
+        int        nocase)		// I - Ignore case?
+{
+  unsigned h = 2166136261U ^ seed;	// Hash value
+
+
+  for (; *name; name ++)
+  {
+    unsigned ch = (unsigned)*name & 255;	// Current character
+
+    if (nocase && ch >= 'A' && ch <= 'Z')
+      ch += 'a' - 'A';
+
+    h = (h ^ ch) * 16777619U;
+  }
+
+  return (h ^ (h >> 15));
+}
+
+
+//
+// 'hd_hash_lookup()' - Look up the array index of a name.
+//
+// The caller must compare the name at the returned index, since names that
+// are not in the table also map to a slot.
+//
+
+static inline int			// O - Array index or -1
+hd_hash_lookup(const char           *name,	// I - Name
+               const unsigned short *disp,	// I - Bucket displacements
+               int                  nbuckets,	// I - Number of buckets
+               const short          *slots,	// I - Slots
+               int                  nslots,	// I - Number of slots (power of 2)
+               int                  nocase)	// I - Ignore case?
+{
+  unsigned d = disp[hd_hash(name, 0, nocase) % (unsigned)nbuckets];
+					// Displacement for bucket
+
+
+  return (slots[hd_hash(name, d, nocase) & (unsigned)(nslots - 1)]);
+}
+
+
+// Element names from _htmlMarkups[] in "htmllib.cxx" (97 names, case-insensitive)
+#define HD_MARKUP_COUNT 97
+#define HD_MARKUP_BUCKETS 32
+#define HD_MARKUP_SLOTS 128
+
+static const unsigned short hd_markup_disp[HD_MARKUP_BUCKETS] =
+{
+  0, 2, 16, 4, 1, 2, 6, 4, 11, 1, 2, 9,
+  2, 5, 7, 4, 14, 7, 4, 1, 1, 4, 1, 13,
+  8, 3, 11, 8, 1, 18, 3, 26
+};
+static const short hd_markup_slots[HD_MARKUP_SLOTS] =
+{
+  39, 9, 22, 16, -1, -1, -1, 24, 94, 2, -1, 18,
+  -1, 15, -1, -1, -1, -1, 74, 84, -1, 62, 34, 78,
+  68, 73, 29, 88, 10, -1, 86, 71, -1, -1, 50, -1,
+  -1, -1, -1, 3, 30, 14, 61, 87, 90, 33, 76, 26,
+  69, 66, 75, 36, 44, 42, 43, 12, -1, 83, -1, 7,
+  -1, 96, 80, -1, 91, -1, 54, 77, 70, 19, 67, 52,
+  28, 82, 32, 60, -1, 85, 38, 53, 27, 1, -1, 56,
+  95, 47, 79, 20, 48, 89, 5, 72, 21, 57, 35, 55,
+  37, 13, 6, 51, 59, 58, 25, -1, 4, 31, 46, 17,
+  63, -1, 40, 64, -1, -1, -1, 92, -1, 49, 23, 8,
+  41, 93, 11, -1, 81, 0, 65, 45
+};
+
+
+// Character entities from iso8859_numbers[] in "iso8859.cxx" (252 names, case-sensitive)
+#define HD_ENTITY_COUNT 252
+#define HD_ENTITY_BUCKETS 84
+#define HD_ENTITY_SLOTS 512
+
+static const unsigned short hd_entity_disp[HD_ENTITY_BUCKETS] =
+{
+  1, 1, 0, 2, 2, 2, 7, 1, 9, 4, 6, 1,
+  5, 2, 1, 1, 4, 0, 1, 7, 1, 1, 2, 1,
+  1, 1, 2, 2, 0, 4, 2, 2, 3, 5, 5, 9,
+  10, 8, 5, 8, 1, 7, 1, 1, 3, 12, 0, 3,
+  2, 2, 1, 3, 2, 1, 5, 4, 1, 1, 2, 3,
+  2, 1, 3, 3, 1, 1, 5, 2, 1, 3, 6, 2,
+  2, 2, 10, 1, 1, 4, 1, 0, 2, 5, 1, 1
+};
+static const short hd_entity_slots[HD_ENTITY_SLOTS] =
+{
+  138, 115, 13, -1, 72, 17, 66, -1, -1, 144, 35, -1,
+  -1, 186, -1, -1, 191, 124, 62, -1, -1, 198, -1, 248,
+  184, -1, 228, -1, -1, -1, 179, -1, 210, 244, 243, -1,
+  -1, 102, 147, 143, -1, -1, -1, -1, -1, -1, -1, 131,
+  32, -1, -1, 27, 69, 205, -1, 223, 53, -1, -1, 167,
+  71, 120, 81, -1, -1, -1, 187, -1, 40, -1, 109, -1,
+  44, 111, 7, -1, -1, -1, 145, 206, -1, -1, 171, -1,
+  -1, 20, 105, -1, 91, 232, -1, -1, 59, -1, 233, -1,
+  108, -1, 231, 68, 55, -1, -1, -1, -1, -1, 43, -1,
+  -1, 126, 11, -1, 227, -1, 135, -1, -1, -1, -1, -1,
+  33, 104, -1, 98, -1, 74, 251, -1, -1, -1, -1, 90,
+  19, -1, 134, -1, -1, 202, -1, -1, -1, 12, -1, 242,
+  235, -1, 146, -1, 63, 230, -1, -1, 58, -1, 5, -1,
+  238, -1, -1, 199, -1, -1, -1, -1, 14, 165, 106, 60,
+  52, -1, -1, -1, -1, -1, 47, 100, 4, -1, -1, -1,
+  -1, 155, -1, -1, 8, -1, 50, 153, 97, 159, 28, -1,
+  -1, 213, -1, -1, -1, -1, 123, -1, 117, 125, 82, -1,
+  139, 121, -1, 114, 241, 34, -1, -1, 168, -1, 152, -1,
+  151, -1, 29, 112, 156, 23, -1, 196, 162, 203, 173, 220,
+  -1, 99, -1, 136, -1, -1, 87, -1, -1, -1, 25, -1,
+  -1, -1, 119, 148, -1, 208, -1, -1, 240, 239, 236, 200,
+  -1, 185, -1, -1, -1, 94, -1, -1, -1, 79, -1, -1,
+  -1, 0, -1, -1, 140, -1, 10, 204, -1, -1, -1, 38,
+  128, -1, -1, -1, 122, 89, 113, 237, 6, 76, -1, -1,
+  127, -1, -1, -1, 201, 15, 175, 250, 30, -1, 67, 164,
+  -1, -1, -1, -1, 195, -1, -1, 54, -1, -1, 174, 189,
+  190, 154, -1, -1, 45, 212, 2, -1, -1, -1, 48, 245,
+  83, -1, -1, 180, -1, 57, 36, -1, -1, 178, 42, 215,
+  -1, 133, -1, 177, -1, -1, -1, -1, -1, 88, 93, -1,
+  130, 41, -1, 181, 141, -1, -1, -1, 217, 77, -1, 85,
+  -1, -1, 160, -1, 9, 157, -1, -1, -1, -1, 56, -1,
+  219, 234, 218, -1, 209, -1, -1, -1, 24, -1, -1, 18,
+  216, -1, 161, 26, 170, 214, -1, 224, -1, -1, -1, -1,
+  -1, -1, 247, 3, 103, -1, -1, -1, 84, -1, -1, -1,
+  192, 22, -1, 169, -1, -1, -1, 64, 207, -1, 96, -1,
+  -1, -1, 222, 78, -1, 172, 137, -1, 163, -1, 188, -1,
+  -1, -1, 221, -1, -1, -1, 158, -1, -1, -1, 176, 149,
+  101, 118, -1, 80, -1, 226, 51, 246, 16, -1, 92, 225,
+  -1, -1, 65, 150, -1, 182, -1, 132, 31, -1, -1, 49,
+  21, -1, -1, -1, -1, -1, 211, -1, -1, 73, 1, 142,
+  -1, -1, 197, -1, -1, -1, 86, -1, -1, 110, -1, 166,
+  -1, 129, 37, 95, 193, 116, 39, 194, 61, -1, 107, 70,
+  -1, -1, 46, 183, 229, 249, 75, -1
+};
+
+
+// Color names from get_color() in "util.cxx" (19 names, case-insensitive)
+#define HD_COLOR_COUNT 19
+#define HD_COLOR_BUCKETS 6
+#define HD_COLOR_SLOTS 32
+
+static const unsigned short hd_color_disp[HD_COLOR_BUCKETS] =
+{
+  2, 2, 1, 12, 1, 1
+};
+static const short hd_color_slots[HD_COLOR_SLOTS] =
+{
+  -1, -1, 18, 5, -1, 8, -1, 2, 3, 15, 12, 0,
+  -1, -1, 13, -1, 9, -1, 10, -1, -1, 6, 1, 4,
+  7, 11, -1, 16, -1, -1, 14, 17
+};
+
+#endif // !_HTMLDOC_HASH_H_
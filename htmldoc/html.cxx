@@ -76,6 +76,8 @@ html_export(tree_t *document,	/* I - Document to export */
   FILE	*out;			/* Output file */
 
 
+  stats_begin(HD_STATS_WRITE);
+
  /*
   * Copy logo and title images...
   */
@@ -172,6 +174,7 @@ html_export(tree_t *document,	/* I - Document to export */
     fputs("</HTML>\n", out);
 
     progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(out));
+    stats_count(HD_COUNT_BYTES_OUT, ftell(out));
 
     fclose(out);
   }
@@ -188,6 +191,8 @@ html_export(tree_t *document,	/* I - Document to export */
     links       = NULL;
   }
 
+  stats_end(HD_STATS_WRITE);
+
   return (out == NULL);
 }
 
@@ -401,6 +406,7 @@ write_footer(FILE **out,	/* IO - Output file pointer */
     fputs("</HTML>\n", *out);
 
     progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(*out));
+    stats_count(HD_COUNT_BYTES_OUT, ftell(*out));
 
     fclose(*out);
     *out = NULL;
@@ -891,7 +897,11 @@ static void
 add_link(uchar *name,		/* I - Name of link */
          uchar *filename)	/* I - File for link */
 {
-  link_t	*temp;		/* New name */
+  link_t	*temp,		/* New name */
+		key;		/* New link */
+  size_t	left,		/* Left side of search */
+		right,		/* Right side of search */
+		mid;		/* Middle of search */
 
 
   if ((temp = find_link(name)) != NULL)
@@ -921,15 +931,24 @@ add_link(uchar *name,		/* I - Name of link */
       links = temp;
     }
 
-    // Add a new link...
-    temp = links + num_links;
-    num_links ++;
+    // Add a new link after any with the same name, keeping the array
+    // sorted...
+    strlcpy((char *)key.name, (char *)name, sizeof(key.name));
+    key.filename = filename;
 
-    strlcpy((char *)temp->name, (char *)name, sizeof(temp->name));
-    temp->filename = filename;
+    for (left = 0, right = num_links; left < right;)
+    {
+      mid = (left + right) / 2;
 
-    if (num_links > 1)
-      qsort(links, num_links, sizeof(link_t), (compare_func_t)compare_links);
+      if (compare_links(&key, links + mid) < 0)
+        right = mid;
+      else
+        left = mid + 1;
+    }
+
+    memmove(links + left + 1, links + left, (num_links - left) * sizeof(link_t));
+    links[left] = key;
+    num_links ++;
   }
 }
 
@@ -21,6 +21,7 @@
 #  include "file.h"
 #  include "hdstring.h"
 #  include "iso8859.h"
+#  include "thread.h"
 
 #  ifdef __cplusplus
 extern "C" {
@@ -259,6 +260,8 @@ typedef struct tree_str
 			height;		/* Height of this fragment in points */
   int			nvars;		/* Number of variables... */
   var_t			*vars;		/* Variables... */
+  int			nstyles;	/* Number of STYLE properties... */
+  var_t			*styles;	/* Parsed STYLE properties... */
 } tree_t;
 
 
@@ -266,9 +269,10 @@ typedef struct tree_str
  * Globals...
  */
 
-extern const char	*_htmlCurrentFile;
+extern HD_THREAD_LOCAL const char *_htmlCurrentFile;
 extern const char	*_htmlMarkups[];
 extern const char	*_htmlData;
+extern const char	*_htmlCharSetDir;
 extern float		_htmlPPI;
 extern int		_htmlGrayscale;
 extern uchar		_htmlTextColor[];
@@ -279,6 +283,7 @@ extern typeface_t	_htmlBodyFont,
 			_htmlHeadingFont;
 extern int		_htmlInitialized;
 extern char		_htmlCharSet[];
+extern hd_mutex_t	_htmlCharSetMutex;
 extern int		_htmlWidthsLoaded[TYPE_MAX][STYLE_MAX];
 extern short		_htmlWidths[TYPE_MAX][STYLE_MAX][256];
 extern short		_htmlWidthsAll[TYPE_MAX][STYLE_MAX][65536];
@@ -310,11 +315,13 @@ extern void	htmlFixLinks(tree_t *tree, uchar *base = 0);
 
 extern uchar	*htmlGetText(tree_t *tree);
 extern uchar	*htmlGetMeta(tree_t *tree, uchar *name);
+extern void	htmlIndexNode(tree_t *t);
 
 extern uchar	*htmlGetVariable(tree_t *t, uchar *name);
 extern int	htmlSetVariable(tree_t *t, uchar *name, uchar *value);
 
 extern uchar	*htmlGetStyle(tree_t *t, uchar *name);
+extern void	htmlParseStyle(tree_t *t);
 
 extern void	htmlSetBaseSize(double p, double s);
 extern void	htmlSetCharSet(const char *cs);
@@ -12,9 +12,7 @@
  * Include necessary headers.
  */
 
-#define _HTMLDOC_CXX_
 #include "htmldoc.h"
-#include "markdown.h"
 #include <cups/http.h>
 #include <ctype.h>
 #include <fcntl.h>
@@ -43,26 +41,13 @@ const char *__XOS2RedirRoot(const char *);
 #endif
 
 
-/*
- * Local types...
- */
-
-typedef int (*exportfunc_t)(tree_t *, tree_t *);
-
-
 /*
  * Local functions...
  */
 
 static int	compare_strings(const char *s, const char *t, int tmin);
 static double	get_seconds(void);
-static int	load_book(const char *filename, tree_t **document,
-		          exportfunc_t *exportfunc, int set_nolocal = 0);
-static void	parse_options(const char *line, exportfunc_t *exportfunc);
 static const char *prefs_getrc(void);
-static int	read_file(const char *filename, tree_t **document,
-		          const char *path);
-static void	set_permissions(const char *p);
 #ifndef WIN32
 extern "C" {
 static void	term_handler(int signum);
@@ -92,6 +77,10 @@ main(int  argc,				/* I - Number of command-line arguments */
 		load_time,		/* Load time */
 		end_time;		/* End time */
   const char	*debug;			/* HTMLDOC_DEBUG environment variable */
+  const char	*stats_file = NULL;	/* Statistics JSON file */
+  const char	*fastcgi = NULL;	/* FastCGI listen address */
+  int		fastcgi_workers = 0;	/* Number of FastCGI workers */
+  int		threads_set = 0;	/* Was --threads used? */
 
 
   start_time = get_seconds();
@@ -146,10 +135,6 @@ main(int  argc,				/* I - Number of command-line arguments */
   if (!getenv("HTMLDOC_NOCGI") && getenv("GATEWAY_INTERFACE") &&
       getenv("SERVER_NAME") && getenv("SERVER_SOFTWARE"))
   {
-    const char	*path_translated;	// PATH_TRANSLATED env var
-    char	bookfile[1024];		// Book filename
-
-
     // CGI mode implies the following options:
     //
     // --no-localfiles
@@ -161,21 +146,6 @@ main(int  argc,				/* I - Number of command-line arguments */
     // we load directory-specific options from the ".book" file in the
     // current web server directory...
 
-    CGIMode       = 1;
-    TocLevels     = 0;
-    TitlePage     = 0;
-    OutputPath[0] = '\0';
-    OutputType    = OUTPUT_WEBPAGES;
-    document      = NULL;
-    exportfunc    = (exportfunc_t)pspdf_export;
-    PSLevel       = 0;
-    PDFVersion    = 14;
-    PDFPageMode   = PDF_DOCUMENT;
-    PDFFirstPage  = PDF_PAGE_1;
-
-    file_cookies(getenv("HTTP_COOKIE"));
-    file_referer(getenv("HTTP_REFERER"));
-
     progress_error(HD_ERROR_NONE, "INFO: HTMLDOC " SVERSION " starting in CGI mode.");
 #ifdef WIN32
     progress_error(HD_ERROR_NONE, "INFO: TEMP is \"%s\"", getenv("TEMP"));
@@ -185,33 +155,7 @@ main(int  argc,				/* I - Number of command-line arguments */
 
     argc = 1;
 
-    // Look for a book file in the following order:
-    //
-    // $PATH_TRANSLATED.book
-    // `dirname $PATH_TRANSLATED`/.book
-    // .book
-    //
-    // If we find one, use it...
-    if ((path_translated = getenv("PATH_TRANSLATED")) != NULL)
-    {
-      // Try $PATH_TRANSLATED.book...
-      snprintf(bookfile, sizeof(bookfile), "%s.book", path_translated);
-      if (access(bookfile, 0))
-      {
-        // Not found, try `dirname $PATH_TRANSLATED`/.book
-        snprintf(bookfile, sizeof(bookfile), "%s/.book",
-	         file_directory(path_translated));
-        if (access(bookfile, 0))
-	  strlcpy(bookfile, ".book", sizeof(bookfile));
-      }
-    }
-    else
-      strlcpy(bookfile, ".book", sizeof(bookfile));
-
-    if (!access(bookfile, 0))
-      load_book(bookfile, &document, &exportfunc, 1);
-    else
-      file_nolocal();
+    cgi_setup(&document, &exportfunc);
   }
   else
 #endif // HAVE_LIBCUPS
@@ -230,6 +174,19 @@ main(int  argc,				/* I - Number of command-line arguments */
     prefs_load();
   }
 
+ /*
+  * Enable statistics before any files are read...
+  */
+
+  for (i = 1; i < (argc - 1); i ++)
+  {
+    if (compare_strings(argv[i], "--stats-json", 5) == 0)
+    {
+      stats_file = argv[++ i];
+      stats_enable();
+    }
+  }
+
  /*
   * Parse command-line options...
   */
@@ -245,6 +202,11 @@ main(int  argc,				/* I - Number of command-line arguments */
     printf("argv[%d] = \"%s\"\n", i, argv[i]);
 #endif // DEBUG
 
+    // Options only apply to the files that follow, so read any files before
+    // processing the next option...
+    if (argv[i][0] == '-')
+      read_files(&document);
+
     if (compare_strings(argv[i], "--batch", 4) == 0)
     {
       i ++;
@@ -322,6 +284,14 @@ main(int  argc,				/* I - Number of command-line arguments */
       else
         usage(argv[i - 1]);
     }
+    else if (compare_strings(argv[i], "--cache", 4) == 0)
+    {
+      i ++;
+      if (i < argc)
+        strlcpy(CacheDir, argv[i], sizeof(CacheDir));
+      else
+        usage(argv[i - 1]);
+    }
     else if (compare_strings(argv[i], "--charset", 4) == 0)
     {
       i ++;
@@ -342,6 +312,11 @@ main(int  argc,				/* I - Number of command-line arguments */
         Compression = atoi(argv[i] + 14);
       else if (PDFVersion >= 12)
         Compression = 1;
+
+      if (strlen(argv[i]) > 14)
+        EPUBCompression = atoi(argv[i] + 14);
+      else
+        EPUBCompression = 9;
     }
     else if (compare_strings(argv[i], "--continuous", 5) == 0)
     {
@@ -402,6 +377,22 @@ main(int  argc,				/* I - Number of command-line arguments */
       EmbedFonts = 1;
     else if (compare_strings(argv[i], "--encryption", 4) == 0)
       Encryption = 1;
+    else if (compare_strings(argv[i], "--fastcgi", 4) == 0)
+    {
+      i ++;
+      if (i < argc)
+        fastcgi = argv[i];
+      else
+        usage(argv[i - 1]);
+    }
+    else if (compare_strings(argv[i], "--fastcgi-workers", 11) == 0)
+    {
+      i ++;
+      if (i < argc && isdigit(argv[i][0] & 255))
+        fastcgi_workers = atoi(argv[i]);
+      else
+        usage(argv[i - 1]);
+    }
     else if (compare_strings(argv[i], "--firstpage", 4) == 0)
     {
       i ++;
@@ -825,6 +816,8 @@ main(int  argc,				/* I - Number of command-line arguments */
       OverflowErrors = 0;
     else if (compare_strings(argv[i], "--no-pscommands", 6) == 0)
       PSCommands = 0;
+    else if (compare_strings(argv[i], "--no-pscompression", 11) == 0)
+      PSCompression = 0;
     else if (compare_strings(argv[i], "--no-strict", 6) == 0)
       StrictHTML = 0;
     else if (compare_strings(argv[i], "--no-title", 7) == 0)
@@ -1000,6 +993,8 @@ main(int  argc,				/* I - Number of command-line arguments */
     }
     else if (compare_strings(argv[i], "--pscommands", 3) == 0)
       PSCommands = 1;
+    else if (compare_strings(argv[i], "--pscompression", 8) == 0)
+      PSCompression = 1;
     else if (compare_strings(argv[i], "--quiet", 3) == 0)
       Verbosity = -1;
     else if (!compare_strings(argv[i], "--referer", 4))
@@ -1026,6 +1021,13 @@ main(int  argc,				/* I - Number of command-line arguments */
       else
         usage(argv[i - 1]);
     }
+    else if (compare_strings(argv[i], "--stats-json", 5) == 0)
+    {
+      // Statistics were enabled before reading any files...
+      i ++;
+      if (i >= argc)
+        usage(argv[i - 1]);
+    }
     else if (compare_strings(argv[i], "--strict", 4) == 0)
       StrictHTML = 1;
     else if (compare_strings(argv[i], "--textcolor", 7) == 0)
@@ -1036,6 +1038,17 @@ main(int  argc,				/* I - Number of command-line arguments */
       else
         usage(argv[i - 1]);
     }
+    else if (compare_strings(argv[i], "--threads", 4) == 0)
+    {
+      i ++;
+      if (i < argc && isdigit(argv[i][0] & 255))
+      {
+        hd_thread_set_count(atoi(argv[i]));
+        threads_set = 1;
+      }
+      else
+        usage(argv[i - 1]);
+    }
     else if (compare_strings(argv[i], "--title", 7) == 0)
       TitlePage = 1;
     else if (compare_strings(argv[i], "--titlefile", 8) == 0 ||
@@ -1148,7 +1161,9 @@ main(int  argc,				/* I - Number of command-line arguments */
 #endif // WIN32 || __EMX__
 
       _htmlCurrentFile = "(stdin)";
+      stats_begin(HD_STATS_PARSE);
       htmlReadFile(file, stdin, ".");
+      stats_end(HD_STATS_PARSE);
 
       if (document == NULL)
         document = file;
@@ -1181,56 +1196,30 @@ main(int  argc,				/* I - Number of command-line arguments */
     {
       num_files ++;
 
-      read_file(argv[i], &document, Path);
+      add_file(argv[i], Path);
     }
   }
 
-#ifdef HAVE_LIBCUPS
-  if (CGIMode)
+  if (fastcgi)
   {
-    char	url[1024];		// URL
-    const char	*https,			// HTTPS env var, if any
-		*path_info,		// Path info, if any
-		*query,			// Query string, if any
-		*server_name,		// Server name
-		*server_port;		// Server port
-
+    if (num_files > 0)
+      usage("Input files cannot be used with --fastcgi.");
 
-    https       = getenv("HTTPS");
-    path_info   = getenv("PATH_INFO");
-    query       = getenv("QUERY_STRING");
-    server_name = getenv("SERVER_NAME");
-    server_port = getenv("SERVER_PORT");
+    // Each worker process formats one request at a time, so only use more
+    // threads per request when asked...
+    if (!threads_set)
+      hd_thread_set_count(1);
 
-    if (server_port && path_info && *path_info)
-    {
-      // Read the referenced file from the local server...
-      if (https && strcmp(https, "off"))
-	httpAssembleURI(HTTP_URI_CODING_ALL, url, sizeof(url), "https",
-	                NULL, server_name, atoi(server_port), path_info);
-      else
-	httpAssembleURI(HTTP_URI_CODING_ALL, url, sizeof(url), "http",
-	                NULL, server_name, atoi(server_port), path_info);
-
-      if (query && *query && *query != '-')
-      {
-	// Include query string on end of URL, which is already URI encoded...
-        strlcat(url, "?", sizeof(url));
-	strlcat(url, query, sizeof(url));
-      }
-
-      progress_error(HD_ERROR_NONE, "INFO: HTMLDOC converting '%s'.", url);
-
-      num_files ++;
-
-      read_file(url, &document, Path);
-    }
-    else
-      progress_error(HD_ERROR_FILE_NOT_FOUND,
-                     "PATH_INFO is not set in the environment.");
+    return (fastcgi_run(fastcgi, fastcgi_workers));
   }
+
+#ifdef HAVE_LIBCUPS
+  if (CGIMode && cgi_add_url())
+    num_files ++;
 #endif // HAVE_LIBCUPS
 
+  read_files(&document);
+
  /*
   * Display the GUI if necessary...
   */
@@ -1268,7 +1257,9 @@ main(int  argc,				/* I - Number of command-line arguments */
     document = document->prev;
 
   // Fix links...
+  stats_begin(HD_STATS_PARSE);
   htmlFixLinks(document);
+  stats_end(HD_STATS_PARSE);
 
   load_time = get_seconds();
 
@@ -1279,6 +1270,8 @@ main(int  argc,				/* I - Number of command-line arguments */
   * Build a table of contents for the documents if necessary...
   */
 
+  stats_begin(HD_STATS_TOC);
+
   if (OutputType == OUTPUT_BOOK && TocLevels > 0)
   {
     toc = toc_build(document);
@@ -1291,6 +1284,8 @@ main(int  argc,				/* I - Number of command-line arguments */
     toc = NULL;
   }
 
+  stats_end(HD_STATS_TOC);
+
   htmlDebugStats("Table of Contents Tree", toc);
 
  /*
@@ -1311,6 +1306,9 @@ main(int  argc,				/* I - Number of command-line arguments */
                    load_time - start_time, end_time - load_time,
 		   end_time - start_time);
 
+  if (stats_file)
+    stats_write(stats_file, end_time - start_time);
+
  /*
   * Cleanup...
   */
@@ -1475,6 +1473,8 @@ prefs_load(void)
 	PSLevel = atoi(line + 8);
       else if (strncasecmp(line, "PSCOMMANDS=", 11) == 0)
 	PSCommands = atoi(line + 11);
+      else if (strncasecmp(line, "PSCOMPRESSION=", 14) == 0)
+	PSCompression = atoi(line + 14);
       else if (strncasecmp(line, "XRXCOMMENTS=", 12) == 0)
 	XRXComments = atoi(line + 12);
       else if (strncasecmp(line, "CHARSET=", 8) == 0)
@@ -1604,6 +1604,7 @@ prefs_save(void)
     fprintf(fp, "PDFVERSION=%d\n", PDFVersion);
     fprintf(fp, "PSLEVEL=%d\n", PSLevel);
     fprintf(fp, "PSCOMMANDS=%d\n", PSCommands);
+    fprintf(fp, "PSCOMPRESSION=%d\n", PSCompression);
     fprintf(fp, "XRXCOMMENTS=%d\n", XRXComments);
     fprintf(fp, "CHARSET=%s\n", _htmlCharSet);
     fprintf(fp, "PAGEMODE=%d\n", PDFPageMode);
@@ -1749,6 +1750,9 @@ prefs_set_paths(void)
   if (getenv("HTMLDOC_DATA") != NULL)
     _htmlData = getenv("HTMLDOC_DATA");
 
+  if (getenv("HTMLDOC_CHARSETS") != NULL)
+    _htmlCharSetDir = getenv("HTMLDOC_CHARSETS");
+
 #ifdef HAVE_LIBFLTK
   if (getenv("HTMLDOC_HELP") != NULL)
     GUI::help_dir = getenv("HTMLDOC_HELP");
@@ -1756,836 +1760,158 @@ prefs_set_paths(void)
 }
 
 
+#ifdef HAVE_LIBCUPS
 /*
- * 'compare_strings()' - Compare two command-line strings.
- */
-
-static int				/* O - -1 or 1 = no match, 0 = match */
-compare_strings(const char *s,		/* I - Command-line string */
-                const char *t,		/* I - Option string */
-                int        tmin)	/* I - Minimum number of unique chars in option */
-{
-  size_t	slen;			/* Length of command-line string */
-
-
-  slen = strlen(s);
-  if (slen < (size_t)tmin)
-    return (-1);
-  else
-    return (strncmp(s, t, slen));
-}
-
-
-/*
- * 'get_seconds()' - Get the current fractional time in seconds.
+ * 'cgi_add_url()' - Add the page for a CGI request.
+ *
+ * The page is read from the local web server using the PATH_INFO and
+ * QUERY_STRING environment variables.
  */
 
-static double				/* O - Number of seconds */
-get_seconds(void)
+int					// O - 1 if added, 0 on error
+cgi_add_url(void)
 {
-#ifdef WIN32
-  return (GetTickCount() * 0.001);
-#else
-  struct timeval	curtime;	/* Current time */
-
-  gettimeofday(&curtime, NULL);
-
-  return (curtime.tv_sec + curtime.tv_usec * 0.000001);
-#endif /* WIN32 */
-}
-
-
-//
-// 'load_book()' - Load a book file...
-//
-
-static int				// O  - 1 = success, 0 = failure
-load_book(const char   *filename,	// I  - Book file
-          tree_t       **document,	// IO - Document tree
-          exportfunc_t *exportfunc,	// O  - Export function
-          int          set_nolocal)	// I  - Set file_nolocal() after lookup?
-{
-  FILE		*fp;			// File to read from
-  char		line[10240];		// Line from file
-  const char 	*dir;			// Directory
-  const char	*local;			// Local filename
-  char		path[2048];		// Current path
-
-
-  // See if the filename contains a path...
-  dir = file_directory(filename);
-
-  if (dir != NULL)
-    snprintf(path, sizeof(path), "%s;%s", dir, Path);
-  else
-    strlcpy(path, Path, sizeof(path));
-
-  // Open the file...
-  local = file_find(Path, filename);
+  char		url[1024];		// URL
+  const char	*https,			// HTTPS env var, if any
+		*path_info,		// Path info, if any
+		*query,			// Query string, if any
+		*server_name,		// Server name
+		*server_port;		// Server port
 
-  if (set_nolocal)
-    file_nolocal();
 
-  if (!local)
-    return (0);
+  https       = getenv("HTTPS");
+  path_info   = getenv("PATH_INFO");
+  query       = getenv("QUERY_STRING");
+  server_name = getenv("SERVER_NAME");
+  server_port = getenv("SERVER_PORT");
 
-  if ((fp = fopen(local, "rb")) == NULL)
+  if (!server_port || !path_info || !*path_info)
   {
-    progress_error(HD_ERROR_READ_ERROR, "Unable to open book file '%s': %s", local, strerror(errno));
+    progress_error(HD_ERROR_FILE_NOT_FOUND,
+                   "PATH_INFO is not set in the environment.");
     return (0);
   }
 
-  // Get the header...
-  file_gets(line, sizeof(line), fp);
-  if (strncmp(line, "#HTMLDOC", 8) != 0)
-  {
-    fclose(fp);
-    progress_error(HD_ERROR_BAD_FORMAT, "Bad or missing #HTMLDOC header in '%s'.", filename);
-    return (0);
-  }
+  // Read the referenced file from the local server...
+  if (https && strcmp(https, "off"))
+    httpAssembleURI(HTTP_URI_CODING_ALL, url, sizeof(url), "https",
+                    NULL, server_name, atoi(server_port), path_info);
+  else
+    httpAssembleURI(HTTP_URI_CODING_ALL, url, sizeof(url), "http",
+                    NULL, server_name, atoi(server_port), path_info);
 
-  // Read the second line from the book file; for older book files, this will
-  // be the file count; for new files this will be the options...
-  do
+  if (query && *query && *query != '-')
   {
-    file_gets(line, sizeof(line), fp);
-
-    if (line[0] == '-')
-    {
-      parse_options(line, exportfunc);
-
-      if (dir != NULL)
-	snprintf(path, sizeof(path), "%s;%s", dir, Path);
-      else
-	strlcpy(path, Path, sizeof(path));
-    }
+    // Include query string on end of URL, which is already URI encoded...
+    strlcat(url, "?", sizeof(url));
+    strlcat(url, query, sizeof(url));
   }
-  while (!line[0]);			// Skip blank lines
 
-  // Get input files/options...
-  while (file_gets(line, sizeof(line), fp) != NULL)
-  {
-    if (!line[0])
-      continue;				// Skip blank lines
-    else if (line[0] == '-')
-    {
-      parse_options(line, exportfunc);
+  progress_error(HD_ERROR_NONE, "INFO: HTMLDOC converting '%s'.", url);
 
-      if (dir != NULL)
-	snprintf(path, sizeof(path), "%s;%s", dir, Path);
-      else
-	strlcpy(path, Path, sizeof(path));
-    }
-    else if (line[0] == '\\')
-      read_file(line + 1, document, path);
-    else
-      read_file(line, document, path);
-  }
-
-  // Close the book file and return...
-  fclose(fp);
+  add_file(url, Path);
 
   return (1);
 }
 
 
-//
-// 'parse_options()' - Parse options from a book file...
-//
+/*
+ * 'cgi_setup()' - Set the options for a CGI request.
+ *
+ * Directory-specific options are loaded from a ".book" file, and access to
+ * local files is disabled afterwards.
+ */
 
-static void
-parse_options(const char   *line,	// I - Options from book file
-              exportfunc_t *exportfunc)	// O - Export function
+void
+cgi_setup(tree_t       **document,	// O - Document tree
+          exportfunc_t *exportfunc)	// O - Export function
 {
-  int		i;			// Looping var
-  const char	*lineptr;		// Pointer into line
-  char		temp[1024],		// Option name
-		temp2[1024],		// Option value
-		*tempptr;		// Pointer into option
-  double	fontsize,		// Size of body text
-		fontspacing;		// Spacing between lines
-
-
-  // Parse the input line...
-  for (lineptr = line; *lineptr != '\0';)
+  const char	*path_translated;	// PATH_TRANSLATED env var
+  char		bookfile[1024];		// Book filename
+
+
+  CGIMode       = 1;
+  TocLevels     = 0;
+  TitlePage     = 0;
+  OutputPath[0] = '\0';
+  OutputType    = OUTPUT_WEBPAGES;
+  *document     = NULL;
+  *exportfunc   = (exportfunc_t)pspdf_export;
+  PSLevel       = 0;
+  PDFVersion    = 14;
+  PDFPageMode   = PDF_DOCUMENT;
+  PDFFirstPage  = PDF_PAGE_1;
+
+  file_cookies(getenv("HTTP_COOKIE"));
+  file_referer(getenv("HTTP_REFERER"));
+
+  // Look for a book file in the following order:
+  //
+  // $PATH_TRANSLATED.book
+  // `dirname $PATH_TRANSLATED`/.book
+  // .book
+  //
+  // If we find one, use it...
+  if ((path_translated = getenv("PATH_TRANSLATED")) != NULL)
   {
-    while (*lineptr == ' ')
-      lineptr ++;
-
-    for (tempptr = temp; *lineptr != '\0' && *lineptr != ' '; lineptr ++)
-      if (tempptr < (temp + sizeof(temp) - 1))
-        *tempptr++ = *lineptr;
-
-    *tempptr = '\0';
-
-    while (*lineptr == ' ')
-      lineptr ++;
-
-    if (strcmp(temp, "--duplex") == 0)
-    {
-      PageDuplex = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--landscape") == 0)
-    {
-      Landscape = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--portrait") == 0)
-    {
-      Landscape = 0;
-      continue;
-    }
-    else if (strncmp(temp, "--jpeg", 6) == 0)
-    {
-      if (strlen(temp) > 7)
-        OutputJPEG = atoi(temp + 7);
-      else
-        OutputJPEG = 90;
-      continue;
-    }
-    else if (strcmp(temp, "--grayscale") == 0)
-    {
-      OutputColor = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--color") == 0)
-    {
-      OutputColor = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--links") == 0)
-    {
-      Links = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-links") == 0)
-    {
-      Links = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--embedfonts") == 0 ||
-             strcmp(temp, "--truetype") == 0)
-    {
-      EmbedFonts = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-embedfonts") == 0 ||
-             strcmp(temp, "--no-truetype") == 0)
-    {
-      EmbedFonts = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--pscommands") == 0)
+    // Try $PATH_TRANSLATED.book...
+    snprintf(bookfile, sizeof(bookfile), "%s.book", path_translated);
+    if (access(bookfile, 0))
     {
-      PSCommands = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-pscommands") == 0)
-    {
-      PSCommands = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--xrxcomments") == 0)
-    {
-      XRXComments = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-xrxcomments") == 0)
-    {
-      XRXComments = 0;
-      continue;
-    }
-    else if (strncmp(temp, "--compression", 13) == 0)
-    {
-      if (strlen(temp) > 14)
-        Compression = atoi(temp + 14);
-      else
-        Compression = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-compression") == 0)
-    {
-      Compression = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--no-jpeg") == 0)
-    {
-      OutputJPEG = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--numbered") == 0)
-    {
-      TocNumbers = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-numbered") == 0)
-    {
-      TocNumbers = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--no-toc") == 0)
-    {
-      TocLevels = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--title") == 0)
-    {
-      TitlePage = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-title") == 0)
-    {
-      TitlePage = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--book") == 0)
-    {
-      OutputType = OUTPUT_BOOK;
-      continue;
-    }
-    else if (strcmp(temp, "--continuous") == 0)
-    {
-      OutputType = OUTPUT_CONTINUOUS;
-      continue;
-    }
-    else if (strcmp(temp, "--webpage") == 0)
-    {
-      OutputType = OUTPUT_WEBPAGES;
-      continue;
-    }
-    else if (strcmp(temp, "--encryption") == 0)
-    {
-      Encryption = 1;
-      continue;
-    }
-    else if (strcmp(temp, "--no-encryption") == 0)
-    {
-      Encryption = 0;
-      continue;
-    }
-    else if (strcmp(temp, "--strict") == 0)
-      StrictHTML = 1;
-    else if (strcmp(temp, "--no-strict") == 0)
-      StrictHTML = 0;
-    else if (strcmp(temp, "--overflow") == 0)
-      OverflowErrors = 1;
-    else if (strcmp(temp, "--no-overflow") == 0)
-      OverflowErrors = 0;
-
-    if (*lineptr == '\"')
-    {
-      lineptr ++;
-
-      for (tempptr = temp2; *lineptr != '\0' && *lineptr != '\"'; lineptr ++)
-        if (tempptr < (temp2 + sizeof(temp2) - 1))
-	  *tempptr++ = *lineptr;
-
-      if (*lineptr == '\"')
-        lineptr ++;
-    }
-    else
-    {
-      for (tempptr = temp2; *lineptr != '\0' && *lineptr != ' '; lineptr ++)
-        if (tempptr < (temp2 + sizeof(temp2) - 1))
-	  *tempptr++ = *lineptr;
-    }
-
-    *tempptr = '\0';
-
-    if (strcmp(temp, "-t") == 0 && !CGIMode)
-    {
-      if (strcmp(temp2, "epub") == 0)
-        *exportfunc = (exportfunc_t)epub_export;
-      else if (strcmp(temp2, "html") == 0)
-        *exportfunc = (exportfunc_t)html_export;
-      else if (strcmp(temp2, "htmlsep") == 0)
-        *exportfunc = (exportfunc_t)htmlsep_export;
-      else if (strcmp(temp2, "pdf11") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 0;
-	PDFVersion  = 11;
-      }
-      else if (strcmp(temp2, "pdf12") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 0;
-	PDFVersion  = 12;
-      }
-      else if (strcmp(temp2, "pdf13") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 0;
-	PDFVersion  = 13;
-      }
-      else if (strcmp(temp2, "pdf") == 0 ||
-               strcmp(temp2, "pdf14") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 0;
-	PDFVersion  = 14;
-      }
-      else if (strcmp(temp2, "ps1") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 1;
-      }
-      else if (strcmp(temp2, "ps") == 0 ||
-               strcmp(temp2, "ps2") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 2;
-      }
-      else if (strcmp(temp2, "ps3") == 0)
-      {
-        *exportfunc = (exportfunc_t)pspdf_export;
-	PSLevel     = 3;
-      }
-    }
-    else if (strcmp(temp, "--letterhead") == 0)
-      strlcpy(Letterhead, temp2, sizeof(Letterhead));
-    else if (strcmp(temp, "--logo") == 0 ||
-             strcmp(temp, "--logoimage") == 0)
-      strlcpy(LogoImage, temp2, sizeof(LogoImage));
-    else if (strcmp(temp, "--titlefile") == 0 ||
-             strcmp(temp, "--titleimage") == 0)
-    {
-      TitlePage = 1;
-      strlcpy(TitleImage, temp2, sizeof(TitleImage));
-    }
-    else if (strcmp(temp, "-f") == 0 && !CGIMode)
-    {
-      OutputFiles = 0;
-      strlcpy(OutputPath, temp2, sizeof(OutputPath));
-    }
-    else if (strcmp(temp, "-d") == 0 && !CGIMode)
-    {
-      OutputFiles = 1;
-      strlcpy(OutputPath, temp2, sizeof(OutputPath));
-    }
-    else if (strcmp(temp, "--browserwidth") == 0)
-      _htmlBrowserWidth = atof(temp2);
-    else if (strcmp(temp, "--nup") == 0)
-      NumberUp = atoi(temp2);
-    else if (strcmp(temp, "--size") == 0)
-      set_page_size(temp2);
-    else if (strcmp(temp, "--left") == 0)
-      PageLeft = get_measurement(temp2);
-    else if (strcmp(temp, "--right") == 0)
-      PageRight = get_measurement(temp2);
-    else if (strcmp(temp, "--top") == 0)
-      PageTop = get_measurement(temp2);
-    else if (strcmp(temp, "--bottom") == 0)
-      PageBottom = get_measurement(temp2);
-    else if (strcmp(temp, "--pre-indent") == 0)
-      PreIndent = get_measurement(temp2);
-    else if (strcmp(temp, "--header") == 0)
-      get_format(temp2, Header);
-    else if (strcmp(temp, "--header1") == 0)
-      get_format(temp2, Header1);
-    else if (strcmp(temp, "--footer") == 0)
-      get_format(temp2, Footer);
-    else if (strcmp(temp, "--bodycolor") == 0)
-      strlcpy(BodyColor, temp2, sizeof(BodyColor));
-    else if (strcmp(temp, "--bodyimage") == 0)
-      strlcpy(BodyImage, temp2, sizeof(BodyImage));
-    else if (strcmp(temp, "--textcolor") == 0)
-      htmlSetTextColor((uchar *)temp2);
-    else if (strcmp(temp, "--linkcolor") == 0)
-      strlcpy(LinkColor, temp2, sizeof(LinkColor));
-    else if (strcmp(temp, "--linkstyle") == 0)
-    {
-      if (strcmp(temp2, "plain") == 0)
-        LinkStyle = 0;
-      else
-        LinkStyle = 1;
-    }
-    else if (strcmp(temp, "--toclevels") == 0)
-      TocLevels = atoi(temp2);
-    else if (strcmp(temp, "--tocheader") == 0)
-      get_format(temp2, TocHeader);
-    else if (strcmp(temp, "--tocfooter") == 0)
-      get_format(temp2, TocFooter);
-    else if (strcmp(temp, "--toctitle") == 0)
-      strlcpy(TocTitle, temp2, sizeof(TocTitle));
-    else if (strcmp(temp, "--fontsize") == 0)
-    {
-      fontsize    = atof(temp2);
-      fontspacing = _htmlSpacings[SIZE_P] / _htmlSizes[SIZE_P];
-
-      if (fontsize < 4.0f)
-        fontsize = 4.0f;
-      else if (fontsize > 24.0f)
-        fontsize = 24.0f;
-
-      htmlSetBaseSize(fontsize, fontspacing);
-    }
-    else if (strcmp(temp, "--fontspacing") == 0)
-    {
-      fontsize    = _htmlSizes[SIZE_P];
-      fontspacing = atof(temp2);
-
-      if (fontspacing < 1.0f)
-        fontspacing = 1.0f;
-      else if (fontspacing > 3.0f)
-        fontspacing = 3.0f;
-
-      htmlSetBaseSize(fontsize, fontspacing);
-    }
-    else if (!strcmp(temp, "--headingfont"))
-    {
-      if (!strcasecmp(temp2, "courier"))
-	_htmlHeadingFont = TYPE_COURIER;
-      else if (!strcasecmp(temp2, "times"))
-	_htmlHeadingFont = TYPE_TIMES;
-      else if (!strcasecmp(temp2, "helvetica") ||
-	       !strcasecmp(temp2, "arial"))
-	_htmlHeadingFont = TYPE_HELVETICA;
-      else if (!strcasecmp(temp2, "monospace"))
-	_htmlHeadingFont = TYPE_MONOSPACE;
-      else if (!strcasecmp(temp2, "serif"))
-	_htmlHeadingFont = TYPE_SERIF;
-      else if (!strcasecmp(temp2, "sans"))
-	_htmlHeadingFont = TYPE_SANS_SERIF;
-    }
-    else if (!strcmp(temp, "--bodyfont"))
-    {
-      if (!strcasecmp(temp2, "monospace"))
-	_htmlBodyFont = TYPE_MONOSPACE;
-      else if (!strcasecmp(temp2, "serif"))
-	_htmlBodyFont = TYPE_SERIF;
-      else if (!strcasecmp(temp2, "sans"))
-	_htmlBodyFont = TYPE_SANS_SERIF;
-      else if (!strcasecmp(temp2, "courier"))
-	_htmlBodyFont = TYPE_COURIER;
-      else if (!strcasecmp(temp2, "times"))
-	_htmlBodyFont = TYPE_TIMES;
-      else if (!strcasecmp(temp2, "helvetica") ||
-	       !strcasecmp(temp2, "arial"))
-	_htmlBodyFont = TYPE_HELVETICA;
-    }
-    else if (strcmp(temp, "--headfootsize") == 0)
-      HeadFootSize = atof(temp2);
-    else if (!strcmp(temp, "--headfootfont"))
-    {
-      if (!strcasecmp(temp2, "courier"))
-      {
-	HeadFootType  = TYPE_COURIER;
-	HeadFootStyle = STYLE_NORMAL;
-      }
-      else if (!strcasecmp(temp2, "courier-bold"))
-      {
-	HeadFootType  = TYPE_COURIER;
-	HeadFootStyle = STYLE_BOLD;
-      }
-      else if (!strcasecmp(temp2, "courier-oblique"))
-      {
-	HeadFootType  = TYPE_COURIER;
-	HeadFootStyle = STYLE_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "courier-boldoblique"))
-      {
-	HeadFootType  = TYPE_COURIER;
-	HeadFootStyle = STYLE_BOLD_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "times") ||
-	       !strcasecmp(temp2, "times-roman"))
-      {
-	HeadFootType  = TYPE_TIMES;
-	HeadFootStyle = STYLE_NORMAL;
-      }
-      else if (!strcasecmp(temp2, "times-bold"))
-      {
-	HeadFootType  = TYPE_TIMES;
-	HeadFootStyle = STYLE_BOLD;
-      }
-      else if (!strcasecmp(temp2, "times-italic"))
-      {
-	HeadFootType  = TYPE_TIMES;
-	HeadFootStyle = STYLE_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "times-bolditalic"))
-      {
-	HeadFootType  = TYPE_TIMES;
-	HeadFootStyle = STYLE_BOLD_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "helvetica"))
-      {
-	HeadFootType  = TYPE_HELVETICA;
-	HeadFootStyle = STYLE_NORMAL;
-      }
-      else if (!strcasecmp(temp2, "helvetica-bold"))
-      {
-	HeadFootType  = TYPE_HELVETICA;
-	HeadFootStyle = STYLE_BOLD;
-      }
-      else if (!strcasecmp(temp2, "helvetica-oblique"))
-      {
-	HeadFootType  = TYPE_HELVETICA;
-	HeadFootStyle = STYLE_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "helvetica-boldoblique"))
-      {
-	HeadFootType  = TYPE_HELVETICA;
-	HeadFootStyle = STYLE_BOLD_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "monospace"))
-      {
-	HeadFootType  = TYPE_MONOSPACE;
-	HeadFootStyle = STYLE_NORMAL;
-      }
-      else if (!strcasecmp(temp2, "monospace-bold"))
-      {
-	HeadFootType  = TYPE_MONOSPACE;
-	HeadFootStyle = STYLE_BOLD;
-      }
-      else if (!strcasecmp(temp2, "monospace-oblique"))
-      {
-	HeadFootType  = TYPE_MONOSPACE;
-	HeadFootStyle = STYLE_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "monospace-boldoblique"))
-      {
-	HeadFootType  = TYPE_MONOSPACE;
-	HeadFootStyle = STYLE_BOLD_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "serif") ||
-	       !strcasecmp(temp2, "serif-roman"))
-      {
-	HeadFootType  = TYPE_SERIF;
-	HeadFootStyle = STYLE_NORMAL;
-      }
-      else if (!strcasecmp(temp2, "serif-bold"))
-      {
-	HeadFootType  = TYPE_SERIF;
-	HeadFootStyle = STYLE_BOLD;
-      }
-      else if (!strcasecmp(temp2, "serif-italic"))
-      {
-	HeadFootType  = TYPE_SERIF;
-	HeadFootStyle = STYLE_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "serif-bolditalic"))
-      {
-	HeadFootType  = TYPE_SERIF;
-	HeadFootStyle = STYLE_BOLD_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "sans"))
-      {
-	HeadFootType  = TYPE_SANS_SERIF;
-	HeadFootStyle = STYLE_NORMAL;
-      }
-      else if (!strcasecmp(temp2, "sans-bold"))
-      {
-	HeadFootType  = TYPE_SANS_SERIF;
-	HeadFootStyle = STYLE_BOLD;
-      }
-      else if (!strcasecmp(temp2, "sans-oblique"))
-      {
-	HeadFootType  = TYPE_SANS_SERIF;
-	HeadFootStyle = STYLE_ITALIC;
-      }
-      else if (!strcasecmp(temp2, "sans-boldoblique"))
-      {
-	HeadFootType  = TYPE_SANS_SERIF;
-	HeadFootStyle = STYLE_BOLD_ITALIC;
-      }
-    }
-    else if (strcmp(temp, "--charset") == 0)
-      htmlSetCharSet(temp2);
-    else if (strcmp(temp, "--pagemode") == 0)
-    {
-      for (i = 0; i < (int)(sizeof(PDFModes) / sizeof(PDFModes[0])); i ++)
-        if (strcasecmp(temp2, PDFModes[i]) == 0)
-	{
-	  PDFPageMode = i;
-	  break;
-	}
-    }
-    else if (strcmp(temp, "--pagelayout") == 0)
-    {
-      for (i = 0; i < (int)(sizeof(PDFLayouts) / sizeof(PDFLayouts[0])); i ++)
-        if (strcasecmp(temp2, PDFLayouts[i]) == 0)
-	{
-	  PDFPageLayout = i;
-	  break;
-	}
-    }
-    else if (strcmp(temp, "--firstpage") == 0)
-    {
-      for (i = 0; i < (int)(sizeof(PDFPages) / sizeof(PDFPages[0])); i ++)
-        if (strcasecmp(temp2, PDFPages[i]) == 0)
-	{
-	  PDFFirstPage = i;
-	  break;
-	}
-    }
-    else if (strcmp(temp, "--pageeffect") == 0)
-    {
-      for (i = 0; i < (int)(sizeof(PDFEffects) / sizeof(PDFEffects[0])); i ++)
-        if (strcasecmp(temp2, PDFEffects[i]) == 0)
-	{
-	  PDFEffect = i;
-	  break;
-	}
+      // Not found, try `dirname $PATH_TRANSLATED`/.book
+      snprintf(bookfile, sizeof(bookfile), "%s/.book",
+	       file_directory(path_translated));
+      if (access(bookfile, 0))
+	strlcpy(bookfile, ".book", sizeof(bookfile));
     }
-    else if (strcmp(temp, "--pageduration") == 0)
-      PDFPageDuration = atof(temp2);
-    else if (strcmp(temp, "--effectduration") == 0)
-      PDFEffectDuration = atof(temp2);
-    else if (strcmp(temp, "--permissions") == 0)
-      set_permissions(temp2);
-    else if (strcmp(temp, "--user-password") == 0)
-      strlcpy(UserPassword, temp2, sizeof(UserPassword));
-    else if (strcmp(temp, "--owner-password") == 0)
-      strlcpy(OwnerPassword, temp2, sizeof(OwnerPassword));
-    else if (strcmp(temp, "--path") == 0)
-      strlcpy(Path, temp2, sizeof(Path) - 1);
-    else if (strcmp(temp, "--proxy") == 0)
-    {
-      strlcpy(Proxy, temp2, sizeof(Proxy));
-      file_proxy(Proxy);
-    }
-    else if (strcmp(temp, "--cookies") == 0)
-      file_cookies(temp2);
   }
+  else
+    strlcpy(bookfile, ".book", sizeof(bookfile));
+
+  if (!access(bookfile, 0))
+    load_book(bookfile, document, exportfunc, 1);
+  else
+    file_nolocal();
 }
+#endif // HAVE_LIBCUPS
 
 
-//
-// 'read_file()' - Read a file into the current document.
-//
+/*
+ * 'compare_strings()' - Compare two command-line strings.
+ */
 
-static int				// O  - 1 on success, 0 on failure
-read_file(const char *filename,		// I  - File/URL to read
-          tree_t     **document,	// IO - Current document
-	  const char *path)		// I  - Search path
+static int				/* O - -1 or 1 = no match, 0 = match */
+compare_strings(const char *s,		/* I - Command-line string */
+                const char *t,		/* I - Option string */
+                int        tmin)	/* I - Minimum number of unique chars in option */
 {
-  FILE		*docfile;		// Document file
-  tree_t	*file;			// HTML document file
-  const char	*realname,		// Real name of file
-		*ext;			// Extension of filename
-  char		base[1024];		// Base directory name of file
-
-
-  DEBUG_printf(("read_file(filename=\"%s\", document=%p, path=\"%s\")\n", filename, (void *)document, path));
-
-  if ((realname = file_find(path, filename)) != NULL)
-  {
-    if ((docfile = fopen(realname, "rb")) != NULL)
-    {
-      // Prepare to read the file...
-      if (Verbosity > 0)
-        progress_error(HD_ERROR_NONE, "INFO: Reading %s...", filename);
-
-      _htmlPPI = 72.0f * _htmlBrowserWidth / (PageWidth - PageLeft - PageRight);
-
-      strlcpy(base, file_directory(filename), sizeof(base));
-      ext = file_extension(filename);
-
-      file = htmlAddTree(NULL, MARKUP_FILE, NULL);
-      htmlSetVariable(file, (uchar *)"_HD_URL", (uchar *)filename);
-      htmlSetVariable(file, (uchar *)"_HD_FILENAME", (uchar *)file_basename(filename));
-      htmlSetVariable(file, (uchar *)"_HD_BASE", (uchar *)base);
-
-      if (ext && !strcmp(ext, "md"))
-      {
-        // Read markdown from a file...
-        mdReadFile(file, docfile, base);
-      }
-      else
-      {
-        // Read HTML from a file...
-        _htmlCurrentFile = filename;
-        htmlReadFile(file, docfile, base);
-      }
-
-      fclose(docfile);
+  size_t	slen;			/* Length of command-line string */
 
-      if (*document == NULL)
-        *document = file;
-      else
-      {
-        while ((*document)->next != NULL)
-          *document = (*document)->next;
 
-        (*document)->next = file;
-        file->prev        = *document;
-      }
-    }
-    else
-    {
-      file = NULL;
-      progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open '%s' for reading.", filename);
-    }
-  }
+  slen = strlen(s);
+  if (slen < (size_t)tmin)
+    return (-1);
   else
-  {
-    file = NULL;
-    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find '%s'.", filename);
-  }
-
-  return (file != NULL);
+    return (strncmp(s, t, slen));
 }
 
 
-//
-// 'set_permissions()' - Set the PDF permission bits.
-//
+/*
+ * 'get_seconds()' - Get the current fractional time in seconds.
+ */
 
-void
-set_permissions(const char *p)		// I - Permission string
+static double				/* O - Number of seconds */
+get_seconds(void)
 {
-  char	*copyp,				// Copy of string
-	*start,				// Start of current keyword
-	*ptr;				// Pointer into string
-
-
-  // Range check input...
-  if (!p || !*p)
-    return;
-
-  // Make a copy of the string and parse it...
-  copyp = strdup(p);
-  if (!copyp)
-    return;
-
-  for (start = copyp; *start; start = ptr)
-  {
-    for (ptr = start; *ptr; ptr ++)
-      if (*ptr == ',')
-      {
-	*ptr++ = '\0';
-	break;
-      }
-
-    if (!strcasecmp(start, "all"))
-      Permissions = -4;
-    else if (!strcasecmp(start, "none"))
-      Permissions = -64;
-    else if (!strcasecmp(start, "print"))
-      Permissions |= PDF_PERM_PRINT;
-    else if (!strcasecmp(start, "no-print"))
-      Permissions &= ~PDF_PERM_PRINT;
-    else if (!strcasecmp(start, "modify"))
-      Permissions |= PDF_PERM_MODIFY;
-    else if (!strcasecmp(start, "no-modify"))
-      Permissions &= ~PDF_PERM_MODIFY;
-    else if (!strcasecmp(start, "copy"))
-      Permissions |= PDF_PERM_COPY;
-    else if (!strcasecmp(start, "no-copy"))
-      Permissions &= ~PDF_PERM_COPY;
-    else if (!strcasecmp(start, "annotate"))
-      Permissions |= PDF_PERM_ANNOTATE;
-    else if (!strcasecmp(start, "no-annotate"))
-      Permissions &= ~PDF_PERM_ANNOTATE;
-  }
+#ifdef WIN32
+  return (GetTickCount() * 0.001);
+#else
+  struct timeval	curtime;	/* Current time */
 
-  if (Permissions != -4)
-    Encryption = 1;
+  gettimeofday(&curtime, NULL);
 
-  free(copyp);
+  return (curtime.tv_sec + curtime.tv_usec * 0.000001);
+#endif /* WIN32 */
 }
 
 
@@ -2661,6 +1987,7 @@ usage(const char *arg)			// I - Bad argument string
     puts("  --book");
     puts("  --bottom margin{in,cm,mm}");
     puts("  --browserwidth pixels");
+    puts("  --cache directory");
     puts("  --charset {cp-874...1258,iso-8859-1...-15,koi8-r,utf-8}");
     puts("  --color");
     puts("  --compression[=level]");
@@ -2671,6 +1998,8 @@ usage(const char *arg)			// I - Bad argument string
     puts("  --effectduration {0.1..10.0}");
     puts("  --embedfonts");
     puts("  --encryption");
+    puts("  --fastcgi {host:port,port,/path/to/socket,-}");
+    puts("  --fastcgi-workers count");
     puts("  --firstpage {p1,toc,c1}");
     puts("  --fontsize {4.0..24.0}");
     puts("  --fontspacing {1.0..3.0}");
@@ -2710,6 +2039,7 @@ usage(const char *arg)			// I - Bad argument string
     puts("  --no-numbered");
     puts("  --no-overflow");
     puts("  --no-pscommands");
+    puts("  --no-pscompression");
     puts("  --no-strict");
     puts("  --no-title");
     puts("  --no-toc");
@@ -2728,13 +2058,16 @@ usage(const char *arg)			// I - Bad argument string
     puts("  --portrait");
     puts("  --proxy http://host:port");
     puts("  --pscommands");
+    puts("  --pscompression");
     puts("  --quiet");
     puts("  --referer url");
     puts("  --right margin{in,cm,mm}");
     puts("  --size {letter,a4,WxH{in,cm,mm},etc}");
+    puts("  --stats-json filename.json");
     puts("  --strict");
     puts("  --textcolor color");
     puts("  --textfont {courier,times,helvetica}");
+    puts("  --threads count");
     puts("  --title");
     puts("  --titlefile filename.{htm,html,shtml}");
     puts("  --titleimage filename.{bmp,gif,jpg,png}");
@@ -20,6 +20,8 @@
 #include "image.h"
 #include "debug.h"
 #include "progress.h"
+#include "stats.h"
+#include "thread.h"
 
 #ifdef HAVE_LIBFLTK
 #  include "gui.h"
@@ -41,6 +43,22 @@ extern "C" {
 #define REF(x)		(void)x;
 
 
+/*
+ * Streaming output support...
+ */
+
+#if defined(HAVE_FOPENCOOKIE) || defined(HAVE_FUNOPEN)
+#  define HTMLDOC_STREAMING		/* Stream PS/PDF output to a callback/fd */
+#endif /* HAVE_FOPENCOOKIE || HAVE_FUNOPEN */
+
+
+/*
+ * Output callback for documents that would go to the standard output...
+ */
+
+typedef int (*outputfunc_t)(void *data, const void *buffer, size_t bytes);
+
+
 /*
  * Output type...
  */
@@ -129,6 +147,7 @@ VAR int		StrictHTML	VALUE(0);	/* Do strict HTML checking */
 VAR int		CGIMode		VALUE(0);	/* Running as CGI? */
 VAR int		Errors		VALUE(0);	/* Number of errors */
 VAR int		Compression	VALUE(1);	/* Non-zero means compress PDFs */
+VAR int		EPUBCompression	VALUE(9);	/* Compression level for EPUB files */
 VAR int		TitlePage	VALUE(1),	/* Need a title page */
 		TocLevels	VALUE(3),	/* Number of table-of-contents levels */
 		TocLinks	VALUE(1),	/* Generate links */
@@ -137,6 +156,8 @@ VAR int		TitlePage	VALUE(1),	/* Need a title page */
 VAR int		OutputType	VALUE(OUTPUT_BOOK);
 						/* Output a "book", etc. */
 VAR char	OutputPath[1024] VALUE("");	/* Output directory/name */
+VAR outputfunc_t OutputFunc	VALUE(NULL);	/* Callback for stdout data */
+VAR void	*OutputData	VALUE(NULL);	/* Callback data */
 VAR int		OutputFiles	VALUE(0),	/* Generate multiple files? */
 		OutputColor	VALUE(1);	/* Output color images */
 VAR int		OutputJPEG	VALUE(0);	/* JPEG compress images? */
@@ -157,6 +178,7 @@ VAR char	OwnerPassword[33] VALUE(""),	/* Owner password */
 VAR int		EmbedFonts	VALUE(1);	/* Embed fonts? */
 VAR int		PSLevel		VALUE(2),	/* Language level (0 for PDF) */
 		PSCommands	VALUE(0),	/* Output PostScript commands? */
+		PSCompression	VALUE(0),	/* Compress PostScript pages? */
 		XRXComments	VALUE(0);	/* Output Xerox comments? */
 VAR int		PageWidth	VALUE(595),	/* Page width in points */
 		PageLength	VALUE(792),	/* Page length in points */
@@ -203,6 +225,7 @@ VAR int		LinkStyle	VALUE(1);	/* 1 = underline, 0 = plain */
 VAR int		Links		VALUE(1);	/* 1 = generate links, 0 = no links */
 VAR char	Path[2048]	VALUE(""),	/* Search path */
 		Proxy[1024]	VALUE("");	/* Proxy URL */
+VAR char	CacheDir[1024]	VALUE("");	/* Parsed document cache directory */
 
 VAR const char	*PDFModes[3]			/* Mode strings */
 #  ifdef _HTMLDOC_CXX_
@@ -241,6 +264,13 @@ VAR int		Tooltips	VALUE(0);	/* Show tooltips? */
 #endif /* HAVE_LIBFLTK */
 
 
+/*
+ * Export function type...
+ */
+
+typedef int (*exportfunc_t)(tree_t *, tree_t *);
+
+
 /*
  * Prototypes...
  */
@@ -261,6 +291,20 @@ extern void	get_format(const char *fmt, char **formats);
 extern int	get_measurement(const char *s, float mul = 1.0f);
 extern void	set_page_size(const char *size);
 
+extern int	add_file(const char *filename, const char *path,
+		         const void *data = NULL, size_t datalen = 0);
+extern void	convert_begin(exportfunc_t *exportfunc);
+extern void	convert_end(void);
+extern int	load_book(const char *filename, tree_t **document,
+		          exportfunc_t *exportfunc, int set_nolocal = 0);
+extern void	read_files(tree_t **document);
+extern void	set_permissions(const char *p);
+
+extern int	cgi_add_url(void);
+extern void	cgi_setup(tree_t **document, exportfunc_t *exportfunc);
+
+extern int	fastcgi_run(const char *address, int workers);
+
 extern void	prefs_load(void);
 extern void	prefs_save(void);
 extern void	prefs_set_paths(void);
@@ -9,6 +9,8 @@
 //
 
 #include "htmldoc.h"
+#include "charsets.h"
+#include "hash.h"
 #ifdef HAVE_LIBCUPS
 #  include <cups/http.h>
 #endif // HAVE_LIBCUPS
@@ -16,7 +18,8 @@
 
 
 //
-// Markup strings...
+// Markup strings, which must be in the same order as the markup_t enumeration.
+// Run "tools/makehash.py" to update "hash.h" after changing them...
 //
 
 const char	*_htmlMarkups[] =
@@ -119,11 +122,15 @@ const char	*_htmlMarkups[] =
 		  "var",
 		  "wbr"
 		};
+static_assert(sizeof(_htmlMarkups) / sizeof(_htmlMarkups[0]) == HD_MARKUP_COUNT, "Run \"tools/makehash.py\" to update \"hash.h\".");
 
-const char	*_htmlCurrentFile = "UNKNOWN";
+HD_THREAD_LOCAL const char *_htmlCurrentFile = "UNKNOWN";
 					// Current file
-int		_htmlCurrentLevel = 0;	// Current include level
+HD_THREAD_LOCAL int _htmlCurrentLevel = 0;
+					// Current include level
 const char	*_htmlData = HTML_DATA;	// Data directory
+const char	*_htmlCharSetDir = NULL;
+					// Character set override directory
 float		_htmlPPI = 80.0f;	// Image resolution
 int		_htmlGrayscale = 0;	// Grayscale output?
 uchar		_htmlTextColor[255] =	// Default text color
@@ -140,6 +147,8 @@ typeface_t	_htmlBodyFont = TYPE_TIMES,
 int		_htmlInitialized = 0;	// Initialized glyphs yet?
 char		_htmlCharSet[256] = "iso-8859-1";
 					// Character set name
+hd_mutex_t	_htmlCharSetMutex = HD_MUTEX_INITIALIZER;
+					// Lock for font widths and glyphs
 int		_htmlWidthsLoaded[TYPE_MAX][STYLE_MAX] =
 		{			// Have the widths been loaded?
 		  { 0, 0, 0, 0 },
@@ -237,7 +246,7 @@ typedef int	(*compare_func_t)(const void *, const void *);
 
 static int	write_file(tree_t *t, FILE *fp, int col);
 static int	compare_variables(var_t *v0, var_t *v1);
-static int	compare_markups(uchar **m0, uchar **m1);
+static int	find_markup(uchar *name);
 static void	delete_node(tree_t *t);
 static void	insert_space(tree_t *parent, tree_t *t);
 static int	parse_markup(tree_t *t, FILE *fp, long *linenum);
@@ -245,7 +254,8 @@ static int	parse_variable(tree_t *t, FILE *fp, long *linenum);
 static int	compute_size(tree_t *t);
 static int	compute_color(tree_t *t, uchar *color);
 static int	get_alignment(tree_t *t);
-static const char *fix_filename(char *path, char *base);
+static const char *fix_filename(char *path, char *base, int fetch = 1);
+static int	is_remote(const char *filename);
 static int      utf8_getc(int ch, FILE *fp);
 
 #define issuper(x)	((x) == MARKUP_CENTER || (x) == MARKUP_DIV ||\
@@ -298,8 +308,10 @@ htmlReadFile(tree_t     *parent,	// I - Parent tree entry
 		*span;			// Value for SPAN tag
   int		sizeval;		// Size value from FONT tag
   long		linenum;		// Line number in file
-  static uchar	s[10240];		// String from file
-  static int	have_whitespace = 0;	// Non-zero if there was leading whitespace
+  static HD_THREAD_LOCAL uchar s[10240];
+					// String from file
+  static HD_THREAD_LOCAL int have_whitespace = 0;
+					// Non-zero if there was leading whitespace
 
 
   DEBUG_printf(("htmlReadFile(parent=%p, fp=%p, base=\"%s\")\n",
@@ -311,6 +323,14 @@ htmlReadFile(tree_t     *parent,	// I - Parent tree entry
     return (NULL);
   }
 
+  // Each file starts without leading whitespace, no matter which thread
+  // parsed the previous file...
+  if (_htmlCurrentLevel == 0)
+    have_whitespace = 0;
+
+  if (parent && parent->markup == MARKUP_FILE)
+    htmlIndexNode(parent);
+
   _htmlCurrentLevel ++;
 
 #ifdef DEBUG
@@ -352,6 +372,8 @@ htmlReadFile(tree_t     *parent,	// I - Parent tree entry
       break;
     }
 
+    stats_count(HD_COUNT_NODES, 1);
+
     // Set/copy font characteristics...
     if (parent == NULL)
     {
@@ -898,6 +920,9 @@ htmlReadFile(tree_t     *parent,	// I - Parent tree entry
     // Do markup-specific stuff...
     descend = 0;
 
+    if (t->markup == MARKUP_META || t->markup == MARKUP_HTML)
+      htmlIndexNode(t);
+
     switch (t->markup)
     {
       case MARKUP_BODY :
@@ -937,7 +962,7 @@ htmlReadFile(tree_t     *parent,	// I - Parent tree entry
           if ((filename = htmlGetVariable(t, (uchar *)"SRC")) != NULL)
 	    htmlSetVariable(t, (uchar *)"REALSRC",
 	                    (uchar *)fix_filename((char *)filename,
-			                          (char *)base));
+			                          (char *)base, 0));
 
       case MARKUP_BR :
       case MARKUP_NONE :
@@ -1894,6 +1919,8 @@ htmlNewTree(tree_t   *parent,	// I - Parent entry
   if (t == NULL)
     return (NULL);
 
+  stats_count(HD_COUNT_NODES, 1);
+
   // Set the markup code and copy the data if necessary...
   t->markup = markup;
   if (data != NULL)
@@ -2124,7 +2151,13 @@ htmlGetMeta(tree_t *tree,	// I - Document tree
   tree_t	*top = tree;	// Top of document tree
   uchar		*tname,		// Name value from tree entry
 		*tcontent;	// Content value from tree entry
+  char		vname[256];	// Index variable name
+
 
+  // Use the index for files that were read with htmlReadFile(), mdReadFile(),
+  // or cache_load()...
+  if (tree && tree->markup == MARKUP_FILE && htmlGetVariable(tree, (uchar *)"_HD_INDEXED") && snprintf(vname, sizeof(vname), "_HD_META_%s", (char *)name) < (int)sizeof(vname))
+    return (htmlGetVariable(tree, (uchar *)vname));
 
   while (tree != NULL)
   {
@@ -2149,6 +2182,57 @@ htmlGetMeta(tree_t *tree,	// I - Document tree
 }
 
 
+//
+// 'htmlIndexNode()' - Add a node to the metadata index of its file.
+//
+// Calling this with a MARKUP_FILE node starts a new index for the file.  The
+// index holds the first value of each META name and the HTML LANG attribute
+// in "_HD_META_name" variables on the file node, so htmlGetMeta() does not
+// need to walk the whole file.
+//
+
+void
+htmlIndexNode(tree_t *t)	// I - Node
+{
+  tree_t	*file;		// File node
+  uchar		*name,		// Metadata name
+		*content;	// Metadata content
+  char		vname[256];	// Index variable name
+
+
+  if (!t)
+    return;
+
+  if (t->markup == MARKUP_FILE)
+  {
+    htmlSetVariable(t, (uchar *)"_HD_INDEXED", (uchar *)"1");
+    return;
+  }
+  else if (t->markup == MARKUP_META)
+  {
+    if ((name = htmlGetVariable(t, (uchar *)"NAME")) == NULL || (content = htmlGetVariable(t, (uchar *)"CONTENT")) == NULL)
+      return;
+  }
+  else if (t->markup == MARKUP_HTML)
+  {
+    if ((content = htmlGetVariable(t, (uchar *)"LANG")) == NULL)
+      return;
+
+    name = (uchar *)"LANG";
+  }
+  else
+    return;
+
+  for (file = t->parent; file && file->markup != MARKUP_FILE; file = file->parent);
+
+  if (!file || snprintf(vname, sizeof(vname), "_HD_META_%s", (char *)name) >= (int)sizeof(vname))
+    return;
+
+  if (!htmlGetVariable(file, (uchar *)vname))
+    htmlSetVariable(file, (uchar *)vname, content);
+}
+
+
 //
 // 'htmlGetStyle()' - Get a style value from a node's STYLE attribute.
 //
@@ -2157,35 +2241,117 @@ uchar *				// O - Value or NULL
 htmlGetStyle(tree_t *t,		// I - Node
              uchar  *name)	// I - Name (including ":")
 {
-  uchar		*ptr,		// Pointer in STYLE attribute
-		*bufptr;	// Pointer in buffer
-  size_t	ptrlen,		// Length of STYLE attribute
-		namelen;	// Length of name
-  static uchar	buffer[1024];	// Buffer for value
+  int		i;		// Looping var
+  var_t		*v;		// Current property
+  size_t	namelen;	// Length of name
 
 
-  // See if we have a STYLE attribute...
-  if ((ptr = htmlGetVariable(t, (uchar *)"STYLE")) == NULL)
+  if (t == NULL || t->nstyles == 0)
     return (NULL);
 
-  // Loop through the STYLE attribute looking for the name...
-  for (namelen = strlen((char *)name), ptrlen = strlen((char *)ptr);
-       ptrlen > namelen;
-       ptr ++, ptrlen --)
-    if (strncasecmp((char *)name, (char *)ptr, namelen) == 0)
-    {
-      for (ptr += namelen; isspace(*ptr); ptr ++);
+  // Names are passed with or without the trailing colon...
+  namelen = strlen((char *)name);
+  if (namelen > 0 && name[namelen - 1] == ':')
+    namelen --;
 
-      for (bufptr = buffer;
-           *ptr && *ptr != ';' && bufptr < (buffer + sizeof(buffer) - 1);
-	   *bufptr++ = *ptr++);
+  // Look the name up in the properties parsed by htmlParseStyle()...
+  for (i = t->nstyles, v = t->styles; i > 0; i --, v ++)
+    if (!strncasecmp((char *)v->name, (char *)name, namelen) && !v->name[namelen])
+      return (v->value);
 
-      *bufptr = '\0';
+  return (NULL);
+}
+
+
+//
+// 'htmlParseStyle()' - Parse a node's STYLE attribute into its property table.
+//
+// The property names and values are added to the string pool so that the
+// many identical STYLE attributes in generated documents share storage.
+//
+
+void
+htmlParseStyle(tree_t *t)	// I - Node
+{
+  int		i;		// Looping var
+  var_t		*v;		// Current property
+  uchar		*style,		// STYLE attribute
+		*ptr;		// Pointer in STYLE attribute
+  size_t	count;		// Maximum number of properties
+  char		name[256],	// Property name
+		*nameptr,	// Pointer in name
+		value[1024],	// Property value
+		*valptr;	// Pointer in value
+
+
+  free(t->styles);
 
-      return (buffer);
+  t->nstyles = 0;
+  t->styles  = NULL;
+
+  // See if we have a STYLE attribute...
+  if ((style = htmlGetVariable(t, (uchar *)"STYLE")) == NULL)
+    return;
+
+  // Every property has a colon, so use that to size the table...
+  for (count = 0, ptr = style; *ptr; ptr ++)
+    if (*ptr == ':')
+      count ++;
+
+  if (count == 0 || (t->styles = (var_t *)calloc(count, sizeof(var_t))) == NULL)
+    return;
+
+  // Loop through the "name: value;" declarations...
+  for (ptr = style; *ptr;)
+  {
+    while (isspace(*ptr) || *ptr == ';')
+      ptr ++;
+
+    for (nameptr = name; *ptr && *ptr != ':' && *ptr != ';'; ptr ++)
+      if (nameptr < (name + sizeof(name) - 1))
+        *nameptr++ = (char)tolower(*ptr);
+
+    while (nameptr > name && isspace(nameptr[-1] & 255))
+      nameptr --;
+
+    *nameptr = '\0';
+
+    if (*ptr != ':')
+      continue;
+
+    for (ptr ++; isspace(*ptr); ptr ++);
+
+    for (valptr = value; *ptr && *ptr != ';'; ptr ++)
+      if (valptr < (value + sizeof(value) - 1))
+        *valptr++ = (char)*ptr;
+
+    while (valptr > value && isspace(valptr[-1] & 255))
+      valptr --;
+
+    *valptr = '\0';
+
+    if (!name[0])
+      continue;
+
+    // Later declarations of a property override earlier ones...
+    for (i = 0, v = t->styles; i < t->nstyles; i ++, v ++)
+      if (!strcmp((char *)v->name, name))
+        break;
+
+    if (i >= t->nstyles)
+    {
+      t->nstyles ++;
+      v->name = (uchar *)hd_strdup(name);
     }
 
-  return (NULL);
+    v->value = (uchar *)hd_strdup(value);
+  }
+
+  if (t->nstyles == 0)
+  {
+    free(t->styles);
+    t->styles = NULL;
+  }
 }
 
 
@@ -2231,6 +2397,16 @@ htmlLoadFontWidths(int typeface, int style)
   char		line[1024];		// Line from AFM file
 
 
+  // Layout threads load widths on demand, so make sure only one thread loads
+  // a given font and that no glyphs are added while we read the widths...
+  hd_mutex_lock(&_htmlCharSetMutex);
+
+  if (_htmlWidthsLoaded[typeface][style])
+  {
+    hd_mutex_unlock(&_htmlCharSetMutex);
+    return;
+  }
+
   // Now read all of the font widths...
   for (ch = 0; ch < 256; ch ++)
     _htmlWidths[typeface][style][ch] = 600;
@@ -2247,6 +2423,7 @@ htmlLoadFontWidths(int typeface, int style)
 #ifndef DEBUG
     progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open font width file '%s'.", filename);
 #endif // !DEBUG
+    hd_mutex_unlock(&_htmlCharSetMutex);
     return;
   }
 
@@ -2302,7 +2479,10 @@ htmlLoadFontWidths(int typeface, int style)
   _htmlWidths[typeface][style][160]    = _htmlWidths[typeface][style][32];
   _htmlWidthsAll[typeface][style][160] = _htmlWidthsAll[typeface][style][32];
 
-  _htmlWidthsLoaded[typeface][style] = 1;
+  // Publish the widths to threads that check the flag without the lock...
+  hd_atomic_set(&_htmlWidthsLoaded[typeface][style], 1);
+
+  hd_mutex_unlock(&_htmlCharSetMutex);
 }
 
 
@@ -2368,6 +2548,10 @@ htmlSetVariable(tree_t *t,	// I - Tree entry
     v->value = (uchar *)hd_strdup((char *)value);
   }
 
+  // Keep the parsed STYLE properties in sync with the attribute...
+  if (!strcasecmp((char *)name, "STYLE"))
+    htmlParseStyle(t);
+
   return (0);
 }
 
@@ -2395,16 +2579,21 @@ htmlSetBaseSize(double p,	// I - Point size of paragraph font
 //
 // 'htmlSetCharSet()' - Set the character set for output.
 //
+// The PostScript glyph names and shipped character sets are compiled in from
+// "charsets.h".  Other character sets are loaded from the "data" directory.
+// When the HTMLDOC_CHARSETS environment variable names a directory, the
+// "psglyphs" and character set files in it override the built-in tables.
+//
 
 void
 htmlSetCharSet(const char *cs)		// I - Character set file to load
 {
   int		i;			// Looping var
+  char		name[256];		// Character set name
   char		filename[1024];		// Filenames
   FILE		*fp;			// Files
   int		ch, unicode;		// Character values
   char		glyph[64];		// Glyph name
-  char		line[1024];		// Line from charset file
   int		chars[256];		// Character encoding array
 
 
@@ -2415,20 +2604,32 @@ htmlSetCharSet(const char *cs)		// I - Character set file to load
     // Load the PostScript glyph names for all of Unicode...
     memset(_htmlGlyphsAll, 0, sizeof(_htmlGlyphsAll));
 
-    snprintf(line, sizeof(line), "%s/data/psglyphs", _htmlData);
-    if ((fp = fopen(line, "r")) != NULL)
+    fp = NULL;
+
+    if (_htmlCharSetDir)
+    {
+      snprintf(filename, sizeof(filename), "%s/psglyphs", _htmlCharSetDir);
+      fp = fopen(filename, "r");
+    }
+
+    if (fp)
     {
       while (fscanf(fp, "%x%63s", &unicode, glyph) == 2)
-        _htmlGlyphsAll[unicode] = strdup(glyph);
+      {
+	if (unicode >= 0 && unicode < (int)(sizeof(_htmlGlyphsAll) / sizeof(_htmlGlyphsAll[0])))
+	  _htmlGlyphsAll[unicode] = strdup(glyph);
+      }
 
       fclose(fp);
-
-      _htmlInitialized = 1;
     }
-#ifndef DEBUG
     else
-      progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open psglyphs data file.");
-#endif // !DEBUG
+    {
+      // Use the built-in glyph names...
+      for (i = 0; i < (int)(sizeof(hd_glyphs) / sizeof(hd_glyphs[0])); i ++)
+	_htmlGlyphsAll[hd_glyphs[i].unicode] = hd_glyph_names + hd_glyphs[i].name;
+    }
+
+    _htmlInitialized = 1;
   }
 
   memset(_htmlGlyphs, 0, sizeof(_htmlGlyphs));
@@ -2453,27 +2654,62 @@ htmlSetCharSet(const char *cs)		// I - Character set file to load
   }
 
   if (strncmp(cs, "8859-", 5) == 0)
-    snprintf(filename, sizeof(filename), "%s/data/iso-%s", _htmlData, cs);
+    snprintf(name, sizeof(name), "iso-%s", cs);
   else
-    snprintf(filename, sizeof(filename), "%s/data/%s", _htmlData, cs);
+    strlcpy(name, cs, sizeof(name));
 
-  if ((fp = fopen(filename, "r")) == NULL)
+  fp = NULL;
+
+  if (_htmlCharSetDir)
   {
-    // Can't open charset file; use ISO-8859-1...
+    snprintf(filename, sizeof(filename), "%s/%s", _htmlCharSetDir, name);
+    fp = fopen(filename, "r");
+  }
+
+  if (!fp)
+  {
+    for (i = 0; i < (int)(sizeof(hd_charsets) / sizeof(hd_charsets[0])); i ++)
+    {
+      if (!strcmp(name, hd_charsets[i].name))
+	break;
+    }
+
+    if (i < (int)(sizeof(hd_charsets) / sizeof(hd_charsets[0])))
+    {
+      // Use the built-in character set...
+      const unsigned short *charset = hd_charsets[i].unicode;
+					// Unicode values for character set
+
+      for (i = 0; i < 256; i ++)
+	chars[i] = charset[i];
+    }
+    else
+    {
+      snprintf(filename, sizeof(filename), "%s/data/%s", _htmlData, name);
+
+      if ((fp = fopen(filename, "r")) == NULL)
+      {
+        // Can't open charset file; use ISO-8859-1...
 #ifndef DEBUG
-    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open character set file '%s'.", cs);
+	progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open character set file '%s'.", cs);
 #endif // !DEBUG
 
-    for (i = 0; i < 256; i ++)
-      chars[i] = i;
+	for (i = 0; i < 256; i ++)
+	  chars[i] = i;
+      }
+    }
   }
-  else
+
+  if (fp)
   {
     // Read the <char> <unicode> lines from the file...
     memset(chars, 0, sizeof(chars));
 
     while (fscanf(fp, "%x%x", &ch, &unicode) == 2)
-      chars[ch] = unicode;
+    {
+      if (ch >= 0 && ch < 256)
+	chars[ch] = unicode;
+    }
 
     fclose(fp);
   }
@@ -2571,18 +2807,25 @@ compare_variables(var_t *v0,	// I - First variable
 
 
 //
-// 'compare_markups()' - Compare two markup strings...
+// 'find_markup()' - Find the index of a markup string.
 //
 
-static int			// O - -1 if m0 < m1, 0 if m0 == m1, 1 if m0 > m1
-compare_markups(uchar **m0,	// I - First markup
-                uchar **m1)	// I - Second markup
+static int			// O - MARKUP_nnnn or -1 if not found
+find_markup(uchar *name)	// I - Markup string
 {
-  if (tolower((*m0)[0]) == 'h' && isdigit((*m0)[1]) &&
-      tolower((*m1)[0]) == 'h' && isdigit((*m1)[1]))
-    return (atoi((char *)*m0 + 1) - atoi((char *)*m1 + 1));
-  else
-    return (strcasecmp((char *)*m0, (char *)*m1));
+  int	i;			// Index in _htmlMarkups
+
+
+  i = hd_hash_lookup((char *)name, hd_markup_disp, HD_MARKUP_BUCKETS, hd_markup_slots, HD_MARKUP_SLOTS, 1);
+
+  if (i >= 0 && !strcasecmp((char *)name, _htmlMarkups[i]))
+    return (i);
+
+  // Headings match by number, so "H01" is the same as "H1"...
+  if (tolower(name[0]) == 'h' && isdigit(name[1]) && (i = atoi((char *)name + 1)) >= 1 && i <= 15)
+    return (MARKUP_H1 + i - 1);
+
+  return (-1);
 }
 
 
@@ -2597,6 +2840,7 @@ delete_node(tree_t *t)		// I - Node to delete
     return;
 
   free(t->vars);
+  free(t->styles);
   free(t);
 }
 
@@ -2623,6 +2867,8 @@ insert_space(tree_t *parent,	// I - Parent node
     return;
   }
 
+  stats_count(HD_COUNT_NODES, 1);
+
   // Set/copy font characteristics...
   if (parent)
   {
@@ -2665,12 +2911,12 @@ parse_markup(tree_t *t,		// I - Current tree entry
              FILE   *fp,	// I - Input file
 	     long   *linenum)	// O - Current line number
 {
-  int	ch, ch2;		// Characters from file
+  int	i,			// Markup index
+	ch, ch2;		// Characters from file
   uchar	markup[255],		// Markup string...
 	*mptr,			// Current character...
 	comment[10240],		// Comment string
-	*cptr,			// Current char...
-	**temp;			// Markup variable entry
+	*cptr;			// Current char...
 
 
   mptr = markup;
@@ -2714,13 +2960,7 @@ parse_markup(tree_t *t,		// I - Current tree entry
   if (ch == EOF)
     return (MARKUP_ERROR);
 
-  mptr = markup;
-  temp = (uchar **)bsearch(&mptr, _htmlMarkups,
-                           sizeof(_htmlMarkups) / sizeof(_htmlMarkups[0]),
-                           sizeof(_htmlMarkups[0]),
-                           (compare_func_t)compare_markups);
-
-  if (temp == NULL)
+  if ((i = find_markup(markup)) < 0)
   {
     // Unrecognized markup stuff...
     t->markup = MARKUP_UNKNOWN;
@@ -2731,7 +2971,7 @@ parse_markup(tree_t *t,		// I - Current tree entry
   }
   else
   {
-    t->markup = (markup_t)((const char **)temp - _htmlMarkups);
+    t->markup = (markup_t)i;
     cptr      = comment;
 
     DEBUG_printf(("%s%s, line %ld\n", indent, markup, *linenum));
@@ -2743,7 +2983,7 @@ parse_markup(tree_t *t,		// I - Current tree entry
 
     while (ch != EOF && cptr < (comment + sizeof(comment) - 2))
     {
-      if (ch == '>' && temp == NULL)
+      if (ch == '>' && i < 0)
         break;
 
       if (ch == '\n')
@@ -3279,14 +3519,14 @@ compute_size(tree_t *t)		// I - Tree entry
     if (int_width > max_width)
       max_width = int_width;
 
-    if (!_htmlWidthsLoaded[t->typeface][t->style])
+    if (!hd_atomic_get(&_htmlWidthsLoaded[t->typeface][t->style]))
       htmlLoadFontWidths(t->typeface, t->style);
 
     width = _htmlWidths[t->typeface][t->style][0x20] * max_width * 0.001f;
   }
   else if (t->data)
   {
-    if (!_htmlWidthsLoaded[t->typeface][t->style])
+    if (!hd_atomic_get(&_htmlWidthsLoaded[t->typeface][t->style]))
       htmlLoadFontWidths(t->typeface, t->style);
 
     for (int_width = 0, ptr = t->data; *ptr != '\0'; ptr ++)
@@ -3382,15 +3622,21 @@ get_alignment(tree_t *t)	// I - Tree entry
 //
 // 'fix_filename()' - Fix a filename to be relative to the base directory.
 //
+// When "fetch" is 0, remote URLs are returned as-is so that they can be
+// retrieved later by the code that needs them.
+//
 
 static const char *			// O - Fixed filename
 fix_filename(char *filename,		// I - Original filename
-             char *base)		// I - Base directory
+             char *base,		// I - Base directory
+             int  fetch)		// I - 1 = retrieve remote URLs, 0 = don't
 {
   char		*slash;			// Location of slash
   char		*tempptr;		// Pointer into filename
-  static char	temp[1024];		// Temporary filename
-  static char	newfilename[1024];	// New filename
+  static HD_THREAD_LOCAL char temp[1024];
+					// Temporary filename
+  static HD_THREAD_LOCAL char newfilename[1024];
+					// New filename
 
 
 //  printf("fix_filename(filename=\"%s\", base=\"%s\")\n", filename, base);
@@ -3438,7 +3684,12 @@ fix_filename(char *filename,		// I - Original filename
   }
 
   if (strcmp(base, ".") == 0 || strstr(filename, "//") != NULL)
-    return (file_find(Path, filename));
+  {
+    if (!fetch && is_remote(filename))
+      return (filename);
+    else
+      return (file_find(Path, filename));
+  }
 
   if (strncmp(filename, "./", 2) == 0 ||
       strncmp(filename, ".\\", 2) == 0)
@@ -3522,7 +3773,25 @@ fix_filename(char *filename,		// I - Original filename
 
 //  printf("    newfilename=\"%s\"\n", newfilename);
 
-  return (file_find(Path, newfilename));
+  if (!fetch && is_remote(newfilename))
+    return (newfilename);
+  else
+    return (file_find(Path, newfilename));
+}
+
+
+//
+// 'is_remote()' - Is a filename a HTTP or HTTPS URL?
+//
+
+static int				// O - 1 if remote, 0 otherwise
+is_remote(const char *filename)		// I - Filename or URL
+{
+  const char	*method = file_method(filename);
+					// Method for URL
+
+
+  return (method && (!strcmp(method, "http") || !strcmp(method, "https")));
 }
 
 
@@ -3545,6 +3814,7 @@ html_memory_used(tree_t *t)		// I - Tree node
   {
     bytes += sizeof(tree_t);
     bytes += (size_t)t->nvars * sizeof(var_t);
+    bytes += (size_t)t->nstyles * sizeof(var_t);
 
     bytes += html_memory_used(t->child);
 
@@ -24,6 +24,20 @@ typedef struct				// Named link structure...
   uchar		name[124];		// Reference name
 } link_t;
 
+typedef struct				// Output file for a heading...
+{
+  tree_t	*start;			// First node in file
+  long		bytes;			// Number of bytes written or -1
+} section_t;
+
+typedef struct				// Document strings for write_section()...
+{
+  uchar		*title,			// Title text
+		*author,		// Author name
+		*copyright,		// Copyright text
+		*docnumber;		// Document number
+} section_info_t;
+
 
 //
 // Local globals...
@@ -34,6 +48,14 @@ static size_t	num_headings = 0,	// Number of headings
 		alloc_headings = 0;	// Allocated headings
 static uchar	**headings;		// Heading strings
 
+// Heading nodes that start each output file...
+static size_t	num_sections = 0,	// Number of sections
+		alloc_sections = 0;	// Allocated sections
+static section_t *sections;		// Sections
+
+// Lock for copying images from multiple threads...
+static hd_mutex_t image_mutex = HD_MUTEX_INITIALIZER;
+
 // Links in document - used to add the correct filename to the link
 static size_t	num_links = 0,		// Number of links
 		alloc_links = 0;	// Allocated links
@@ -51,20 +73,20 @@ typedef int	(*compare_func_t)(const void *, const void *);
 static void	write_header(FILE **out, uchar *filename, uchar *title,
 		             uchar *author, uchar *copyright, uchar *docnumber,
 			     int heading);
-static void	write_footer(FILE **out, int heading);
+static long	write_footer(FILE **out, int heading);
 static void	write_title(FILE *out, uchar *title, uchar *author,
 		            uchar *copyright, uchar *docnumber);
 static int	write_all(FILE *out, tree_t *t, int col);
-static int	write_doc(FILE **out, tree_t *t, int col, int *heading,
-		          uchar *title, uchar *author, uchar *copyright,
-			  uchar *docnumber);
+static int	write_doc(FILE *out, tree_t *t, tree_t *stop);
 static int	write_node(FILE *out, tree_t *t, int col);
 static int	write_nodeclose(FILE *out, tree_t *t, int col);
+static void	write_section(void *data, int index);
 static int	write_toc(FILE *out, tree_t *t, int col);
 static uchar	*get_title(tree_t *doc);
 
-static void	add_heading(tree_t *t);
+static int	add_heading(tree_t *t);
 static void	add_link(uchar *name);
+static void	add_section(tree_t *t);
 static link_t	*find_link(uchar *name);
 static int	compare_links(link_t *n1, link_t *n2);
 static void	scan_links(tree_t *t);
@@ -81,11 +103,14 @@ htmlsep_export(tree_t *document,	// I - Document to export
 {
   size_t	i;			// Looping var
   int		heading;		// Current heading number
+  long		bytes;			// Bytes written
   uchar		*title,			// Title text
 		*author,		// Author name
 		*copyright,		// Copyright text
 		*docnumber;		// Document number
   FILE		*out;			// Output file
+  section_info_t info;			// Document strings for sections
+  int		status = 0;		// Export status
 
 
   // We only support writing to a directory...
@@ -95,6 +120,8 @@ htmlsep_export(tree_t *document,	// I - Document to export
     return (-1);
   }
 
+  stats_begin(HD_STATS_WRITE);
+
   // Copy logo and title images...
   if (LogoImage[0])
     image_copy(LogoImage, file_find(LogoImage, Path), OutputPath);
@@ -149,7 +176,10 @@ htmlsep_export(tree_t *document,	// I - Document to export
     if (out != NULL)
       write_title(out, title, author, copyright, docnumber);
 
-    write_footer(&out, -1);
+    if ((bytes = write_footer(&out, -1)) < 0)
+      status = -1;
+    else
+      progress_error(HD_ERROR_NONE, "BYTES: %ld", bytes);
 
     write_header(&out, (uchar *)"toc.html", title, author, copyright,
                  docnumber, -1);
@@ -161,14 +191,27 @@ htmlsep_export(tree_t *document,	// I - Document to export
   if (out != NULL)
     write_toc(out, toc, 0);
 
-  write_footer(&out, -1);
+  if ((bytes = write_footer(&out, -1)) < 0)
+    status = -1;
+  else
+    progress_error(HD_ERROR_NONE, "BYTES: %ld", bytes);
 
-  // Then write each output file...
-  heading = -1;
-  write_doc(&out, document, 0, &heading, title, author, copyright, docnumber);
+  // Then write the file for each heading on multiple threads, reporting the
+  // sizes in order afterwards...
+  info.title     = title;
+  info.author    = author;
+  info.copyright = copyright;
+  info.docnumber = docnumber;
 
-  if (out != NULL)
-    write_footer(&out, heading);
+  hd_parallel((int)num_sections, write_section, &info);
+
+  for (i = 0; i < num_sections; i ++)
+  {
+    if (sections[i].bytes < 0)
+      status = -1;
+    else
+      progress_error(HD_ERROR_NONE, "BYTES: %ld", sections[i].bytes);
+  }
 
   // Free memory...
   if (title != NULL)
@@ -195,7 +238,18 @@ htmlsep_export(tree_t *document,	// I - Document to export
     headings       = NULL;
   }
 
-  return (out == NULL);
+  if (alloc_sections)
+  {
+    free(sections);
+
+    num_sections   = 0;
+    alloc_sections = 0;
+    sections       = NULL;
+  }
+
+  stats_end(HD_STATS_WRITE);
+
+  return (status);
 }
 
 
@@ -239,6 +293,8 @@ write_header(FILE   **out,		// IO - Output file
     return;
   }
 
+  setvbuf(*out, NULL, _IOFBF, 65536);
+
   fputs("<!DOCTYPE html>\n", *out);
   fputs("<HTML>\n", *out);
   fputs("<HEAD>\n", *out);
@@ -332,12 +388,15 @@ write_header(FILE   **out,		// IO - Output file
 // 'write_footer()' - Output the standard "footer" for a HTML file.
 //
 
-static void
+static long				// O - Number of bytes written or -1 on error
 write_footer(FILE **out,		// IO - Output file pointer
 	     int  heading)		// I  - Current heading
 {
+  long	bytes;				// Number of bytes written
+
+
   if (*out == NULL)
-    return;
+    return (-1);
 
   fputs("<HR NOSHADE>\n", *out);
 
@@ -365,10 +424,18 @@ write_footer(FILE **out,		// IO - Output file pointer
   fputs("</BODY>\n", *out);
   fputs("</HTML>\n", *out);
 
-  progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(*out));
+  bytes = ftell(*out);
+  stats_count(HD_COUNT_BYTES_OUT, bytes);
+
+  if (fclose(*out))
+  {
+    progress_error(HD_ERROR_WRITE_ERROR, "Unable to write output file: %s", strerror(errno));
+    bytes = -1;
+  }
 
-  fclose(*out);
   *out = NULL;
+
+  return (bytes);
 }
 
 
@@ -502,50 +569,45 @@ write_all(FILE   *out,			// I - Output file
 
 
 //
-// 'write_doc()' - Write the entire document.
+// 'write_doc()' - Write the document nodes from "t" up to but not including
+//                 "stop".
+//
+// Nodes are written in document order, closing each parent as the walk
+// leaves it, so that the output matches a recursive walk of the whole tree
+// that is cut at the start and stop nodes.
 //
 
 static int				// O - Current column
-write_doc(FILE   **out,			// I - Output file
-          tree_t *t,			// I - Document tree
-          int    col,			// I - Current column
-          int    *heading,		// IO - Current heading
-	  uchar  *title,		// I  - Title
-          uchar  *author,		// I  - Author
-	  uchar  *copyright,		// I  - Copyright
-	  uchar  *docnumber)		// I  - Document number
+write_doc(FILE   *out,			// I - Output file
+          tree_t *t,			// I - First node to write
+          tree_t *stop)			// I - Node to stop at or `NULL`
 {
-  uchar	filename[1024];			// Filename
+  int	col = 0;			// Current column
 
 
-  while (t != NULL)
+  while (t != NULL && t != stop)
   {
-    if (t->markup >= MARKUP_H1 && t->markup < (MARKUP_H1 + TocLevels) &&
-        htmlGetVariable(t, (uchar *)"_HD_OMIT_TOC") == NULL)
+    col = write_node(out, t, col);
+
+    if (t->child != NULL && t->markup != MARKUP_HEAD && t->markup != MARKUP_TITLE)
     {
-      if (*heading >= 0)
-        write_footer(out, *heading);
+      t = t->child;
+      continue;
+    }
 
-      (*heading) ++;
+    // Close this node and any parents that end with it...
+    while (t != NULL)
+    {
+      col = write_nodeclose(out, t, col);
 
-      if (*heading >= 0)
+      if (t->next != NULL)
       {
-	snprintf((char *)filename, sizeof(filename), "%s.html",
-	         headings[*heading]);
-	write_header(out, filename, title, author, copyright, docnumber,
-                     *heading);
+        t = t->next;
+        break;
       }
-    }
-
-    col = write_node(*out, t, col);
-
-    if (t->markup != MARKUP_HEAD && t->markup != MARKUP_TITLE)
-      col = write_doc(out, t->child, col, heading,
-                      title, author, copyright, docnumber);
-
-    col = write_nodeclose(*out, t, col);
 
-    t = t->next;
+      t = t->parent;
+    }
   }
 
   return (col);
@@ -677,7 +739,9 @@ write_node(FILE   *out,			// I - Output file
               src[0] != '/' && src[0] != '\\' &&
 	      (!isalpha(src[0]) || src[1] != ':'))
           {
+            hd_mutex_lock(&image_mutex);
             image_copy((char *)src, (char *)realsrc, OutputPath);
+            hd_mutex_unlock(&image_mutex);
             strlcpy((char *)newsrc, file_basename((char *)src), sizeof(newsrc));
             htmlSetVariable(t, (uchar *)"SRC", newsrc);
           }
@@ -832,6 +896,40 @@ write_nodeclose(FILE   *out,		// I - Output file
 }
 
 
+//
+// 'write_section()' - Write the file for a heading.
+//
+// This function is called from hd_parallel() and only reads the document
+// tree, headings, and links.
+//
+
+static void
+write_section(void *data,		// I - Document strings
+              int  index)		// I - Section number
+{
+  section_info_t *info = (section_info_t *)data;
+					// Document strings
+  section_t	*section = sections + index;
+					// Section to write
+  FILE		*out = NULL;		// Output file
+  uchar		filename[1024];		// Filename
+
+
+  stats_begin(HD_STATS_WRITE);
+
+  snprintf((char *)filename, sizeof(filename), "%s.html", headings[index]);
+  write_header(&out, filename, info->title, info->author, info->copyright,
+               info->docnumber, index);
+
+  if (out != NULL)
+    write_doc(out, section->start, (size_t)index < (num_sections - 1) ? section[1].start : NULL);
+
+  section->bytes = write_footer(&out, index);
+
+  stats_end(HD_STATS_WRITE);
+}
+
+
 //
 // 'write_toc()' - Write all markup text for the given table-of-contents.
 //
@@ -892,7 +990,7 @@ get_title(tree_t *doc)			// I - Document tree
 // 'add_heading()' - Add a heading to the list of headings...
 //
 
-static void
+static int				// O - 1 if added, 0 otherwise
 add_heading(tree_t *t)			// I - Heading node
 {
   size_t	i,			// Looping var
@@ -909,7 +1007,7 @@ add_heading(tree_t *t)			// I - Heading node
   if (!heading || !*heading)
   {
     free(heading);
-    return;				// Nothing to do!
+    return (0);				// Nothing to do!
   }
 
   // Sanitize the text...
@@ -952,7 +1050,8 @@ add_heading(tree_t *t)			// I - Heading node
 	             "Unable to allocate memory for %d headings - %s",
 	             (int)alloc_headings, strerror(errno));
       alloc_headings -= ALLOC_HEADINGS;
-      return;
+      free(heading);
+      return (0);
     }
 
     headings = temp;
@@ -971,6 +1070,8 @@ add_heading(tree_t *t)			// I - Heading node
   }
 
   num_headings ++;
+
+  return (1);
 }
 
 
@@ -982,7 +1083,11 @@ static void
 add_link(uchar *name)			// I - Name of link
 {
   uchar		*filename;		// File for link
-  link_t	*temp;			// New name
+  link_t	*temp,			// New name
+		key;			// New link
+  size_t	left,			// Left side of search
+		right,			// Right side of search
+		mid;			// Middle of search
 
 
   if (num_headings)
@@ -1019,16 +1124,64 @@ add_link(uchar *name)			// I - Name of link
       links = temp;
     }
 
-    // Add a new link...
-    temp = links + num_links;
+    // Add a new link after any with the same name, keeping the array
+    // sorted...
+    strlcpy((char *)key.name, (char *)name, sizeof(key.name));
+    key.filename = filename;
+
+    for (left = 0, right = num_links; left < right;)
+    {
+      mid = (left + right) / 2;
+
+      if (compare_links(&key, links + mid) < 0)
+        right = mid;
+      else
+        left = mid + 1;
+    }
+
+    memmove(links + left + 1, links + left, (num_links - left) * sizeof(link_t));
+    links[left] = key;
     num_links ++;
+  }
+}
 
-    strlcpy((char *)temp->name, (char *)name, sizeof(temp->name));
-    temp->filename = filename;
 
-    if (num_links > 1)
-      qsort(links, num_links, sizeof(link_t), (compare_func_t)compare_links);
+//
+// 'add_section()' - Add a heading node that starts a new output file...
+//
+
+static void
+add_section(tree_t *t)			// I - Heading node
+{
+  section_t	*temp;			// New section array pointer
+
+
+  if (num_sections >= alloc_sections)
+  {
+    // Allocate more sections...
+    alloc_sections += ALLOC_HEADINGS;
+
+    if (num_sections == 0)
+      temp = (section_t *)malloc(sizeof(section_t) * alloc_sections);
+    else
+      temp = (section_t *)realloc(sections, sizeof(section_t) * alloc_sections);
+
+    if (temp == NULL)
+    {
+      progress_error(HD_ERROR_OUT_OF_MEMORY,
+	             "Unable to allocate memory for %d sections - %s",
+	             (int)alloc_sections, strerror(errno));
+      alloc_sections -= ALLOC_HEADINGS;
+      return;
+    }
+
+    sections = temp;
   }
+
+  sections[num_sections].start = t;
+  sections[num_sections].bytes = -1;
+
+  num_sections ++;
 }
 
 
@@ -1085,8 +1238,8 @@ scan_links(tree_t *t)			// I - Document tree
   while (t != NULL)
   {
     if (t->markup >= MARKUP_H1 && t->markup < (MARKUP_H1 + TocLevels) &&
-        htmlGetVariable(t, (uchar *)"_HD_OMIT_TOC") == NULL)
-      add_heading(t);
+        htmlGetVariable(t, (uchar *)"_HD_OMIT_TOC") == NULL && add_heading(t))
+      add_section(t);
 
     if (t->markup == MARKUP_A &&
         (name = htmlGetVariable(t, (uchar *)"NAME")) != NULL)
@@ -1119,8 +1272,7 @@ update_links(tree_t *t,			// I - Document tree
   // Scan the document, rewriting HREF's as needed...
   while (t != NULL)
   {
-    if (t->markup >= MARKUP_H1 && t->markup < (MARKUP_H1 + TocLevels) &&
-        htmlGetVariable(t, (uchar *)"_HD_OMIT_TOC") == NULL && heading)
+    if (heading && (size_t)(*heading + 1) < num_sections && sections[*heading + 1].start == t)
       (*heading) ++;
 
     // Figure out the current filename based upon the current heading number...
@@ -31,6 +31,9 @@ extern "C" {		/* Workaround for JPEG header problems... */
  */
 
 #define IMAGE_MAX_DIM	23170		// Maximum dimension - sqrt(2GiB / 4)
+#define IMAGE_MAX_DECODE (256 * 1024 * 1024)
+					// Maximum pixel data decoded at once
+#define IMAGE_PROBE_SIZE 16384		// Bytes to get for remote image headers
 
 
 /*
@@ -42,6 +45,41 @@ extern "C" {		/* Workaround for JPEG header problems... */
 
 typedef uchar	gif_cmap_t[256][3];
 
+typedef struct gif_lzw_s		// GIF LZW decoder state
+{
+  FILE		*fp;			// File to read from
+  uchar		buf[256];		// Current data block
+  int		bufpos,			// Position in data block
+		buflen;			// Length of data block
+  unsigned	bits;			// Unused bits from data block
+  int		numbits,		// Number of unused bits
+		eod,			// Hit end of data blocks?
+		done;			// Done decoding?
+  int		set_code_size,		// Initial code size
+		code_size,		// Current code size
+		clear_code,		// Clear code
+		end_code,		// End code
+		max_code,		// Next code in table
+		max_code_size,		// Code limit for current code size
+		firstcode,		// First index of last string
+		oldcode;		// Last code read or -1 after clear
+  short		prefix[4096];		// String table prefix codes
+  uchar		suffix[4096];		// String table suffix indices
+  uchar		stack[4097];		// Pending indices (reversed)
+  int		sp;			// Number of pending indices
+} gif_lzw_t;
+
+
+/*
+ * Image decoding batch for image_decode()...
+ */
+
+typedef struct image_batch_s		// Images being decoded
+{
+  image_t	**imgs;			// Images
+  int		gray;			// 0 = color, 1 = grayscale
+} image_batch_t;
+
 
 /*
  * BMP definitions...
@@ -62,7 +100,8 @@ typedef uchar	gif_cmap_t[256][3];
 static size_t	num_images = 0,		/* Number of images in cache */
 		alloc_images = 0;	/* Allocated images */
 static image_t	**images = NULL;	/* Images in cache */
-static int	gif_eof = 0;		/* Did we hit EOF? */
+static hd_mutex_t images_mutex = HD_MUTEX_INITIALIZER;
+					/* Lock for image cache */
 
 
 /*
@@ -72,14 +111,19 @@ static int	gif_eof = 0;		/* Did we hit EOF? */
 static int	gif_read_cmap(FILE *fp, int ncolors, gif_cmap_t cmap,
 		              int *gray);
 static int	gif_get_block(FILE *fp, uchar *buffer);
-static int	gif_get_code (FILE *fp, int code_size, int first_time);
+static int	gif_get_code(gif_lzw_t *lzw);
 static int	gif_read_image(FILE *fp, image_t *img, gif_cmap_t cmap,
 		               int interlace, int transparent);
-static int	gif_read_lzw(FILE *fp, int first_time, int input_code_size);
+static int	gif_read_lzw(gif_lzw_t *lzw, FILE *fp, int input_code_size,
+		             uchar *out, int count);
 
+static int	image_check_header(FILE *fp);
 static int	image_compare(image_t **img1, image_t **img2);
+static void	image_decode_cb(image_batch_t *batch, int index);
 static int	image_load_bmp(image_t *img, FILE *fp, int gray, int load_data);
 static int	image_load_gif(image_t *img, FILE *fp, int gray, int load_data);
+static image_t	*image_load_locked(const char *filename, int gray, int load_data);
+static int	image_read(image_t *img, int gray, int load_data);
 
 #ifdef HAVE_LIBJPEG
 static int	image_load_jpeg(image_t *img, FILE *fp, int gray, int load_data);
@@ -165,124 +209,58 @@ gif_get_block(FILE  *fp,	/* I - File to read from */
   */
 
   if ((count = getc(fp)) == EOF)
-  {
-    gif_eof = 1;
     return (-1);
-  }
-  else if (count == 0)
-    gif_eof = 1;
-  else if (fread(buf, 1, (size_t)count, fp) < (size_t)count)
+  else if (count > 0 && fread(buf, 1, (size_t)count, fp) < (size_t)count)
   {
     progress_error(HD_ERROR_READ_ERROR,
                    "Unable to read GIF block of %d bytes: %s", count,
                    strerror(errno));
-    gif_eof = 1;
     return (-1);
   }
-  else
-    gif_eof = 0;
 
   return (count);
 }
 
 
 /*
- * 'gif_get_code()' - Get a LZW code from the file...
+ * 'gif_get_code()' - Get a LZW code from the data blocks...
  */
 
-static int			/* O - LZW code */
-gif_get_code(FILE *fp,		/* I - File to read from */
-	     int  code_size,	/* I - Size of code in bits */
-	     int  first_time)	/* I - 1 = first time, 0 = not first time */
+static int				/* O - LZW code or -1 on end of data */
+gif_get_code(gif_lzw_t *lzw)		/* I - LZW decoder */
 {
-  unsigned		i, j,		/* Looping vars */
-			ret;		/* Return value */
-  int			count;		/* Number of bytes read */
-  static uchar		buf[280];	/* Input buffer */
-  static unsigned	curbit,		/* Current bit */
-			lastbit,	/* Last bit in buffer */
-			done,		/* Done with this buffer? */
-			last_byte;	/* Last byte in buffer */
-  static unsigned	bits[8] =	/* Bit masks for codes */
-			{
-			  0x01, 0x02, 0x04, 0x08,
-			  0x10, 0x20, 0x40, 0x80
-			};
-
-
-  if (first_time)
-  {
-   /*
-    * Just initialize the input buffer...
-    */
+  int	count,				/* Number of bytes read */
+	code;				/* Code */
 
-    curbit    = 0;
-    lastbit   = 0;
-    last_byte = 0;
-    done      = 0;
 
-    return (0);
-  }
+ /*
+  * Codes are packed LSB first, so shift whole bytes into the bit buffer
+  * until we have enough bits for the current code...
+  */
 
-  if ((curbit + (unsigned)code_size) >= lastbit)
+  while (lzw->numbits < lzw->code_size)
   {
-   /*
-    * Don't have enough bits to hold the code...
-    */
-
-    if (done)
+    if (lzw->bufpos >= lzw->buflen)
     {
-      progress_error(HD_ERROR_READ_ERROR, "Not enough data left to read GIF compression code.");
-      return (-1);	/* Sorry, no more... */
-    }
-
-   /*
-    * Move last two bytes to front of buffer...
-    */
-
-    if (last_byte > 1)
-    {
-      buf[0]    = buf[last_byte - 2];
-      buf[1]    = buf[last_byte - 1];
-      last_byte = 2;
-    }
-    else if (last_byte == 1)
-    {
-      buf[0]    = buf[last_byte - 1];
-      last_byte = 1;
-    }
-
-   /*
-    * Read in another buffer...
-    */
-
-    if ((count = gif_get_block(fp, buf + last_byte)) <= 0)
-    {
-     /*
-      * Whoops, no more data!
-      */
+      if (lzw->eod || (count = gif_get_block(lzw->fp, lzw->buf)) <= 0)
+      {
+        lzw->eod = 1;
+        return (-1);
+      }
 
-      done = 1;
-      return (-1);
+      lzw->bufpos = 0;
+      lzw->buflen = count;
     }
 
-   /*
-    * Update buffer state...
-    */
-
-    curbit    = curbit + 8 * last_byte - lastbit;
-    last_byte += (unsigned)count;
-    lastbit   = last_byte * 8;
+    lzw->bits    |= (unsigned)lzw->buf[lzw->bufpos ++] << lzw->numbits;
+    lzw->numbits += 8;
   }
 
-  for (ret = 0, i = curbit + (unsigned)code_size - 1, j = (unsigned)code_size;
-       j > 0;
-       i --, j --)
-    ret = (ret << 1) | ((buf[i / 8] & bits[i & 7]) != 0);
+  code         = (int)(lzw->bits & ((1U << lzw->code_size) - 1));
+  lzw->bits    >>= lzw->code_size;
+  lzw->numbits -= lzw->code_size;
 
-  curbit += (unsigned)code_size;
-
-  return (int)ret;
+  return (code);
 }
 
 
@@ -297,233 +275,382 @@ gif_read_image(FILE       *fp,		/* I - Input file */
 	       int        interlace,	/* I - Non-zero = interlaced image */
 	       int        transparent)	/* I - Transparent color */
 {
-  uchar		code_size,		/* Code size */
+  int		code_size;		/* Code size */
+  gif_lzw_t	*lzw;			/* LZW decoder */
+  uchar		*row,			/* Colormap indices for row */
+		*rowptr,		/* Pointer into row */
 		*temp;			/* Current pixel */
-  int		xpos,			/* Current X position */
+  int		count,			/* Number of indices decoded */
+		xpos,			/* Current X position */
 		ypos,			/* Current Y position */
 		pass;			/* Current pass */
-  int		pixel;			/* Current pixel */
-  static int	xpasses[4] = { 8, 8, 4, 2 },
-		ypasses[5] = { 0, 4, 2, 1, 999999 };
-
+  static const int xpasses[4] = { 8, 8, 4, 2 },
+		ypasses[4] = { 0, 4, 2, 1 };
 
-  xpos      = 0;
-  ypos      = 0;
-  pass      = 0;
-  code_size = (uchar)getc(fp);
 
-  if (code_size < 2 || code_size > 8)
+  if ((code_size = getc(fp)) < 2 || code_size > 8)
   {
     progress_error(HD_ERROR_READ_ERROR, "Bad GIF file '%s': invalid code size %d.", img->filename, code_size);
     return (-1);
   }
 
-  if (gif_read_lzw(fp, 1, code_size) < 0)
+  if ((lzw = (gif_lzw_t *)malloc(sizeof(gif_lzw_t) + (size_t)img->width)) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for '%s'.", img->filename);
     return (-1);
+  }
 
-  temp = img->pixels;
+  gif_read_lzw(lzw, fp, code_size, NULL, 0);
 
-  while ((pixel = gif_read_lzw(fp, 0, code_size)) >= 0 && pixel < 256)
-  {
-    temp[0] = cmap[pixel][0];
+  row = (uchar *)(lzw + 1);
+
+ /*
+  * Decode each row of colormap indices and then convert them to pixels.
+  * Interlaced images are stored in 4 passes: every 8th row starting at row
+  * 0, every 8th row starting at row 4, every 4th row starting at row 2, and
+  * every 2nd row starting at row 1...
+  */
 
-    if (img->depth > 1)
+  for (pass = interlace ? 0 : 3; pass < 4; pass ++)
+  {
+    for (ypos = interlace ? ypasses[pass] : 0;
+         ypos < img->height;
+	 ypos += interlace ? xpasses[pass] : 1)
     {
-      temp[1] = cmap[pixel][1];
-      temp[2] = cmap[pixel][2];
-    }
+      if ((count = gif_read_lzw(lzw, fp, code_size, row, img->width)) < img->width)
+      {
+       /*
+        * Use the first color for any missing data...
+	*/
 
-    if (pixel == transparent)
-      image_set_mask(img, xpos, ypos);
+        memset(row + count, 0, (size_t)(img->width - count));
+      }
 
-    xpos ++;
-    temp += img->depth;
-    if (xpos == img->width)
-    {
-      xpos = 0;
+      temp = img->pixels + ypos * img->width * img->depth;
 
-      if (interlace)
+      if (img->depth == 1)
       {
-        ypos += xpasses[pass];
-        temp += (xpasses[pass] - 1) * img->width * img->depth;
-
-        if (ypos >= img->height)
+	for (xpos = img->width, rowptr = row; xpos > 0; xpos --, rowptr ++, temp ++)
+	  *temp = cmap[*rowptr][0];
+      }
+      else
+      {
+	for (xpos = img->width, rowptr = row; xpos > 0; xpos --, rowptr ++, temp += 3)
 	{
-	  pass ++;
-
-          ypos = ypasses[pass];
-          temp = img->pixels + ypos * img->width * img->depth;
+	  temp[0] = cmap[*rowptr][0];
+	  temp[1] = cmap[*rowptr][1];
+	  temp[2] = cmap[*rowptr][2];
 	}
       }
-      else
-	ypos ++;
-    }
 
-    if (ypos >= img->height)
-      break;
+      if (transparent >= 0)
+      {
+	for (xpos = 0; xpos < img->width; xpos ++)
+	  if (row[xpos] == transparent)
+	    image_set_mask(img, xpos, ypos);
+      }
+    }
   }
 
+  free(lzw);
+
   return (0);
 }
 
 
 /*
- * 'gif_read_lzw()' - Read a byte from the LZW stream...
+ * 'gif_read_lzw()' - Decode colormap indices from the LZW stream...
+ *
+ * Call with "count" equal to 0 to initialize the decoder.
  */
 
-static int				/* I - Byte from stream */
-gif_read_lzw(FILE *fp,			/* I - File to read from */
-	     int  first_time,		/* I - 1 = first time, 0 = not first time */
- 	     int  input_code_size)	/* I - Code size in bits */
+static int				/* O - Number of indices decoded */
+gif_read_lzw(gif_lzw_t *lzw,		/* I - LZW decoder */
+             FILE      *fp,		/* I - File to read from */
+	     int       input_code_size,	/* I - Code size in bits */
+	     uchar     *out,		/* I - Output buffer */
+	     int       count)		/* I - Number of indices to decode */
 {
   int		i,			/* Looping var */
 		code,			/* Current code */
-		incode;			/* Input code */
-  static short	fresh = 0,		/* 1 = empty buffers */
-		code_size = 0,		/* Current code size */
-		set_code_size = 0,	/* Initial code size set */
-		max_code = 0,		/* Maximum code used */
-		max_code_size = 0,	/* Maximum code size */
-		firstcode = 0,		/* First code read */
-		oldcode = 0,		/* Last code read */
-		clear_code = 0,		/* Clear code for LZW input */
-		end_code = 0,		/* End code for LZW input */
-		table[2][4096],		/* String table */
-		stack[8192],		/* Output stack */
-		*sp = stack;		/* Current stack pointer */
-
-
-  if (first_time)
+		incode,			/* Input code */
+		num;			/* Number of indices decoded */
+  uchar		buf[256];		/* Data block buffer */
+
+
+  if (count == 0)
   {
    /*
     * Setup LZW state...
     */
 
-    set_code_size = (short)input_code_size;
-    code_size     = set_code_size + 1;
-    clear_code    = (short)(1 << set_code_size);
-    end_code      = clear_code + 1;
-    max_code_size = 2 * clear_code;
-    max_code      = clear_code + 2;
+    memset(lzw, 0, sizeof(gif_lzw_t));
 
-   /*
-    * Initialize input buffers...
-    */
+    lzw->fp            = fp;
+    lzw->set_code_size = input_code_size;
+    lzw->code_size     = input_code_size + 1;
+    lzw->clear_code    = 1 << input_code_size;
+    lzw->end_code      = lzw->clear_code + 1;
+    lzw->max_code_size = 2 * lzw->clear_code;
+    lzw->max_code      = lzw->clear_code + 2;
+    lzw->oldcode       = -1;
+
+    for (i = 0; i < lzw->clear_code; i ++)
+      lzw->suffix[i] = (uchar)i;
+
+    return (0);
+  }
 
-    gif_get_code(fp, 0, 1);
+  num = 0;
 
+  while (num < count)
+  {
    /*
-    * Wipe the decompressor table...
+    * Copy any pending indices from the last string...
     */
 
-    fresh = 1;
+    while (lzw->sp > 0 && num < count)
+      out[num ++] = lzw->stack[-- lzw->sp];
 
-    for (i = 0; i < clear_code; i ++)
+    if (num >= count || lzw->done)
+      break;
+
+    if ((code = gif_get_code(lzw)) < 0)
     {
-      table[0][i] = 0;
-      table[1][i] = (short)i;
+      lzw->done = 1;
+      break;
     }
 
-    for (; i < 4096; i ++)
-      table[0][i] = table[1][0] = 0;
+    if (code == lzw->clear_code)
+    {
+     /*
+      * Reset the string table...
+      */
 
-    sp = stack;
+      lzw->code_size     = lzw->set_code_size + 1;
+      lzw->max_code_size = 2 * lzw->clear_code;
+      lzw->max_code      = lzw->clear_code + 2;
+      lzw->oldcode       = -1;
+      continue;
+    }
+    else if (code == lzw->end_code)
+    {
+     /*
+      * Skip any remaining data blocks...
+      */
 
-    return (0);
-  }
-  else if (fresh)
-  {
-    fresh = 0;
+      if (!lzw->eod)
+        while (gif_get_block(fp, buf) > 0);
 
-    do
-      firstcode = oldcode = (short)gif_get_code(fp, code_size, 0);
-    while (firstcode == clear_code);
+      lzw->eod  = 1;
+      lzw->done = 1;
+      break;
+    }
+    else if (lzw->oldcode < 0)
+    {
+     /*
+      * The first code after a clear code is a single index...
+      */
 
-    return (firstcode);
-  }
+      if (code >= lzw->clear_code)
+      {
+        lzw->done = 1;
+        break;
+      }
 
-  if (sp > stack)
-    return (*--sp);
+      out[num ++]    = (uchar)code;
+      lzw->firstcode = code;
+      lzw->oldcode   = code;
+      continue;
+    }
 
-  while ((code = gif_get_code(fp, code_size, 0)) >= 0)
-  {
-    if (code == clear_code)
+    incode = code;
+
+    if (code >= lzw->max_code)
     {
-      for (i = 0; i < clear_code; i ++)
+      if (code > lzw->max_code)
       {
-	table[0][i] = 0;
-	table[1][i] = (short)i;
+        lzw->done = 1;
+        break;
       }
 
-      for (; i < 4096; i ++)
-	table[0][i] = table[1][i] = 0;
+      lzw->stack[lzw->sp ++] = (uchar)lzw->firstcode;
+      code = lzw->oldcode;
+    }
 
-      code_size     = set_code_size + 1;
-      max_code_size = 2 * clear_code;
-      max_code      = clear_code + 2;
+    while (code >= lzw->clear_code)
+    {
+      if (lzw->sp >= (int)sizeof(lzw->stack))
+      {
+        lzw->done = 1;
+	return (num);
+      }
 
-      sp = stack;
+      lzw->stack[lzw->sp ++] = lzw->suffix[code];
+      code = lzw->prefix[code];
+    }
 
-      firstcode = oldcode = (short)gif_get_code(fp, code_size, 0);
+    lzw->firstcode         = lzw->suffix[code];
+    lzw->stack[lzw->sp ++] = (uchar)lzw->firstcode;
 
-      return (firstcode);
+    if ((code = lzw->max_code) < 4096)
+    {
+      lzw->prefix[code] = (short)lzw->oldcode;
+      lzw->suffix[code] = (uchar)lzw->firstcode;
+      lzw->max_code ++;
+
+      if (lzw->max_code >= lzw->max_code_size && lzw->max_code_size < 4096)
+      {
+	lzw->max_code_size *= 2;
+	lzw->code_size ++;
+      }
     }
-    else if (code == end_code)
+
+    lzw->oldcode = incode;
+  }
+
+  return (num);
+}
+
+
+/*
+ * 'image_check_header()' - Check that a file contains a complete image header.
+ *
+ * This walks the GIF blocks, PNG chunks, or JPEG markers that the loaders
+ * read before the image data, or the BMP header and colormap, without
+ * decoding anything.  Files in other formats are reported as complete so that
+ * the loader can report the error.
+ */
+
+static int				/* O - 1 if complete, 0 if truncated */
+image_check_header(FILE *fp)		/* I - File to check */
+{
+  uchar		buf[16];		/* Header buffer */
+  int		ch,			/* Current character */
+		marker;			/* JPEG marker */
+  long		length;			/* Length of block/chunk/marker */
+
+
+  rewind(fp);
+
+  if (fread(buf, 1, sizeof(buf), fp) < sizeof(buf))
+    return (0);
+
+  if (!memcmp(buf, "GIF87a", 6) || !memcmp(buf, "GIF89a", 6))
+  {
+   /*
+    * Skip the global colormap and extensions up to the image descriptor and
+    * its local colormap...
+    */
+
+    length = 13;
+    if (buf[10] & GIF_COLORMAP)
+      length += 3 * (2 << (buf[10] & 0x07));
+
+    fseek(fp, length, SEEK_SET);
+
+    for (;;)
     {
-      uchar	buf[260];
+      switch (getc(fp))
+      {
+        case '!' :			/* Extension record */
+            if (getc(fp) == EOF)
+              return (0);
 
-      if (!gif_eof)
-        while (gif_get_block(fp, buf) > 0);
+            while ((ch = getc(fp)) > 0)
+              fseek(fp, ch, SEEK_CUR);
+
+            if (ch == EOF)
+              return (0);
+            break;
 
-      return (-2);
+        case ',' :			/* Image descriptor */
+            if (fread(buf, 1, 9, fp) < 9)
+              return (0);
+
+            if (!(buf[8] & GIF_COLORMAP))
+              return (1);
+
+            fseek(fp, 3 * (2 << (buf[8] & 0x07)) - 1, SEEK_CUR);
+
+            return (getc(fp) != EOF);
+
+        case EOF :
+            return (0);
+
+        default :
+            return (1);
+      }
     }
+  }
+  else if (!memcmp(buf, "\211PNG", 4))
+  {
+   /*
+    * Skip chunks up to the first IDAT chunk...
+    */
 
-    incode = code;
+    fseek(fp, 8, SEEK_SET);
 
-    if (code >= max_code)
+    while (fread(buf, 1, 8, fp) == 8)
     {
-      *sp++ = firstcode;
-      code  = oldcode;
+      if (!memcmp(buf + 4, "IDAT", 4))
+        return (1);
+
+      length = ((long)buf[0] << 24) | (buf[1] << 16) | (buf[2] << 8) | buf[3];
+      fseek(fp, length + 4, SEEK_CUR);
     }
 
-    while (code >= clear_code)
-    {
-      if (sp >= (stack + sizeof(stack) / sizeof(stack[0])))
-        return (255);
+    return (0);
+  }
+  else if (!memcmp(buf, "\377\330\377", 3))
+  {
+   /*
+    * Skip markers up to and including the start of scan...
+    */
 
-      *sp++ = table[1][code];
+    fseek(fp, 2, SEEK_SET);
 
-      if (code == table[0][code])
-	return (255);
+    for (;;)
+    {
+      if ((ch = getc(fp)) != 0xff)
+        return (ch != EOF);
 
-      code = table[0][code];
-    }
+      while ((marker = getc(fp)) == 0xff);
 
-    if (sp >= (stack + sizeof(stack) / sizeof(stack[0])))
-      return (255);
+      if (marker == EOF)
+        return (0);
+      else if (marker == 0x01 || (marker >= 0xd0 && marker <= 0xd8))
+        continue;			/* Marker without a length */
 
-    *sp++ = firstcode = table[1][code];
+      if ((length = getc(fp)) == EOF || (ch = getc(fp)) == EOF)
+        return (0);
 
-    if ((code = max_code) < 4096)
-    {
-      table[0][code] = oldcode;
-      table[1][code] = firstcode;
-      max_code ++;
+      length = (length << 8) | ch;
+      fseek(fp, length - 3, SEEK_CUR);
 
-      if (max_code >= max_code_size && max_code_size < 4096)
-      {
-	max_code_size *= 2;
-	code_size ++;
-      }
+      if (getc(fp) == EOF)
+        return (0);
+      else if (marker == 0xda)
+        return (1);
     }
+  }
+  else if (!memcmp(buf, "BM", 2))
+  {
+   /*
+    * Make sure we have everything up to the pixel data...
+    */
 
-    oldcode = (short)incode;
+    length = buf[10] | (buf[11] << 8) | (buf[12] << 16) | ((long)buf[13] << 24);
 
-    if (sp > stack)
-      return (*--sp);
+    if (length < 16 || length > 2048)
+      length = 2048;
+
+    fseek(fp, length - 1, SEEK_SET);
+
+    return (getc(fp) != EOF);
   }
 
-  return (code);
+  return (1);
 }
 
 
@@ -561,6 +688,13 @@ image_copy(const char *src,		/* I - Source file */
   if (!src || !realsrc || !destpath)
     return;
 
+ /*
+  * Remote images are not retrieved until they are needed...
+  */
+
+  if (file_method(realsrc) && (realsrc = file_find(Path, realsrc)) == NULL)
+    return;
+
  /*
   * Figure out the destination filename...
   */
@@ -594,12 +728,119 @@ image_copy(const char *src,		/* I - Source file */
     fwrite(buffer, 1, (size_t)nbytes, out);
 
   progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(out));
+  stats_count(HD_COUNT_BYTES_OUT, ftell(out));
 
   fclose(in);
   fclose(out);
 }
 
 
+/*
+ * 'image_decode()' - Decode the pixel data for a list of images.
+ *
+ * Images are decoded in order using worker threads, in batches whose pixel
+ * data fits in IMAGE_MAX_DECODE bytes.  The callback, if any, is called from
+ * the current thread for each image in the list as soon as its batch has
+ * been decoded, so the callback can write and unload each image before the
+ * next batch is decoded.  Images that cannot be decoded are skipped.
+ *
+ * Without a callback only the first batch is decoded, and the remaining
+ * images are loaded when they are used.
+ */
+
+void
+image_decode(int        num_imgs,	/* I - Number of images */
+             image_t    **imgs,		/* I - Images */
+             int        gray,		/* I - 0 = color, 1 = grayscale */
+             image_cb_t cb,		/* I - Callback or NULL */
+             void       *data)		/* I - Callback data */
+{
+  int		i, j,			/* Looping vars */
+		first,			/* First image in batch */
+		last,			/* Last image in batch */
+		count;			/* Number of images to decode */
+  size_t	bytes,			/* Bytes in batch */
+		size;			/* Bytes for current image */
+  image_t	*img;			/* Current image */
+  image_batch_t	batch;			/* Images to decode */
+
+
+  if (num_imgs <= 0 || !imgs)
+    return;
+
+  if ((batch.imgs = (image_t **)malloc((size_t)num_imgs * sizeof(image_t *))) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d images.", num_imgs);
+    return;
+  }
+
+  batch.gray = gray;
+
+  for (first = 0; first < num_imgs; first = last)
+  {
+   /*
+    * Collect the images that need to be decoded, stopping when the memory
+    * limit is reached...
+    */
+
+    for (last = first, count = 0, bytes = 0; last < num_imgs; last ++)
+    {
+      img = imgs[last];
+
+      if (img->pixels || img->obj)
+        continue;
+
+      for (j = 0; j < count; j ++)
+        if (batch.imgs[j] == img)
+	  break;
+
+      if (j < count)
+        continue;
+
+      size = (size_t)img->width * (size_t)img->height * (size_t)img->depth;
+
+      if (count > 0 && (bytes + size) > IMAGE_MAX_DECODE)
+        break;
+
+      batch.imgs[count ++] = img;
+      bytes += size;
+    }
+
+   /*
+    * Decode them and then pass the images to the callback in order...
+    */
+
+    stats_begin(HD_STATS_IMAGES);
+    hd_parallel(count, (hd_work_cb_t)image_decode_cb, &batch);
+    stats_end(HD_STATS_IMAGES);
+
+    if (!cb)
+      break;
+
+    for (i = first; i < last; i ++)
+      if (imgs[i]->pixels || imgs[i]->obj)
+        (*cb)(data, imgs[i]);
+  }
+
+  free(batch.imgs);
+}
+
+
+/*
+ * 'image_decode_cb()' - Decode one image in a batch.
+ *
+ * This function is called from hd_parallel() and only changes the image
+ * it decodes.
+ */
+
+static void
+image_decode_cb(image_batch_t *batch,	/* I - Images to decode */
+                int           index)	/* I - Image index */
+{
+  image_read(batch->imgs[index], batch->gray, 1);
+}
+
+
 /*
  * 'image_find()' - Find an image file in memory...
  */
@@ -627,6 +868,8 @@ image_find(const char *filename,/* I - Name of image file */
   * See if we've already loaded it...
   */
 
+  hd_mutex_lock(&images_mutex);
+
   if (num_images > 0)
   {
     strlcpy(key.filename, filename, sizeof(key.filename));
@@ -636,13 +879,19 @@ image_find(const char *filename,/* I - Name of image file */
                                 (int (*)(const void *, const void *))image_compare);
     if (match != NULL)
     {
-      if (load_data && !(*match)->pixels)
-        return (image_load((*match)->filename, (*match)->depth == 1, 1));
-      else
-        return (*match);
+      image_t *img = *match;		/* Matching image */
+
+      if (load_data && !img->pixels)
+        img = image_load_locked(img->filename, img->depth == 1, 1);
+
+      hd_mutex_unlock(&images_mutex);
+
+      return (img);
     }
   }
 
+  hd_mutex_unlock(&images_mutex);
+
   return (NULL);
 }
 
@@ -704,18 +953,36 @@ image_load(const char *filename,/* I - Name of image file */
            int        gray,	/* I - 0 = color, 1 = grayscale */
            int        load_data)/* I - 1 = load image data, 0 = just info */
 {
-#ifdef DEBUG
-  int		i;		/* Looping var */
-#endif // DEBUG
-  FILE		*fp;		/* File pointer */
-  uchar		header[16];	/* First 16 bytes of file */
+  image_t	*img;		/* Image */
+
+
+ /*
+  * Images are shared by all layout threads, so only one thread can load an
+  * image at a time...
+  */
+
+  hd_mutex_lock(&images_mutex);
+  img = image_load_locked(filename, gray, load_data);
+  hd_mutex_unlock(&images_mutex);
+
+  return (img);
+}
+
+
+/*
+ * 'image_load_locked()' - Load an image file from disk with the cache locked.
+ */
+
+static image_t *		/* O - Pointer to image */
+image_load_locked(const char *filename,/* I - Name of image file */
+                  int        gray,	/* I - 0 = color, 1 = grayscale */
+                  int        load_data)/* I - 1 = load image data, 0 = just info */
+{
   image_t	*img,		/* New image buffer */
 		key,		/* Search key... */
 		*keyptr,	/* Pointer to search key... */
 		**match,	/* Matching image */
 		**temp;		/* Temporary array pointer */
-  int		status;		/* Status of load... */
-  const char	*realname;	/* Real filename */
 
 
  /*
@@ -728,7 +995,7 @@ image_load(const char *filename,/* I - Name of image file */
   if (filename[0] == '\0')	/* Microsoft VC++ runtime bug workaround... */
     return (NULL);
 
-  DEBUG_printf(("image_load(filename=\"%s\", gray=%d, load_data=%d)\n",
+  DEBUG_printf(("image_load_locked(filename=\"%s\", gray=%d, load_data=%d)\n",
                 filename, gray, load_data));
   DEBUG_printf(("Path = \"%s\"\n", Path));
 
@@ -746,51 +1013,13 @@ image_load(const char *filename,/* I - Name of image file */
     if (match != NULL && (!load_data || (*match)->pixels))
     {
       (*match)->use ++;
+      stats_count(HD_COUNT_CACHE_HITS, 1);
       return (*match);
     }
   }
   else
     match = NULL;
 
- /*
-  * Figure out the file type...
-  */
-
-  if ((realname = file_find(Path, filename)) == NULL)
-  {
-    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find image file '%s'.", filename);
-    return (NULL);
-  }
-
-  if ((fp = fopen(realname, "rb")) == NULL)
-  {
-    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open image file '%s' (%s) for reading.", filename, realname);
-    return (NULL);
-  }
-
-  if (fread(header, 1, sizeof(header), fp) == 0)
-  {
-    progress_error(HD_ERROR_READ_ERROR, "Unable to read image file '%s'.", filename);
-    fclose(fp);
-    return (NULL);
-  }
-
-#ifdef DEBUG
-  printf("Header for \"%s\" (%s): \"", filename, realname);
-
-  for (i = 0; i < (int)sizeof(header); i ++)
-    if (header[i] < ' ' || header[i] >= 127)
-      printf("\\x%02X", header[i]);
-    else
-      putchar(header[i]);
-
-  puts("\"\n");
-
-  printf("match = %p\n", (void *)match);
-#endif // DEBUG
-
-  rewind(fp);
-
   // See if the images array needs to be resized...
   if (!match)
   {
@@ -807,7 +1036,6 @@ image_load(const char *filename,/* I - Name of image file */
       if (temp == NULL)
       {
 	progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d images.", (int)alloc_images);
-	fclose(fp);
 	return (NULL);
       }
 
@@ -818,19 +1046,123 @@ image_load(const char *filename,/* I - Name of image file */
     if ((img = (image_t *)calloc(sizeof(image_t), 1)) == NULL)
     {
       progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for '%s'.", filename);
-      fclose(fp);
       return (NULL);
     }
 
-    images[num_images] = img;
-
     strlcpy(img->filename, filename, sizeof(img->filename));
     img->use = 1;
   }
   else
     img = *match;
 
+  // Load the image...
+  if (image_read(img, gray, load_data))
+  {
+    if (!match)
+      free(img);
+    return (NULL);
+  }
+
+  if (!match)
+  {
+    images[num_images ++] = img;
+    if (num_images > 1)
+      qsort(images, num_images, sizeof(image_t *),
+            (int (*)(const void *, const void *))image_compare);
+  }
+
+  return (img);
+}
+
+
+/*
+ * 'image_read()' - Read an image file.
+ *
+ * This function only changes the image passed to it and can be called from
+ * several threads at once for different images.
+ */
+
+static int			/* O - 0 = success, -1 = fail */
+image_read(image_t *img,	/* I - Image */
+           int     gray,	/* I - 0 = color, 1 = grayscale */
+           int     load_data)	/* I - 1 = load image data, 0 = just info */
+{
+#ifdef DEBUG
+  int		i;		/* Looping var */
+#endif // DEBUG
+  FILE		*fp;		/* File pointer */
+  uchar		header[16];	/* First 16 bytes of file */
+  int		status;		/* Status of load... */
+  const char	*filename,	/* Image filename */
+		*realname;	/* Real filename */
+
+
+ /*
+  * Figure out the file type...  Layout only needs the image dimensions, so
+  * just get the start of remote files until the image data is needed...
+  */
+
+  filename = img->filename;
+
+  if (!load_data && file_method(filename))
+    realname = file_probe(Path, filename, IMAGE_PROBE_SIZE);
+  else
+    realname = file_find(Path, filename);
+
+  if (!realname)
+  {
+    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find image file '%s'.", filename);
+    return (-1);
+  }
+
+  if ((fp = fopen(realname, "rb")) == NULL)
+  {
+    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open image file '%s' (%s) for reading.", filename, realname);
+    return (-1);
+  }
+
+  if (!load_data && file_method(filename) && !image_check_header(fp))
+  {
+   /*
+    * The image header is larger than the start of the file we got, so get
+    * the whole file...
+    */
+
+    fclose(fp);
+
+    if ((realname = file_find(Path, filename)) == NULL || (fp = fopen(realname, "rb")) == NULL)
+    {
+      progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open image file '%s' for reading.", filename);
+      return (-1);
+    }
+  }
+
+  rewind(fp);
+
+  if (fread(header, 1, sizeof(header), fp) == 0)
+  {
+    progress_error(HD_ERROR_READ_ERROR, "Unable to read image file '%s'.", filename);
+    fclose(fp);
+    return (-1);
+  }
+
+#ifdef DEBUG
+  printf("Header for \"%s\" (%s): \"", filename, realname);
+
+  for (i = 0; i < (int)sizeof(header); i ++)
+    if (header[i] < ' ' || header[i] >= 127)
+      printf("\\x%02X", header[i]);
+    else
+      putchar(header[i]);
+
+  puts("\"\n");
+#endif // DEBUG
+
+  rewind(fp);
+
   // Load the image as appropriate...
+  stats_begin(HD_STATS_IMAGES);
+
   if (memcmp(header, "GIF87a", 6) == 0 ||
       memcmp(header, "GIF89a", 6) == 0)
     status = image_load_gif(img,  fp, gray, load_data);
@@ -847,31 +1179,19 @@ image_load(const char *filename,/* I - Name of image file */
   else
   {
     progress_error(HD_ERROR_BAD_FORMAT, "Unknown image file format for '%s'.", file_rlookup(filename));
+    stats_end(HD_STATS_IMAGES);
     fclose(fp);
-    if (!match)
-      free(img);
-    return (NULL);
+    return (-1);
   }
 
+  stats_end(HD_STATS_IMAGES);
+
   fclose(fp);
 
   if (status)
-  {
     progress_error(HD_ERROR_READ_ERROR, "Unable to load image file '%s'.", file_rlookup(filename));
-    if (!match)
-      free(img);
-    return (NULL);
-  }
-
-  if (!match)
-  {
-    num_images ++;
-    if (num_images > 1)
-      qsort(images, num_images, sizeof(image_t *),
-            (int (*)(const void *, const void *))image_compare);
-  }
 
-  return (img);
+  return (status);
 }
 
 
@@ -1294,6 +1614,7 @@ image_load_gif(image_t *img,	/* I - Image pointer */
     switch (getc(fp))
     {
       case ';' :	/* End of image */
+      case EOF :
           return (-1);		/* Early end of file */
 
       case '!' :	/* Extension record */
@@ -1305,7 +1626,7 @@ image_load_gif(image_t *img,	/* I - Image pointer */
               transparent = buf[3];
           }
 
-          while (gif_get_block(fp, buf) != 0);
+          while (gif_get_block(fp, buf) > 0);
           break;
 
       case ',' :	/* Image data */
@@ -1805,12 +2126,12 @@ image_set_mask(image_t *img,	/* I - Image to operate on */
 {
   int		i, j;		/* Looping vars */
   uchar		*maskptr;	/* Pointer into mask image */
-  static uchar	masks[8] =	/* Masks for each bit */
+  static const uchar masks[8] =	/* Masks for each bit */
 		{
 		  0x80, 0x40, 0x20, 0x10,
 		  0x08, 0x04, 0x02, 0x01
 		};
-  static uchar	dither[4][4] = // Simple 4x4 clustered-dot dither
+  static const uchar dither[4][4] = // Simple 4x4 clustered-dot dither
 		{
 		  { 0,  2,  15, 6 },
 		  { 4,  12, 9,  11 },
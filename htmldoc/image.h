@@ -45,6 +45,9 @@ typedef struct			/**** Image structure ****/
 		maskscale;	/* Scaling of mask data */
 } image_t;
 
+typedef void (*image_cb_t)(void *data, image_t *img);
+				/**** Image callback ****/
+
 
 /*
  * Prototypes...
@@ -52,6 +55,8 @@ typedef struct			/**** Image structure ****/
 
 extern void	image_copy(const char *src, const char *realsrc,
 		           const char *destpath);
+extern void	image_decode(int num_imgs, image_t **imgs, int gray,
+		             image_cb_t cb, void *data);
 extern image_t	*image_find(const char *filename, int load_data = 0);
 extern void	image_flush_cache(void);
 extern int	image_getlist(image_t ***ptrs);
@@ -14,6 +14,8 @@
 
 #include "html.h"
 #include "types.h"
+#include "thread.h"
+#include "hash.h"
 
 
 /*
@@ -26,6 +28,7 @@ typedef struct
   int	value;
 } lut_t;
 
+// Run "tools/makehash.py" to update "hash.h" after changing this table...
 static lut_t	iso8859_numbers[] =
 		{
 		  { "AElig",	198 },
@@ -281,10 +284,9 @@ static lut_t	iso8859_numbers[] =
 		  { "zwj",	8205 },
 		  { "zwnj",	8204 }
 		};
+static_assert(sizeof(iso8859_numbers) / sizeof(iso8859_numbers[0]) == HD_ENTITY_COUNT, "Run \"tools/makehash.py\" to update \"hash.h\".");
 static lut_t	*iso8859_names[256];
 
-static int	compare_lut(lut_t *, lut_t *);
-
 
 /*
  * 'iso8859()' - Return the 8-bit character value of a glyph name.
@@ -293,9 +295,8 @@ static int	compare_lut(lut_t *, lut_t *);
 uchar					/* O - ISO-8859-1 equivalent */
 iso8859(uchar *name)			/* I - Glyph name */
 {
-  lut_t	key,				/* Lookup table key */
-	*match;				/* Matching entry pointer */
-  int	ch;				/* Character */
+  int	i,				/* Index in lookup table */
+	ch;				/* Character */
 
 
   if (strlen((char *)name) == 1)
@@ -313,16 +314,13 @@ iso8859(uchar *name)			/* I - Glyph name */
   }
   else
   {
-    strlcpy((char *)key.name, (char *)name, sizeof(key.name));
-    match = (lut_t *)bsearch(&key, iso8859_numbers,
-                             sizeof(iso8859_numbers) / sizeof(iso8859_numbers[0]),
-                             sizeof(iso8859_numbers[0]),
-                             (int (*)(const void *, const void *))compare_lut);
+    // Look up the named entity, which is case-sensitive...
+    i = hd_hash_lookup((char *)name, hd_entity_disp, HD_ENTITY_BUCKETS, hd_entity_slots, HD_ENTITY_SLOTS, 0);
 
-    if (match == NULL)
+    if (i < 0 || strcmp((char *)name, (char *)iso8859_numbers[i].name))
       return (0);
     else
-      ch = match->value;
+      ch = iso8859_numbers[i].value;
   }
 
   if (ch > 0x7f && _htmlUTF8)
@@ -340,6 +338,10 @@ iso8859(uchar *name)			/* I - Glyph name */
     if (!_htmlInitialized)
       htmlSetCharSet("iso-8859-1");
 
+    // Files are parsed on multiple threads, so lock the character set while
+    // we look for and possibly add the character...
+    hd_mutex_lock(&_htmlCharSetMutex);
+
     if ((glyph = _htmlGlyphsAll[ch]) == NULL)
     {
       snprintf(uniglyph, sizeof(uniglyph), "uni%04x", ch);
@@ -370,22 +372,28 @@ iso8859(uchar *name)			/* I - Glyph name */
 	  {
 	    for (int style = 0; style < STYLE_MAX; style ++)
 	    {
-	      if (_htmlWidthsLoaded[typeface][style])
+	      if (hd_atomic_get(&_htmlWidthsLoaded[typeface][style]))
 	      {
 	        _htmlWidths[typeface][style][newch] = _htmlWidthsAll[typeface][style][ch];
 	      }
 	    }
 	  }
 
+	  hd_mutex_unlock(&_htmlCharSetMutex);
+
 	  // Return the new character...
 	  return ((uchar)newch);
 	}
 
+      hd_mutex_unlock(&_htmlCharSetMutex);
+
       // No room, return nul...
       return (0);
     }
     else
       ch = newch;
+
+    hd_mutex_unlock(&_htmlCharSetMutex);
   }
 
   return ((uchar)ch);
@@ -402,37 +410,46 @@ iso8859(uchar value)	/* I - ISO-8859-1 equivalent */
   int		i;		/* Looping var */
   int		ch;		/* Current character */
   static int	first_time = 1;	/* First time called? */
-  static uchar	buf[255];	/* Character buffer */
+  static HD_THREAD_LOCAL uchar buf[255];
+				/* Character buffer */
 
 
-  if (first_time)
+  if (hd_atomic_get(&first_time))
   {
-    memset(iso8859_names, 0, sizeof(iso8859_names));
+    // Initialize the glyph table once, even with multiple threads...
+    hd_mutex_lock(&_htmlCharSetMutex);
 
-    for (i = 0; i < (int)(sizeof(iso8859_numbers) / sizeof(iso8859_numbers[0])); i ++)
-      if ((ch = iso8859_numbers[i].value) < 128)
-	iso8859_names[ch] = iso8859_numbers + i;
-      else
-      {
-	// Lookup Unicode value in the current charset...
-	const char *glyph;
-	char uniglyph[32];
+    if (first_time)
+    {
+      memset(iso8859_names, 0, sizeof(iso8859_names));
 
-        if ((glyph = _htmlGlyphsAll[ch]) == NULL)
+      for (i = 0; i < (int)(sizeof(iso8859_numbers) / sizeof(iso8859_numbers[0])); i ++)
+	if ((ch = iso8859_numbers[i].value) < 128)
+	  iso8859_names[ch] = iso8859_numbers + i;
+	else
 	{
-	  snprintf(uniglyph, sizeof(uniglyph), "uni%04x", ch);
-	  glyph = uniglyph;
-	}
+	  // Lookup Unicode value in the current charset...
+	  const char *glyph;
+	  char uniglyph[32];
 
-	for (ch = 128; ch < 256; ch ++)
-	  if (_htmlGlyphs[ch] && !strcmp(_htmlGlyphs[ch], glyph))
+	  if ((glyph = _htmlGlyphsAll[ch]) == NULL)
 	  {
-	    iso8859_names[ch] = iso8859_numbers + i;
-	    break;
+	    snprintf(uniglyph, sizeof(uniglyph), "uni%04x", ch);
+	    glyph = uniglyph;
 	  }
-      }
 
-    first_time = 0;
+	  for (ch = 128; ch < 256; ch ++)
+	    if (_htmlGlyphs[ch] && !strcmp(_htmlGlyphs[ch], glyph))
+	    {
+	      iso8859_names[ch] = iso8859_numbers + i;
+	      break;
+	    }
+	}
+
+      hd_atomic_set(&first_time, 0);
+    }
+
+    hd_mutex_unlock(&_htmlCharSetMutex);
   }
 
   if (iso8859_names[value] == NULL)
@@ -492,7 +509,7 @@ iso8859(uchar value)	/* I - ISO-8859-1 equivalent */
 const uchar *                           /* O - XHTML string */
 xhtml_entity(uchar ch)                  /* I - Character */
 {
-  static uchar	buf[5];                 /* UTF-8 character buffer */
+  static HD_THREAD_LOCAL uchar buf[5];  /* UTF-8 character buffer */
 
 
   if (ch == '&')
@@ -550,15 +567,3 @@ xhtml_entity(uchar ch)                  /* I - Character */
     return (buf);
   }
 }
-
-
-/*
- * 'compare_lut()' - Compare two glyphs.
- */
-
-static int		/* O - 0 if equal, -1 if a<b, 1 if a>b */
-compare_lut(lut_t *a,	/* I - First glyph */
-            lut_t *b)	/* I - Second glyph */
-{
-  return (strcmp((char *)a->name, (char *)b->name));
-}
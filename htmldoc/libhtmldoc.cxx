@@ -0,0 +1,1615 @@
+/*
+ * Conversion library for HTMLDOC, a HTML document processing program.
+ *
+ * Copyright 2011-2026 by Michael R Sweet.
+ * Copyright 1997-2010 by Easy Software Products.  All rights reserved.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+/*
+ * Include necessary headers.
+ */
+
+#define _HTMLDOC_CXX_
+#include "htmldoc.h"
+#include "libhtmldoc.h"
+#include "markdown.h"
+#include "cache.h"
+
+
+/*
+ * Options that are reset before each conversion...
+ *
+ * The HTML globals are declared without a size in html.h, so their sizes are
+ * listed explicitly.
+ */
+
+#define HD_OPTIONS \
+  HD_OPTION(Verbosity) \
+  HD_OPTION(OverflowErrors) \
+  HD_OPTION(StrictHTML) \
+  HD_OPTION(Compression) \
+  HD_OPTION(EPUBCompression) \
+  HD_OPTION(TitlePage) \
+  HD_OPTION(TocLevels) \
+  HD_OPTION(TocLinks) \
+  HD_OPTION(TocNumbers) \
+  HD_OPTION(TocDocCount) \
+  HD_OPTION(OutputType) \
+  HD_OPTION(OutputPath) \
+  HD_OPTION(OutputFiles) \
+  HD_OPTION(OutputColor) \
+  HD_OPTION(OutputJPEG) \
+  HD_OPTION(PDFVersion) \
+  HD_OPTION(PDFPageMode) \
+  HD_OPTION(PDFPageLayout) \
+  HD_OPTION(PDFFirstPage) \
+  HD_OPTION(PDFEffect) \
+  HD_OPTION(PDFEffectDuration) \
+  HD_OPTION(PDFPageDuration) \
+  HD_OPTION(Encryption) \
+  HD_OPTION(Permissions) \
+  HD_OPTION(OwnerPassword) \
+  HD_OPTION(UserPassword) \
+  HD_OPTION(EmbedFonts) \
+  HD_OPTION(PSLevel) \
+  HD_OPTION(PSCommands) \
+  HD_OPTION(PSCompression) \
+  HD_OPTION(XRXComments) \
+  HD_OPTION(PageWidth) \
+  HD_OPTION(PageLength) \
+  HD_OPTION(PageLeft) \
+  HD_OPTION(PageRight) \
+  HD_OPTION(PageTop) \
+  HD_OPTION(PageBottom) \
+  HD_OPTION(PagePrintWidth) \
+  HD_OPTION(PagePrintLength) \
+  HD_OPTION(PageDuplex) \
+  HD_OPTION(Landscape) \
+  HD_OPTION(NumberUp) \
+  HD_OPTION(PreIndent) \
+  HD_OPTION(HeadFootType) \
+  HD_OPTION(HeadFootStyle) \
+  HD_OPTION(HeadFootSize) \
+  HD_OPTION(Header) \
+  HD_OPTION(Header1) \
+  HD_OPTION(TocHeader) \
+  HD_OPTION(Footer) \
+  HD_OPTION(TocFooter) \
+  HD_OPTION(TocTitle) \
+  HD_OPTION(TitleImage) \
+  HD_OPTION(Letterhead) \
+  HD_OPTION(LogoImage) \
+  HD_OPTION(BodyColor) \
+  HD_OPTION(BodyImage) \
+  HD_OPTION(LinkColor) \
+  HD_OPTION(HFImage) \
+  HD_OPTION(LinkStyle) \
+  HD_OPTION(Links) \
+  HD_OPTION(Path) \
+  HD_OPTION(Proxy) \
+  HD_OPTION(CacheDir) \
+  HD_OPTION(_htmlPPI) \
+  HD_OPTION(_htmlGrayscale) \
+  HD_OPTION(_htmlBrowserWidth) \
+  HD_OPTION(_htmlBodyFont) \
+  HD_OPTION(_htmlHeadingFont) \
+  HD_OPTION_ARRAY(_htmlTextColor, 255) \
+  HD_OPTION_ARRAY(_htmlSizes, 8) \
+  HD_OPTION_ARRAY(_htmlSpacings, 8)
+
+#define HD_OPTION(v)		+ sizeof(v)
+#define HD_OPTION_ARRAY(v,n)	+ sizeof(v[0]) * (n)
+#define HD_OPTIONS_SIZE		(0 HD_OPTIONS)
+
+
+/*
+ * Local types...
+ */
+
+typedef struct				// Input file or buffer for a job
+{
+  char		*name;			// Filename/URL or buffer name
+  void		*data;			// Buffer data, NULL for files
+  size_t	datalen;		// Length of buffer data
+} hd_file_t;
+
+struct hd_job_s			// Conversion job
+{
+  char		*options;		// Options, if any
+  size_t	num_files,		// Number of input files
+		alloc_files;		// Allocated input files
+  hd_file_t	*files;			// Input files
+};
+
+typedef struct				// Output buffer
+{
+  unsigned char	*data;			// Output data
+  size_t	used,			// Number of bytes used
+		alloc;			// Allocated bytes
+} hd_output_t;
+
+typedef struct				// Input file to read...
+{
+  char		*filename,		// File/URL to read
+		*path;			// Search path
+  const void	*data;			// Buffer to read, if any
+  size_t	datalen;		// Length of buffer
+  tree_t	*file;			// Document tree for file, if any
+  progress_log_t *log;			// Messages from reading the file
+} input_t;
+
+
+/*
+ * Local globals...
+ */
+
+static hd_mutex_t	convert_mutex = HD_MUTEX_INITIALIZER;
+					// Lock for conversions
+static int		defaults_saved = 0;
+					// Have the default options been saved?
+static unsigned char	defaults[HD_OPTIONS_SIZE];
+					// Default options
+static size_t		num_inputs = 0,	// Number of files to read
+			alloc_inputs = 0;
+					// Allocated input files
+static input_t		*inputs = NULL;	// Files to read
+
+
+/*
+ * Local functions...
+ */
+
+static void	options_restore(const unsigned char *buffer);
+static void	options_save(unsigned char *buffer);
+static void	parse_options(const char *line, exportfunc_t *exportfunc);
+static void	read_file(void *data, int index);
+static int	read_output(const char *filename, void **data, size_t *datalen);
+static int	write_output(void *data, const void *buffer, size_t bytes);
+
+
+/*
+ * 'hdAddBuffer()' - Add an in-memory document to a conversion job.
+ *
+ * The name is used to resolve relative links and to detect Markdown input
+ * (".md" extension).  The data is copied.
+ */
+
+int					// O - 1 on success, 0 on failure
+hdAddBuffer(hd_job_t   *job,		// I - Conversion job
+            const char *name,		// I - Name of document
+            const void *data,		// I - Document data
+            size_t     datalen)		// I - Length of document data
+{
+  hd_file_t	*file;			// New input file
+
+
+  if (!job || !name || (!data && datalen > 0))
+    return (0);
+
+  if (job->num_files >= job->alloc_files)
+  {
+    if ((file = (hd_file_t *)realloc(job->files, (job->alloc_files + 16) * sizeof(hd_file_t))) == NULL)
+      return (0);
+
+    job->files       = file;
+    job->alloc_files += 16;
+  }
+
+  file = job->files + job->num_files;
+
+  if ((file->name = strdup(name)) == NULL)
+    return (0);
+
+  // Always allocate at least one byte so that data is never NULL for buffers...
+  if ((file->data = malloc(datalen > 0 ? datalen : 1)) == NULL)
+  {
+    free(file->name);
+    return (0);
+  }
+
+  if (datalen > 0)
+    memcpy(file->data, data, datalen);
+
+  file->datalen = datalen;
+
+  job->num_files ++;
+
+  return (1);
+}
+
+
+/*
+ * 'hdAddFile()' - Add a file or URL to a conversion job.
+ */
+
+int					// O - 1 on success, 0 on failure
+hdAddFile(hd_job_t   *job,		// I - Conversion job
+          const char *filename)		// I - File or URL
+{
+  hd_file_t	*file;			// New input file
+
+
+  if (!job || !filename)
+    return (0);
+
+  if (job->num_files >= job->alloc_files)
+  {
+    if ((file = (hd_file_t *)realloc(job->files, (job->alloc_files + 16) * sizeof(hd_file_t))) == NULL)
+      return (0);
+
+    job->files       = file;
+    job->alloc_files += 16;
+  }
+
+  file = job->files + job->num_files;
+
+  if ((file->name = strdup(filename)) == NULL)
+    return (0);
+
+  file->data    = NULL;
+  file->datalen = 0;
+
+  job->num_files ++;
+
+  return (1);
+}
+
+
+/*
+ * 'hdConvert()' - Convert the documents in a job.
+ *
+ * The output is returned in a buffer that must be freed with free().  Options
+ * use the book file syntax and default to PDF output ("-t pdf"), and every
+ * conversion starts from the default options.  No messages are written to the
+ * standard error.  PDF and PostScript output is collected in memory; HTML and
+ * EPUB output is written to a temporary file that is then read back.
+ *
+ * Jobs may be created and converted from any number of threads, but only one
+ * job is converted at a time and other callers wait for it to finish: the
+ * options, document, image, and layout state of a conversion are process
+ * globals shared with the command-line program.  Each conversion still
+ * formats chapters and reads files with multiple threads (--threads or
+ * HTMLDOC_THREADS).
+ */
+
+int					// O - 1 on success, 0 on failure
+hdConvert(hd_job_t *job,		// I - Conversion job
+          void     **data,		// O - Output data
+          size_t   *datalen)		// O - Length of output data
+{
+  int		status = 0;		// Return status
+  size_t	i;			// Looping var
+  exportfunc_t	exportfunc;		// Export function
+  tree_t	*document = NULL,	// Document tree
+		*toc;			// Table of contents
+  FILE		*fp;			// Temporary file
+  hd_output_t	output;			// Output buffer
+
+
+  if (data)
+    *data = NULL;
+  if (datalen)
+    *datalen = 0;
+
+  if (!job || !data || !datalen)
+    return (0);
+
+  memset(&output, 0, sizeof(output));
+
+  convert_begin(&exportfunc);
+
+  Verbosity = -1;
+
+  // Apply the options for this job...
+  if (job->options)
+    parse_options(job->options, &exportfunc);
+
+  if (OutputFiles || exportfunc == (exportfunc_t)htmlsep_export)
+  {
+    progress_error(HD_ERROR_BAD_FORMAT, "Multiple output files are not supported.");
+  }
+  else if (job->num_files == 0)
+  {
+    progress_error(HD_ERROR_NO_FILES, "No HTML files.");
+  }
+#ifdef HTMLDOC_STREAMING
+  else if (exportfunc == (exportfunc_t)pspdf_export)
+  {
+    // Send the output to memory...
+    OutputPath[0] = '\0';
+    OutputFunc    = write_output;
+    OutputData    = &output;
+  }
+#endif // HTMLDOC_STREAMING
+  else if ((fp = file_temp(OutputPath, sizeof(OutputPath))) == NULL)
+  {
+    progress_error(HD_ERROR_WRITE_ERROR, "Unable to create temporary file '%s': %s", OutputPath, strerror(errno));
+  }
+  else
+    fclose(fp);
+
+  if (!Errors)
+  {
+    // Read the input files...
+    for (i = 0; i < job->num_files; i ++)
+      add_file(job->files[i].name, Path, job->files[i].data, job->files[i].datalen);
+
+    read_files(&document);
+
+    if (document)
+    {
+      // Find the first file, fix links, and write the output...
+      while (document->prev != NULL)
+        document = document->prev;
+
+      htmlFixLinks(document);
+
+      if (OutputType == OUTPUT_BOOK && TocLevels > 0)
+        toc = toc_build(document);
+      else
+        toc = NULL;
+
+      (*exportfunc)(document, toc);
+
+      htmlDeleteTree(document);
+      htmlDeleteTree(toc);
+
+      if (Errors)
+        free(output.data);
+      else if (OutputFunc)
+      {
+        // Return the output buffer, which is always allocated...
+        *data    = output.data ? output.data : malloc(1);
+        *datalen = output.used;
+        status   = *data != NULL;
+      }
+      else
+        status = read_output(OutputPath, data, datalen);
+    }
+    else
+      free(output.data);
+  }
+
+  OutputFunc = NULL;
+  OutputData = NULL;
+
+  convert_end();
+
+  return (status);
+}
+
+
+/*
+ * 'hdCreateJob()' - Create a conversion job.
+ */
+
+hd_job_t *				// O - New job or NULL on error
+hdCreateJob(void)
+{
+  return ((hd_job_t *)calloc(1, sizeof(hd_job_t)));
+}
+
+
+/*
+ * 'hdDeleteJob()' - Delete a conversion job.
+ */
+
+void
+hdDeleteJob(hd_job_t *job)		// I - Conversion job
+{
+  size_t	i;			// Looping var
+
+
+  if (!job)
+    return;
+
+  for (i = 0; i < job->num_files; i ++)
+  {
+    free(job->files[i].name);
+    free(job->files[i].data);
+  }
+
+  free(job->files);
+  free(job->options);
+  free(job);
+}
+
+
+/*
+ * 'hdSetOptions()' - Set the options for a conversion job.
+ *
+ * The options use the same syntax as the second line of a book file, for
+ * example "--webpage -t epub --size letter", and replace any previous
+ * options.
+ */
+
+int					// O - 1 on success, 0 on failure
+hdSetOptions(hd_job_t   *job,		// I - Conversion job
+             const char *options)	// I - Options
+{
+  char	*copy;				// Copy of options
+
+
+  if (!job)
+    return (0);
+
+  if (options)
+  {
+    if ((copy = strdup(options)) == NULL)
+      return (0);
+  }
+  else
+    copy = NULL;
+
+  free(job->options);
+  job->options = copy;
+
+  return (1);
+}
+
+
+//
+// 'add_file()' - Add a file to be read.
+//
+
+int					// O - 1 on success, 0 on failure
+add_file(const char *filename,		// I - File/URL to read
+         const char *path,		// I - Search path
+         const void *data,		// I - Buffer to read or NULL for a file
+         size_t     datalen)		// I - Length of buffer
+{
+  input_t	*input;			// New input file
+
+
+  if (num_inputs >= alloc_inputs)
+  {
+    if ((input = (input_t *)realloc(inputs, (alloc_inputs + 16) * sizeof(input_t))) == NULL)
+    {
+      progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for input files - %s", strerror(errno));
+      return (0);
+    }
+
+    inputs       = input;
+    alloc_inputs += 16;
+  }
+
+  input = inputs + num_inputs;
+
+  memset(input, 0, sizeof(input_t));
+
+  if ((input->filename = strdup(filename)) == NULL || (input->path = strdup(path ? path : "")) == NULL)
+  {
+    free(input->filename);
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for input files - %s", strerror(errno));
+    return (0);
+  }
+
+  input->data    = data;
+  input->datalen = datalen;
+
+  num_inputs ++;
+
+  return (1);
+}
+
+
+//
+// 'convert_begin()' - Start a conversion with the default options.
+//
+// The first call saves the current options as the defaults.  Conversions are
+// run one at a time, so this waits for any other conversion to finish.
+//
+
+void
+convert_begin(exportfunc_t *exportfunc)	// O - Export function
+{
+  hd_mutex_lock(&convert_mutex);
+
+  if (!defaults_saved)
+  {
+    const char	*data_dir,		// HTMLDOC_DATA env variable
+		*charset_dir;		// HTMLDOC_CHARSETS env variable
+
+    if ((data_dir = getenv("HTMLDOC_DATA")) != NULL)
+      _htmlData = data_dir;
+
+    if ((charset_dir = getenv("HTMLDOC_CHARSETS")) != NULL)
+      _htmlCharSetDir = charset_dir;
+
+    options_save(defaults);
+    defaults_saved = 1;
+  }
+
+  options_restore(defaults);
+
+  if (_htmlInitialized && strcmp(_htmlCharSet, "iso-8859-1"))
+    htmlSetCharSet("iso-8859-1");
+
+  file_cookies(NULL);
+  file_local();
+  file_proxy(NULL);
+  file_referer(NULL);
+
+  get_format(".t.", Header);
+  get_format("h.1", Footer);
+  get_format(".t.", TocHeader);
+  get_format("..i", TocFooter);
+
+  Errors      = 0;
+  PSLevel     = 0;
+  PDFVersion  = 14;
+  *exportfunc = (exportfunc_t)pspdf_export;
+}
+
+
+//
+// 'convert_end()' - Clean up the temporary files, images, and strings from a
+//                   conversion.
+//
+
+void
+convert_end(void)
+{
+  int	i;				// Looping var
+
+
+  file_cleanup();
+  image_flush_cache();
+  hd_strfreeall();
+
+  for (i = 0; i < 3; i ++)
+  {
+    Header[i]    = NULL;
+    Header1[i]   = NULL;
+    Footer[i]    = NULL;
+    TocHeader[i] = NULL;
+    TocFooter[i] = NULL;
+  }
+
+  hd_mutex_unlock(&convert_mutex);
+}
+
+
+//
+// 'load_book()' - Load a book file...
+//
+
+int					// O  - 1 = success, 0 = failure
+load_book(const char   *filename,	// I  - Book file
+          tree_t       **document,	// IO - Document tree
+          exportfunc_t *exportfunc,	// O  - Export function
+          int          set_nolocal)	// I  - Set file_nolocal() after lookup?
+{
+  FILE		*fp;			// File to read from
+  char		line[10240];		// Line from file
+  const char 	*dir;			// Directory
+  const char	*local;			// Local filename
+  char		path[2048];		// Current path
+
+
+  // See if the filename contains a path...
+  dir = file_directory(filename);
+
+  if (dir != NULL)
+    snprintf(path, sizeof(path), "%s;%s", dir, Path);
+  else
+    strlcpy(path, Path, sizeof(path));
+
+  // Open the file...
+  local = file_find(Path, filename);
+
+  if (set_nolocal)
+    file_nolocal();
+
+  if (!local)
+    return (0);
+
+  if ((fp = fopen(local, "rb")) == NULL)
+  {
+    progress_error(HD_ERROR_READ_ERROR, "Unable to open book file '%s': %s", local, strerror(errno));
+    return (0);
+  }
+
+  // Get the header...
+  file_gets(line, sizeof(line), fp);
+  if (strncmp(line, "#HTMLDOC", 8) != 0)
+  {
+    fclose(fp);
+    progress_error(HD_ERROR_BAD_FORMAT, "Bad or missing #HTMLDOC header in '%s'.", filename);
+    return (0);
+  }
+
+  // Read the second line from the book file; for older book files, this will
+  // be the file count; for new files this will be the options...
+  do
+  {
+    file_gets(line, sizeof(line), fp);
+
+    if (line[0] == '-')
+    {
+      parse_options(line, exportfunc);
+
+      if (dir != NULL)
+	snprintf(path, sizeof(path), "%s;%s", dir, Path);
+      else
+	strlcpy(path, Path, sizeof(path));
+    }
+  }
+  while (!line[0]);			// Skip blank lines
+
+  // Get input files/options...
+  while (file_gets(line, sizeof(line), fp) != NULL)
+  {
+    if (!line[0])
+      continue;				// Skip blank lines
+    else if (line[0] == '-')
+    {
+      read_files(document);
+      parse_options(line, exportfunc);
+
+      if (dir != NULL)
+	snprintf(path, sizeof(path), "%s;%s", dir, Path);
+      else
+	strlcpy(path, Path, sizeof(path));
+    }
+    else if (line[0] == '\\')
+      add_file(line + 1, path);
+    else
+      add_file(line, path);
+  }
+
+  // Close the book file and read the files...
+  fclose(fp);
+
+  read_files(document);
+
+  return (1);
+}
+
+
+//
+// 'options_restore()' - Restore options from a buffer.
+//
+
+static void
+options_restore(
+    const unsigned char *buffer)	// I - Saved options
+{
+#undef HD_OPTION
+#undef HD_OPTION_ARRAY
+#define HD_OPTION(v)		memcpy(&v, buffer, sizeof(v)); buffer += sizeof(v);
+#define HD_OPTION_ARRAY(v,n)	memcpy(v, buffer, sizeof(v[0]) * (n)); buffer += sizeof(v[0]) * (n);
+
+  HD_OPTIONS
+}
+
+
+//
+// 'options_save()' - Save options to a buffer.
+//
+
+static void
+options_save(unsigned char *buffer)	// O - Saved options
+{
+#undef HD_OPTION
+#undef HD_OPTION_ARRAY
+#define HD_OPTION(v)		memcpy(buffer, &v, sizeof(v)); buffer += sizeof(v);
+#define HD_OPTION_ARRAY(v,n)	memcpy(buffer, v, sizeof(v[0]) * (n)); buffer += sizeof(v[0]) * (n);
+
+  HD_OPTIONS
+}
+
+
+//
+// 'parse_options()' - Parse options from a book file...
+//
+
+static void
+parse_options(const char   *line,	// I - Options from book file
+              exportfunc_t *exportfunc)	// O - Export function
+{
+  int		i;			// Looping var
+  const char	*lineptr;		// Pointer into line
+  char		temp[1024],		// Option name
+		temp2[1024],		// Option value
+		*tempptr;		// Pointer into option
+  double	fontsize,		// Size of body text
+		fontspacing;		// Spacing between lines
+
+
+  // Parse the input line...
+  for (lineptr = line; *lineptr != '\0';)
+  {
+    while (*lineptr == ' ')
+      lineptr ++;
+
+    for (tempptr = temp; *lineptr != '\0' && *lineptr != ' '; lineptr ++)
+      if (tempptr < (temp + sizeof(temp) - 1))
+        *tempptr++ = *lineptr;
+
+    *tempptr = '\0';
+
+    while (*lineptr == ' ')
+      lineptr ++;
+
+    if (strcmp(temp, "--duplex") == 0)
+    {
+      PageDuplex = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--landscape") == 0)
+    {
+      Landscape = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--portrait") == 0)
+    {
+      Landscape = 0;
+      continue;
+    }
+    else if (strncmp(temp, "--jpeg", 6) == 0)
+    {
+      if (strlen(temp) > 7)
+        OutputJPEG = atoi(temp + 7);
+      else
+        OutputJPEG = 90;
+      continue;
+    }
+    else if (strcmp(temp, "--grayscale") == 0)
+    {
+      OutputColor = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--color") == 0)
+    {
+      OutputColor = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--links") == 0)
+    {
+      Links = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-links") == 0)
+    {
+      Links = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--embedfonts") == 0 ||
+             strcmp(temp, "--truetype") == 0)
+    {
+      EmbedFonts = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-embedfonts") == 0 ||
+             strcmp(temp, "--no-truetype") == 0)
+    {
+      EmbedFonts = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--pscommands") == 0)
+    {
+      PSCommands = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-pscommands") == 0)
+    {
+      PSCommands = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--pscompression") == 0)
+    {
+      PSCompression = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-pscompression") == 0)
+    {
+      PSCompression = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--xrxcomments") == 0)
+    {
+      XRXComments = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-xrxcomments") == 0)
+    {
+      XRXComments = 0;
+      continue;
+    }
+    else if (strncmp(temp, "--compression", 13) == 0)
+    {
+      if (strlen(temp) > 14 && PDFVersion >= 12)
+        Compression = atoi(temp + 14);
+      else if (PDFVersion >= 12)
+        Compression = 1;
+
+      if (strlen(temp) > 14)
+        EPUBCompression = atoi(temp + 14);
+      else
+        EPUBCompression = 9;
+      continue;
+    }
+    else if (strcmp(temp, "--no-compression") == 0)
+    {
+      Compression = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--no-jpeg") == 0)
+    {
+      OutputJPEG = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--numbered") == 0)
+    {
+      TocNumbers = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-numbered") == 0)
+    {
+      TocNumbers = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--no-toc") == 0)
+    {
+      TocLevels = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--title") == 0)
+    {
+      TitlePage = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-title") == 0)
+    {
+      TitlePage = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--book") == 0)
+    {
+      OutputType = OUTPUT_BOOK;
+      continue;
+    }
+    else if (strcmp(temp, "--continuous") == 0)
+    {
+      OutputType = OUTPUT_CONTINUOUS;
+      continue;
+    }
+    else if (strcmp(temp, "--webpage") == 0)
+    {
+      OutputType = OUTPUT_WEBPAGES;
+      continue;
+    }
+    else if (strcmp(temp, "--encryption") == 0)
+    {
+      Encryption = 1;
+      continue;
+    }
+    else if (strcmp(temp, "--no-encryption") == 0)
+    {
+      Encryption = 0;
+      continue;
+    }
+    else if (strcmp(temp, "--strict") == 0)
+      StrictHTML = 1;
+    else if (strcmp(temp, "--no-strict") == 0)
+      StrictHTML = 0;
+    else if (strcmp(temp, "--overflow") == 0)
+      OverflowErrors = 1;
+    else if (strcmp(temp, "--no-overflow") == 0)
+      OverflowErrors = 0;
+
+    if (*lineptr == '\"')
+    {
+      lineptr ++;
+
+      for (tempptr = temp2; *lineptr != '\0' && *lineptr != '\"'; lineptr ++)
+        if (tempptr < (temp2 + sizeof(temp2) - 1))
+	  *tempptr++ = *lineptr;
+
+      if (*lineptr == '\"')
+        lineptr ++;
+    }
+    else
+    {
+      for (tempptr = temp2; *lineptr != '\0' && *lineptr != ' '; lineptr ++)
+        if (tempptr < (temp2 + sizeof(temp2) - 1))
+	  *tempptr++ = *lineptr;
+    }
+
+    *tempptr = '\0';
+
+    if (strcmp(temp, "-t") == 0 && !CGIMode)
+    {
+      if (strcmp(temp2, "epub") == 0)
+        *exportfunc = (exportfunc_t)epub_export;
+      else if (strcmp(temp2, "html") == 0)
+        *exportfunc = (exportfunc_t)html_export;
+      else if (strcmp(temp2, "htmlsep") == 0)
+        *exportfunc = (exportfunc_t)htmlsep_export;
+      else if (strcmp(temp2, "pdf11") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 0;
+	PDFVersion  = 11;
+      }
+      else if (strcmp(temp2, "pdf12") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 0;
+	PDFVersion  = 12;
+      }
+      else if (strcmp(temp2, "pdf13") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 0;
+	PDFVersion  = 13;
+      }
+      else if (strcmp(temp2, "pdf") == 0 ||
+               strcmp(temp2, "pdf14") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 0;
+	PDFVersion  = 14;
+      }
+      else if (strcmp(temp2, "ps1") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 1;
+      }
+      else if (strcmp(temp2, "ps") == 0 ||
+               strcmp(temp2, "ps2") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 2;
+      }
+      else if (strcmp(temp2, "ps3") == 0)
+      {
+        *exportfunc = (exportfunc_t)pspdf_export;
+	PSLevel     = 3;
+      }
+    }
+    else if (strcmp(temp, "--letterhead") == 0)
+      strlcpy(Letterhead, temp2, sizeof(Letterhead));
+    else if (strcmp(temp, "--logo") == 0 ||
+             strcmp(temp, "--logoimage") == 0)
+      strlcpy(LogoImage, temp2, sizeof(LogoImage));
+    else if (strcmp(temp, "--titlefile") == 0 ||
+             strcmp(temp, "--titleimage") == 0)
+    {
+      TitlePage = 1;
+      strlcpy(TitleImage, temp2, sizeof(TitleImage));
+    }
+    else if (strcmp(temp, "-f") == 0 && !CGIMode)
+    {
+      OutputFiles = 0;
+      strlcpy(OutputPath, temp2, sizeof(OutputPath));
+    }
+    else if (strcmp(temp, "-d") == 0 && !CGIMode)
+    {
+      OutputFiles = 1;
+      strlcpy(OutputPath, temp2, sizeof(OutputPath));
+    }
+    else if (strcmp(temp, "--browserwidth") == 0)
+      _htmlBrowserWidth = atof(temp2);
+    else if (strcmp(temp, "--nup") == 0)
+      NumberUp = atoi(temp2);
+    else if (strcmp(temp, "--size") == 0)
+      set_page_size(temp2);
+    else if (strcmp(temp, "--left") == 0)
+      PageLeft = get_measurement(temp2);
+    else if (strcmp(temp, "--right") == 0)
+      PageRight = get_measurement(temp2);
+    else if (strcmp(temp, "--top") == 0)
+      PageTop = get_measurement(temp2);
+    else if (strcmp(temp, "--bottom") == 0)
+      PageBottom = get_measurement(temp2);
+    else if (strcmp(temp, "--pre-indent") == 0)
+      PreIndent = get_measurement(temp2);
+    else if (strcmp(temp, "--header") == 0)
+      get_format(temp2, Header);
+    else if (strcmp(temp, "--header1") == 0)
+      get_format(temp2, Header1);
+    else if (strcmp(temp, "--footer") == 0)
+      get_format(temp2, Footer);
+    else if (strcmp(temp, "--bodycolor") == 0)
+      strlcpy(BodyColor, temp2, sizeof(BodyColor));
+    else if (strcmp(temp, "--bodyimage") == 0)
+      strlcpy(BodyImage, temp2, sizeof(BodyImage));
+    else if (strcmp(temp, "--textcolor") == 0)
+      htmlSetTextColor((uchar *)temp2);
+    else if (strcmp(temp, "--linkcolor") == 0)
+      strlcpy(LinkColor, temp2, sizeof(LinkColor));
+    else if (strcmp(temp, "--linkstyle") == 0)
+    {
+      if (strcmp(temp2, "plain") == 0)
+        LinkStyle = 0;
+      else
+        LinkStyle = 1;
+    }
+    else if (strcmp(temp, "--toclevels") == 0)
+      TocLevels = atoi(temp2);
+    else if (strcmp(temp, "--tocheader") == 0)
+      get_format(temp2, TocHeader);
+    else if (strcmp(temp, "--tocfooter") == 0)
+      get_format(temp2, TocFooter);
+    else if (strcmp(temp, "--toctitle") == 0)
+      strlcpy(TocTitle, temp2, sizeof(TocTitle));
+    else if (strcmp(temp, "--fontsize") == 0)
+    {
+      fontsize    = atof(temp2);
+      fontspacing = _htmlSpacings[SIZE_P] / _htmlSizes[SIZE_P];
+
+      if (fontsize < 4.0f)
+        fontsize = 4.0f;
+      else if (fontsize > 24.0f)
+        fontsize = 24.0f;
+
+      htmlSetBaseSize(fontsize, fontspacing);
+    }
+    else if (strcmp(temp, "--fontspacing") == 0)
+    {
+      fontsize    = _htmlSizes[SIZE_P];
+      fontspacing = atof(temp2);
+
+      if (fontspacing < 1.0f)
+        fontspacing = 1.0f;
+      else if (fontspacing > 3.0f)
+        fontspacing = 3.0f;
+
+      htmlSetBaseSize(fontsize, fontspacing);
+    }
+    else if (!strcmp(temp, "--headingfont"))
+    {
+      if (!strcasecmp(temp2, "courier"))
+	_htmlHeadingFont = TYPE_COURIER;
+      else if (!strcasecmp(temp2, "times"))
+	_htmlHeadingFont = TYPE_TIMES;
+      else if (!strcasecmp(temp2, "helvetica") ||
+	       !strcasecmp(temp2, "arial"))
+	_htmlHeadingFont = TYPE_HELVETICA;
+      else if (!strcasecmp(temp2, "monospace"))
+	_htmlHeadingFont = TYPE_MONOSPACE;
+      else if (!strcasecmp(temp2, "serif"))
+	_htmlHeadingFont = TYPE_SERIF;
+      else if (!strcasecmp(temp2, "sans"))
+	_htmlHeadingFont = TYPE_SANS_SERIF;
+    }
+    else if (!strcmp(temp, "--bodyfont"))
+    {
+      if (!strcasecmp(temp2, "monospace"))
+	_htmlBodyFont = TYPE_MONOSPACE;
+      else if (!strcasecmp(temp2, "serif"))
+	_htmlBodyFont = TYPE_SERIF;
+      else if (!strcasecmp(temp2, "sans"))
+	_htmlBodyFont = TYPE_SANS_SERIF;
+      else if (!strcasecmp(temp2, "courier"))
+	_htmlBodyFont = TYPE_COURIER;
+      else if (!strcasecmp(temp2, "times"))
+	_htmlBodyFont = TYPE_TIMES;
+      else if (!strcasecmp(temp2, "helvetica") ||
+	       !strcasecmp(temp2, "arial"))
+	_htmlBodyFont = TYPE_HELVETICA;
+    }
+    else if (strcmp(temp, "--headfootsize") == 0)
+      HeadFootSize = atof(temp2);
+    else if (!strcmp(temp, "--headfootfont"))
+    {
+      if (!strcasecmp(temp2, "courier"))
+      {
+	HeadFootType  = TYPE_COURIER;
+	HeadFootStyle = STYLE_NORMAL;
+      }
+      else if (!strcasecmp(temp2, "courier-bold"))
+      {
+	HeadFootType  = TYPE_COURIER;
+	HeadFootStyle = STYLE_BOLD;
+      }
+      else if (!strcasecmp(temp2, "courier-oblique"))
+      {
+	HeadFootType  = TYPE_COURIER;
+	HeadFootStyle = STYLE_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "courier-boldoblique"))
+      {
+	HeadFootType  = TYPE_COURIER;
+	HeadFootStyle = STYLE_BOLD_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "times") ||
+	       !strcasecmp(temp2, "times-roman"))
+      {
+	HeadFootType  = TYPE_TIMES;
+	HeadFootStyle = STYLE_NORMAL;
+      }
+      else if (!strcasecmp(temp2, "times-bold"))
+      {
+	HeadFootType  = TYPE_TIMES;
+	HeadFootStyle = STYLE_BOLD;
+      }
+      else if (!strcasecmp(temp2, "times-italic"))
+      {
+	HeadFootType  = TYPE_TIMES;
+	HeadFootStyle = STYLE_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "times-bolditalic"))
+      {
+	HeadFootType  = TYPE_TIMES;
+	HeadFootStyle = STYLE_BOLD_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "helvetica"))
+      {
+	HeadFootType  = TYPE_HELVETICA;
+	HeadFootStyle = STYLE_NORMAL;
+      }
+      else if (!strcasecmp(temp2, "helvetica-bold"))
+      {
+	HeadFootType  = TYPE_HELVETICA;
+	HeadFootStyle = STYLE_BOLD;
+      }
+      else if (!strcasecmp(temp2, "helvetica-oblique"))
+      {
+	HeadFootType  = TYPE_HELVETICA;
+	HeadFootStyle = STYLE_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "helvetica-boldoblique"))
+      {
+	HeadFootType  = TYPE_HELVETICA;
+	HeadFootStyle = STYLE_BOLD_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "monospace"))
+      {
+	HeadFootType  = TYPE_MONOSPACE;
+	HeadFootStyle = STYLE_NORMAL;
+      }
+      else if (!strcasecmp(temp2, "monospace-bold"))
+      {
+	HeadFootType  = TYPE_MONOSPACE;
+	HeadFootStyle = STYLE_BOLD;
+      }
+      else if (!strcasecmp(temp2, "monospace-oblique"))
+      {
+	HeadFootType  = TYPE_MONOSPACE;
+	HeadFootStyle = STYLE_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "monospace-boldoblique"))
+      {
+	HeadFootType  = TYPE_MONOSPACE;
+	HeadFootStyle = STYLE_BOLD_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "serif") ||
+	       !strcasecmp(temp2, "serif-roman"))
+      {
+	HeadFootType  = TYPE_SERIF;
+	HeadFootStyle = STYLE_NORMAL;
+      }
+      else if (!strcasecmp(temp2, "serif-bold"))
+      {
+	HeadFootType  = TYPE_SERIF;
+	HeadFootStyle = STYLE_BOLD;
+      }
+      else if (!strcasecmp(temp2, "serif-italic"))
+      {
+	HeadFootType  = TYPE_SERIF;
+	HeadFootStyle = STYLE_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "serif-bolditalic"))
+      {
+	HeadFootType  = TYPE_SERIF;
+	HeadFootStyle = STYLE_BOLD_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "sans"))
+      {
+	HeadFootType  = TYPE_SANS_SERIF;
+	HeadFootStyle = STYLE_NORMAL;
+      }
+      else if (!strcasecmp(temp2, "sans-bold"))
+      {
+	HeadFootType  = TYPE_SANS_SERIF;
+	HeadFootStyle = STYLE_BOLD;
+      }
+      else if (!strcasecmp(temp2, "sans-oblique"))
+      {
+	HeadFootType  = TYPE_SANS_SERIF;
+	HeadFootStyle = STYLE_ITALIC;
+      }
+      else if (!strcasecmp(temp2, "sans-boldoblique"))
+      {
+	HeadFootType  = TYPE_SANS_SERIF;
+	HeadFootStyle = STYLE_BOLD_ITALIC;
+      }
+    }
+    else if (strcmp(temp, "--charset") == 0)
+      htmlSetCharSet(temp2);
+    else if (strcmp(temp, "--pagemode") == 0)
+    {
+      for (i = 0; i < (int)(sizeof(PDFModes) / sizeof(PDFModes[0])); i ++)
+        if (strcasecmp(temp2, PDFModes[i]) == 0)
+	{
+	  PDFPageMode = i;
+	  break;
+	}
+    }
+    else if (strcmp(temp, "--pagelayout") == 0)
+    {
+      for (i = 0; i < (int)(sizeof(PDFLayouts) / sizeof(PDFLayouts[0])); i ++)
+        if (strcasecmp(temp2, PDFLayouts[i]) == 0)
+	{
+	  PDFPageLayout = i;
+	  break;
+	}
+    }
+    else if (strcmp(temp, "--firstpage") == 0)
+    {
+      for (i = 0; i < (int)(sizeof(PDFPages) / sizeof(PDFPages[0])); i ++)
+        if (strcasecmp(temp2, PDFPages[i]) == 0)
+	{
+	  PDFFirstPage = i;
+	  break;
+	}
+    }
+    else if (strcmp(temp, "--pageeffect") == 0)
+    {
+      for (i = 0; i < (int)(sizeof(PDFEffects) / sizeof(PDFEffects[0])); i ++)
+        if (strcasecmp(temp2, PDFEffects[i]) == 0)
+	{
+	  PDFEffect = i;
+	  break;
+	}
+    }
+    else if (strcmp(temp, "--pageduration") == 0)
+      PDFPageDuration = atof(temp2);
+    else if (strcmp(temp, "--effectduration") == 0)
+      PDFEffectDuration = atof(temp2);
+    else if (strcmp(temp, "--permissions") == 0)
+      set_permissions(temp2);
+    else if (strcmp(temp, "--user-password") == 0)
+      strlcpy(UserPassword, temp2, sizeof(UserPassword));
+    else if (strcmp(temp, "--owner-password") == 0)
+      strlcpy(OwnerPassword, temp2, sizeof(OwnerPassword));
+    else if (strcmp(temp, "--path") == 0)
+      strlcpy(Path, temp2, sizeof(Path) - 1);
+    else if (strcmp(temp, "--cache") == 0)
+      strlcpy(CacheDir, temp2, sizeof(CacheDir));
+    else if (strcmp(temp, "--proxy") == 0)
+    {
+      strlcpy(Proxy, temp2, sizeof(Proxy));
+      file_proxy(Proxy);
+    }
+    else if (strcmp(temp, "--cookies") == 0)
+      file_cookies(temp2);
+  }
+}
+
+
+//
+// 'read_file()' - Read an input file.
+//
+// This function is called from hd_parallel() and saves any messages so they
+// can be shown in order by read_files().
+//
+
+static void
+read_file(void *data,			// I - Unused
+          int  index)			// I - Input file number
+{
+  input_t	*input = inputs + index;// Input file
+  const char	*filename = input->filename;
+					// File/URL to read
+  FILE		*docfile;		// Document file
+  tree_t	*file;			// HTML document file
+  const char	*realname,		// Real name of file
+		*ext;			// Extension of filename
+  char		base[1024],		// Base directory name of file
+		key[HD_CACHE_KEY_SIZE];	// Cache key
+  int		markdown,		// Markdown file?
+		cached = 0;		// Loaded from cache?
+
+
+  (void)data;
+
+  DEBUG_printf(("read_file(filename=\"%s\", path=\"%s\")\n", filename, input->path));
+
+  input->log = progress_log_new();
+  progress_log_set(input->log);
+
+  stats_begin(HD_STATS_PARSE);
+
+  if (input->data)
+  {
+    // Copy the buffer to a temporary file for the parser...
+    if ((docfile = tmpfile()) != NULL && fwrite(input->data, 1, input->datalen, docfile) != input->datalen)
+    {
+      fclose(docfile);
+      docfile = NULL;
+    }
+
+    if (docfile)
+      rewind(docfile);
+    else
+      progress_error(HD_ERROR_WRITE_ERROR, "Unable to create temporary file for '%s': %s", filename, strerror(errno));
+  }
+  else if ((realname = file_find(input->path, filename)) == NULL)
+  {
+    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find '%s'.", filename);
+    docfile = NULL;
+  }
+  else if ((docfile = fopen(realname, "rb")) == NULL)
+    progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open '%s' for reading.", filename);
+
+  if (docfile)
+  {
+    // Prepare to read the file...
+    if (Verbosity > 0)
+      progress_error(HD_ERROR_NONE, "INFO: Reading %s...", filename);
+
+    strlcpy(base, file_directory(filename), sizeof(base));
+    ext = file_extension(filename);
+
+    file = htmlAddTree(NULL, MARKUP_FILE, NULL);
+    htmlSetVariable(file, (uchar *)"_HD_URL", (uchar *)filename);
+    htmlSetVariable(file, (uchar *)"_HD_FILENAME", (uchar *)file_basename(filename));
+    htmlSetVariable(file, (uchar *)"_HD_BASE", (uchar *)base);
+
+    markdown = ext && !strcmp(ext, "md");
+
+    if (CacheDir[0] && cache_key(docfile, filename, base, markdown, key, sizeof(key)))
+    {
+      // Use the previously parsed tree if the document has not changed...
+      if (cache_load(key, file))
+        cached = 1;
+    }
+    else
+      key[0] = '\0';
+
+    if (cached)
+    {
+      // Skip to the end of the file for the byte count...
+      fseek(docfile, 0, SEEK_END);
+    }
+    else if (markdown)
+    {
+      // Read markdown from a file...
+      mdReadFile(file, docfile, base);
+    }
+    else
+    {
+      // Read HTML from a file...
+      _htmlCurrentFile = filename;
+      htmlReadFile(file, docfile, base);
+      _htmlCurrentFile = "UNKNOWN";
+    }
+
+    // Only save documents that were read without errors, so that the same
+    // messages are shown every time...
+    if (!cached && key[0] && progress_log_errors(input->log) == 0)
+      cache_save(key, file);
+
+    stats_count(HD_COUNT_BYTES_IN, (long long)ftell(docfile));
+
+    fclose(docfile);
+
+    input->file = file;
+  }
+
+  stats_end(HD_STATS_PARSE);
+
+  progress_log_set(NULL);
+}
+
+
+//
+// 'read_files()' - Read the input files into the current document.
+//
+// The files are parsed on multiple threads (one at a time for UTF-8) and then
+// added to the end of the document in the order they were listed.
+//
+
+void
+read_files(tree_t **document)		// IO - Last file in document
+{
+  size_t	i;			// Looping var
+  tree_t	*file;			// HTML document file
+
+
+  if (num_inputs == 0)
+    return;
+
+  // Set the image resolution and character set before starting any threads...
+  _htmlPPI = 72.0f * _htmlBrowserWidth / (PageWidth - PageLeft - PageRight);
+
+  if (!_htmlInitialized)
+    htmlSetCharSet("iso-8859-1");
+
+  stats_begin(HD_STATS_PARSE);
+
+  if (_htmlUTF8)
+  {
+    // UTF-8 characters are added to the custom character set in the order
+    // they are first seen, so read the files one at a time to get the same
+    // mapping every time...
+    for (i = 0; i < num_inputs; i ++)
+      read_file(NULL, (int)i);
+  }
+  else
+    hd_parallel((int)num_inputs, read_file, NULL);
+
+  stats_end(HD_STATS_PARSE);
+
+  // Show messages and add files in order, keeping track of the last file...
+  if (*document != NULL)
+  {
+    while ((*document)->next != NULL)
+      *document = (*document)->next;
+  }
+
+  for (i = 0; i < num_inputs; i ++)
+  {
+    progress_log_flush(inputs[i].log);
+
+    if ((file = inputs[i].file) != NULL)
+    {
+      if (*document != NULL)
+      {
+        (*document)->next = file;
+        file->prev        = *document;
+      }
+
+      *document = file;
+    }
+
+    free(inputs[i].filename);
+    free(inputs[i].path);
+  }
+
+  num_inputs = 0;
+}
+
+
+//
+// 'read_output()' - Read an output file into memory.
+//
+
+static int				// O - 1 on success, 0 on failure
+read_output(const char *filename,	// I - Output file
+            void       **data,		// O - Output data
+            size_t     *datalen)	// O - Length of output data
+{
+  FILE		*fp;			// Output file
+  long		length;			// Length of file
+  void		*buffer;		// Output data
+
+
+  if ((fp = fopen(filename, "rb")) == NULL)
+  {
+    progress_error(HD_ERROR_READ_ERROR, "Unable to open '%s' for reading: %s", filename, strerror(errno));
+    return (0);
+  }
+
+  if (fseek(fp, 0, SEEK_END) || (length = ftell(fp)) < 0 || fseek(fp, 0, SEEK_SET))
+  {
+    progress_error(HD_ERROR_READ_ERROR, "Unable to read '%s': %s", filename, strerror(errno));
+    fclose(fp);
+    return (0);
+  }
+
+  if ((buffer = malloc(length > 0 ? (size_t)length : 1)) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for output - %s", strerror(errno));
+    fclose(fp);
+    return (0);
+  }
+
+  if (fread(buffer, 1, (size_t)length, fp) != (size_t)length)
+  {
+    progress_error(HD_ERROR_READ_ERROR, "Unable to read '%s': %s", filename, strerror(errno));
+    free(buffer);
+    fclose(fp);
+    return (0);
+  }
+
+  fclose(fp);
+
+  *data    = buffer;
+  *datalen = (size_t)length;
+
+  return (1);
+}
+
+
+//
+// 'set_permissions()' - Set the PDF permission bits.
+//
+
+void
+set_permissions(const char *p)		// I - Permission string
+{
+  char	*copyp,				// Copy of string
+	*start,				// Start of current keyword
+	*ptr;				// Pointer into string
+
+
+  // Range check input...
+  if (!p || !*p)
+    return;
+
+  // Make a copy of the string and parse it...
+  copyp = strdup(p);
+  if (!copyp)
+    return;
+
+  for (start = copyp; *start; start = ptr)
+  {
+    for (ptr = start; *ptr; ptr ++)
+      if (*ptr == ',')
+      {
+	*ptr++ = '\0';
+	break;
+      }
+
+    if (!strcasecmp(start, "all"))
+      Permissions = -4;
+    else if (!strcasecmp(start, "none"))
+      Permissions = -64;
+    else if (!strcasecmp(start, "print"))
+      Permissions |= PDF_PERM_PRINT;
+    else if (!strcasecmp(start, "no-print"))
+      Permissions &= ~PDF_PERM_PRINT;
+    else if (!strcasecmp(start, "modify"))
+      Permissions |= PDF_PERM_MODIFY;
+    else if (!strcasecmp(start, "no-modify"))
+      Permissions &= ~PDF_PERM_MODIFY;
+    else if (!strcasecmp(start, "copy"))
+      Permissions |= PDF_PERM_COPY;
+    else if (!strcasecmp(start, "no-copy"))
+      Permissions &= ~PDF_PERM_COPY;
+    else if (!strcasecmp(start, "annotate"))
+      Permissions |= PDF_PERM_ANNOTATE;
+    else if (!strcasecmp(start, "no-annotate"))
+      Permissions &= ~PDF_PERM_ANNOTATE;
+  }
+
+  if (Permissions != -4)
+    Encryption = 1;
+
+  free(copyp);
+}
+
+
+//
+// 'write_output()' - Append output data to a buffer.
+//
+
+static int				// O - 1 on success, 0 on error
+write_output(void       *data,		// I - Output buffer
+             const void *buffer,	// I - Data to append
+             size_t     bytes)		// I - Number of bytes
+{
+  hd_output_t	*output = (hd_output_t *)data;
+					// Output buffer
+
+
+  if ((output->used + bytes) > output->alloc)
+  {
+    size_t		alloc;		// New allocation size
+    unsigned char	*temp;		// New buffer
+
+    for (alloc = output->alloc ? output->alloc : 65536; alloc < (output->used + bytes); alloc *= 2);
+
+    if ((temp = (unsigned char *)realloc(output->data, alloc)) == NULL)
+    {
+      progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for output - %s", strerror(errno));
+      return (0);
+    }
+
+    output->data  = temp;
+    output->alloc = alloc;
+  }
+
+  memcpy(output->data + output->used, buffer, bytes);
+  output->used += bytes;
+
+  return (1);
+}
@@ -0,0 +1,43 @@
+/*
+ * Conversion library definitions for HTMLDOC, a HTML document processing
+ * program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+#ifndef _LIBHTMLDOC_H_
+#  define _LIBHTMLDOC_H_
+
+#  include <stddef.h>
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif /* __cplusplus */
+
+
+/*
+ * Types...
+ */
+
+typedef struct hd_job_s hd_job_t;	/* Conversion job, converted one at a time */
+
+
+/*
+ * Prototypes...
+ */
+
+extern int		hdAddBuffer(hd_job_t *job, const char *name, const void *data, size_t datalen);
+extern int		hdAddFile(hd_job_t *job, const char *filename);
+extern int		hdConvert(hd_job_t *job, void **data, size_t *datalen);
+extern hd_job_t	*hdCreateJob(void);
+extern void		hdDeleteJob(hd_job_t *job);
+extern int		hdSetOptions(hd_job_t *job, const char *options);
+
+#  ifdef __cplusplus
+}
+#  endif /* __cplusplus */
+
+#endif /* !_LIBHTMLDOC_H_ */
@@ -16,12 +16,26 @@
 #  include "progress.h"
 
 
+/*
+ * Local types...
+ */
+
+typedef struct md_doc_s			/* Document being streamed */
+{
+  tree_t	*html,			/* HTML element */
+		*head,			/* HEAD element */
+		*body;			/* BODY element */
+} md_doc_t;
+
+
 /*
  * Local functions...
  */
 
 static void       add_block(tree_t *hparent, mmd_t *parent);
 static void       add_leaf(tree_t *hparent, mmd_t *node);
+static void       add_metadata(md_doc_t *md, mmd_t *doc);
+static void       add_top_block(md_doc_t *md, mmd_t *block);
 static uchar      *get_text(uchar *text);
 static uchar      *make_anchor(mmd_t *block);
 static uchar      *make_anchor(const uchar *text);
@@ -29,6 +43,9 @@ static uchar      *make_anchor(const uchar *text);
 
 /*
  * 'mdReadFile()' - Read a Markdown file.
+ *
+ * Blocks are added to the document tree as they are parsed, so the complete
+ * Markdown document never needs to be held in memory.
  */
 
 tree_t *				/* O - HTML document tree */
@@ -36,60 +53,30 @@ mdReadFile(tree_t     *parent,		/* I - Parent node */
            FILE       *fp,		/* I - File to read from */
            const char *base)		/* I - Base path/URL */
 {
-  mmd_t       *doc;			/* Markdown document */
-  tree_t      *html,                    /* HTML element */
-              *head,                    /* HEAD element */
-              *temp,                    /* META/TITLE element */
-              *body;                    /* BODY element */
-  const char  *meta;                    /* Title, author, etc. */
+  md_doc_t    md;			/* Document being streamed */
+  tree_t      *temp;			/* HEAD child element */
 
 
-  doc = mmdLoadFile(NULL, fp);
-  html = htmlAddTree(parent, MARKUP_HTML, NULL);
-  if ((meta = mmdGetMetadata(doc, "lang")) != NULL)
-    htmlSetVariable(html, (uchar *)"lang", get_text((uchar *)meta));
+  md.html = htmlAddTree(parent, MARKUP_HTML, NULL);
+  md.head = htmlAddTree(md.html, MARKUP_HEAD, NULL);
+  md.body = htmlAddTree(md.html, MARKUP_BODY, NULL);
 
-  head = htmlAddTree(html, MARKUP_HEAD, NULL);
-  if ((meta = mmdGetMetadata(doc, "title")) != NULL)
-  {
-    temp = htmlAddTree(head, MARKUP_TITLE, NULL);
-    htmlAddTree(temp, MARKUP_NONE, get_text((uchar *)meta));
-  }
-  if ((meta = mmdGetMetadata(doc, "author")) != NULL)
-  {
-    temp = htmlAddTree(head, MARKUP_META, NULL);
-    htmlSetVariable(temp, (uchar *)"name", (uchar *)"author");
-    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
-  }
-  if ((meta = mmdGetMetadata(doc, "copyright")) != NULL)
-  {
-    temp = htmlAddTree(head, MARKUP_META, NULL);
-    htmlSetVariable(temp, (uchar *)"name", (uchar *)"copyright");
-    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
-  }
-  if ((meta = mmdGetMetadata(doc, "version")) != NULL)
-  {
-    temp = htmlAddTree(head, MARKUP_META, NULL);
-    htmlSetVariable(temp, (uchar *)"name", (uchar *)"version");
-    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
-  }
-  if ((meta = mmdGetMetadata(doc, "language")) != NULL)
-  {
-    htmlSetVariable(html, (uchar *)"lang", get_text((uchar *)meta));
-  }
-  if ((meta = mmdGetMetadata(doc, "subject")) != NULL)
-  {
-    temp = htmlAddTree(head, MARKUP_META, NULL);
-    htmlSetVariable(temp, (uchar *)"name", (uchar *)"keywords");
-    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
-  }
+  mmdStreamFile(fp, (mmd_blockcb_t)add_top_block, &md);
+
+  /*
+   * Index the metadata in document order...
+   */
 
-  body = htmlAddTree(html, MARKUP_BODY, NULL);
-  add_block(body, doc);
+  if (parent && parent->markup == MARKUP_FILE)
+  {
+    htmlIndexNode(parent);
+    htmlIndexNode(md.html);
 
-  mmdFree(doc);
+    for (temp = md.head->child; temp; temp = temp->next)
+      htmlIndexNode(temp);
+  }
 
-  return (html);
+  return (md.html);
 }
 
 
@@ -372,6 +359,72 @@ add_leaf(tree_t *html,                  /* I - Parent HTML node */
 }
 
 
+/*
+ * 'add_metadata()' - Add the document metadata to the HTML and HEAD elements.
+ */
+
+static void
+add_metadata(md_doc_t *md,              /* I - Document being streamed */
+             mmd_t    *doc)             /* I - Markdown document */
+{
+  tree_t      *temp;                    /* META/TITLE element */
+  const char  *meta;                    /* Title, author, etc. */
+
+
+  if ((meta = mmdGetMetadata(doc, "lang")) != NULL)
+    htmlSetVariable(md->html, (uchar *)"lang", get_text((uchar *)meta));
+
+  if ((meta = mmdGetMetadata(doc, "title")) != NULL)
+  {
+    temp = htmlAddTree(md->head, MARKUP_TITLE, NULL);
+    htmlAddTree(temp, MARKUP_NONE, get_text((uchar *)meta));
+  }
+  if ((meta = mmdGetMetadata(doc, "author")) != NULL)
+  {
+    temp = htmlAddTree(md->head, MARKUP_META, NULL);
+    htmlSetVariable(temp, (uchar *)"name", (uchar *)"author");
+    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
+  }
+  if ((meta = mmdGetMetadata(doc, "copyright")) != NULL)
+  {
+    temp = htmlAddTree(md->head, MARKUP_META, NULL);
+    htmlSetVariable(temp, (uchar *)"name", (uchar *)"copyright");
+    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
+  }
+  if ((meta = mmdGetMetadata(doc, "version")) != NULL)
+  {
+    temp = htmlAddTree(md->head, MARKUP_META, NULL);
+    htmlSetVariable(temp, (uchar *)"name", (uchar *)"version");
+    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
+  }
+  if ((meta = mmdGetMetadata(doc, "language")) != NULL)
+  {
+    htmlSetVariable(md->html, (uchar *)"lang", get_text((uchar *)meta));
+  }
+  if ((meta = mmdGetMetadata(doc, "subject")) != NULL)
+  {
+    temp = htmlAddTree(md->head, MARKUP_META, NULL);
+    htmlSetVariable(temp, (uchar *)"name", (uchar *)"keywords");
+    htmlSetVariable(temp, (uchar *)"content", get_text((uchar *)meta));
+  }
+}
+
+
+/*
+ * 'add_top_block()' - Add a completed top-level block to the document.
+ */
+
+static void
+add_top_block(md_doc_t *md,             /* I - Document being streamed */
+              mmd_t    *block)          /* I - Top-level block */
+{
+  if (mmdGetType(block) == MMD_TYPE_METADATA)
+    add_metadata(md, mmdGetParent(block));
+  else
+    add_block(md->body, block);
+}
+
+
 /*
  * 'get_text()' - Get Markdown text in HTMLDOC's charset.
  */
@@ -382,12 +435,18 @@ get_text(uchar *text)                   /* I - Markdown text */
   uchar         *bufptr,                /* Pointer into buffer */
                 *bufend;                /* End of buffer */
   int           unich;                  /* Unicode character */
-  static uchar  buffer[8192];           /* Temporary buffer */
+  static HD_THREAD_LOCAL uchar buffer[8192];
+                                        /* Temporary buffer */
 
 
   if (!_htmlUTF8 || text == NULL)
     return (text);
 
+  for (bufptr = text; *bufptr && !(*bufptr & 0x80); bufptr ++);
+
+  if (!*bufptr)
+    return (text);                      /* Plain ASCII needs no conversion */
+
   bufptr = buffer;
   bufend = buffer + sizeof(buffer) - 1;
 
@@ -460,7 +519,8 @@ make_anchor(mmd_t *block)               /* I - Block node */
   mmd_t         *node;                  /* Current child node */
   const char    *text;                  /* Text from block */
   uchar         *bufptr;                /* Pointer into buffer */
-  static uchar  buffer[1024];           /* Buffer for anchor string */
+  static HD_THREAD_LOCAL uchar buffer[1024];
+                                        /* Buffer for anchor string */
 
 
   for (bufptr = buffer, node = mmdGetFirstChild(block); node; node = mmdGetNextSibling(node))
@@ -490,7 +550,8 @@ static uchar *                          /* O - Anchor string */
 make_anchor(const uchar *text)          /* I - Text */
 {
   uchar         *bufptr;                /* Pointer into buffer */
-  static uchar  buffer[1024];           /* Buffer for anchor string */
+  static HD_THREAD_LOCAL uchar buffer[1024];
+                                        /* Buffer for anchor string */
 
 
   for (bufptr = buffer; *text && bufptr < (buffer + sizeof(buffer) - 1); text ++)
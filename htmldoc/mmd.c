@@ -86,6 +86,7 @@ struct _mmd_s
 		*last_child,		// Last child node
 		*prev_sibling,		// Previous sibling node
 		*next_sibling;		// Next sibling node
+  size_t	num_pending;		// Number of pending links in block
 };
 
 typedef struct _mmd_filebuf_s		// Buffered file
@@ -109,8 +110,13 @@ typedef struct _mmd_ref_s		// Reference link
 typedef struct _mmd_doc_s		// Markdown document
 {
   mmd_t		*root;			// Root node
-  size_t	num_references;		// Number of references
+  size_t	num_references,		// Number of references
+		alloc_references;	// Allocated references
   _mmd_ref_t	*references;		// References
+  size_t	hash_size,		// Size of reference hash table (power of 2)
+		*hash;			// Reference hash table (index + 1)
+  mmd_blockcb_t	blockcb;		// Block callback function, if any
+  void		*blockdata;		// Block callback data
 } _mmd_doc_t;
 
 typedef struct _mmd_stack_s		// Markdown block stack
@@ -135,11 +141,13 @@ static mmd_option_t	mmd_options = MMD_OPTION_ALL;
 //
 
 static mmd_t	*mmd_add(mmd_t *parent, mmd_type_t type, int whitespace, char *text, char *url);
+static mmd_t	*mmd_block(_mmd_doc_t *doc, mmd_t *node);
 static void	mmd_free(mmd_t *node);
 static int	mmd_has_continuation(const char *line, _mmd_filebuf_t *file, int indent);
 static size_t	mmd_iocb_file(FILE *fp, char *buffer, size_t bytes);
 static size_t	mmd_iocb_string(const char **s, char *buffer, size_t bytes);
 static size_t	mmd_is_chars(const char *lineptr, const char *chars, size_t minchars);
+static mmd_t	*mmd_load(mmd_t *root, mmd_iocb_t cb, void *cbdata, mmd_blockcb_t blockcb, void *blockdata);
 static size_t	mmd_is_codefence(char *lineptr, char fence, size_t fencelen, char **language);
 static bool	mmd_is_table(_mmd_filebuf_t *file, int indent);
 static void	mmd_parse_inline(_mmd_doc_t *doc, mmd_t *parent, char *lineptr);
@@ -148,6 +156,7 @@ static void	mmd_read_buffer(_mmd_filebuf_t *file);
 static char	*mmd_read_line(_mmd_filebuf_t *file, char *line, size_t linesize);
 static void	mmd_ref_add(_mmd_doc_t *doc, mmd_t *node, const char *name, const char *url, const char *title);
 static _mmd_ref_t *mmd_ref_find(_mmd_doc_t *doc, const char *name);
+static size_t	mmd_ref_hash(const char *name);
 static void	mmd_remove(mmd_t *node);
 #if DEBUG
 static const char *mmd_type_string(mmd_type_t type);
@@ -319,7 +328,7 @@ mmdGetMetadata(mmd_t	  *doc,		// I - Document
 
   for (current = metadata->first_child; current; current = current->next_sibling)
   {
-    if (strncmp(current->text, prefix, prefix_len))
+    if (!current->text || strncmp(current->text, prefix, prefix_len))
       continue;
 
     value = current->text + prefix_len;
@@ -477,999 +486,1101 @@ mmdLoadIO(mmd_t      *root,		// I - Root node for document or `NULL` for a new d
           mmd_iocb_t cb,		// I - Read callback function
           void       *cbdata)		// I - Read callback data
 {
-  size_t	i;			// Looping var
-  _mmd_doc_t	doc;			// Document
-  _mmd_ref_t	*reference;		// Current reference
-  mmd_t		*block = NULL;		// Current block
-  mmd_type_t	type;			// Type for line
-  _mmd_filebuf_t file;			// File buffer
-  char		line[8192],		// Read line
-		*linestart,		// Start of line
-		*lineptr,		// Pointer into line
-		*lineend,		// End of line
-		*temp;			// Temporary pointer
-  int		newindent;		// New indentation
-  int		blank_code = 0;		// Saved indented blank code line
-  mmd_type_t	columns[256];		// Alignment of table columns
-  int		num_columns = 0,	// Number of columns in table
-		rows = 0;		// Number of rows in table
-  _mmd_stack_t	stack[32],		// Block stack
-		*stackptr = stack;	// Pointer to top of stack
-
-
-  // Create an empty document as needed...
-  DEBUG_printf("mmdLoadIO: mmd_options=%d%s%s\n", mmd_options, (mmd_options & MMD_OPTION_METADATA) ? " METADATA" : "", (mmd_options & MMD_OPTION_TABLES) ? " TABLES" : "");
-
-  memset(&doc, 0, sizeof(doc));
+  return (mmd_load(root, cb, cbdata, NULL, NULL));
+}
 
-  if (root)
-    doc.root = root;
-  else
-    doc.root = mmd_add(NULL, MMD_TYPE_DOCUMENT, 0, NULL, NULL);
 
-  if (!doc.root)
-    return (NULL);
+//
+// 'mmdLoadString()' - Load a markdown string into nodes.
+//
 
-  // Initialize the block stack...
-  memset(stack, 0, sizeof(stack));
-  stackptr->parent = doc.root;
+mmd_t *					// O - Root node in markdown
+mmdLoadString(mmd_t      *root,		// I - Root node for document or `NULL` for a new document
+              const char *s)		// I - String to load
+{
+  return (mmdLoadIO(root, (mmd_iocb_t)mmd_iocb_string, &s));
+}
 
-  // Read lines until end-of-file...
-  memset(&file, 0, sizeof(file));
-  file.cb     = cb;
-  file.cbdata = cbdata;
 
-#ifdef __clang_analyzer__
-  memset(line, 0, sizeof(line));
-#endif // __clang_analyzer__
+//
+// 'mmdSetOptions()' - Set (enable/disable) support for various markdown options.
+//
 
-  while ((lineptr = mmd_read_line(&file, line, sizeof(line))) != NULL)
-  {
-    DEBUG_printf("%03d	%-12s  %s", stackptr->indent, mmd_type_string(stackptr->parent->type) + 9, lineptr);
-#if DEBUG
-    if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
-      DEBUG2_printf("	  blank_code=%d\n", blank_code);
-#endif // DEBUG
+void
+mmdSetOptions(mmd_option_t options)	// I - Options
+{
+  mmd_options = options;
+}
 
-    linestart = lineptr;
 
-    while (isspace(*lineptr & 255))
-      lineptr ++;
+//
+// 'mmdStreamFile()' - Stream the blocks of a markdown file from a stdio file.
+//
 
-    DEBUG2_printf("	line indent=%d\n", (int)(lineptr - line));
-    DEBUG2_printf("	stackptr=%d\n", (int)(stackptr - stack));
+bool					// O - `true` on success, `false` on error
+mmdStreamFile(FILE          *fp,	// I - File to load
+              mmd_blockcb_t blockcb,	// I - Block callback function
+              void          *blockdata)	// I - Block callback data
+{
+  return (mmdStreamIO((mmd_iocb_t)mmd_iocb_file, fp, blockcb, blockdata));
+}
 
-    if (!*lineptr && stackptr->parent->type == MMD_TYPE_TABLE)
-    {
-      DEBUG2_puts("END TABLE\n");
-      stackptr --;
-      block = NULL;
-      continue;
-    }
-    else if (stackptr->parent->type != MMD_TYPE_CODE_BLOCK && *lineptr == '>' && (lineptr - linestart) < 4)
-    {
-      // Block quote.  See if there is an existing blockquote...
-      DEBUG_printf("	 BLOCKQUOTE (stackptr=%ld)\n", stackptr - stack);
 
-      if (stackptr == stack || stack[1].parent->type != MMD_TYPE_BLOCK_QUOTE)
-      {
-	block		 = NULL;
-	stackptr	 = stack + 1;
-	stackptr->parent = mmd_add(doc.root, MMD_TYPE_BLOCK_QUOTE, 0, NULL, NULL);
-	stackptr->indent = 2;
-	stackptr->fence	 = '\0';
-      }
+//
+// 'mmdStreamIO()' - Stream the blocks of a markdown file using a callback.
+//
+// The block callback is called for each top-level block (heading, paragraph,
+// list, table, etc.) in document order as soon as the block is complete.  The
+// block is still a child of the document node when the callback is called, so
+// `mmdGetMetadata(mmdGetParent(block), ...)` works for the metadata block.
+// The block is freed when the callback returns.
+//
+// Blocks containing reference links are held until the references are
+// defined or the end of the file is reached.
+//
 
-      // Skip whitespace after the ">"...
-      lineptr ++;
-      if (isspace(*lineptr & 255))
-	lineptr ++;
+bool					// O - `true` on success, `false` on error
+mmdStreamIO(mmd_iocb_t    cb,		// I - Read callback function
+            void          *cbdata,	// I - Read callback data
+            mmd_blockcb_t blockcb,	// I - Block callback function
+            void          *blockdata)	// I - Block callback data
+{
+  mmd_t	*root;				// Document node
 
-      linestart = lineptr;
 
-      while (isspace(*lineptr & 255))
-	lineptr ++;
-    }
-    else if (*lineptr != '>' && stackptr > stack && stack[1].parent->type == MMD_TYPE_BLOCK_QUOTE && (!block || *lineptr == '\n' || mmd_is_chars(lineptr, "- \t", 3) || mmd_is_chars(lineptr, "_ \t", 3) || mmd_is_chars(lineptr, "* \t", 3)))
-    {
-      // Not a lazy continuation so terminate this block quote...
-      DEBUG_puts("     Terminating BLOCKQUOTE\n");
-      block    = NULL;
-      stackptr = stack;
-    }
+  if ((root = mmd_load(NULL, cb, cbdata, blockcb, blockdata)) == NULL)
+    return (false);
 
-    // Now handle all other markup not related to block quotes...
-    DEBUG2_printf("	stackptr=%d (%s), block=%p (%s)\n", (int)(stackptr - stack), mmd_type_string(stackptr->parent->type) + 9, block, block ? mmd_type_string(block->type) + 9 : "");
-    DEBUG2_printf("	strchr(lineptr, '|')=%p, mmd_is_table(&file, stackptr->indent)=%d\n", strchr(lineptr, '|'), mmd_is_table(&file, stackptr->indent));
-    DEBUG2_printf("	linestart=%d, lineptr=%d\n", (int)(linestart - line), (int)(lineptr - line));
-    DEBUG2_printf("	mmd_is_chars(lineptr, \"-\", 1)=%d\n", (int)mmd_is_chars(lineptr, "-", 1));
-    DEBUG2_printf("	mmd_is_chars(lineptr, \"=\", 1)=%d\n", (int)mmd_is_chars(lineptr, "=", 1));
+  mmdFree(root);
 
-    if ((lineptr - line - stackptr->indent) < 4 && ((stackptr->parent->type != MMD_TYPE_CODE_BLOCK && !stackptr->fence && mmd_is_codefence(lineptr, '\0', 0, NULL)) || (stackptr->fence && mmd_is_codefence(lineptr, stackptr->fence, stackptr->fencelen, NULL))))
-    {
-      // Code fence...
-      DEBUG2_printf("stackptr->indent=%d, fence='%c', fencelen=%d\n", stackptr->indent, stackptr->fence, (int)stackptr->fencelen);
+  return (true);
+}
 
-      if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
-      {
-	DEBUG2_puts("Ending code block...\n");
-	stackptr --;
-      }
-      else if (stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-      {
-	char	*language;		// Language name, if any
 
-	DEBUG2_printf("Starting code block with fence '%c'.\n", *lineptr);
+//
+// 'mmd_add()' - Add a new markdown node.
+//
 
-	block		     = NULL;
-	stackptr[1].parent   = mmd_add(stackptr->parent, MMD_TYPE_CODE_BLOCK, 0, NULL, NULL);
-	stackptr[1].indent   = lineptr - line;
-	stackptr[1].fence    = *lineptr;
-	stackptr[1].fencelen = mmd_is_codefence(lineptr, '\0', 0, &language);
-	stackptr ++;
+static mmd_t *				// O - New node
+mmd_add(mmd_t	   *parent,		// I - Parent node
+	mmd_type_t type,		// I - Node type
+	int	   whitespace,		// I - 1 if whitespace precedes this node
+	char	   *text,		// I - Text, if any
+	char	   *url)		// I - URL, if any
+{
+  mmd_t		*temp;			// New node
 
-	DEBUG2_printf("Code language=\"%s\"\n", language);
 
-	if (language)
-	  stackptr->parent->extra = strdup(language);
+  DEBUG2_printf("Adding %s to %p(%s), whitespace=%d, text=\"%s\", url=\"%s\"\n", mmd_type_string(type), parent, parent ? mmd_type_string(parent->type) : "", whitespace, text ? text : "(null)", url ? url : "(null)");
 
-	blank_code = 0;
-      }
-      continue;
-    }
-    else if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK && (lineptr - line) >= stackptr->indent)
-    {
-      if (line[stackptr->indent] == '\n')
-      {
-	blank_code ++;
-      }
-      else
-      {
-	while (blank_code > 0)
-	{
-	  mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, "\n", NULL);
-	  blank_code --;
-	}
+  if (!parent && type != MMD_TYPE_DOCUMENT)
+    return (NULL);			// Only document nodes can be at the root
 
-	mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, line + stackptr->indent, NULL);
-      }
-      continue;
-    }
-    else if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK && stackptr->fence)
+  if ((temp = calloc(1, sizeof(mmd_t))) != NULL)
+  {
+    if (parent)
     {
-      DEBUG2_printf("	  fence='%c'\n", stackptr->fence);
+      // Add node to the parent...
+      temp->parent = parent;
 
-      if (!*lineptr)
+      if (parent->last_child)
       {
-	blank_code ++;
+	parent->last_child->next_sibling = temp;
+	temp->prev_sibling		 = parent->last_child;
+	parent->last_child		 = temp;
       }
       else
       {
-	while (blank_code > 0)
-	{
-	  mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, "\n", NULL);
-	  blank_code --;
-	}
-
-	mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, lineptr, NULL);
+	parent->first_child = parent->last_child = temp;
       }
-      continue;
     }
-    else if (!strncmp(lineptr, "---", 3) && doc.root->first_child == NULL && (mmd_options & MMD_OPTION_METADATA))
-    {
-      // Document metadata...
-      block = mmd_add(doc.root, MMD_TYPE_METADATA, 0, NULL, NULL);
 
-      while ((lineptr = mmd_read_line(&file, line, sizeof(line))) != NULL)
-      {
-	while (isspace(*lineptr & 255))
-	  lineptr ++;
+    // Copy the node values...
+    temp->type	     = type;
+    temp->whitespace = whitespace;
 
-	if (!strncmp(lineptr, "---", 3) || !strncmp(lineptr, "...", 3))
-	  break;
+    if (text)
+      temp->text = strdup(text);
 
-	lineend = lineptr + strlen(lineptr) - 1;
-	if (lineend > lineptr && *lineend == '\n')
-	  *lineend = '\0';
+    if (url)
+      temp->url = strdup(url);
+  }
 
-	mmd_add(block, MMD_TYPE_METADATA_TEXT, 0, lineptr, NULL);
-      }
-      continue;
-    }
-    else if (block && block->type == MMD_TYPE_PARAGRAPH && (lineptr - linestart) < 4 && (lineptr - line) >= stackptr->indent && (mmd_is_chars(lineptr, "-", 1) || mmd_is_chars(lineptr, "=", 1)))
-    {
-      int ch = *lineptr;
+  return (temp);
+}
 
-      DEBUG_puts("     SETEXT HEADING\n");
 
-      lineptr += 3;
-      while (*lineptr == ch)
-	lineptr ++;
-      while (isspace(*lineptr & 255))
-	lineptr ++;
+//
+// 'mmd_block()' - Return the top-level block containing a node.
+//
 
-      if (!*lineptr)
-      {
-	if (ch == '=')
-	  block->type = MMD_TYPE_HEADING_1;
-	else
-	  block->type = MMD_TYPE_HEADING_2;
+static mmd_t *				// O - Top-level block
+mmd_block(_mmd_doc_t *doc,		// I - Document
+          mmd_t      *node)		// I - Node
+{
+  while (node->parent && node->parent != doc->root)
+    node = node->parent;
 
-	block = NULL;
-	continue;
-      }
+  return (node);
+}
 
-      type = MMD_TYPE_PARAGRAPH;
-    }
-    else if ((lineptr - linestart) < 4 && (mmd_is_chars(lineptr, "- \t", 3) || mmd_is_chars(lineptr, "_ \t", 3) || mmd_is_chars(lineptr, "* \t", 3)))
-    {
-      DEBUG_puts("     THEMATIC BREAK\n");
 
-      if (line[0] == '>')
-	stackptr = stack + 1;
-      else
-	stackptr = stack;
-
-      mmd_add(stackptr->parent, MMD_TYPE_THEMATIC_BREAK, 0, NULL, NULL);
-//      type  = MMD_TYPE_PARAGRAPH;
-      block = NULL;
-      continue;
-    }
-    else if ((*lineptr == '-' || *lineptr == '+' || *lineptr == '*') && (lineptr[1] == '\t' || lineptr[1] == ' '))
-    {
-      // Bulleted list...
-      DEBUG_puts("     UNORDERED LIST\n");
+//
+// 'mmd_free()' - Free memory used by a node.
+//
 
-      lineptr	+= 2;
-      linestart = lineptr;
-      newindent = linestart - line;
+static void
+mmd_free(mmd_t *node)			// I - Node
+{
+  free(node->text);
+  free(node->url);
+  free(node->extra);
+  free(node);
+}
 
-      while (isspace(*lineptr & 255))
-	lineptr ++;
 
-      while (stackptr > stack && stackptr->indent > newindent)
-	stackptr --;
+//
+// 'mmd_has_continuation()' - Determine whether the next line is a continuation
+//			      of the current one.
+//
 
-      if (stackptr > stack && stackptr->parent->type == MMD_TYPE_LIST_ITEM && stackptr->indent == newindent)
-	stackptr --;
+static int				// O - 1 if the next line continues, 0 otherwise
+mmd_has_continuation(
+    const char	   *line,		// I - Current line
+    _mmd_filebuf_t *file,		// I - File buffer
+    int		   indent)		// I - Indentation for current block
+{
+  const char	*lineptr = line;	// Pointer into current line
+  const char	*fileptr = file->bufptr;// Pointer into next line
 
-      if (stackptr > stack && stackptr->parent->type == MMD_TYPE_ORDERED_LIST && stackptr->indent == newindent)
-	stackptr --;
 
-      if (stackptr > stack && stackptr->parent->type == MMD_TYPE_BLOCK_QUOTE && line[0] != '>')
-	stackptr --;
+  if (*fileptr == '\n' || *fileptr == '\r')
+    return (0);
 
-      if (stackptr->parent->type != MMD_TYPE_UNORDERED_LIST && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-      {
-	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_UNORDERED_LIST, 0, NULL, NULL);
-	stackptr[1].indent = linestart - line;
-	stackptr[1].fence  = '\0';
-	stackptr ++;
-      }
+  do
+  {
+    while (isspace(*lineptr & 255))
+      lineptr ++;
 
-      if (stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-      {
-	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_LIST_ITEM, 0, NULL, NULL);
-	stackptr[1].indent = linestart - line;
-	stackptr[1].fence  = '\0';
-	stackptr ++;
-      }
+    if (*lineptr == '[' && (lineptr - line - indent) < 4 && (*fileptr == ' ' || *fileptr == '\t'))
+      return (1);
 
-      type  = MMD_TYPE_PARAGRAPH;
-      block = NULL;
+    while (isspace(*fileptr & 255))
+      fileptr ++;
 
-      if (mmd_is_chars(lineptr, "- \t", 3) || mmd_is_chars(lineptr, "_ \t", 3) || mmd_is_chars(lineptr, "* \t", 3))
-      {
-	mmd_add(stackptr->parent, MMD_TYPE_THEMATIC_BREAK, 0, NULL, NULL);
-	continue;
-      }
-    }
-    else if (isdigit(*lineptr & 255))
+    if (*lineptr == '>' && *fileptr == '>')
     {
-      // Ordered list?
-      DEBUG_puts("     ORDERED LIST?\n");
-
-      temp = lineptr + 1;
+      lineptr ++;
+      fileptr ++;
+    }
+    else if (*fileptr == '>')
+      return (0);
 
-      while (isdigit(*temp & 255))
-	temp ++;
+    if (*fileptr == '\n' || *fileptr == '\r')
+      return (0);
+  }
+  while (isspace(*lineptr & 255) || isspace(*fileptr & 255));
 
-      if ((*temp == '.' || *temp == ')') && (temp[1] == '\t' || temp[1] == ' '))
-      {
-        // Yes, ordered list.
-	lineptr	  = temp + 2;
-	linestart = lineptr;
-	newindent = linestart - line;
+  if (*lineptr == '#')
+    return (0);
 
-	while (isspace(*lineptr & 255))
-	  lineptr ++;
+  if (strchr("-+*", *fileptr) && isspace(fileptr[1] & 255))
+  {
+    // Bullet list item...
+    return (0);
+  }
 
-	while (stackptr > stack && stackptr->indent > newindent)
-	  stackptr --;
+  if (isdigit(*fileptr & 255))
+  {
+    // Ordered list item...
+    while (*fileptr && isdigit(*fileptr & 255))
+      fileptr ++;
 
-	if (stackptr->parent->type == MMD_TYPE_LIST_ITEM && stackptr->indent == newindent)
-	  stackptr --;
+    if (*fileptr == '.' || *fileptr == '(')
+      return (0);
+  }
 
-	if (stackptr->parent->type == MMD_TYPE_UNORDERED_LIST && stackptr->indent == newindent)
-	  stackptr --;
+  if (mmd_is_codefence((char *)fileptr, '\0', 0, NULL))
+    return (0);
 
-	if (stackptr->parent->type == MMD_TYPE_BLOCK_QUOTE && line[0] != '>')
-	  stackptr --;
+  if (mmd_is_chars(fileptr, "- \t", 3) || mmd_is_chars(fileptr, "_ \t", 3) || mmd_is_chars(fileptr, "* \t", 3))
+  {
+    // Thematic break...
+    return (0);
+  }
 
-	if (stackptr->parent->type != MMD_TYPE_ORDERED_LIST && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-	{
-	  stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_ORDERED_LIST, 0, NULL, NULL);
-	  stackptr[1].indent = linestart - line;
-	  stackptr[1].fence  = '\0';
-	  stackptr ++;
-	}
+  if (mmd_is_chars(fileptr, "-", 1) || mmd_is_chars(fileptr, "=", 1))
+  {
+    // Heading...
+    return (0);
+  }
 
-	if (stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-	{
-	  stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_LIST_ITEM, 0, NULL, NULL);
-	  stackptr[1].indent = linestart - line;
-	  stackptr[1].fence  = '\0';
-	  stackptr ++;
-	}
+  if (*fileptr == '#')
+  {
+    // Possible heading...
+    int count = 0;
 
-	type  = MMD_TYPE_PARAGRAPH;
-	block = NULL;
-      }
-      else
-      {
-        // No, just a regular paragraph...
-	type = block ? block->type : MMD_TYPE_PARAGRAPH;
-      }
-    }
-    else if (*lineptr == '#' && (lineptr - linestart) < 4)
+    while (*fileptr == '#')
     {
-      // Heading, count the number of '#' for the heading level...
-      DEBUG_puts("     HEADING?\n");
+      fileptr ++;
+      count ++;
+    }
 
-      newindent = lineptr - line;
-      temp	= lineptr + 1;
+    if (count <= 6)
+      return (0);
+  }
 
-      while (*temp == '#')
-	temp ++;
+  return ((fileptr - file->bufptr) <= indent);
+}
 
-      if ((temp - lineptr) <= 6 && isspace(*temp & 255))
-      {
-        // Heading 1-6...
-	type  = MMD_TYPE_HEADING_1 + (temp - lineptr - 1);
-	block = NULL;
 
-        // Skip whitespace after "#"...
-	lineptr = temp;
-	while (isspace(*lineptr & 255))
-	  lineptr ++;
+//
+// 'mmd_iocb_file()' - Read from a file.
+//
 
-	linestart = lineptr;
+static size_t				// O - Number of bytes read
+mmd_iocb_file(FILE   *fp,		// I - File pointer
+              char   *buffer,		// I - Buffer
+              size_t bytes)		// I - Number of bytes to read
+{
+  return (fread(buffer, 1, bytes, fp));
+}
 
-        // Strip trailing "#" characters and whitespace...
-	temp = lineptr + strlen(lineptr) - 1;
-	while (temp > lineptr && isspace(*temp & 255))
-	  *temp-- = '\0';
-	while (temp > lineptr && *temp == '#')
-	  temp --;
-	if (isspace(*temp & 255))
-	{
-	  while (temp > lineptr && isspace(*temp & 255))
-	    *temp-- = '\0';
-	}
-	else if (temp == lineptr)
-	  *temp = '\0';
 
-	while (stackptr > stack && stackptr->indent > newindent)
-	  stackptr --;
+//
+// 'mmd_iocb_string()' - Read from a string.
+//
 
-	block = mmd_add(stackptr->parent, type, 0, NULL, NULL);
-      }
-      else
-      {
-        // More than 6 #'s, just treat as a paragraph...
-	type = MMD_TYPE_PARAGRAPH;
-      }
-    }
-    else if (block && block->type >= MMD_TYPE_HEADING_1 && block->type <= MMD_TYPE_HEADING_6)
-    {
-      DEBUG_puts("     PARAGRAPH\n");
+static size_t				// O - Number of bytes read
+mmd_iocb_string(const char **s,		// I - Pointer into string
+                char       *buffer,	// I - Buffer
+                size_t     bytes)	// I - Number of bytes to read
+{
+  size_t	ret;			// Bytes read/returned
 
-      type  = MMD_TYPE_PARAGRAPH;
-      block = NULL;
-    }
-    else if (!block)
-    {
-      type = MMD_TYPE_PARAGRAPH;
 
-      if (lineptr == line && stackptr->parent->type != MMD_TYPE_TABLE)
-	stackptr = stack;
-    }
-    else
-      type = block->type;
+  // See how many bytes remain in the string...
+  if ((ret = strlen(*s)) > bytes)
+    ret = bytes;
 
-    if (!*lineptr)
-    {
-      if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
-	blank_code ++;
-      else if (stackptr->parent->type == MMD_TYPE_BLOCK_QUOTE && line[0] != '>')
-	stackptr --;
+  if (ret > 0)
+  {
+    // Copy bytes from the string...
+    memcpy(buffer, *s, ret);
+    (*s) += ret;
+  }
 
-      block = NULL;
-      continue;
-    }
-    else if (!strcmp(lineptr, "+"))
-    {
-      if (block)
-      {
-	if (block->type == MMD_TYPE_LIST_ITEM)
-	  block = mmd_add(block, MMD_TYPE_PARAGRAPH, 0, NULL, NULL);
-	else if (block->parent->type == MMD_TYPE_LIST_ITEM)
-	  block = mmd_add(block->parent, MMD_TYPE_PARAGRAPH, 0, NULL, NULL);
-	else
-	  block = NULL;
-      }
-      continue;
-    }
-    else if ((mmd_options & MMD_OPTION_TABLES) && strchr(lineptr, '|') && (stackptr->parent->type == MMD_TYPE_TABLE || mmd_is_table(&file, stackptr->indent)))
-    {
-      // Table...
-      int	col;			// Current column
-      char	*start,			// Start of column/cell
-		*end;			// End of column/cell
-      mmd_t	*row = NULL,		// Current row
-		*cell;			// Current cell
+  return (ret);
+}
 
-      DEBUG2_printf("TABLE stackptr->parent=%p (%d), rows=%d\n", stackptr->parent, stackptr->parent->type, rows);
 
-      if (stackptr->parent->type != MMD_TYPE_TABLE && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-      {
-	DEBUG2_printf("ADDING NEW TABLE to %p (%s)\n", stackptr->parent, mmd_type_string(stackptr->parent->type));
+//
+// 'mmd_is_chars()' - Determine whether a line consists solely of whitespace
+//		      and the specified character.
+//
 
-	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_TABLE, 0, NULL, NULL);
-	stackptr[1].indent = stackptr->indent;
-	stackptr[1].fence  = '\0';
-	stackptr ++;
+static size_t				// O - 1 if as specified, 0 otherwise
+mmd_is_chars(const char *lineptr,	// I - Current line
+	     const char *chars,		// I - Non-space character
+	     size_t	minchars)	// I - Minimum number of non-space characters
+{
+  size_t	found_ch = 0;		// Did we find the specified characters?
 
-	block = mmd_add(stackptr->parent, MMD_TYPE_TABLE_HEADER, 0, NULL, NULL);
+  while (*lineptr == *chars)
+  {
+    found_ch ++;
+    lineptr ++;
+  }
 
-	for (col = 0; col < (int)(sizeof(columns) / sizeof(columns[0])); col ++)
-	  columns[col] = MMD_TYPE_TABLE_BODY_CELL_LEFT;
+  if (minchars > 1)
+  {
+    while (*lineptr && strchr(chars, *lineptr))
+    {
+      if (*lineptr == *chars)
+	found_ch ++;
 
-	num_columns = 0;
-	rows	    = -1;
-      }
-      else if (rows > 0)
-      {
-	if (rows == 1)
-	  block = mmd_add(stackptr->parent, MMD_TYPE_TABLE_BODY, 0, NULL, NULL);
-      }
-      else
-	block = NULL;
+      lineptr ++;
+    }
+  }
 
-      if (block)
-	row = mmd_add(block, MMD_TYPE_TABLE_ROW, 0, NULL, NULL);
+  while (*lineptr && isspace(*lineptr & 255) && *lineptr != '\n')
+    lineptr ++;
 
-      if (*lineptr == '|')
-	lineptr ++;			// Skip leading pipe
+  if ((*lineptr && *lineptr != '\n') || found_ch < minchars)
+    return (0);
+  else
+    return (found_ch);
+}
 
-      if ((end = lineptr + strlen(lineptr) - 1) > lineptr)
-      {
-	while ((*end == '\n' || *end == 'r') && end > lineptr)
-	  end --;
 
-	if (end > lineptr && *end == '|')
-	  *end = '\0';			// Truncate trailing pipe
-      }
+//
+// 'mmd_is_codefence()' - Determine whether the line contains a code fence.
+//
 
-      for (col = 0; lineptr && *lineptr && col < (int)(sizeof(columns) / sizeof(columns[0])); col ++)
-      {
-        // Get the bounds of the stackptr->parent cell...
-	start = lineptr;
-	if ((lineptr = strchr(lineptr + 1, '|')) != NULL)
-	  *lineptr++ = '\0';
+static size_t				// O - Length of fence or 0 otherwise
+mmd_is_codefence(char	*lineptr,	// I - Line
+		 char	fence,		// I - Current fence character, if any
+		 size_t fencelen,	// I - Current fence length
+		 char	**language)	// O - Language name, if any
+{
+  char		match = fence;		// Character to match
+  size_t	len = 0;		// Length of fence chars
 
-	if (block)
-	{
-	  // Add a cell to this row...
-	  if (block->type == MMD_TYPE_TABLE_HEADER)
-	    cell = mmd_add(row, MMD_TYPE_TABLE_HEADER_CELL, 0, NULL, NULL);
-	  else
-	    cell = mmd_add(row, columns[col], 0, NULL, NULL);
 
-	  mmd_parse_inline(&doc, cell, start);
-	}
-	else
-	{
-	  // Process separator row for alignment...
-	  while (isspace(*start & 255))
-	    start ++;
+  if (language)
+    *language = NULL;
 
-	  for (end = start + strlen(start) - 1; end > start && isspace(*end & 255); end --)
-	    ;				// Find the last non-space character
+  if (!match)
+  {
+    if (*lineptr == '~' || *lineptr == '`')
+      match = *lineptr;
+    else
+      return (0);
+  }
 
-	  if (*start == ':' && *end == ':')
-	    columns[col] = MMD_TYPE_TABLE_BODY_CELL_CENTER;
-	  else if (*end == ':')
-	    columns[col] = MMD_TYPE_TABLE_BODY_CELL_RIGHT;
+  while (*lineptr == match)
+  {
+    lineptr ++;
+    len ++;
+  }
 
-	  DEBUG2_printf("COLUMN %d SEPARATOR=\"%s\", TYPE=%d\n", col, start, columns[col]);
-	}
-      }
+  if (len < 3 || (fencelen && len < fencelen))
+    return (0);
 
-      // Make sure the table is balanced...
-      if (col > num_columns)
-      {
-	num_columns = col;
-      }
-      else if (block && block->type != MMD_TYPE_TABLE_HEADER)
+  if (*lineptr && *lineptr != '\n' && fence)
+    return (0);
+  else if (*lineptr && *lineptr != '\n' && !fence)
+  {
+    if (match == '`' && strchr(lineptr, match))
+      return (0);
+
+    while (isspace(*lineptr & 255))
+      lineptr ++;
+
+    if (*lineptr && language)
+    {
+      *language = lineptr;
+
+      while (*lineptr && !isspace(*lineptr & 255))
       {
-	while (col < num_columns)
+	if (*lineptr == '\\' && lineptr[1])
 	{
-	  mmd_add(row, columns[col], 0, NULL, NULL);
-	  col ++;
+	  // Remove "\"
+	  memmove(lineptr, lineptr + 1, strlen(lineptr));
 	}
-      }
 
-      rows ++;
-      continue;
-    }
-    else if (stackptr->parent->type == MMD_TYPE_TABLE)
-    {
-      DEBUG2_puts("END TABLE\n");
-      stackptr --;
-      block = NULL;
+	lineptr ++;
+      }
+      *lineptr = '\0';
     }
+  }
 
-    if (stackptr->parent->type != MMD_TYPE_CODE_BLOCK && (!block || block->type == MMD_TYPE_CODE_BLOCK) && (lineptr - linestart) >= (stackptr->indent + 4))
-    {
-      // Indented code block.
-      if (stackptr->parent->type != MMD_TYPE_CODE_BLOCK && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
-      {
-	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_CODE_BLOCK, 0, NULL, NULL);
-	stackptr[1].indent = stackptr->indent + 4;
-	stackptr[1].fence  = '\0';
-	stackptr ++;
+  return (len);
+}
 
-	blank_code = 0;
-      }
 
-      while (blank_code > 0)
-      {
-	mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, "\n", NULL);
-	blank_code --;
-      }
+//
+// 'mmd_is_table()' - Look ahead to see if the next line contains a heading
+//		      divider for a table.
+//
 
-      mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, line + stackptr->indent, NULL);
+static bool				// O - `true` if this is a table, `false` otherwise
+mmd_is_table(_mmd_filebuf_t *file,	// I - File to read from
+	     int	    indent)	// I - Indentation of table line
+{
+  const char	*ptr;			// Pointer into buffer
 
-      continue;
-    }
 
-    if (!block || block->type != type)
-    {
-      if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
-	stackptr --;
+  ptr = file->bufptr;
+  while (*ptr)
+  {
+    if (!strchr(" \t>", *ptr))
+      break;
 
-      block = mmd_add(stackptr->parent, type, 0, NULL, NULL);
-    }
+    ptr ++;
+  }
 
-    // Read continuation lines before parsing this...
-    while (mmd_has_continuation(line, &file, stackptr->indent))
-    {
-      char *ptr = line + strlen(line);
+  if ((ptr - file->bufptr - indent) >= 4)
+    return (false);
 
-      if (!mmd_read_line(&file, ptr, sizeof(line) - (size_t)(ptr - line)))
-	break;
-      else if (line[0] == '>' && *ptr == '>')
-	memmove(ptr, ptr + 1, strlen(ptr));
+  while (*ptr)
+  {
+    if (!strchr(" \t:-|", *ptr))
+      break;
 
-      DEBUG2_printf("        line=\"%s\"\n", line);
-    }
+    ptr ++;
+  }
 
-    mmd_parse_inline(&doc, block, lineptr);
-
-    if (block->type == MMD_TYPE_PARAGRAPH && !block->first_child)
-    {
-      mmd_remove(block);
-      mmd_free(block);
-      block = NULL;
-    }
-  }
-
-  // Free any references...
-  for (i = doc.num_references, reference = doc.references; i > 0; i --, reference ++)
-  {
-    if (reference->pending)
-    {
-      char	text[8192];		// Reference text
-      size_t	j;			// Looping var
-
-      DEBUG2_printf("Clearing links for '%s'.\n", reference->name);
-      snprintf(text, sizeof(text), "[%s]", reference->name);
-
-      for (j = 0; j < reference->num_pending; j ++)
-      {
-	free(reference->pending[j]->text);
-	reference->pending[j]->text = strdup(text);
-	reference->pending[j]->type = MMD_TYPE_NORMAL_TEXT;
-      }
-
-      free(reference->pending);
-    }
-
-    free(reference->name);
-    free(reference->url);
-  }
-
-  free(doc.references);
-
-  // Return the root node...
-  return (doc.root);
-}
+  return (*ptr == '\r' || *ptr == '\n');
+}
 
 
 //
-// 'mmdLoadString()' - Load a markdown string into nodes.
+// 'mmd_load()' - Load a markdown file into nodes, optionally streaming blocks.
 //
 
-mmd_t *					// O - Root node in markdown
-mmdLoadString(mmd_t      *root,		// I - Root node for document or `NULL` for a new document
-              const char *s)		// I - String to load
+static mmd_t *				// O - Root node in markdown
+mmd_load(mmd_t         *root,		// I - Root node for document or `NULL` for a new document
+         mmd_iocb_t    cb,		// I - Read callback function
+         void          *cbdata,	// I - Read callback data
+         mmd_blockcb_t blockcb,	// I - Block callback function or `NULL`
+         void          *blockdata)	// I - Block callback data
 {
-  return (mmdLoadIO(root, (mmd_iocb_t)mmd_iocb_string, &s));
-}
+  size_t	i;			// Looping var
+  _mmd_doc_t	doc;			// Document
+  _mmd_ref_t	*reference;		// Current reference
+  mmd_t		*block = NULL,		// Current block
+		*node;			// Completed top-level block
+  mmd_type_t	type;			// Type for line
+  _mmd_filebuf_t file;			// File buffer
+  char		line[8192],		// Read line
+		*linestart,		// Start of line
+		*lineptr,		// Pointer into line
+		*lineend,		// End of line
+		*temp;			// Temporary pointer
+  int		newindent;		// New indentation
+  int		blank_code = 0;		// Saved indented blank code line
+  mmd_type_t	columns[256];		// Alignment of table columns
+  int		num_columns = 0,	// Number of columns in table
+		rows = 0;		// Number of rows in table
+  _mmd_stack_t	stack[32],		// Block stack
+		*stackptr = stack;	// Pointer to top of stack
 
 
-//
-// 'mmdSetOptions()' - Set (enable/disable) support for various markdown options.
-//
+  // Create an empty document as needed...
+  DEBUG_printf("mmdLoadIO: mmd_options=%d%s%s\n", mmd_options, (mmd_options & MMD_OPTION_METADATA) ? " METADATA" : "", (mmd_options & MMD_OPTION_TABLES) ? " TABLES" : "");
 
-void
-mmdSetOptions(mmd_option_t options)	// I - Options
-{
-  mmd_options = options;
-}
+  memset(&doc, 0, sizeof(doc));
 
+  if (root)
+    doc.root = root;
+  else
+    doc.root = mmd_add(NULL, MMD_TYPE_DOCUMENT, 0, NULL, NULL);
 
-//
-// 'mmd_add()' - Add a new markdown node.
-//
+  if (!doc.root)
+    return (NULL);
 
-static mmd_t *				// O - New node
-mmd_add(mmd_t	   *parent,		// I - Parent node
-	mmd_type_t type,		// I - Node type
-	int	   whitespace,		// I - 1 if whitespace precedes this node
-	char	   *text,		// I - Text, if any
-	char	   *url)		// I - URL, if any
-{
-  mmd_t		*temp;			// New node
+  doc.blockcb   = blockcb;
+  doc.blockdata = blockdata;
 
+  // Initialize the block stack...
+  memset(stack, 0, sizeof(stack));
+  stackptr->parent = doc.root;
 
-  DEBUG2_printf("Adding %s to %p(%s), whitespace=%d, text=\"%s\", url=\"%s\"\n", mmd_type_string(type), parent, parent ? mmd_type_string(parent->type) : "", whitespace, text ? text : "(null)", url ? url : "(null)");
+  // Read lines until end-of-file...
+  memset(&file, 0, sizeof(file));
+  file.cb     = cb;
+  file.cbdata = cbdata;
 
-  if (!parent && type != MMD_TYPE_DOCUMENT)
-    return (NULL);			// Only document nodes can be at the root
+#ifdef __clang_analyzer__
+  memset(line, 0, sizeof(line));
+#endif // __clang_analyzer__
 
-  if ((temp = calloc(1, sizeof(mmd_t))) != NULL)
+  while ((lineptr = mmd_read_line(&file, line, sizeof(line))) != NULL)
   {
-    if (parent)
+    // Send completed top-level blocks to the block callback.  Only the last
+    // child of the document can still change, unless an earlier block has a
+    // link to a reference that has not been defined yet...
+    while (blockcb && (node = doc.root->first_child) != doc.root->last_child && !node->num_pending)
     {
-      // Add node to the parent...
-      temp->parent = parent;
-
-      if (parent->last_child)
-      {
-	parent->last_child->next_sibling = temp;
-	temp->prev_sibling		 = parent->last_child;
-	parent->last_child		 = temp;
-      }
-      else
-      {
-	parent->first_child = parent->last_child = temp;
-      }
+      (*blockcb)(blockdata, node);
+      mmdFree(node);
     }
 
-    // Copy the node values...
-    temp->type	     = type;
-    temp->whitespace = whitespace;
-
-    if (text)
-      temp->text = strdup(text);
-
-    if (url)
-      temp->url = strdup(url);
-  }
-
-  return (temp);
-}
-
-
-//
-// 'mmd_free()' - Free memory used by a node.
-//
-
-static void
-mmd_free(mmd_t *node)			// I - Node
-{
-  free(node->text);
-  free(node->url);
-  free(node->extra);
-  free(node);
-}
+    DEBUG_printf("%03d	%-12s  %s", stackptr->indent, mmd_type_string(stackptr->parent->type) + 9, lineptr);
+#if DEBUG
+    if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
+      DEBUG2_printf("	  blank_code=%d\n", blank_code);
+#endif // DEBUG
 
+    linestart = lineptr;
 
-//
-// 'mmd_has_continuation()' - Determine whether the next line is a continuation
-//			      of the current one.
-//
+    while (isspace(*lineptr & 255))
+      lineptr ++;
 
-static int				// O - 1 if the next line continues, 0 otherwise
-mmd_has_continuation(
-    const char	   *line,		// I - Current line
-    _mmd_filebuf_t *file,		// I - File buffer
-    int		   indent)		// I - Indentation for current block
-{
-  const char	*lineptr = line;	// Pointer into current line
-  const char	*fileptr = file->bufptr;// Pointer into next line
+    DEBUG2_printf("	line indent=%d\n", (int)(lineptr - line));
+    DEBUG2_printf("	stackptr=%d\n", (int)(stackptr - stack));
 
+    if (!*lineptr && stackptr->parent->type == MMD_TYPE_TABLE)
+    {
+      DEBUG2_puts("END TABLE\n");
+      stackptr --;
+      block = NULL;
+      continue;
+    }
+    else if (stackptr->parent->type != MMD_TYPE_CODE_BLOCK && *lineptr == '>' && (lineptr - linestart) < 4)
+    {
+      // Block quote.  See if there is an existing blockquote...
+      DEBUG_printf("	 BLOCKQUOTE (stackptr=%ld)\n", stackptr - stack);
 
-  if (*fileptr == '\n' || *fileptr == '\r')
-    return (0);
+      if (stackptr == stack || stack[1].parent->type != MMD_TYPE_BLOCK_QUOTE)
+      {
+	block		 = NULL;
+	stackptr	 = stack + 1;
+	stackptr->parent = mmd_add(doc.root, MMD_TYPE_BLOCK_QUOTE, 0, NULL, NULL);
+	stackptr->indent = 2;
+	stackptr->fence	 = '\0';
+      }
 
-  do
-  {
-    while (isspace(*lineptr & 255))
+      // Skip whitespace after the ">"...
       lineptr ++;
+      if (isspace(*lineptr & 255))
+	lineptr ++;
 
-    if (*lineptr == '[' && (lineptr - line - indent) < 4 && (*fileptr == ' ' || *fileptr == '\t'))
-      return (1);
-
-    while (isspace(*fileptr & 255))
-      fileptr ++;
+      linestart = lineptr;
 
-    if (*lineptr == '>' && *fileptr == '>')
+      while (isspace(*lineptr & 255))
+	lineptr ++;
+    }
+    else if (*lineptr != '>' && stackptr > stack && stack[1].parent->type == MMD_TYPE_BLOCK_QUOTE && (!block || *lineptr == '\n' || mmd_is_chars(lineptr, "- \t", 3) || mmd_is_chars(lineptr, "_ \t", 3) || mmd_is_chars(lineptr, "* \t", 3)))
     {
-      lineptr ++;
-      fileptr ++;
+      // Not a lazy continuation so terminate this block quote...
+      DEBUG_puts("     Terminating BLOCKQUOTE\n");
+      block    = NULL;
+      stackptr = stack;
     }
-    else if (*fileptr == '>')
-      return (0);
-
-    if (*fileptr == '\n' || *fileptr == '\r')
-      return (0);
-  }
-  while (isspace(*lineptr & 255) || isspace(*fileptr & 255));
-
-  if (*lineptr == '#')
-    return (0);
 
-  if (strchr("-+*", *fileptr) && isspace(fileptr[1] & 255))
-  {
-    // Bullet list item...
-    return (0);
-  }
+    // Now handle all other markup not related to block quotes...
+    DEBUG2_printf("	stackptr=%d (%s), block=%p (%s)\n", (int)(stackptr - stack), mmd_type_string(stackptr->parent->type) + 9, block, block ? mmd_type_string(block->type) + 9 : "");
+    DEBUG2_printf("	strchr(lineptr, '|')=%p, mmd_is_table(&file, stackptr->indent)=%d\n", strchr(lineptr, '|'), mmd_is_table(&file, stackptr->indent));
+    DEBUG2_printf("	linestart=%d, lineptr=%d\n", (int)(linestart - line), (int)(lineptr - line));
+    DEBUG2_printf("	mmd_is_chars(lineptr, \"-\", 1)=%d\n", (int)mmd_is_chars(lineptr, "-", 1));
+    DEBUG2_printf("	mmd_is_chars(lineptr, \"=\", 1)=%d\n", (int)mmd_is_chars(lineptr, "=", 1));
 
-  if (isdigit(*fileptr & 255))
-  {
-    // Ordered list item...
-    while (*fileptr && isdigit(*fileptr & 255))
-      fileptr ++;
+    if ((lineptr - line - stackptr->indent) < 4 && ((stackptr->parent->type != MMD_TYPE_CODE_BLOCK && !stackptr->fence && mmd_is_codefence(lineptr, '\0', 0, NULL)) || (stackptr->fence && mmd_is_codefence(lineptr, stackptr->fence, stackptr->fencelen, NULL))))
+    {
+      // Code fence...
+      DEBUG2_printf("stackptr->indent=%d, fence='%c', fencelen=%d\n", stackptr->indent, stackptr->fence, (int)stackptr->fencelen);
 
-    if (*fileptr == '.' || *fileptr == '(')
-      return (0);
-  }
+      if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
+      {
+	DEBUG2_puts("Ending code block...\n");
+	stackptr --;
+      }
+      else if (stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+      {
+	char	*language;		// Language name, if any
 
-  if (mmd_is_codefence((char *)fileptr, '\0', 0, NULL))
-    return (0);
+	DEBUG2_printf("Starting code block with fence '%c'.\n", *lineptr);
 
-  if (mmd_is_chars(fileptr, "- \t", 3) || mmd_is_chars(fileptr, "_ \t", 3) || mmd_is_chars(fileptr, "* \t", 3))
-  {
-    // Thematic break...
-    return (0);
-  }
+	block		     = NULL;
+	stackptr[1].parent   = mmd_add(stackptr->parent, MMD_TYPE_CODE_BLOCK, 0, NULL, NULL);
+	stackptr[1].indent   = lineptr - line;
+	stackptr[1].fence    = *lineptr;
+	stackptr[1].fencelen = mmd_is_codefence(lineptr, '\0', 0, &language);
+	stackptr ++;
 
-  if (mmd_is_chars(fileptr, "-", 1) || mmd_is_chars(fileptr, "=", 1))
-  {
-    // Heading...
-    return (0);
-  }
+	DEBUG2_printf("Code language=\"%s\"\n", language);
 
-  if (*fileptr == '#')
-  {
-    // Possible heading...
-    int count = 0;
+	if (language)
+	  stackptr->parent->extra = strdup(language);
 
-    while (*fileptr == '#')
+	blank_code = 0;
+      }
+      continue;
+    }
+    else if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK && (lineptr - line) >= stackptr->indent)
     {
-      fileptr ++;
-      count ++;
+      if (line[stackptr->indent] == '\n')
+      {
+	blank_code ++;
+      }
+      else
+      {
+	while (blank_code > 0)
+	{
+	  mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, "\n", NULL);
+	  blank_code --;
+	}
+
+	mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, line + stackptr->indent, NULL);
+      }
+      continue;
     }
+    else if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK && stackptr->fence)
+    {
+      DEBUG2_printf("	  fence='%c'\n", stackptr->fence);
 
-    if (count <= 6)
-      return (0);
-  }
+      if (!*lineptr)
+      {
+	blank_code ++;
+      }
+      else
+      {
+	while (blank_code > 0)
+	{
+	  mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, "\n", NULL);
+	  blank_code --;
+	}
 
-  return ((fileptr - file->bufptr) <= indent);
-}
+	mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, lineptr, NULL);
+      }
+      continue;
+    }
+    else if (!strncmp(lineptr, "---", 3) && doc.root->first_child == NULL && (mmd_options & MMD_OPTION_METADATA))
+    {
+      // Document metadata...
+      block = mmd_add(doc.root, MMD_TYPE_METADATA, 0, NULL, NULL);
 
+      while ((lineptr = mmd_read_line(&file, line, sizeof(line))) != NULL)
+      {
+	while (isspace(*lineptr & 255))
+	  lineptr ++;
 
-//
-// 'mmd_iocb_file()' - Read from a file.
-//
+	if (!strncmp(lineptr, "---", 3) || !strncmp(lineptr, "...", 3))
+	  break;
 
-static size_t				// O - Number of bytes read
-mmd_iocb_file(FILE   *fp,		// I - File pointer
-              char   *buffer,		// I - Buffer
-              size_t bytes)		// I - Number of bytes to read
-{
-  return (fread(buffer, 1, bytes, fp));
-}
+	lineend = lineptr + strlen(lineptr) - 1;
+	if (lineend > lineptr && *lineend == '\n')
+	  *lineend = '\0';
 
+	mmd_add(block, MMD_TYPE_METADATA_TEXT, 0, lineptr, NULL);
+      }
 
-//
-// 'mmd_iocb_string()' - Read from a string.
-//
+      // Text after the metadata starts a new block...
+      block = NULL;
+      continue;
+    }
+    else if (block && block->type == MMD_TYPE_PARAGRAPH && (lineptr - linestart) < 4 && (lineptr - line) >= stackptr->indent && (mmd_is_chars(lineptr, "-", 1) || mmd_is_chars(lineptr, "=", 1)))
+    {
+      int ch = *lineptr;
 
-static size_t				// O - Number of bytes read
-mmd_iocb_string(const char **s,		// I - Pointer into string
-                char       *buffer,	// I - Buffer
-                size_t     bytes)	// I - Number of bytes to read
-{
-  size_t	ret;			// Bytes read/returned
+      DEBUG_puts("     SETEXT HEADING\n");
 
+      lineptr += 3;
+      while (*lineptr == ch)
+	lineptr ++;
+      while (isspace(*lineptr & 255))
+	lineptr ++;
 
-  // See how many bytes remain in the string...
-  if ((ret = strlen(*s)) > bytes)
-    ret = bytes;
+      if (!*lineptr)
+      {
+	if (ch == '=')
+	  block->type = MMD_TYPE_HEADING_1;
+	else
+	  block->type = MMD_TYPE_HEADING_2;
 
-  if (ret > 0)
-  {
-    // Copy bytes from the string...
-    memcpy(buffer, *s, ret);
-    (*s) += ret;
-  }
+	block = NULL;
+	continue;
+      }
+
+      type = MMD_TYPE_PARAGRAPH;
+    }
+    else if ((lineptr - linestart) < 4 && (mmd_is_chars(lineptr, "- \t", 3) || mmd_is_chars(lineptr, "_ \t", 3) || mmd_is_chars(lineptr, "* \t", 3)))
+    {
+      DEBUG_puts("     THEMATIC BREAK\n");
+
+      if (line[0] == '>')
+	stackptr = stack + 1;
+      else
+	stackptr = stack;
+
+      mmd_add(stackptr->parent, MMD_TYPE_THEMATIC_BREAK, 0, NULL, NULL);
+//      type  = MMD_TYPE_PARAGRAPH;
+      block = NULL;
+      continue;
+    }
+    else if ((*lineptr == '-' || *lineptr == '+' || *lineptr == '*') && (lineptr[1] == '\t' || lineptr[1] == ' '))
+    {
+      // Bulleted list...
+      DEBUG_puts("     UNORDERED LIST\n");
+
+      lineptr	+= 2;
+      linestart = lineptr;
+      newindent = linestart - line;
+
+      while (isspace(*lineptr & 255))
+	lineptr ++;
+
+      while (stackptr > stack && stackptr->indent > newindent)
+	stackptr --;
+
+      if (stackptr > stack && stackptr->parent->type == MMD_TYPE_LIST_ITEM && stackptr->indent == newindent)
+	stackptr --;
+
+      if (stackptr > stack && stackptr->parent->type == MMD_TYPE_ORDERED_LIST && stackptr->indent == newindent)
+	stackptr --;
+
+      if (stackptr > stack && stackptr->parent->type == MMD_TYPE_BLOCK_QUOTE && line[0] != '>')
+	stackptr --;
+
+      if (stackptr->parent->type != MMD_TYPE_UNORDERED_LIST && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+      {
+	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_UNORDERED_LIST, 0, NULL, NULL);
+	stackptr[1].indent = linestart - line;
+	stackptr[1].fence  = '\0';
+	stackptr ++;
+      }
+
+      if (stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+      {
+	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_LIST_ITEM, 0, NULL, NULL);
+	stackptr[1].indent = linestart - line;
+	stackptr[1].fence  = '\0';
+	stackptr ++;
+      }
+
+      type  = MMD_TYPE_PARAGRAPH;
+      block = NULL;
+
+      if (mmd_is_chars(lineptr, "- \t", 3) || mmd_is_chars(lineptr, "_ \t", 3) || mmd_is_chars(lineptr, "* \t", 3))
+      {
+	mmd_add(stackptr->parent, MMD_TYPE_THEMATIC_BREAK, 0, NULL, NULL);
+	continue;
+      }
+    }
+    else if (isdigit(*lineptr & 255))
+    {
+      // Ordered list?
+      DEBUG_puts("     ORDERED LIST?\n");
+
+      temp = lineptr + 1;
+
+      while (isdigit(*temp & 255))
+	temp ++;
+
+      if ((*temp == '.' || *temp == ')') && (temp[1] == '\t' || temp[1] == ' '))
+      {
+        // Yes, ordered list.
+	lineptr	  = temp + 2;
+	linestart = lineptr;
+	newindent = linestart - line;
+
+	while (isspace(*lineptr & 255))
+	  lineptr ++;
+
+	while (stackptr > stack && stackptr->indent > newindent)
+	  stackptr --;
+
+	if (stackptr->parent->type == MMD_TYPE_LIST_ITEM && stackptr->indent == newindent)
+	  stackptr --;
+
+	if (stackptr->parent->type == MMD_TYPE_UNORDERED_LIST && stackptr->indent == newindent)
+	  stackptr --;
+
+	if (stackptr->parent->type == MMD_TYPE_BLOCK_QUOTE && line[0] != '>')
+	  stackptr --;
+
+	if (stackptr->parent->type != MMD_TYPE_ORDERED_LIST && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+	{
+	  stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_ORDERED_LIST, 0, NULL, NULL);
+	  stackptr[1].indent = linestart - line;
+	  stackptr[1].fence  = '\0';
+	  stackptr ++;
+	}
+
+	if (stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+	{
+	  stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_LIST_ITEM, 0, NULL, NULL);
+	  stackptr[1].indent = linestart - line;
+	  stackptr[1].fence  = '\0';
+	  stackptr ++;
+	}
+
+	type  = MMD_TYPE_PARAGRAPH;
+	block = NULL;
+      }
+      else
+      {
+        // No, just a regular paragraph...
+	type = block ? block->type : MMD_TYPE_PARAGRAPH;
+      }
+    }
+    else if (*lineptr == '#' && (lineptr - linestart) < 4)
+    {
+      // Heading, count the number of '#' for the heading level...
+      DEBUG_puts("     HEADING?\n");
+
+      newindent = lineptr - line;
+      temp	= lineptr + 1;
+
+      while (*temp == '#')
+	temp ++;
+
+      if ((temp - lineptr) <= 6 && isspace(*temp & 255))
+      {
+        // Heading 1-6...
+	type  = MMD_TYPE_HEADING_1 + (temp - lineptr - 1);
+	block = NULL;
+
+        // Skip whitespace after "#"...
+	lineptr = temp;
+	while (isspace(*lineptr & 255))
+	  lineptr ++;
+
+	linestart = lineptr;
+
+        // Strip trailing "#" characters and whitespace...
+	temp = lineptr + strlen(lineptr) - 1;
+	while (temp > lineptr && isspace(*temp & 255))
+	  *temp-- = '\0';
+	while (temp > lineptr && *temp == '#')
+	  temp --;
+	if (isspace(*temp & 255))
+	{
+	  while (temp > lineptr && isspace(*temp & 255))
+	    *temp-- = '\0';
+	}
+	else if (temp == lineptr)
+	  *temp = '\0';
+
+	while (stackptr > stack && stackptr->indent > newindent)
+	  stackptr --;
+
+	block = mmd_add(stackptr->parent, type, 0, NULL, NULL);
+      }
+      else
+      {
+        // More than 6 #'s, just treat as a paragraph...
+	type = MMD_TYPE_PARAGRAPH;
+      }
+    }
+    else if (block && block->type >= MMD_TYPE_HEADING_1 && block->type <= MMD_TYPE_HEADING_6)
+    {
+      DEBUG_puts("     PARAGRAPH\n");
+
+      type  = MMD_TYPE_PARAGRAPH;
+      block = NULL;
+    }
+    else if (!block)
+    {
+      type = MMD_TYPE_PARAGRAPH;
+
+      if (lineptr == line && stackptr->parent->type != MMD_TYPE_TABLE)
+	stackptr = stack;
+    }
+    else
+      type = block->type;
+
+    if (!*lineptr)
+    {
+      if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
+	blank_code ++;
+      else if (stackptr->parent->type == MMD_TYPE_BLOCK_QUOTE && line[0] != '>')
+	stackptr --;
+
+      block = NULL;
+      continue;
+    }
+    else if (!strcmp(lineptr, "+"))
+    {
+      if (block)
+      {
+	if (block->type == MMD_TYPE_LIST_ITEM)
+	  block = mmd_add(block, MMD_TYPE_PARAGRAPH, 0, NULL, NULL);
+	else if (block->parent->type == MMD_TYPE_LIST_ITEM)
+	  block = mmd_add(block->parent, MMD_TYPE_PARAGRAPH, 0, NULL, NULL);
+	else
+	  block = NULL;
+      }
+      continue;
+    }
+    else if ((mmd_options & MMD_OPTION_TABLES) && strchr(lineptr, '|') && (stackptr->parent->type == MMD_TYPE_TABLE || mmd_is_table(&file, stackptr->indent)))
+    {
+      // Table...
+      int	col;			// Current column
+      char	*start,			// Start of column/cell
+		*end;			// End of column/cell
+      mmd_t	*row = NULL,		// Current row
+		*cell;			// Current cell
+
+      DEBUG2_printf("TABLE stackptr->parent=%p (%d), rows=%d\n", stackptr->parent, stackptr->parent->type, rows);
+
+      if (stackptr->parent->type != MMD_TYPE_TABLE && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+      {
+	DEBUG2_printf("ADDING NEW TABLE to %p (%s)\n", stackptr->parent, mmd_type_string(stackptr->parent->type));
+
+	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_TABLE, 0, NULL, NULL);
+	stackptr[1].indent = stackptr->indent;
+	stackptr[1].fence  = '\0';
+	stackptr ++;
+
+	block = mmd_add(stackptr->parent, MMD_TYPE_TABLE_HEADER, 0, NULL, NULL);
+
+	for (col = 0; col < (int)(sizeof(columns) / sizeof(columns[0])); col ++)
+	  columns[col] = MMD_TYPE_TABLE_BODY_CELL_LEFT;
+
+	num_columns = 0;
+	rows	    = -1;
+      }
+      else if (rows > 0)
+      {
+	if (rows == 1)
+	  block = mmd_add(stackptr->parent, MMD_TYPE_TABLE_BODY, 0, NULL, NULL);
+      }
+      else
+	block = NULL;
+
+      if (block)
+	row = mmd_add(block, MMD_TYPE_TABLE_ROW, 0, NULL, NULL);
+
+      if (*lineptr == '|')
+	lineptr ++;			// Skip leading pipe
+
+      if ((end = lineptr + strlen(lineptr) - 1) > lineptr)
+      {
+	while ((*end == '\n' || *end == 'r') && end > lineptr)
+	  end --;
+
+	if (end > lineptr && *end == '|')
+	  *end = '\0';			// Truncate trailing pipe
+      }
+
+      for (col = 0; lineptr && *lineptr && col < (int)(sizeof(columns) / sizeof(columns[0])); col ++)
+      {
+        // Get the bounds of the stackptr->parent cell...
+	start = lineptr;
+	if ((lineptr = strchr(lineptr + 1, '|')) != NULL)
+	  *lineptr++ = '\0';
+
+	if (block)
+	{
+	  // Add a cell to this row...
+	  if (block->type == MMD_TYPE_TABLE_HEADER)
+	    cell = mmd_add(row, MMD_TYPE_TABLE_HEADER_CELL, 0, NULL, NULL);
+	  else
+	    cell = mmd_add(row, columns[col], 0, NULL, NULL);
 
-  return (ret);
-}
+	  mmd_parse_inline(&doc, cell, start);
+	}
+	else
+	{
+	  // Process separator row for alignment...
+	  while (isspace(*start & 255))
+	    start ++;
 
+	  for (end = start + strlen(start) - 1; end > start && isspace(*end & 255); end --)
+	    ;				// Find the last non-space character
 
-//
-// 'mmd_is_chars()' - Determine whether a line consists solely of whitespace
-//		      and the specified character.
-//
+	  if (*start == ':' && *end == ':')
+	    columns[col] = MMD_TYPE_TABLE_BODY_CELL_CENTER;
+	  else if (*end == ':')
+	    columns[col] = MMD_TYPE_TABLE_BODY_CELL_RIGHT;
 
-static size_t				// O - 1 if as specified, 0 otherwise
-mmd_is_chars(const char *lineptr,	// I - Current line
-	     const char *chars,		// I - Non-space character
-	     size_t	minchars)	// I - Minimum number of non-space characters
-{
-  size_t	found_ch = 0;		// Did we find the specified characters?
+	  DEBUG2_printf("COLUMN %d SEPARATOR=\"%s\", TYPE=%d\n", col, start, columns[col]);
+	}
+      }
 
-  while (*lineptr == *chars)
-  {
-    found_ch ++;
-    lineptr ++;
-  }
+      // Make sure the table is balanced...
+      if (col > num_columns)
+      {
+	num_columns = col;
+      }
+      else if (block && block->type != MMD_TYPE_TABLE_HEADER)
+      {
+	while (col < num_columns)
+	{
+	  mmd_add(row, columns[col], 0, NULL, NULL);
+	  col ++;
+	}
+      }
 
-  if (minchars > 1)
-  {
-    while (*lineptr && strchr(chars, *lineptr))
+      rows ++;
+      continue;
+    }
+    else if (stackptr->parent->type == MMD_TYPE_TABLE)
     {
-      if (*lineptr == *chars)
-	found_ch ++;
-
-      lineptr ++;
+      DEBUG2_puts("END TABLE\n");
+      stackptr --;
+      block = NULL;
     }
-  }
 
-  while (*lineptr && isspace(*lineptr & 255) && *lineptr != '\n')
-    lineptr ++;
-
-  if ((*lineptr && *lineptr != '\n') || found_ch < minchars)
-    return (0);
-  else
-    return (found_ch);
-}
+    if (stackptr->parent->type != MMD_TYPE_CODE_BLOCK && (!block || block->type == MMD_TYPE_CODE_BLOCK) && (lineptr - linestart) >= (stackptr->indent + 4))
+    {
+      // Indented code block.
+      if (stackptr->parent->type != MMD_TYPE_CODE_BLOCK && stackptr < (stack + sizeof(stack) / sizeof(stack[0]) - 1))
+      {
+	stackptr[1].parent = mmd_add(stackptr->parent, MMD_TYPE_CODE_BLOCK, 0, NULL, NULL);
+	stackptr[1].indent = stackptr->indent + 4;
+	stackptr[1].fence  = '\0';
+	stackptr ++;
 
+	blank_code = 0;
+      }
 
-//
-// 'mmd_is_codefence()' - Determine whether the line contains a code fence.
-//
+      while (blank_code > 0)
+      {
+	mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, "\n", NULL);
+	blank_code --;
+      }
 
-static size_t				// O - Length of fence or 0 otherwise
-mmd_is_codefence(char	*lineptr,	// I - Line
-		 char	fence,		// I - Current fence character, if any
-		 size_t fencelen,	// I - Current fence length
-		 char	**language)	// O - Language name, if any
-{
-  char		match = fence;		// Character to match
-  size_t	len = 0;		// Length of fence chars
+      mmd_add(stackptr->parent, MMD_TYPE_CODE_TEXT, 0, line + stackptr->indent, NULL);
 
+      continue;
+    }
 
-  if (language)
-    *language = NULL;
+    if (!block || block->type != type)
+    {
+      if (stackptr->parent->type == MMD_TYPE_CODE_BLOCK)
+	stackptr --;
 
-  if (!match)
-  {
-    if (*lineptr == '~' || *lineptr == '`')
-      match = *lineptr;
-    else
-      return (0);
-  }
+      block = mmd_add(stackptr->parent, type, 0, NULL, NULL);
+    }
 
-  while (*lineptr == match)
-  {
-    lineptr ++;
-    len ++;
-  }
+    // Read continuation lines before parsing this...
+    while (mmd_has_continuation(line, &file, stackptr->indent))
+    {
+      char *ptr = line + strlen(line);
 
-  if (len < 3 || (fencelen && len < fencelen))
-    return (0);
+      if (!mmd_read_line(&file, ptr, sizeof(line) - (size_t)(ptr - line)))
+	break;
+      else if (line[0] == '>' && *ptr == '>')
+	memmove(ptr, ptr + 1, strlen(ptr));
 
-  if (*lineptr && *lineptr != '\n' && fence)
-    return (0);
-  else if (*lineptr && *lineptr != '\n' && !fence)
-  {
-    if (match == '`' && strchr(lineptr, match))
-      return (0);
+      DEBUG2_printf("        line=\"%s\"\n", line);
+    }
 
-    while (isspace(*lineptr & 255))
-      lineptr ++;
+    mmd_parse_inline(&doc, block, lineptr);
 
-    if (*lineptr && language)
+    if (block->type == MMD_TYPE_PARAGRAPH && !block->first_child)
     {
-      *language = lineptr;
-
-      while (*lineptr && !isspace(*lineptr & 255))
-      {
-	if (*lineptr == '\\' && lineptr[1])
-	{
-	  // Remove "\"
-	  memmove(lineptr, lineptr + 1, strlen(lineptr));
-	}
-
-	lineptr ++;
-      }
-      *lineptr = '\0';
+      mmd_remove(block);
+      mmd_free(block);
+      block = NULL;
     }
   }
 
-  return (len);
-}
-
-
-//
-// 'mmd_is_table()' - Look ahead to see if the next line contains a heading
-//		      divider for a table.
-//
+  // Free any references...
+  for (i = doc.num_references, reference = doc.references; i > 0; i --, reference ++)
+  {
+    if (reference->pending)
+    {
+      char	text[8192];		// Reference text
+      size_t	j;			// Looping var
 
-static bool				// O - `true` if this is a table, `false` otherwise
-mmd_is_table(_mmd_filebuf_t *file,	// I - File to read from
-	     int	    indent)	// I - Indentation of table line
-{
-  const char	*ptr;			// Pointer into buffer
+      DEBUG2_printf("Clearing links for '%s'.\n", reference->name);
+      snprintf(text, sizeof(text), "[%s]", reference->name);
 
+      for (j = 0; j < reference->num_pending; j ++)
+      {
+	free(reference->pending[j]->text);
+	reference->pending[j]->text = strdup(text);
+	reference->pending[j]->type = MMD_TYPE_NORMAL_TEXT;
+      }
 
-  ptr = file->bufptr;
-  while (*ptr)
-  {
-    if (!strchr(" \t>", *ptr))
-      break;
+      free(reference->pending);
+    }
 
-    ptr ++;
+    free(reference->name);
+    free(reference->url);
+    free(reference->title);
   }
 
-  if ((ptr - file->bufptr - indent) >= 4)
-    return (false);
+  free(doc.references);
+  free(doc.hash);
 
-  while (*ptr)
+  // Send any remaining blocks to the block callback...
+  if (blockcb)
   {
-    if (!strchr(" \t:-|", *ptr))
-      break;
-
-    ptr ++;
+    while ((node = doc.root->first_child) != NULL)
+    {
+      (*blockcb)(blockdata, node);
+      mmdFree(node);
+    }
   }
 
-  return (*ptr == '\r' || *ptr == '\n');
+  // Return the root node...
+  return (doc.root);
 }
 
 
@@ -2218,6 +2329,8 @@ mmd_ref_add(_mmd_doc_t *doc,		// I - Document
 
 	if (title)
 	  ref->pending[i]->extra = strdup(title);
+
+        mmd_block(doc, ref->pending[i])->num_pending --;
       }
 
       free(ref->pending);
@@ -2227,20 +2340,61 @@ mmd_ref_add(_mmd_doc_t *doc,		// I - Document
       return;
     }
   }
-  else if ((ref = realloc(doc->references, (doc->num_references + 1) * sizeof(_mmd_ref_t))) != NULL)
+  else
   {
-    doc->references = ref;
-    ref += doc->num_references;
-    doc->num_references ++;
+    // Grow the references array and hash table as needed...
+    if (doc->num_references >= doc->alloc_references)
+    {
+      size_t alloc_references = doc->alloc_references ? 2 * doc->alloc_references : 16;
+					// New allocation
+
+      if ((ref = realloc(doc->references, alloc_references * sizeof(_mmd_ref_t))) == NULL)
+	return;
+
+      doc->references	    = ref;
+      doc->alloc_references = alloc_references;
+    }
+
+    if (2 * (doc->num_references + 1) > doc->hash_size)
+    {
+      size_t hash_size = doc->hash_size ? 2 * doc->hash_size : 64,
+					// New size of hash table
+	     *hash;			// New hash table
+
+      if ((hash = calloc(hash_size, sizeof(size_t))) == NULL)
+	return;
+
+      for (i = 0; i < doc->num_references; i ++)
+      {
+	size_t h = mmd_ref_hash(doc->references[i].name) & (hash_size - 1);
+					// Hash slot
+
+	while (hash[h])
+	  h = (h + 1) & (hash_size - 1);
+
+	hash[h] = i + 1;
+      }
+
+      free(doc->hash);
+
+      doc->hash      = hash;
+      doc->hash_size = hash_size;
+    }
+
+    ref = doc->references + doc->num_references;
 
     ref->name	     = strdup(name);
     ref->url	     = url ? strdup(url) : NULL;
     ref->title	     = title ? strdup(title) : NULL;
     ref->num_pending = 0;
     ref->pending     = NULL;
+
+    for (i = mmd_ref_hash(name) & (doc->hash_size - 1); doc->hash[i]; i = (i + 1) & (doc->hash_size - 1))
+      ;					// Find an empty slot
+
+    doc->num_references ++;
+    doc->hash[i] = doc->num_references;
   }
-  else
-    return;
 
   if (node)
   {
@@ -2252,6 +2406,8 @@ mmd_ref_add(_mmd_doc_t *doc,		// I - Document
     else if ((ref->pending = realloc(ref->pending, (ref->num_pending + 1) * sizeof(mmd_t *))) != NULL)
     {
       ref->pending[ref->num_pending ++] = node;
+
+      mmd_block(doc, node)->num_pending ++;
     }
   }
 }
@@ -2268,14 +2424,36 @@ mmd_ref_find(_mmd_doc_t *doc,		// I - Document
   size_t	i;			// Looping var
 
 
-  for (i = 0; i < doc->num_references; i ++)
-    if (!strcasecmp(name, doc->references[i].name))
-      return (doc->references + i);
+  if (!doc->hash)
+    return (NULL);
+
+  for (i = mmd_ref_hash(name) & (doc->hash_size - 1); doc->hash[i]; i = (i + 1) & (doc->hash_size - 1))
+  {
+    if (!strcasecmp(name, doc->references[doc->hash[i] - 1].name))
+      return (doc->references + doc->hash[i] - 1);
+  }
 
   return (NULL);
 }
 
 
+//
+// 'mmd_ref_hash()' - Compute the case-insensitive hash of a reference name.
+//
+
+static size_t				// O - Hash value
+mmd_ref_hash(const char *name)		// I - Reference name
+{
+  size_t	h = 2166136261U;	// Hash value
+
+
+  while (*name)
+    h = (h ^ (size_t)tolower(*name++ & 255)) * 16777619U;
+
+  return (h ^ (h >> 15));
+}
+
+
 //
 // 'mmd_remove()' - Remove a node from its parent.
 //
@@ -79,6 +79,8 @@ typedef enum mmd_type_e
 typedef struct _mmd_s mmd_t;		// Markdown node
 typedef size_t (*mmd_iocb_t)(void *cbdata, char *buffer, size_t bytes);
 					// mmdLoadIO callback function
+typedef void (*mmd_blockcb_t)(void *cbdata, mmd_t *block);
+					// mmdStreamIO block callback function
 
 //
 // Functions...
@@ -104,6 +106,8 @@ extern mmd_t        *mmdLoadFile(mmd_t *root, FILE *fp);
 extern mmd_t        *mmdLoadIO(mmd_t *root, mmd_iocb_t cb, void *cbdata);
 extern mmd_t        *mmdLoadString(mmd_t *root, const char *s);
 extern void         mmdSetOptions(mmd_option_t options);
+extern bool         mmdStreamFile(FILE *fp, mmd_blockcb_t blockcb, void *blockdata);
+extern bool         mmdStreamIO(mmd_iocb_t cb, void *cbdata, mmd_blockcb_t blockcb, void *blockdata);
 
 
 #  ifdef __cplusplus
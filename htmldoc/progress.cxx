@@ -27,11 +27,39 @@ static FILE	*error_log = NULL;
 #endif // WIN32
 
 
+/*
+ * Local types...
+ */
+
+typedef struct				/**** Saved message ****/
+{
+  HDerror	error;			/* Error number */
+  char		*text;			/* Message text */
+} message_t;
+
+struct progress_log_s			/**** Saved messages ****/
+{
+  size_t	num_messages,		/* Number of messages */
+		alloc_messages;		/* Allocated messages */
+  message_t	*messages;		/* Messages */
+};
+
+
 /*
  * Local globals...
  */
 
 static int	progress_visible = 0;
+static hd_mutex_t progress_mutex = HD_MUTEX_INITIALIZER;
+static HD_THREAD_LOCAL progress_log_t *progress_log = NULL;
+					/* Saved messages for this thread */
+
+
+/*
+ * Local functions...
+ */
+
+static void	progress_message(HDerror error, const char *text);
 
 
 /*
@@ -50,19 +78,166 @@ progress_error(HDerror    error,	/* I - Error number */
   if (error == HD_ERROR_HTML_ERROR && !StrictHTML)
     return;
 
-  if (error)
-    Errors ++;
-
   va_start(ap, format);
   vsnprintf(text, sizeof(text), format, ap);
   va_end(ap);
 
+  if (progress_log)
+  {
+    // Save the message to show later...
+    message_t	*temp;			/* New messages array */
+
+    if (progress_log->num_messages >= progress_log->alloc_messages)
+    {
+      if ((temp = (message_t *)realloc(progress_log->messages, (progress_log->alloc_messages + 16) * sizeof(message_t))) == NULL)
+      {
+        progress_message(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for messages.");
+        progress_message(error, text);
+        return;
+      }
+
+      progress_log->messages       = temp;
+      progress_log->alloc_messages += 16;
+    }
+
+    temp        = progress_log->messages + progress_log->num_messages;
+    temp->error = error;
+
+    if ((temp->text = strdup(text)) != NULL)
+      progress_log->num_messages ++;
+    else
+      progress_message(error, text);
+    return;
+  }
+
+  progress_message(error, text);
+}
+
+
+/*
+ * 'progress_hide()' - Hide the current run status.
+ */
+
+void
+progress_hide(void)
+{
+  if (hd_thread_worker())
+    return;
+
+#ifdef HAVE_LIBFLTK
+  if (BookGUI != NULL)
+  {
+    BookGUI->progress(0, "HTMLDOC " SVERSION " Ready.");
+    return;
+  }
+#endif /* HAVE_LIBFLTK */
+
+  if (CGIMode)
+    return;
+
+  if (Verbosity > 0)
+  {
+    fprintf(stderr, "\r%-79.79s\r", "");
+    fflush(stderr);
+  }
+
+  progress_visible = 0;
+}
+
+
+/*
+ * 'progress_log_errors()' - Count the saved error messages.
+ */
+
+int					/* O - Number of errors */
+progress_log_errors(progress_log_t *log)/* I - Saved messages */
+{
+  size_t	i;			/* Looping var */
+  int		count = 0;		/* Number of errors */
+
+
+  if (!log)
+    return (0);
+
+  for (i = 0; i < log->num_messages; i ++)
+    if (log->messages[i].error != HD_ERROR_NONE)
+      count ++;
+
+  return (count);
+}
+
+
+/*
+ * 'progress_log_flush()' - Show and free saved messages.
+ */
+
+void
+progress_log_flush(progress_log_t *log)	/* I - Saved messages */
+{
+  size_t	i;			/* Looping var */
+
+
+  if (!log)
+    return;
+
+  for (i = 0; i < log->num_messages; i ++)
+  {
+    progress_message(log->messages[i].error, log->messages[i].text);
+    free(log->messages[i].text);
+  }
+
+  free(log->messages);
+  free(log);
+}
+
+
+/*
+ * 'progress_log_new()' - Create a list of saved messages.
+ */
+
+progress_log_t *			/* O - Saved messages */
+progress_log_new(void)
+{
+  return ((progress_log_t *)calloc(1, sizeof(progress_log_t)));
+}
+
+
+/*
+ * 'progress_log_set()' - Save messages from the current thread.
+ *
+ * Messages from progress_error() are saved in the log until the log is
+ * flushed, so that work done in parallel can be reported in order.  Pass
+ * `NULL` to show messages immediately again.
+ */
+
+void
+progress_log_set(progress_log_t *log)	/* I - Saved messages or `NULL` */
+{
+  progress_log = log;
+}
+
+
+/*
+ * 'progress_message()' - Show a formatted message.
+ */
+
+static void
+progress_message(HDerror    error,	/* I - Error number */
+                 const char *text)	/* I - Message text */
+{
+  // Errors can be reported from layout threads, so serialize the output...
+  hd_mutex_lock(&progress_mutex);
+
+  if (error)
+    Errors ++;
+
 #ifdef HAVE_LIBFLTK
   if (BookGUI != NULL)
   {
     if (error)
       BookGUI->add_error(text);
 
+    hd_mutex_unlock(&progress_mutex);
     return;
   }
 #endif /* HAVE_LIBFLTK */
@@ -97,6 +272,7 @@ progress_error(HDerror    error,	/* I - Error number */
       fflush(error_log);
     }
 
+    hd_mutex_unlock(&progress_mutex);
     return;
   }
 #endif // WIN32
@@ -116,34 +292,8 @@ progress_error(HDerror    error,	/* I - Error number */
 
     fflush(stderr);
   }
-}
-
-
-/*
- * 'progress_hide()' - Hide the current run status.
- */
 
-void
-progress_hide(void)
-{
-#ifdef HAVE_LIBFLTK
-  if (BookGUI != NULL)
-  {
-    BookGUI->progress(0, "HTMLDOC " SVERSION " Ready.");
-    return;
-  }
-#endif /* HAVE_LIBFLTK */
-
-  if (CGIMode)
-    return;
-
-  if (Verbosity > 0)
-  {
-    fprintf(stderr, "\r%-79.79s\r", "");
-    fflush(stderr);
-  }
-
-  progress_visible = 0;
+  hd_mutex_unlock(&progress_mutex);
 }
 
 
@@ -159,6 +309,9 @@ progress_show(const char *format,	/* I - Printf-style format string */
   static char	text[2048];		/* Formatted text string */
 
 
+  if (hd_thread_worker())
+    return;
+
   va_start(ap, format);
   vsnprintf(text, sizeof(text), format, ap);
   va_end(ap);
@@ -199,6 +352,9 @@ progress_show(const char *format,	/* I - Printf-style format string */
 void
 progress_update(int percent)	/* I - Percent complete */
 {
+  if (hd_thread_worker())
+    return;
+
 #ifdef HAVE_LIBFLTK
   if (BookGUI != NULL)
   {
@@ -45,6 +45,13 @@ typedef enum
 } HDerror;
 
 
+/*
+ * Saved messages for a file or other unit of work...
+ */
+
+typedef struct progress_log_s progress_log_t;
+
+
 /*
  * Prototypes...
  */
@@ -55,6 +62,10 @@ __attribute__ ((__format__ (__printf__, 2, 3)))
 #    endif /* __GNUC__ */
 ;
 extern void	progress_hide(void);
+extern int	progress_log_errors(progress_log_t *log);
+extern void	progress_log_flush(progress_log_t *log);
+extern progress_log_t *progress_log_new(void);
+extern void	progress_log_set(progress_log_t *log);
 extern void	progress_show(const char *format, ...)
 #    ifdef __GNUC__
 __attribute__ ((__format__ (__printf__, 1, 2)))
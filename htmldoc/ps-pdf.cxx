@@ -27,6 +27,7 @@
 /*#define DEBUG*/
 #include "htmldoc.h"
 #include "markdown.h"
+#include "cache.h"
 #include "md5-private.h"
 #define md5_append _cupsMD5Append
 #define md5_finish _cupsMD5Finish
@@ -59,9 +60,17 @@ extern "C" {		/* Workaround for JPEG header problems... */
 
 
 /*
- * Output options...
+ * 64-bit file offsets...
  */
 
+#ifdef WIN32
+#  define fseeko	_fseeki64
+#  define ftello	_ftelli64
+typedef __int64 hdoff_t;
+#else
+typedef off_t hdoff_t;
+#endif // WIN32
+
 #define HTMLDOC_ASCII85
 //#define HTMLDOC_INTERPOLATION
 #define HTMLDOC_PRODUCER "htmldoc " SVERSION " Copyright 2011-" SYEAR " by Michael R Sweet"
@@ -126,7 +135,8 @@ typedef struct				//// Page information
 		duplex,			// Duplex this page?
 		landscape;		// Landscape orientation?
   render_t	*start,			// First render element
-		*end;			// Last render element
+		*end,			// Last render element
+		*furniture;		// First header/footer element
   uchar		*url,                   // URL/file
                 *chapter,		// Chapter text
 		*heading;		// Heading text
@@ -140,6 +150,8 @@ typedef struct				//// Page information
   char		page_text[64];		// Page number for TOC
   image_t	*background_image;	// Background image
   float		background_color[3];	// Background color
+  int		background_obj,		// Background form object
+		furniture_obj;		// Header/footer form object
 
   // Number-up support
   int		nup;			// Number up pages
@@ -147,6 +159,85 @@ typedef struct				//// Page information
   float		outmatrix[2][3];	// Transform matrix
 } page_t;
 
+typedef struct				//// Deferred named link
+{
+  int		append;			// Always append (file links)?
+  link_t	link;			// Link name and position
+} joblink_t;
+
+typedef struct				//// Chapter layout job
+{
+  tree_t	*start,			// First node in chapter
+		*stop;			// First node in next chapter
+  uchar		*url,			// Current URL at start of chapter
+		*end_url;		// Current URL at end of chapter
+  tree_t	*heading;		// Current heading at end of chapter
+  int		chapter;		// Chapter number before start
+  float		left,			// Left margin
+		right,			// Right margin
+		bottom,			// Bottom margin
+		top,			// Top margin
+		y;			// Final Y position
+  int		page,			// Final page
+		start_page;		// First page of chapter
+  size_t	num_pages;		// Number of pages
+  page_t	*pages;			// Pages
+  size_t	num_headings;		// Number of headings
+  int		*heading_pages,		// Heading pages
+		*heading_tops;		// Heading positions
+  size_t	num_links,		// Number of named links
+		alloc_links;		// Allocated named links
+  joblink_t	*links;			// Named links in document order
+  progress_log_t *log;			// Messages from formatting
+  char		key[HD_CACHE_KEY_SIZE];	// Layout cache key or ""
+  size_t	num_nodes;		// Number of nodes in chapter
+  tree_t	**nodes;		// Nodes in chapter for layout cache
+} chapter_job_t;
+
+typedef struct				//// Node number for layout cache
+{
+  tree_t	*node;			// Node
+  size_t	number;			// Node number (1-based)
+} nodenum_t;
+
+typedef struct				//// Layout state of a thread
+{
+  uchar		*current_url;		// Current URL
+  int		title_page,		// Formatting the title page?
+		chapter,		// Current chapter
+		chapter_starts[MAX_CHAPTERS],
+					// First page of each chapter
+		chapter_ends[MAX_CHAPTERS];
+					// Last page of each chapter
+  size_t	num_headings,		// Number of headings
+		alloc_headings;		// Allocated headings
+  int		*heading_pages,		// Heading pages
+		*heading_tops;		// Heading positions
+  size_t	num_pages,		// Number of pages
+		alloc_pages;		// Allocated pages
+  page_t	*pages;			// Pages
+  tree_t	*current_heading;	// Current heading
+  uchar		list_types[16];		// List types
+  int		list_values[16];	// List values
+} layout_state_t;
+
+typedef struct				//// Header/footer element for sharing
+{
+  char		*key;			// Drawing state and contents
+  int		page,			// Page number
+		group,			// Group of identical elements
+		count;			// Number of identical elements
+  render_t	*r;			// Render element
+} hfitem_t;
+
+typedef struct				//// Shared header/footer elements of a page
+{
+  char		*set;			// Groups of shared elements
+  int		page,			// Page number
+		first,			// First header/footer element
+		count;			// Number of header/footer elements
+} hfset_t;
+
 typedef struct				//// Output page info
 {
   int		nup;			// Number up pages
@@ -154,6 +245,33 @@ typedef struct				//// Output page info
   int		annot_object;		// Annotation object
 } outpage_t;
 
+typedef struct				//// ASCII85 encoder state
+{
+  int		col;			// Current output column
+  size_t	leftcount;		// Number of bytes in leftdata
+  uchar		leftdata[4];		// Bytes left over from the last call
+} ascii85_t;
+
+typedef struct				//// Shared image output state
+{
+  FILE		*out;			// Output file
+  int		count,			// Number of images written
+		num_images;		// Number of images to write
+} pdf_images_t;
+
+#ifdef HTMLDOC_STREAMING
+typedef struct				//// Streaming output sink
+{
+  int		fd,			// Output file descriptor
+		direct;			// Write data immediately?
+  hdoff_t	offset;			// Number of bytes written to fd
+  uchar		*buffer;		// Pending (uncommitted) data
+  size_t	used,			// Number of pending bytes
+		alloc,			// Allocated size of buffer
+		pos;			// Current position in buffer
+} sink_t;
+#endif // HTMLDOC_STREAMING
+
 
 /*
  * Local globals...
@@ -163,39 +281,49 @@ static time_t	doc_time;		// Current time
 static struct tm doc_date;		// Current date
 static struct tm doc_gmdate;		// Current date (UTC)
 
-static uchar    *current_url = NULL;
-static int	title_page;
-static int	chapter,
-		chapter_outstarts[MAX_CHAPTERS],
-		chapter_outends[MAX_CHAPTERS],
+// Layout state is per-thread so that chapters can be formatted in parallel
+static HD_THREAD_LOCAL uchar *current_url = NULL;
+static HD_THREAD_LOCAL int title_page;
+static HD_THREAD_LOCAL int chapter,
 		chapter_starts[MAX_CHAPTERS],
 		chapter_ends[MAX_CHAPTERS];
+static int	chapter_outstarts[MAX_CHAPTERS],
+		chapter_outends[MAX_CHAPTERS];
 
-static size_t	num_headings = 0,
+static HD_THREAD_LOCAL size_t num_headings = 0,
 		alloc_headings = 0;
-static int	*heading_pages = NULL,
+static HD_THREAD_LOCAL int *heading_pages = NULL,
 		*heading_tops = NULL;
 
-static size_t	num_pages = 0,
+static HD_THREAD_LOCAL size_t num_pages = 0,
 		alloc_pages = 0;
-static page_t	*pages = NULL;
-static tree_t	*current_heading;
+static HD_THREAD_LOCAL page_t *pages = NULL;
+static HD_THREAD_LOCAL tree_t *current_heading;
 
 static size_t	num_outpages = 0;
 static outpage_t *outpages = NULL;
 
-static size_t	num_links = 0,
+static HD_THREAD_LOCAL size_t num_links = 0,
 		alloc_links = 0;
-static link_t	*links = NULL;
+static HD_THREAD_LOCAL link_t *links = NULL;
 
-static uchar	list_types[16];
-static int	list_values[16];
+static HD_THREAD_LOCAL uchar list_types[16];
+static HD_THREAD_LOCAL int list_values[16];
 
-static char	stdout_filename[256];
+static HD_THREAD_LOCAL chapter_job_t *current_job = NULL;
+					// Chapter being formatted by this thread
+
+#ifdef HTMLDOC_STREAMING
+static sink_t	stdout_sink;		// Sink for streamed stdout output
+static int	stdout_sink_active = 0;	// Is the sink in use?
+#else
+static char	stdout_filename[256];	// Temporary file for stdout
+#endif // HTMLDOC_STREAMING
 static size_t	num_objects = 0,
 		alloc_objects = 0;
-static int	*objects = NULL,
-		root_object,
+static hdoff_t	*objects = NULL;		// Object offsets
+static int	pdf_stream_error = 0;	// Was a stream too large?
+static int	root_object,
 		info_object,
 		outline_object,
 		pages_object,
@@ -227,11 +355,14 @@ static float	render_size,
 		render_x,
 		render_y,
 		render_startx,
+		render_textx,
 		render_spacing;
 
 static int		compressor_active = 0;
 static z_stream		compressor;
 static uchar		comp_buffer[8192];
+static ascii85_t	ascii85_state;	// ASCII85 encoder for PostScript output
+static FILE		*page_file = NULL;	// Temporary file for PostScript pages
 static uchar		encrypt_key[16];
 static int		encrypt_len;
 static rc4_context_t	encrypt_state;
@@ -264,9 +395,14 @@ static void	ps_write_background(FILE *out);
 static void	pdf_write_document(uchar *author, uchar *creator,
 		                   uchar *copyright, uchar *keywords,
 				   uchar *subject, uchar *lang, tree_t *doc, tree_t *toc);
+static void	pdf_write_forms(FILE *out);
+static void	pdf_write_image(pdf_images_t *info, image_t *img);
 static void	pdf_write_outpage(FILE *out, int outpage);
 static void	pdf_write_page(FILE *out, int page);
+static void	pdf_write_renders(FILE *out, render_t *start);
 static void	pdf_write_resources(FILE *out, int page);
+static void	write_cgi_header(tree_t *doc, hdoff_t length);
+static int	write_stdout(const void *buffer, size_t bytes);
 #ifdef DEBUG_TOC
 static void	pdf_text_contents(FILE *out, tree_t *toc, int indent = 0);
 #endif // DEBUG_TOC
@@ -286,11 +422,19 @@ static void	flate_open_stream(FILE *out);
 static void	flate_close_stream(FILE *out);
 static void	flate_puts(const char *s, FILE *out);
 static void	flate_printf(FILE *out, const char *format, ...);
-static void	flate_write(FILE *out, uchar *inbuf, int length, int flush=0);
+static void	flate_write(FILE *out, uchar *inbuf, size_t length, int flush=0);
+static char	*format_float(char *s, float number, int digits);
 
 static void	parse_contents(tree_t *t, float left, float width, float bottom,
 		               float length, float *y, int *page, int *heading,
 			       tree_t *chap);
+static int	find_chapters(tree_t *t, chapter_job_t *jobs);
+static void	hash_chapter(chapter_job_t *job);
+static int	load_chapter(chapter_job_t *job);
+static void	save_chapter(chapter_job_t *job);
+static void	parse_chapter(void *data, int index);
+static int	parse_chapters(tree_t *t, float left, float right, float bottom,
+		               float top, int *page);
 static void	parse_doc(tree_t *t, float *left, float *right, float *bottom,
 		          float *top, float *x, float *y, int *page,
 			  tree_t *cpara, int *needspace);
@@ -317,8 +461,12 @@ static void	parse_comment(tree_t *t, float *left, float *width, float *bottom,
 static void	check_pages(int page);
 
 static void	add_link(tree_t *html, uchar *name, int page, int top);
+static void	insert_link(link_t *link, int append);
 static link_t	*find_link(uchar *name);
+static int	compare_hfitems(hfitem_t **a, hfitem_t **b);
+static int	compare_hfsets(hfset_t *a, hfset_t *b);
 static int	compare_links(link_t *n1, link_t *n2);
+static int	compare_nodes(nodenum_t *a, nodenum_t *b);
 
 static void	find_background(tree_t *t);
 static void	write_background(int page, FILE *out);
@@ -337,25 +485,44 @@ static float	get_width(uchar *s, int typeface, int style, int size);
 static void	update_image_size(tree_t *t);
 static uchar	*get_title(tree_t *doc);
 static FILE	*open_file(void);
+#ifdef HTMLDOC_STREAMING
+static FILE	*sink_open(int fd, int direct);
+static void	sink_commit(FILE *out);
+static int	sink_write(sink_t *sink, const uchar *buffer, size_t bytes);
+extern "C" {
+static int	sink_close(void *ptr);
+static hdoff_t	sink_seek(sink_t *sink, hdoff_t offset, int whence);
+#  ifdef HAVE_FOPENCOOKIE
+static int	sink_seek_cb(void *ptr, off64_t *offset, int whence);
+static ssize_t	sink_write_cb(void *ptr, const char *buf, size_t size);
+#  else
+static fpos_t	sink_seek_cb(void *ptr, fpos_t offset, int whence);
+static int	sink_write_cb(void *ptr, const char *buf, int size);
+#  endif // HAVE_FOPENCOOKIE
+}
+#endif // HTMLDOC_STREAMING
 static void	set_color(FILE *out, float *rgb);
 static void	set_font(FILE *out, int typeface, int style, float size);
 static void	set_pos(FILE *out, float x, float y);
 static void	write_prolog(FILE *out, int pages, uchar *author,
 		             uchar *creator, uchar *copyright,
 			     uchar *keywords, uchar *subject);
-static void	ps_hex(FILE *out, uchar *data, int length);
+static void	ps_hex(FILE *out, uchar *data, size_t length);
 #ifdef HTMLDOC_ASCII85
-static void	ps_ascii85(FILE *out, uchar *data, int length, int eod = 0);
+static void	ps_ascii85(FILE *out, ascii85_t *state, uchar *data, size_t length, int eod = 0);
 #endif // HTMLDOC_ASCII85
 static void	jpg_init(j_compress_ptr cinfo);
 static boolean	jpg_empty(j_compress_ptr cinfo);
 static void	jpg_term(j_compress_ptr cinfo);
 static void	jpg_setup(FILE *out, image_t *img, j_compress_ptr cinfo);
 static int	compare_rgb(unsigned *rgb1, unsigned *rgb2);
+static void	decode_images(render_t *start);
 static void	write_image(FILE *out, render_t *r, int write_obj = 0);
 static void	write_imagemask(FILE *out, render_t *r);
 static void	write_string(FILE *out, uchar *s, int compress);
-static void	write_text(FILE *out, render_t *r);
+static render_t	*write_text(FILE *out, render_t *r);
+static float	write_text_width(render_t *r);
+static float	text_size(render_t *r);
 static void	write_trailer(FILE *out, int pages, uchar *lang);
 static int	write_type1(FILE *out, typeface_t typeface,
 			    style_t style);
@@ -523,6 +690,7 @@ pspdf_export(tree_t *document,	/* I - Document to export */
   memset(list_values, 0, sizeof(list_values));
   memset(chapter_starts, -1, sizeof(chapter_starts));
   memset(chapter_ends, -1, sizeof(chapter_starts));
+  memset(&ascii85_state, 0, sizeof(ascii85_state));
 
  /*
   * Get the current date, using the SOURCE_DATE_EPOCH environment variable, if
@@ -545,10 +713,16 @@ pspdf_export(tree_t *document,	/* I - Document to export */
   alloc_links    = 0;
   links          = NULL;
   num_pages      = 0;
+  chapter        = 0;
+  title_page     = 0;
+  current_url    = NULL;
+  current_heading = NULL;
 
   DEBUG_printf(("pspdf_export: TitlePage = %d, TitleImage = \"%s\"\n",
                 TitlePage, TitleImage));
 
+  stats_begin(HD_STATS_LAYOUT);
+
   if (TitlePage)
   {
     const char *title_ext = file_extension(TitleImage);
@@ -574,6 +748,7 @@ pspdf_export(tree_t *document,	/* I - Document to export */
       if ((title_file = file_find(Path, TitleImage)) == NULL)
       {
 	progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to find title file '%s'.", TitleImage);
+	stats_end(HD_STATS_LAYOUT);
 	return (1);
       }
 
@@ -581,6 +756,7 @@ pspdf_export(tree_t *document,	/* I - Document to export */
       if ((fp = fopen(title_file, "rb")) == NULL)
       {
 	progress_error(HD_ERROR_FILE_NOT_FOUND, "Unable to open title file '%s': %s", TitleImage, strerror(errno));
+	stats_end(HD_STATS_LAYOUT);
 	return (1);
       }
 
@@ -734,6 +910,8 @@ pspdf_export(tree_t *document,	/* I - Document to export */
     chapter           = 1;
     TocDocCount       = 1;
     chapter_starts[1] = num_pages;
+
+    stats_chapter(1);
   }
 
   title_page      = 0;
@@ -795,7 +973,8 @@ pspdf_export(tree_t *document,	/* I - Document to export */
 
   y = top;
 
-  parse_doc(document, &left, &right, &bottom, &top, &x, &y, &page, NULL, &needspace);
+  if (!parse_chapters(document, left, right, bottom, top, &page))
+    parse_doc(document, &left, &right, &bottom, &top, &x, &y, &page, NULL, &needspace);
 
   if (PageDuplex && (num_pages & 1))
   {
@@ -871,6 +1050,8 @@ pspdf_export(tree_t *document,	/* I - Document to export */
     chapter_starts[0] = num_pages;
     chapter           = 0;
 
+    stats_chapter(0);
+
     parse_contents(toc, 0, PagePrintWidth, bottom, top, &y, &page, &heading, 0);
     if (PageDuplex && (num_pages & 1))
       check_pages(num_pages);
@@ -880,6 +1061,8 @@ pspdf_export(tree_t *document,	/* I - Document to export */
       pspdf_prepare_page(page);
   }
 
+  stats_end(HD_STATS_LAYOUT);
+
   if (TocDocCount > MAX_CHAPTERS)
     TocDocCount = MAX_CHAPTERS;
 
@@ -898,12 +1081,17 @@ pspdf_export(tree_t *document,	/* I - Document to export */
     pspdf_debug_stats();
 
     progress_error(HD_ERROR_NONE, "PAGES: %d", (int)num_outpages);
+    stats_count(HD_COUNT_PAGES, num_outpages);
+
+    stats_begin(HD_STATS_WRITE);
 
     if (PSLevel > 0)
       ps_write_document(author, creator, copyright, keywords, subject, lang);
     else
       pdf_write_document(author, creator, copyright, keywords, subject, lang,
                          document, toc);
+
+    stats_end(HD_STATS_WRITE);
   }
   else
   {
@@ -1363,12 +1551,15 @@ pspdf_prepare_page(int page)		/* I - Page number */
   int	print_page;			/* Printed page # */
   char	page_text[64];			/* Page number text */
   int	top;				/* Top of page */
+  render_t *last;			/* Last element before headings */
 
 
   DEBUG_printf(("pspdf_prepare_page(%d)\n", page));
   if (page < 0 || (size_t)page >= num_pages)
     return;
 
+  last = pages[page].end;
+
  /*
   * Make a page number; use roman numerals for the table of contents
   * and arabic numbers for all others...
@@ -1439,6 +1630,13 @@ pspdf_prepare_page(int page)		/* I - Page number */
     pspdf_prepare_heading(page, print_page, pages[page].footer, 0, page_text, sizeof(page_text));
   }
 
+ /*
+  * Remember where the headers and footers start so that PDF output can share
+  * them between pages...
+  */
+
+  pages[page].furniture = last ? last->next : pages[page].start;
+
  /*
   * Copy the page number for the TOC...
   */
@@ -1888,7 +2086,8 @@ ps_write_document(uchar *author,	/* I - Author of document */
     {
       write_trailer(out, 0, lang);
 
-      progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(out));
+      progress_error(HD_ERROR_NONE, "BYTES: %lld", (long long)ftello(out));
+      stats_count(HD_COUNT_BYTES_OUT, (long long)ftello(out));
 
       fclose(out);
     }
@@ -1926,7 +2125,8 @@ ps_write_document(uchar *author,	/* I - Author of document */
     {
       write_trailer(out, 0, lang);
 
-      progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(out));
+      progress_error(HD_ERROR_NONE, "BYTES: %lld", (long long)ftello(out));
+      stats_count(HD_COUNT_BYTES_OUT, (long long)ftello(out));
 
       fclose(out);
     }
@@ -1940,12 +2140,19 @@ ps_write_document(uchar *author,	/* I - Author of document */
   {
     write_trailer(out, 0, lang);
 
-    progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(out));
+    progress_error(HD_ERROR_NONE, "BYTES: %lld", (long long)ftello(out));
+    stats_count(HD_COUNT_BYTES_OUT, (long long)ftello(out));
 
     if (out != stdout)
       fclose(out);
   }
 
+  if (page_file)
+  {
+    fclose(page_file);
+    page_file = NULL;
+  }
+
   if (Verbosity)
     progress_hide();
 }
@@ -1963,6 +2170,10 @@ ps_write_outpage(FILE *out,	/* I - Output file */
   page_t	*p;		/* Current page */
   outpage_t	*op;		/* Current output page */
   int		i;		/* Looping var */
+  FILE		*pout;		/* Output file for drawing commands */
+  long		length;		/* Length of drawing commands */
+  size_t	bytes;		/* Bytes read */
+  uchar		buffer[8192];	/* Copy buffer */
 
 
   if (outpage < 0 || outpage >= (int)num_outpages)
@@ -2092,13 +2303,28 @@ ps_write_outpage(FILE *out,	/* I - Output file */
   }
 
  /*
-  * Render all of the pages...
+  * Render all of the pages, writing the drawing commands to a temporary file
+  * when they will be compressed...
   */
 
+  pout = out;
+
+  if (PSLevel > 2 && PSCompression && Compression)
+  {
+    if (!page_file && (page_file = tmpfile()) == NULL)
+      progress_error(HD_ERROR_WRITE_ERROR,
+                     "Unable to create temporary page file - %s", strerror(errno));
+    else
+    {
+      rewind(page_file);
+      pout = page_file;
+    }
+  }
+
   switch (op->nup)
   {
     case 1 :
-        ps_write_page(out, op->pages[0]);
+        ps_write_page(pout, op->pages[0]);
 	break;
 
     default :
@@ -2109,16 +2335,41 @@ ps_write_outpage(FILE *out,	/* I - Output file */
 
           p = pages + op->pages[i];
 
-          fprintf(out, "GS[%.3f %.3f %.3f %.3f %.3f %.3f]CM\n",
+          fprintf(pout, "GS[%.3f %.3f %.3f %.3f %.3f %.3f]CM\n",
 	          p->outmatrix[0][0], p->outmatrix[1][0],
 	          p->outmatrix[0][1], p->outmatrix[1][1],
 	          p->outmatrix[0][2], p->outmatrix[1][2]);
-          ps_write_page(out, op->pages[i]);
-	  fputs("GR\n", out);
+          ps_write_page(pout, op->pages[i]);
+	  fputs("GR\n", pout);
 	}
 	break;
   }
 
+ /*
+  * Compress the drawing commands inside the page; the DSC comments and
+  * showpage stay outside of the compressed stream...
+  */
+
+  if (pout != out)
+  {
+    length = ftell(page_file);
+    rewind(page_file);
+
+    fputs("FP\n", out);
+    flate_open_stream(out);
+
+    while (length > 0 &&
+           (bytes = fread(buffer, 1, length < (long)sizeof(buffer) ?
+	                                 (size_t)length : sizeof(buffer),
+			  page_file)) > 0)
+    {
+      flate_write(out, buffer, bytes);
+      length -= (long)bytes;
+    }
+
+    flate_close_stream(out);
+  }
+
  /*
   * Output the page trailer...
   */
@@ -2188,6 +2439,8 @@ ps_write_page(FILE  *out,	/* I - Output file */
   * Render all graphics elements...
   */
 
+  decode_images(p->start);
+
   for (r = p->start; r != NULL; r = r->next)
     switch (r->type)
     {
@@ -2285,13 +2538,24 @@ pdf_write_document(uchar  *author,	// I - Author of document
   FILE		*out;			// Output file
   int		outpage,		// Current page #
 		heading;		// Current heading #
+#ifndef HTMLDOC_STREAMING
   int		bytes;			// Number of bytes
   char		buffer[8192];		// Copy buffer
-  int		num_images;		// Number of images in document
-  image_t	**images;		// Pointers to images
-  render_t	temp;			// Dummy rendering data...
+#endif // !HTMLDOC_STREAMING
+  int		num_images,		// Number of images in document
+		num_shared;		// Number of shared images
+  image_t	**images,		// Pointers to images
+		**shared;		// Shared images
+  pdf_images_t	info;			// Shared image output state
 
 
+#ifdef HTMLDOC_STREAMING
+  // In CGI mode the headers go out first, without a Content-Length, so the
+  // client gets each object as soon as it is written...
+  if (CGIMode && !OutputPath[0])
+    write_cgi_header(doc, -1);
+#endif // HTMLDOC_STREAMING
+
   // Open the output file...
   out = open_file();
   if (out == NULL)
@@ -2302,41 +2566,50 @@ pdf_write_document(uchar  *author,	// I - Author of document
   }
 
   // Clear the objects array...
-  num_objects   = 0;
-  alloc_objects = 0;
-  objects       = NULL;
+  num_objects      = 0;
+  alloc_objects    = 0;
+  objects          = NULL;
+  pdf_stream_error = 0;
 
   // Write the prolog...
   write_prolog(out, num_outpages, author, creator, copyright, keywords, subject);
 
-  // Write images as needed...
+  // Write images that are shared or too large to inline, decoding them in
+  // parallel ahead of the writer...
   num_images = image_getlist(&images);
+  num_shared = 0;
 
-  for (i = 0; i < num_images; i ++)
+  if (num_images > 0 && (shared = (image_t **)malloc((size_t)num_images * sizeof(image_t *))) != NULL)
   {
-    int	hfi;				// Header/footer image index
+    for (i = 0; i < num_images; i ++)
+    {
+      int	hfi;			// Header/footer image index
 
 
-    for (hfi = 0; hfi < MAX_HF_IMAGES; hfi ++)
-      if (images[i] == hfimage[hfi])
-        break;
+      for (hfi = 0; hfi < MAX_HF_IMAGES; hfi ++)
+	if (images[i] == hfimage[hfi])
+	  break;
+
+      if (images[i]->use > 1 || images[i]->mask ||
+	  (images[i]->width * images[i]->height * images[i]->depth) > 65536 ||
+	  images[i] == background_image ||
+	  images[i] == logo_image ||
+	  hfi < MAX_HF_IMAGES)
+	shared[num_shared ++] = images[i];
+    }
 
-    memset(&temp, 0, sizeof(temp));	// For Coverity, not explicitly necessary
+    info.out        = out;
+    info.count      = 0;
+    info.num_images = num_shared;
 
-    if (images[i]->use > 1 || images[i]->mask ||
-        (images[i]->width * images[i]->height * images[i]->depth) > 65536 ||
-	images[i] == background_image ||
-	images[i] == logo_image ||
-	hfi < MAX_HF_IMAGES)
-    {
-      progress_show("Writing image %d (%s)...", i + 1, images[i]->filename);
-      progress_update(100 * i / num_images);
+    image_decode(num_shared, shared, !OutputColor, (image_cb_t)pdf_write_image, &info);
 
-      temp.data.image = images[i];
-      write_image(out, &temp, 1);
-    }
+    free(shared);
   }
 
+  // Write backgrounds, headers, and footers that are shared between pages...
+  pdf_write_forms(out);
+
   // Write links and target names...
   pdf_write_links(out);
   if (PDFVersion >= 12)
@@ -2359,9 +2632,33 @@ pdf_write_document(uchar  *author,	// I - Author of document
   fputs("]", out);
   pdf_end_object(out);
 
-  for (outpage = 0; outpage < (int)num_outpages; outpage ++)
+  for (outpage = 0; outpage < (int)num_outpages && !pdf_stream_error; outpage ++)
     pdf_write_outpage(out, outpage);
 
+  if (pdf_stream_error)
+  {
+   /*
+    * A stream was too large for its length field, so remove the incomplete
+    * output file...
+    */
+
+    fclose(out);
+
+    if (OutputPath[0])
+      unlink(OutputPath);
+
+    free(objects);
+
+    num_objects   = 0;
+    alloc_objects = 0;
+    objects       = NULL;
+
+    if (Verbosity)
+      progress_hide();
+
+    return;
+  }
+
   if (OutputType == OUTPUT_BOOK && TocLevels > 0)
   {
    /*
@@ -2389,34 +2686,17 @@ pdf_write_document(uchar  *author,	// I - Author of document
 
   write_trailer(out, 0, lang);
 
-  progress_error(HD_ERROR_NONE, "BYTES: %ld", ftell(out));
+  progress_error(HD_ERROR_NONE, "BYTES: %lld", (long long)ftello(out));
+  stats_count(HD_COUNT_BYTES_OUT, (long long)ftello(out));
 
+#ifndef HTMLDOC_STREAMING
   if (CGIMode)
-  {
-    const char	*meta_filename = (const char *)htmlGetMeta(doc, (uchar *)"HTMLDOC.filename");
-    const char	*filename;
-
-    if (meta_filename)
-    {
-      if ((filename = strrchr(meta_filename, '/')) != NULL)
-        filename ++;
-      else
-        filename = meta_filename;
-    }
-    else
-      filename = "htmldoc.pdf";
-
-    // In CGI mode, we only produce PDF output to stdout...
-    printf("Content-Type: application/pdf\r\n"
-	   "Content-Length: %ld\r\n"
-	   "Content-Disposition: inline; filename=\"%s\"\r\n"
-	   "Accept-Ranges: none\r\n"
-	   "X-Creator: HTMLDOC " SVERSION "\r\n"
-	   "\r\n", ftell(out), filename);
-  }
+    write_cgi_header(doc, ftello(out));
+#endif // !HTMLDOC_STREAMING
 
   fclose(out);
 
+#ifndef HTMLDOC_STREAMING
   //
   // If we are sending the output to stdout, copy the temp file now...
   //
@@ -2436,11 +2716,13 @@ pdf_write_document(uchar  *author,	// I - Author of document
     out = fopen(stdout_filename, "rb");
 
     while ((bytes = fread(buffer, 1, sizeof(buffer), out)) > 0)
-      fwrite(buffer, 1, (size_t)bytes, stdout);
+      if (!write_stdout(buffer, (size_t)bytes))
+        break;
 
     // Close the temporary file (it is removed when the program exits...)
     fclose(out);
   }
+#endif // !HTMLDOC_STREAMING
 
   // Clear the objects array...
   if (alloc_objects)
@@ -2458,129 +2740,558 @@ pdf_write_document(uchar  *author,	// I - Author of document
 
 
 /*
- * 'pdf_write_resources()' - Write the resources dictionary for a page.
+ * 'write_cgi_header()' - Write the HTTP response header in CGI mode.
  */
 
 static void
-pdf_write_resources(FILE *out,		/* I - Output file */
-                    int  outpage)	/* I - Output page for resources */
+write_cgi_header(tree_t  *doc,		// I - Document
+                 hdoff_t length)	// I - Length of PDF file or -1 if unknown
 {
-  int		i;			/* Looping var */
-  outpage_t	*op;			/* Current output page */
-  page_t	*p;			/* Current page */
-  render_t	*r;			/* Render pointer */
-  int		fonts_used[TYPE_MAX * STYLE_MAX];
-					/* Non-zero if the page uses a font */
-  int		images_used;		/* Non-zero if the page uses an image */
-  int		text_used;		/* Non-zero if the page uses text */
-  static const char *effects[] =	/* Effects and their commands */
-		{
-		  "",
-		  "/S/Box/M/I",
-		  "/S/Box/M/O",
-		  "/S/Dissolve",
-		  "/S/Glitter/Di 270",
-		  "/S/Glitter/Di 315",
-		  "/S/Glitter/Di 0",
-		  "/S/Blinds/Dm/H",
-		  "/S/Split/Dm/H/M/I",
-		  "/S/Split/Dm/H/M/O",
-		  "/S/Blinds/Dm/V",
-		  "/S/Split/Dm/V/M/I",
-		  "/S/Split/Dm/V/M/O",
-		  "/S/Wipe/Di 270",
-		  "/S/Wipe/Di 180",
-		  "/S/Wipe/Di 0",
-		  "/S/Wipe/Di 90"
-		};
+  const char	*meta_filename = (const char *)htmlGetMeta(doc, (uchar *)"HTMLDOC.filename");
+  const char	*filename;		// Filename for Content-Disposition
+  char		header[1024],		// Response header
+		*ptr;			// Pointer into header
 
 
-  memset(fonts_used, 0, sizeof(fonts_used));
-  images_used  = background_image != NULL;
-  text_used    = 0;
-  op           = outpages + outpage;
-  for (i = 0; i < op->nup; i ++)
+  if (meta_filename)
   {
-    if (op->pages[i] < 0)
-      break;
+    if ((filename = strrchr(meta_filename, '/')) != NULL)
+      filename ++;
+    else
+      filename = meta_filename;
+  }
+  else
+    filename = "htmldoc.pdf";
 
-    p = pages + op->pages[i];
+  // In CGI mode, we only produce PDF output to stdout...
+  strlcpy(header, "Content-Type: application/pdf\r\n", sizeof(header));
+  ptr = header + strlen(header);
+  if (length >= 0)
+  {
+    snprintf(ptr, sizeof(header) - (size_t)(ptr - header), "Content-Length: %lld\r\n", (long long)length);
+    ptr += strlen(ptr);
+  }
+  snprintf(ptr, sizeof(header) - (size_t)(ptr - header),
+	   "Content-Disposition: inline; filename=\"%s\"\r\n"
+	   "Accept-Ranges: none\r\n"
+	   "X-Creator: HTMLDOC " SVERSION "\r\n"
+	   "\r\n", filename);
 
-    for (r = p->start; r != NULL; r = r->next)
+  write_stdout(header, strlen(header));
+}
+
+
+/*
+ * 'pdf_write_forms()' - Write backgrounds, headers, and footers that are the
+ *                       same on multiple pages as form XObjects.
+ *
+ * The background of every page with the same size is drawn by a single form.
+ * Header and footer elements that appear on more than one page are grouped by
+ * the set of shared elements on each page, and each set that is used by two or
+ * more pages becomes a form that replaces those elements on the pages.
+ * Elements that change from page to page, such as page numbers, are left on
+ * the page.
+ */
+
+static void
+pdf_write_forms(FILE *out)		/* I - Output file */
+{
+  int		i, j, k, n,		/* Looping vars */
+		page,			/* Current page */
+		bbox,			/* Size of form bounding box */
+		bytes,			/* Estimated size of form content */
+		page_width,		/* Width of page */
+		page_length;		/* Length of page */
+  page_t	*p;			/* Current page */
+  render_t	*r,			/* Current render element */
+		*start,			/* First shared element */
+		*last;			/* Last shared element */
+  int		num_items,		/* Number of header/footer elements */
+		alloc_items;		/* Allocated header/footer elements */
+  hfitem_t	*items,			/* Header/footer elements */
+		*item,			/* Current element */
+		**sorted;		/* Elements sorted by key */
+  hfset_t	*sets;			/* Shared elements for each page */
+  char		key[2048],		/* Key for element or set */
+		*keyptr;		/* Pointer into key */
+  int		fonts_used[TYPE_MAX * STYLE_MAX];
+					/* Non-zero if the form uses a font */
+  int		bg_sizes[16][3],	/* Background forms by page size */
+		num_bg_sizes;		/* Number of background forms */
+
+
+ /*
+  * Write the background forms...
+  */
+
+  if (background_image)
+  {
+    for (page = 0, num_bg_sizes = 0; page < (int)num_pages; page ++)
     {
-      if (r->type == RENDER_IMAGE)
+      p = pages + page;
+
+      if (Landscape)
       {
-	images_used = 1;
+	page_length = p->width;
+	page_width  = p->length;
       }
-      else if (r->type == RENDER_TEXT)
+      else
       {
-	text_used = 1;
-	fonts_used[r->data.text.typeface * 4 + r->data.text.style] = 1;
+	page_width  = p->width;
+	page_length = p->length;
+      }
+
+      for (i = 0; i < num_bg_sizes; i ++)
+        if (bg_sizes[i][0] == page_width && bg_sizes[i][1] == page_length)
+          break;
+
+      if (i < num_bg_sizes)
+      {
+        p->background_obj = bg_sizes[i][2];
+        continue;
       }
+      else if (num_bg_sizes >= (int)(sizeof(bg_sizes) / sizeof(bg_sizes[0])))
+        continue;			// Draw the background on the page
+
+      render_rgb[0] = -1.0f;
+      render_rgb[1] = -1.0f;
+      render_rgb[2] = -1.0f;
+
+      pdf_start_object(out);
+      fputs("/Type/XObject/Subtype/Form", out);
+      fprintf(out, "/BBox[0 0 %d %d]", page_width, page_length);
+      fprintf(out, "/Resources<</XObject<</I%d %d 0 R>>>>", background_image->obj, background_image->obj);
+      if (Compression)
+        fputs("/Filter/FlateDecode", out);
+      pdf_start_stream(out);
+      flate_open_stream(out);
+
+      write_background(page, out);
+
+      flate_close_stream(out);
+      pdf_end_object(out);
+
+      p->background_obj = (int)num_objects;
+
+      bg_sizes[num_bg_sizes][0] = page_width;
+      bg_sizes[num_bg_sizes][1] = page_length;
+      bg_sizes[num_bg_sizes][2] = p->background_obj;
+      num_bg_sizes ++;
     }
   }
 
-  fputs("/Resources<<", out);
+ /*
+  * Collect the header and footer elements of every page...
+  */
 
-  if (!images_used)
-  {
-    fputs("/ProcSet[/PDF/Text]", out);
-  }
-  else if (PDFVersion >= 12)
-  {
-    if (OutputColor)
-      fputs("/ProcSet[/PDF/Text/ImageB/ImageC/ImageI]", out);
-    else
-      fputs("/ProcSet[/PDF/Text/ImageB/ImageI]", out);
-  }
-  else
-  {
-    if (OutputColor)
-      fputs("/ProcSet[/PDF/Text/ImageB/ImageC]", out);
-    else
-      fputs("/ProcSet[/PDF/Text/ImageB]", out);
-  }
+  num_items   = 0;
+  alloc_items = 0;
+  items       = NULL;
+  sorted      = NULL;
 
-  if (text_used)
+  if ((sets = (hfset_t *)calloc(num_pages, sizeof(hfset_t))) == NULL)
   {
-    fputs("/Font<<", out);
-    for (i = 0; i < (TYPE_MAX * STYLE_MAX); i ++)
-      if (fonts_used[i])
-	fprintf(out, "/F%x %d 0 R", i, font_objects[i]);
-    fputs(">>", out); // End of Font
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d pages.", (int)num_pages);
+    return;
   }
 
-  if (images_used)
+  for (page = 0; page < (int)num_pages; page ++)
   {
-    fputs("/XObject<<", out);
+    sets[page].page  = page;
+    sets[page].first = num_items;
 
-    for (i = 0; i < op->nup; i ++)
+    for (r = pages[page].furniture; r; r = r->next)
     {
-      if (op->pages[i] < 0)
-	break;
+      if (r->type == RENDER_TEXT)
+        snprintf(key, sizeof(key), "T %g %g %g %g %d %d %g %g %g %g %g %s", r->x, r->y, r->width, r->height, r->data.text.typeface, r->data.text.style, r->data.text.size, r->data.text.spacing, r->data.text.rgb[0], r->data.text.rgb[1], r->data.text.rgb[2], (char *)r->data.text.buffer);
+      else if (r->type == RENDER_IMAGE)
+        snprintf(key, sizeof(key), "I %g %g %g %g %p", r->x, r->y, r->width, r->height, (void *)r->data.image);
+      else
+        continue;
 
-      p = pages + op->pages[i];
+      if (num_items >= alloc_items)
+      {
+        hfitem_t *temp;			// New elements
 
-      for (r = p->start; r != NULL; r = r->next)
+        alloc_items += 256;
+
+        if ((temp = (hfitem_t *)realloc(items, (size_t)alloc_items * sizeof(hfitem_t))) == NULL)
+        {
+          progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d header/footer elements.", alloc_items);
+          goto cleanup;
+        }
+
+        items = temp;
+      }
+
+      if ((items[num_items].key = strdup(key)) == NULL)
       {
-	if (r->type == RENDER_IMAGE && r->data.image->obj)
-	  fprintf(out, "/I%d %d 0 R", r->data.image->obj, r->data.image->obj);
+        progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d header/footer elements.", alloc_items);
+        goto cleanup;
       }
-    }
 
-    if (background_image)
-      fprintf(out, "/I%d %d 0 R", background_image->obj,
-	      background_image->obj);
+      items[num_items].page  = page;
+      items[num_items].group = 0;
+      items[num_items].count = 0;
+      items[num_items].r     = r;
 
-    fputs(">>", out); // End of XObject
-  }
+      num_items ++;
+    }
 
-  fputs(">>", out); // End of Resources
+    sets[page].count     = num_items - sets[page].first;
+    pages[page].furniture = NULL;
+  }
 
-  if (PDFEffect)
-    fprintf(out, "/Dur %.0f/Trans<</Type/Trans/D %.1f%s>>", PDFPageDuration,
-            PDFEffectDuration, effects[PDFEffect]);
-}
+  if (num_items < 2)
+    goto cleanup;
+
+ /*
+  * Group identical elements...
+  */
+
+  if ((sorted = (hfitem_t **)malloc((size_t)num_items * sizeof(hfitem_t *))) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d header/footer elements.", num_items);
+    goto cleanup;
+  }
+
+  for (i = 0; i < num_items; i ++)
+    sorted[i] = items + i;
+
+  qsort(sorted, (size_t)num_items, sizeof(hfitem_t *), (compare_func_t)compare_hfitems);
+
+  for (i = 0; i < num_items; i = j)
+  {
+    for (j = i + 1; j < num_items && !strcmp(sorted[i]->key, sorted[j]->key); j ++);
+
+    for (k = i; k < j; k ++)
+    {
+      sorted[k]->group = i + 1;
+      sorted[k]->count = j - i;
+    }
+  }
+
+ /*
+  * Build the set of shared elements for each page and sort the pages by
+  * set...
+  */
+
+  for (page = 0; page < (int)num_pages; page ++)
+  {
+    keyptr  = key;
+    *keyptr = '\0';
+
+    for (i = 0, item = items + sets[page].first; i < sets[page].count; i ++, item ++)
+    {
+      if (item->count < 2)
+        continue;
+
+      if (keyptr >= (key + sizeof(key) - 12))
+        break;
+
+      snprintf(keyptr, sizeof(key) - (size_t)(keyptr - key), "%d,", item->group);
+      keyptr += strlen(keyptr);
+    }
+
+    if (keyptr > key && keyptr < (key + sizeof(key) - 12))
+      sets[page].set = strdup(key);
+  }
+
+  qsort(sets, num_pages, sizeof(hfset_t), (compare_func_t)compare_hfsets);
+
+ /*
+  * Write a form for each set that is used on more than one page...
+  */
+
+  for (i = 0; i < (int)num_pages; i = j)
+  {
+    for (j = i + 1; j < (int)num_pages && sets[i].set && sets[j].set && !strcmp(sets[i].set, sets[j].set); j ++);
+
+    if (!sets[i].set || (j - i) < 2)
+      continue;
+
+    // Only use a form when it makes the file smaller - each page needs about
+    // 30 bytes to draw the form and list it in the page resources, and the
+    // form object itself needs about 250 bytes plus the content.  Compressed
+    // content is roughly half the size...
+    for (n = 0, bytes = 0, item = items + sets[i].first; n < sets[i].count; n ++, item ++)
+    {
+      if (item->count < 2)
+        continue;
+      else if (item->r->type == RENDER_TEXT)
+        bytes += (int)strlen((char *)item->r->data.text.buffer) + 24;
+      else
+        bytes += 40;
+    }
+
+    if (Compression)
+      bytes /= 2;
+
+    if (((j - i) * (bytes - 30) - bytes - 250) <= 0)
+      continue;
+
+    // Move the shared elements from the pages, keeping those from the first
+    // page for the form...
+    start = last = NULL;
+
+    memset(fonts_used, 0, sizeof(fonts_used));
+
+    for (k = i; k < j; k ++)
+    {
+      p = pages + sets[k].page;
+
+      for (n = 0, item = items + sets[k].first; n < sets[k].count; n ++, item ++)
+      {
+        if (item->count < 2)
+          continue;
+
+	r = item->r;
+
+	if (r->prev)
+	  r->prev->next = r->next;
+	else
+	  p->start = r->next;
+
+	if (r->next)
+	  r->next->prev = r->prev;
+	else
+	  p->end = r->prev;
+
+	if (k > i)
+	{
+	  free(r);
+	  continue;
+	}
+
+	r->prev = last;
+	r->next = NULL;
+
+	if (last)
+	  last->next = r;
+	else
+	  start = r;
+
+	last = r;
+
+	if (r->type == RENDER_TEXT)
+	  fonts_used[r->data.text.typeface * 4 + r->data.text.style] = 1;
+      }
+    }
+
+    p    = pages + sets[i].page;
+    bbox = p->width > p->length ? p->width : p->length;
+
+    pdf_start_object(out);
+    fputs("/Type/XObject/Subtype/Form", out);
+    fprintf(out, "/BBox[%d %d %d %d]", -bbox, -bbox, bbox, bbox);
+    fputs("/Resources<<", out);
+
+    for (k = 0; k < (TYPE_MAX * STYLE_MAX); k ++)
+      if (fonts_used[k])
+        break;
+
+    if (k < (TYPE_MAX * STYLE_MAX))
+    {
+      fputs("/Font<<", out);
+      for (; k < (TYPE_MAX * STYLE_MAX); k ++)
+	if (fonts_used[k])
+	  fprintf(out, "/F%x %d 0 R", k, font_objects[k]);
+      fputs(">>", out); // End of Font
+    }
+
+    for (r = start; r; r = r->next)
+      if (r->type == RENDER_IMAGE && r->data.image->obj)
+        break;
+
+    if (r)
+    {
+      fputs("/XObject<<", out);
+      for (; r; r = r->next)
+	if (r->type == RENDER_IMAGE && r->data.image->obj)
+	  fprintf(out, "/I%d %d 0 R", r->data.image->obj, r->data.image->obj);
+      fputs(">>", out); // End of XObject
+    }
+
+    fputs(">>", out); // End of Resources
+
+    if (Compression)
+      fputs("/Filter/FlateDecode", out);
+    pdf_start_stream(out);
+    flate_open_stream(out);
+
+    render_rgb[0] = -1.0f;
+    render_rgb[1] = -1.0f;
+    render_rgb[2] = -1.0f;
+
+    pdf_write_renders(out, start);
+
+    flate_close_stream(out);
+    pdf_end_object(out);
+
+    for (k = i; k < j; k ++)
+      pages[sets[k].page].furniture_obj = (int)num_objects;
+  }
+
+ /*
+  * Free memory and return...
+  */
+
+  cleanup:
+
+  for (i = 0; i < num_items; i ++)
+    free(items[i].key);
+
+  for (page = 0; page < (int)num_pages; page ++)
+    free(sets[page].set);
+
+  free(items);
+  free(sorted);
+  free(sets);
+}
+
+
+/*
+ * 'pdf_write_resources()' - Write the resources dictionary for a page.
+ */
+
+static void
+pdf_write_resources(FILE *out,		/* I - Output file */
+                    int  outpage)	/* I - Output page for resources */
+{
+  int		i;			/* Looping var */
+  outpage_t	*op;			/* Current output page */
+  page_t	*p;			/* Current page */
+  render_t	*r;			/* Render pointer */
+  int		fonts_used[TYPE_MAX * STYLE_MAX];
+					/* Non-zero if the page uses a font */
+  int		images_used;		/* Non-zero if the page uses an image */
+  int		forms_used;		/* Non-zero if the page uses a form */
+  int		text_used;		/* Non-zero if the page uses text */
+  static const char *effects[] =	/* Effects and their commands */
+		{
+		  "",
+		  "/S/Box/M/I",
+		  "/S/Box/M/O",
+		  "/S/Dissolve",
+		  "/S/Glitter/Di 270",
+		  "/S/Glitter/Di 315",
+		  "/S/Glitter/Di 0",
+		  "/S/Blinds/Dm/H",
+		  "/S/Split/Dm/H/M/I",
+		  "/S/Split/Dm/H/M/O",
+		  "/S/Blinds/Dm/V",
+		  "/S/Split/Dm/V/M/I",
+		  "/S/Split/Dm/V/M/O",
+		  "/S/Wipe/Di 270",
+		  "/S/Wipe/Di 180",
+		  "/S/Wipe/Di 0",
+		  "/S/Wipe/Di 90"
+		};
+
+
+  memset(fonts_used, 0, sizeof(fonts_used));
+  images_used  = background_image != NULL;
+  forms_used   = 0;
+  text_used    = 0;
+  op           = outpages + outpage;
+  for (i = 0; i < op->nup; i ++)
+  {
+    if (op->pages[i] < 0)
+      break;
+
+    p = pages + op->pages[i];
+
+    if (p->furniture_obj)
+      forms_used = 1;
+
+    for (r = p->start; r != NULL; r = r->next)
+    {
+      if (r->type == RENDER_IMAGE)
+      {
+	images_used = 1;
+      }
+      else if (r->type == RENDER_TEXT)
+      {
+	text_used = 1;
+	fonts_used[r->data.text.typeface * 4 + r->data.text.style] = 1;
+      }
+    }
+  }
+
+  fputs("/Resources<<", out);
+
+  if (!images_used)
+  {
+    fputs("/ProcSet[/PDF/Text]", out);
+  }
+  else if (PDFVersion >= 12)
+  {
+    if (OutputColor)
+      fputs("/ProcSet[/PDF/Text/ImageB/ImageC/ImageI]", out);
+    else
+      fputs("/ProcSet[/PDF/Text/ImageB/ImageI]", out);
+  }
+  else
+  {
+    if (OutputColor)
+      fputs("/ProcSet[/PDF/Text/ImageB/ImageC]", out);
+    else
+      fputs("/ProcSet[/PDF/Text/ImageB]", out);
+  }
+
+  if (text_used)
+  {
+    fputs("/Font<<", out);
+    for (i = 0; i < (TYPE_MAX * STYLE_MAX); i ++)
+      if (fonts_used[i])
+	fprintf(out, "/F%x %d 0 R", i, font_objects[i]);
+    fputs(">>", out); // End of Font
+  }
+
+  if (images_used || forms_used)
+  {
+    fputs("/XObject<<", out);
+
+    for (i = 0; i < op->nup; i ++)
+    {
+      if (op->pages[i] < 0)
+	break;
+
+      p = pages + op->pages[i];
+
+      for (r = p->start; r != NULL; r = r->next)
+      {
+	if (r->type == RENDER_IMAGE && r->data.image->obj)
+	  fprintf(out, "/I%d %d 0 R", r->data.image->obj, r->data.image->obj);
+      }
+    }
+
+    if (background_image)
+      fprintf(out, "/I%d %d 0 R", background_image->obj,
+	      background_image->obj);
+
+    for (i = 0; i < op->nup; i ++)
+    {
+      if (op->pages[i] < 0)
+	break;
+
+      p = pages + op->pages[i];
+
+      if (p->background_obj)
+	fprintf(out, "/X%d %d 0 R", p->background_obj, p->background_obj);
+      if (p->furniture_obj)
+	fprintf(out, "/X%d %d 0 R", p->furniture_obj, p->furniture_obj);
+    }
+
+    fputs(">>", out); // End of XObject
+  }
+
+  fputs(">>", out); // End of Resources
+
+  if (PDFEffect)
+    fprintf(out, "/Dur %.0f/Trans<</Type/Trans/D %.1f%s>>", PDFPageDuration,
+            PDFEffectDuration, effects[PDFEffect]);
+}
 
 
 /*
@@ -2697,9 +3408,6 @@ static void
 pdf_write_page(FILE  *out,	/* I - Output file */
                int   page)	/* I - Page number */
 {
-  render_t	*r,		/* Render pointer */
-		*next;		/* Next render */
-  float		box[3];		/* RGB color for boxes */
   page_t	*p;		/* Current page */
   const char	*debug;		/* HTMLDOC_DEBUG environment variable */
 
@@ -2734,25 +3442,71 @@ pdf_write_page(FILE  *out,	/* I - Output file */
                  p->bottom);
 
  /*
-  * Render all graphics elements...
+  * Draw any shared headers and footers, then everything else...
   */
 
-  box[0] = -1.0f;
-  box[1] = -1.0f;
-  box[2] = -1.0f;
+  if (p->furniture_obj)
+    flate_printf(out, "/X%d Do\n", p->furniture_obj);
 
-  for (r = p->start; r != NULL; r = r->next)
-    switch (r->type)
-    {
-      case RENDER_IMAGE :
-          if (r->width > 0.01f && r->height > 0.01f)
-            write_image(out, r);
-          break;
+  decode_images(p->start);
+  pdf_write_renders(out, p->start);
 
-      case RENDER_BOX :
-	  if (r->height == 0.0)
-	  {
-            if (box[0] != r->data.box[0] ||
+  p->start = NULL;
+
+  if ((debug = getenv("HTMLDOC_DEBUG")) != NULL && strstr(debug, "margin"))
+  {
+    // Show printable area...
+    flate_printf(out, "1 0 1 RG 0 0 %d %d re S\n", p->width - p->right - p->left,
+        	 p->length - p->top - p->bottom);
+  }
+
+ /*
+  * Output the page trailer...
+  */
+
+  flate_puts("Q\n", out);
+}
+
+
+/*
+ * 'pdf_write_renders()' - Write a list of render elements to a PDF stream.
+ *
+ * Graphics are drawn first, followed by text.  The render elements are freed
+ * as they are written.
+ */
+
+static void
+pdf_write_renders(FILE     *out,	/* I - Output file */
+                  render_t *start)	/* I - First render element */
+{
+  render_t	*r,		/* Render pointer */
+		*next,		/* Next render */
+		*end;		/* End of text run */
+  float		box[3];		/* RGB color for boxes */
+  char		buffer[255],	/* Operator buffer */
+		*bufptr;	/* Pointer into buffer */
+
+
+ /*
+  * Render all graphics elements...
+  */
+
+  box[0] = -1.0f;
+  box[1] = -1.0f;
+  box[2] = -1.0f;
+
+  for (r = start; r != NULL; r = r->next)
+    switch (r->type)
+    {
+      case RENDER_IMAGE :
+          if (r->width > 0.01f && r->height > 0.01f)
+            write_image(out, r);
+          break;
+
+      case RENDER_BOX :
+	  if (r->height == 0.0)
+	  {
+            if (box[0] != r->data.box[0] ||
 		box[1] != r->data.box[1] ||
 		box[2] != r->data.box[2])
             {
@@ -2767,15 +3521,30 @@ pdf_write_page(FILE  *out,	/* I - Output file */
 		             box[0] * 0.31f + box[1] * 0.61f + box[2] * 0.08f);
             }
 
-            flate_printf(out, "%.1f %.1f m %.1f %.1f l S\n",
-                	 r->x, r->y, r->x + r->width, r->y);
+            bufptr    = format_float(buffer, r->x, 1);
+            *bufptr++ = ' ';
+            bufptr    = format_float(bufptr, r->y, 1);
+            memcpy(bufptr, " m ", 3);
+            bufptr    = format_float(bufptr + 3, r->x + r->width, 1);
+            *bufptr++ = ' ';
+            bufptr    = format_float(bufptr, r->y, 1);
+            strlcpy(bufptr, " l S\n", sizeof(buffer) - (size_t)(bufptr - buffer));
 	  }
 	  else
 	  {
             set_color(out, r->data.box);
-            flate_printf(out, "%.1f %.1f %.1f %.1f re f\n",
-                	 r->x, r->y, r->width, r->height);
+
+            bufptr    = format_float(buffer, r->x, 1);
+            *bufptr++ = ' ';
+            bufptr    = format_float(bufptr, r->y, 1);
+            *bufptr++ = ' ';
+            bufptr    = format_float(bufptr, r->width, 1);
+            *bufptr++ = ' ';
+            bufptr    = format_float(bufptr, r->height, 1);
+            strlcpy(bufptr, " re f\n", sizeof(buffer) - (size_t)(bufptr - buffer));
 	  }
+
+          flate_puts(buffer, out);
 	  break;
     }
 
@@ -2792,31 +3561,26 @@ pdf_write_page(FILE  *out,	/* I - Output file */
   render_y        = -1.0f;
   render_spacing  = -1.0f;
 
-  for (r = p->start, next = NULL; r != NULL; r = next)
+  for (r = start, next = NULL; r != NULL;)
   {
+   /*
+    * Text on the same line can be written as a single TJ array, in which
+    * case write_text() returns the first entity it did not use...
+    */
+
     if (r->type == RENDER_TEXT)
-      write_text(out, r);
+      end = write_text(out, r);
+    else
+      end = r->next;
 
-    next = r->next;
-    free(r);
+    for (; r != end; r = next)
+    {
+      next = r->next;
+      free(r);
+    }
   }
 
-  p->start = NULL;
-
   flate_puts("ET\n", out);
-
-  if ((debug = getenv("HTMLDOC_DEBUG")) != NULL && strstr(debug, "margin"))
-  {
-    // Show printable area...
-    flate_printf(out, "1 0 1 RG 0 0 %d %d re S\n", p->width - p->right - p->left,
-        	 p->length - p->top - p->bottom);
-  }
-
- /*
-  * Output the page trailer...
-  */
-
-  flate_puts("Q\n", out);
 }
 
 
@@ -3175,8 +3939,8 @@ pdf_count_headings(tree_t *toc)	/* I - TOC entry */
  * PDF object state variables...
  */
 
-static int	pdf_stream_length = 0;
-static int	pdf_stream_start = 0;
+static hdoff_t	pdf_stream_length = 0;
+static hdoff_t	pdf_stream_start = 0;
 static int	pdf_object_type = 0;
 
 
@@ -3188,7 +3952,7 @@ static int			// O - Object number
 pdf_start_object(FILE *out,	// I - File to write to
                  int  array)	// I - 1 = array, 0 = dictionary
 {
-  int	*temp;			// Temporary integer pointer
+  hdoff_t	*temp;			// Temporary offset pointer
 
 
   num_objects ++;
@@ -3199,9 +3963,9 @@ pdf_start_object(FILE *out,	// I - File to write to
     alloc_objects += ALLOC_OBJECTS;
 
     if (alloc_objects == ALLOC_OBJECTS)
-      temp = (int *)malloc(sizeof(int) * alloc_objects);
+      temp = (hdoff_t *)malloc(sizeof(hdoff_t) * alloc_objects);
     else
-      temp = (int *)realloc(objects, sizeof(int) * alloc_objects);
+      temp = (hdoff_t *)realloc(objects, sizeof(hdoff_t) * alloc_objects);
 
     if (temp == NULL)
     {
@@ -3213,7 +3977,7 @@ pdf_start_object(FILE *out,	// I - File to write to
     objects = temp;
   }
 
-  objects[num_objects] = ftell(out);
+  objects[num_objects] = ftello(out);
   fprintf(out, "%d 0 obj", (int)num_objects);
 
   pdf_object_type = array;
@@ -3235,9 +3999,9 @@ pdf_start_stream(FILE *out)	// I - File to write to
   // zeroes to cover the maximum size of a stream.
 
   fputs("/Length ", out);
-  pdf_stream_length = ftell(out);
+  pdf_stream_length = ftello(out);
   fputs("0000000000>>stream\n", out);
-  pdf_stream_start = ftell(out);
+  pdf_stream_start = ftello(out);
 }
 
 
@@ -3248,18 +4012,28 @@ pdf_start_stream(FILE *out)	// I - File to write to
 static void
 pdf_end_object(FILE *out)	// I - File to write to
 {
-  int	length;			// Total length of stream
+  hdoff_t	length;			// Total length of stream
 
 
   if (pdf_stream_start)
   {
     // For streams, go back and update the length field in the
     // object dictionary...
-    length = ftell(out) - pdf_stream_start;
+    length = ftello(out) - pdf_stream_start;
 
-    fseek(out, pdf_stream_length, SEEK_SET);
-    fprintf(out, "%-10d", length);
-    fseek(out, 0, SEEK_END);
+    if (length > 9999999999LL)
+    {
+      // The length does not fit in the 10 digits reserved for it, so the
+      // document cannot be completed...
+      progress_error(HD_ERROR_CONTENT_TOO_LARGE, "PDF stream too large (%lld bytes).", (long long)length);
+      pdf_stream_error = 1;
+    }
+    else
+    {
+      fseeko(out, pdf_stream_length, SEEK_SET);
+      fprintf(out, "%-10lld", (long long)length);
+      fseeko(out, 0, SEEK_END);
+    }
 
     pdf_stream_start = 0;
 
@@ -3269,6 +4043,37 @@ pdf_end_object(FILE *out)	// I - File to write to
     fputs(pdf_object_type ? "]" : ">>", out);
 
   fputs("endobj\n", out);
+
+#ifdef HTMLDOC_STREAMING
+  // Send the finished object to the client...
+  if (stdout_sink_active)
+    sink_commit(out);
+#endif // HTMLDOC_STREAMING
+}
+
+
+/*
+ * 'pdf_write_image()' - Write a shared image object.
+ *
+ * This function is called from image_decode() once the image is decoded.
+ */
+
+static void
+pdf_write_image(pdf_images_t *info,	// I - Shared image output state
+                image_t      *img)	// I - Image
+{
+  render_t	temp;			// Dummy rendering data...
+
+
+  info->count ++;
+
+  progress_show("Writing image %d (%s)...", info->count, img->filename);
+  progress_update(100 * info->count / info->num_images);
+
+  memset(&temp, 0, sizeof(temp));	// For Coverity, not explicitly necessary
+
+  temp.data.image = img;
+  write_image(info->out, &temp, 1);
 }
 
 
@@ -3862,158 +4667,1173 @@ render_contents(tree_t *t,		/* I - Tree to parse */
     if (nptr > number)
       nptr --;
 
-    strlcpy((char *)nptr, pages[hpage].page_text, sizeof(number) - (size_t)(nptr - number));
+    strlcpy((char *)nptr, pages[hpage].page_text, sizeof(number) - (size_t)(nptr - number));
+
+    r = new_render(*page, RENDER_TEXT, right - width + x, *y, 0, 0, number);
+    r->data.text.typeface = t->typeface;
+    r->data.text.style    = t->style;
+    r->data.text.size     = (float)_htmlSizes[t->size];
+    memcpy(r->data.text.rgb, rgb, sizeof(rgb));
+  }
+}
+
+
+/*
+ * 'count_headings()' - Count the number of headings in the TOC.
+ */
+
+static int
+count_headings(tree_t *t)		// I - Tree to count
+{
+  tree_t	*doc = t;		// Top of tree
+  int		count;			// Number of headings...
+
+
+  count = 0;
+
+  while (t != NULL)
+  {
+    switch (t->markup)
+    {
+      case MARKUP_B :
+      case MARKUP_LI :
+          count ++;
+	  break;
+
+      default :
+          break;
+    }
+
+    t = htmlWalkNext(doc, t);
+  }
+
+  return (count);
+}
+
+
+/*
+ * 'parse_contents()' - Parse the table of contents and produce a
+ *                      rendering list...
+ */
+
+static void
+parse_contents(tree_t *t,		/* I - Tree to parse */
+               float  left,		/* I - Left margin */
+               float  right,		/* I - Printable width */
+               float  bottom,		/* I - Bottom margin */
+               float  top,		/* I - Printable top */
+               float  *y,		/* IO - Y position */
+               int    *page,		/* IO - Page # */
+               int    *heading,		/* IO - Heading # */
+	       tree_t *chap)		/* I - Chapter heading */
+{
+  bool	descend;			/* Descend? */
+
+
+  DEBUG_printf(("parse_contents(t=%p, left=%.1f, right=%.1f, bottom=%.1f, top=%.1f, y=%.1f, page=%d, heading=%d, chap=%p)\n",
+                (void *)t, left, right, bottom, top, *y, *page, *heading, (void *)chap));
+
+  while (t != NULL)
+  {
+    DEBUG_printf(("parse_contents: t=%p(%s)\n", (void *)t, t->markup == MARKUP_NONE ? (char *)t->data : t->markup < MARKUP_NONE ? "--" : _htmlMarkups[t->markup]));
+
+    descend = false;
+
+    switch (t->markup)
+    {
+      case MARKUP_B :	/* Top-level TOC */
+          if (t->prev != NULL)	/* Advance one line prior to top-levels... */
+            *y -= _htmlSpacings[SIZE_P];
+
+          if (*y < (bottom + _htmlSpacings[SIZE_P] * 3))
+	    *y = 0; // Force page break
+
+          chap = t;
+
+      case MARKUP_LI :	/* Lower-level TOC */
+          DEBUG_printf(("parse_contents: heading=%d, page = %d\n", *heading,
+                        heading_pages[*heading]));
+
+         /*
+          * Put the text unless the author has flagged it otherwise...
+          */
+
+          if (htmlGetVariable(t, (uchar *)"_HD_OMIT_TOC") == NULL)
+	  {
+            render_contents(t, left, right, bottom, top, y, page, *heading, chap);
+
+           /*
+	    * Update current headings for header/footer strings in TOC.
+	    */
+
+	    check_pages(*page);
+
+	    if (t->markup == MARKUP_B && pages[*page].chapter == pages[*page - 1].chapter)
+	    {
+	      uchar *tchapter = htmlGetText(t->child->child);
+	      pages[*page].chapter = (uchar *)hd_strdup((char *)tchapter);
+	      free(tchapter);
+
+              for (int i = *page + 1; i < (int)num_pages; i ++)
+                pages[i].chapter = pages[*page].chapter;
+            }
+
+	    if (pages[*page].heading == pages[*page - 1].heading)
+	    {
+	      uchar *theading = htmlGetText(t->child->child);
+	      pages[*page].heading = (uchar *)hd_strdup((char *)theading);
+	      free(theading);
+
+              for (int i = *page + 1; i < (int)num_pages; i ++)
+                pages[i].heading = pages[*page].heading;
+	    }
+
+           /*
+            * Next heading...
+            */
+
+            (*heading) ++;
+
+            descend = true;
+          }
+	  else if (t->next != NULL && t->next->markup == MARKUP_UL)
+	  {
+	   /*
+	    * Skip children of omitted heading...
+	    */
+
+	    t = t->next;
+
+	    (*heading) += count_headings(t->child) + 1;
+	  }
+	  else
+	  {
+	    (*heading) ++;
+          }
+          break;
+
+      default :
+          descend = true;
+          break;
+    }
+
+    t = htmlWalkNext(NULL, t, descend);
+  }
+}
+
+
+/*
+ * 'find_chapters()' - Find the chapters in a book for parallel formatting.
+ *
+ * Chapters can only be formatted independently when each H1 is a top-level
+ * element of its file and nothing in the document changes the page size,
+ * headers, or footers from one chapter to the next.
+ */
+
+static int				// O - Number of chapters or 0 if not possible
+find_chapters(tree_t        *t,		// I - Document tree
+              chapter_job_t *jobs)	// O - Chapter jobs
+{
+  int		count = 0;		// Number of chapters
+  uchar		*url = current_url;	// Current URL
+  tree_t	*parent;		// Parent node
+  const char	*comment;		// Pointer into comment
+  static const char * const commands[] =
+  {					// Comment commands that change pages
+    "MEDIA ",
+    "HEADER",
+    "FOOTER ",
+    "NUMBER-UP "
+  };
+
+
+  for (; t != NULL; t = htmlWalkNext(NULL, t))
+  {
+    switch (t->markup)
+    {
+      case MARKUP_FILE :
+          url = htmlGetVariable(t, (uchar *)"_HD_URL");
+          break;
+
+      case MARKUP_H1 :
+          for (parent = t->parent; parent != NULL; parent = parent->parent)
+          {
+            if (parent->markup != MARKUP_FILE && parent->markup != MARKUP_HTML &&
+                parent->markup != MARKUP_BODY)
+              return (0);
+          }
+
+          if (count >= (MAX_CHAPTERS - 1))
+            return (0);
+
+          if (count > 0)
+          {
+            jobs[count].start   = t;
+            jobs[count].url     = url;
+            jobs[count].chapter = count;
+          }
+
+          jobs[count].stop = NULL;
+          if (count > 0)
+            jobs[count - 1].stop = t;
+
+          count ++;
+          break;
+
+      case MARKUP_COMMENT :
+          if (!t->data)
+            break;
+
+          for (comment = (const char *)t->data; *comment; comment ++)
+          {
+            if (comment > (const char *)t->data && !isspace(comment[-1] & 255))
+              continue;
+
+            for (size_t i = 0; i < (sizeof(commands) / sizeof(commands[0])); i ++)
+            {
+              if (!strncasecmp(comment, commands[i], strlen(commands[i])))
+                return (0);
+            }
+          }
+          break;
+
+      default :
+          break;
+    }
+  }
+
+  return (count);
+}
+
+
+/*
+ * 'hash_chapter()' - Compute the layout cache key for a chapter.
+ *
+ * Chapters always start on a new page, so the layout of a chapter only
+ * depends on its own elements (and the elements that contain it), the
+ * chapter number, and the page and formatting options.  The Unicode values
+ * of the 8-bit characters are also part of the key, since the text is saved
+ * as 8-bit values that can change from run to run for UTF-8 documents.  The
+ * nodes of the chapter are saved so that heading nodes can be stored as node
+ * numbers.
+ */
+
+static void
+hash_chapter(chapter_job_t *job)	// I - Chapter job
+{
+  md5_state_t	md5;			// MD5 state
+  md5_byte_t	digest[16];		// MD5 digest
+  cache_buf_t	buf;			// Data to hash
+  tree_t	*t,			// Current node
+		*temp,			// Linked node
+		**nodes;		// New nodes array
+  size_t	alloc_nodes = 0;	// Allocated nodes
+  unsigned long long bits,		// Packed attributes
+		link;			// Distance to linked node
+  int		i;			// Looping var
+  unsigned	order = 0x01020304;	// Byte order check
+  const struct
+  {
+    const void	*value;			// Option value
+    size_t	size;			// Size of value
+  }		options[] =		// Options that affect the layout
+  {
+    { &(job->chapter), sizeof(job->chapter) },
+    { &(job->left), sizeof(job->left) },
+    { &(job->right), sizeof(job->right) },
+    { &(job->bottom), sizeof(job->bottom) },
+    { &(job->top), sizeof(job->top) },
+    { &order, sizeof(order) },
+    { &PageWidth, sizeof(PageWidth) },
+    { &PageLength, sizeof(PageLength) },
+    { &PageLeft, sizeof(PageLeft) },
+    { &PageRight, sizeof(PageRight) },
+    { &PageTop, sizeof(PageTop) },
+    { &PageBottom, sizeof(PageBottom) },
+    { &PagePrintWidth, sizeof(PagePrintWidth) },
+    { &PagePrintLength, sizeof(PagePrintLength) },
+    { &PageDuplex, sizeof(PageDuplex) },
+    { &Landscape, sizeof(Landscape) },
+    { &NumberUp, sizeof(NumberUp) },
+    { &PreIndent, sizeof(PreIndent) },
+    { &OutputType, sizeof(OutputType) },
+    { &OutputColor, sizeof(OutputColor) },
+    { &PSLevel, sizeof(PSLevel) },
+    { &PDFVersion, sizeof(PDFVersion) },
+    { &Links, sizeof(Links) },
+    { &LinkStyle, sizeof(LinkStyle) },
+    { &TocLevels, sizeof(TocLevels) },
+    { &TocLinks, sizeof(TocLinks) },
+    { &TocNumbers, sizeof(TocNumbers) },
+    { &StrictHTML, sizeof(StrictHTML) },
+    { &OverflowErrors, sizeof(OverflowErrors) },
+    { &_htmlPPI, sizeof(_htmlPPI) },
+    { &_htmlBrowserWidth, sizeof(_htmlBrowserWidth) },
+    { &_htmlGrayscale, sizeof(_htmlGrayscale) },
+    { &_htmlBodyFont, sizeof(_htmlBodyFont) },
+    { &_htmlHeadingFont, sizeof(_htmlHeadingFont) },
+    { _htmlSizes, 8 * sizeof(_htmlSizes[0]) },
+    { _htmlSpacings, 8 * sizeof(_htmlSpacings[0]) },
+    { link_color, sizeof(link_color) },
+    { background_color, sizeof(background_color) },
+    { _htmlUnicode + 128, 128 * sizeof(_htmlUnicode[0]) }
+  };
+
+
+  job->key[0] = '\0';
+
+  memset(&buf, 0, sizeof(buf));
+
+  // Start with the options...
+  cache_add_string(&buf, (uchar *)"HDLAYOUT1\n" SVERSION);
+
+  for (i = 0; i < (int)(sizeof(options) / sizeof(options[0])); i ++)
+    cache_add_bytes(&buf, options[i].value, options[i].size);
+
+  for (i = 0; i < 3; i ++)
+  {
+    cache_add_string(&buf, (uchar *)Header[i]);
+    cache_add_string(&buf, (uchar *)Header1[i]);
+    cache_add_string(&buf, (uchar *)Footer[i]);
+  }
+
+  cache_add_string(&buf, (uchar *)_htmlData);
+  cache_add_string(&buf, (uchar *)_htmlCharSet);
+  cache_add_string(&buf, _htmlTextColor);
+  cache_add_string(&buf, background_image ? (uchar *)background_image->filename : NULL);
+  cache_add_string(&buf, job->url);
+
+  md5_init(&md5);
+
+  // Then the elements containing the chapter, and the chapter itself...
+  for (t = job->start->parent; t && !buf.error; t = t->parent)
+  {
+    cache_add_number(&buf, (unsigned long long)(t->markup - MARKUP_FILE));
+    cache_add_number(&buf, (unsigned long long)t->nvars);
+
+    for (i = 0; i < t->nvars; i ++)
+    {
+      cache_add_string(&buf, t->vars[i].name);
+      cache_add_string(&buf, t->vars[i].value);
+    }
+  }
+
+  for (t = job->start; t && t != job->stop && !buf.error; t = htmlWalkNext(NULL, t))
+  {
+    if (job->num_nodes >= alloc_nodes)
+    {
+      if ((nodes = (tree_t **)realloc(job->nodes, (alloc_nodes + 1024) * sizeof(tree_t *))) == NULL)
+      {
+        buf.error = 1;
+        break;
+      }
+
+      job->nodes  = nodes;
+      alloc_nodes += 1024;
+    }
+
+    job->nodes[job->num_nodes ++] = t;
+
+    bits = (unsigned long long)t->halignment |
+           ((unsigned long long)t->valignment << 2) |
+           ((unsigned long long)t->typeface << 4) |
+           ((unsigned long long)t->size << 7) |
+           ((unsigned long long)t->style << 10) |
+           ((unsigned long long)t->underline << 12) |
+           ((unsigned long long)t->strikethrough << 13) |
+           ((unsigned long long)t->subscript << 14) |
+           ((unsigned long long)t->superscript << 15) |
+           ((unsigned long long)t->preformatted << 16) |
+           ((unsigned long long)t->indent << 17) |
+           ((unsigned long long)(t->child != NULL) << 21) |
+           ((unsigned long long)(t->next != NULL) << 22);
+
+    for (link = 0, temp = t; t->link && temp && temp != t->link; temp = temp->parent)
+      link ++;
+
+    cache_add_number(&buf, (unsigned long long)(t->markup - MARKUP_FILE));
+    cache_add_number(&buf, bits);
+    cache_add_bytes(&buf, &(t->red), 1);
+    cache_add_bytes(&buf, &(t->green), 1);
+    cache_add_bytes(&buf, &(t->blue), 1);
+    cache_add_bytes(&buf, &(t->width), sizeof(t->width));
+    cache_add_bytes(&buf, &(t->height), sizeof(t->height));
+    cache_add_number(&buf, t->link ? link + 1 : 0);
+    cache_add_string(&buf, t->data);
+    cache_add_number(&buf, (unsigned long long)t->nvars);
+
+    for (i = 0; i < t->nvars; i ++)
+    {
+      cache_add_string(&buf, t->vars[i].name);
+      cache_add_string(&buf, t->vars[i].value);
+    }
+
+    if (buf.used >= 65536)
+    {
+      md5_append(&md5, buf.data, (int)buf.used);
+      buf.used = 0;
+    }
+  }
+
+  if (!buf.error)
+  {
+    md5_append(&md5, buf.data, (int)buf.used);
+    md5_finish(&md5, digest);
+
+    for (i = 0; i < 16; i ++)
+      snprintf(job->key + 2 * i, sizeof(job->key) - (size_t)(2 * i), "%02x", digest[i]);
+  }
+
+  free(buf.data);
+}
+
+
+/*
+ * 'load_chapter()' - Load the layout of a chapter from the cache.
+ */
+
+static int				// O - 1 on success, 0 on failure
+load_chapter(chapter_job_t *job)	// I - Chapter job
+{
+  unsigned char	*data;			// File contents
+  size_t	datalen;		// Length of file
+  cache_in_t	in;			// Input buffer
+  size_t	i,			// Looping var
+		j,			// Looping var
+		count,			// Number of renders
+		number;			// Node number/length
+  int		k;			// Looping var
+  page_t	*p;			// Current page
+  render_t	*r;			// Current render
+  unsigned char	*bytes;			// Raw bytes
+  uchar		*s;			// String
+  image_t	*img;			// Image
+
+
+  if ((data = cache_read(job->key, "layout", &datalen)) == NULL)
+    return (0);
+
+  in.ptr   = data;
+  in.end   = data + datalen;
+  in.error = 0;
+
+  if ((s = cache_get_string(&in)) == NULL || strcmp((char *)s, "HDLAYOUT1\n" SVERSION))
+  {
+    free(data);
+    return (0);
+  }
+
+#define GET_VALUE(v) if ((bytes = cache_get_bytes(&in, sizeof(v))) != NULL) memcpy(&(v), bytes, sizeof(v))
+#define GET_NODE(v) if ((number = (size_t)cache_get_number(&in)) > job->num_nodes) in.error = 1; else v = number ? job->nodes[number - 1] : NULL
+
+  // Final position and pages...
+  GET_VALUE(job->y);
+  GET_VALUE(job->page);
+  GET_VALUE(job->start_page);
+  job->end_url = cache_get_string(&in);
+  GET_NODE(job->heading);
+
+  job->num_pages = (size_t)cache_get_number(&in);
+
+  if (in.error || job->num_pages == 0 || job->num_pages > datalen || job->page < 0 || (size_t)job->page > job->num_pages || job->start_page < -1 || (size_t)(job->start_page + 1) > job->num_pages || (job->pages = (page_t *)calloc(job->num_pages, sizeof(page_t))) == NULL)
+  {
+    job->num_pages = 0;
+    free(data);
+    return (0);
+  }
+
+  for (i = 0, p = job->pages; i < job->num_pages && !in.error; i ++, p ++)
+  {
+    GET_VALUE(p->width);
+    GET_VALUE(p->length);
+    GET_VALUE(p->left);
+    GET_VALUE(p->right);
+    GET_VALUE(p->top);
+    GET_VALUE(p->bottom);
+    GET_VALUE(p->duplex);
+    GET_VALUE(p->landscape);
+    GET_VALUE(p->media_position);
+    GET_VALUE(p->nup);
+    GET_VALUE(p->background_color);
+
+    if (p->nup != 1)
+      in.error = 1;
+
+    p->url     = cache_get_string(&in);
+    p->chapter = cache_get_string(&in);
+    p->heading = cache_get_string(&in);
+    GET_NODE(p->headnode);
+
+    for (k = 0; k < 3; k ++)
+    {
+      p->header[k]  = cache_get_string(&in);
+      p->header1[k] = cache_get_string(&in);
+      p->footer[k]  = cache_get_string(&in);
+    }
+
+    if ((s = cache_get_string(&in)) != NULL)
+      strlcpy(p->media_color, (char *)s, sizeof(p->media_color));
+    if ((s = cache_get_string(&in)) != NULL)
+      strlcpy(p->media_type, (char *)s, sizeof(p->media_type));
+    if ((s = cache_get_string(&in)) != NULL)
+      strlcpy(p->page_text, (char *)s, sizeof(p->page_text));
+
+    if ((s = cache_get_string(&in)) != NULL && (p->background_image = image_find((char *)s)) == NULL)
+      in.error = 1;
+
+    // Then the render list...
+    for (count = (size_t)cache_get_number(&in), j = 0; j < count && !in.error; j ++)
+    {
+      int	type = (int)cache_get_number(&in);
+					// Type of render
+
+      if (type == RENDER_TEXT || type == RENDER_LINK)
+        number = (size_t)cache_get_number(&in);
+      else
+        number = 1;
+
+      if (in.error || number == 0 || number > datalen || (r = (render_t *)calloc(sizeof(render_t) + number - 1, 1)) == NULL)
+      {
+        in.error = 1;
+        break;
+      }
+
+      // Add to the end of the page...
+      if (p->end)
+        p->end->next = r;
+      else
+        p->start = r;
+
+      r->prev = p->end;
+      p->end  = r;
+
+      r->type = type;
+
+      GET_VALUE(r->x);
+      GET_VALUE(r->y);
+      GET_VALUE(r->width);
+      GET_VALUE(r->height);
+
+      switch (type)
+      {
+        case RENDER_TEXT :
+            GET_VALUE(r->data.text.typeface);
+            GET_VALUE(r->data.text.style);
+            GET_VALUE(r->data.text.size);
+            GET_VALUE(r->data.text.spacing);
+            GET_VALUE(r->data.text.rgb);
+
+            if (r->data.text.typeface < TYPE_COURIER || r->data.text.typeface > TYPE_DINGBATS || r->data.text.style < STYLE_NORMAL || r->data.text.style > STYLE_BOLD_ITALIC)
+              in.error = 1;
+            else if ((bytes = cache_get_bytes(&in, number - 1)) != NULL)
+              memcpy(r->data.text.buffer, bytes, number - 1);
+            break;
+
+        case RENDER_LINK :
+            if ((bytes = cache_get_bytes(&in, number - 1)) != NULL)
+              memcpy(r->data.link, bytes, number - 1);
+            break;
+
+        case RENDER_IMAGE :
+        case RENDER_BG :
+            if ((s = cache_get_string(&in)) == NULL || (img = image_find((char *)s)) == NULL)
+              in.error = 1;
+            else
+              r->data.image = img;
+            break;
+
+        case RENDER_BOX :
+            GET_VALUE(r->data.box);
+            break;
+
+        default :
+            in.error = 1;
+            break;
+      }
+    }
+  }
+
+  // The headings...
+  if (!in.error && (job->num_headings = (size_t)cache_get_number(&in)) > 0)
+  {
+    if (job->num_headings > datalen || (job->heading_pages = (int *)calloc(job->num_headings, sizeof(int))) == NULL || (job->heading_tops = (int *)calloc(job->num_headings, sizeof(int))) == NULL)
+      in.error = 1;
+
+    for (i = 0; i < job->num_headings && !in.error; i ++)
+    {
+      GET_VALUE(job->heading_pages[i]);
+      GET_VALUE(job->heading_tops[i]);
+
+      if (job->heading_pages[i] < 0 || (size_t)job->heading_pages[i] >= job->num_pages)
+        in.error = 1;
+    }
+  }
+
+  // And the named links...
+  if (!in.error && (job->num_links = (size_t)cache_get_number(&in)) > 0)
+  {
+    if (job->num_links > datalen || (job->links = (joblink_t *)calloc(job->num_links, sizeof(joblink_t))) == NULL)
+      in.error = 1;
+
+    job->alloc_links = job->num_links;
+
+    for (i = 0; i < job->num_links && !in.error; i ++)
+    {
+      job->links[i].append = (int)cache_get_number(&in);
+
+      GET_VALUE(job->links[i].link.page);
+      GET_VALUE(job->links[i].link.top);
+
+      // Links at the end of a chapter point to the start of the next one...
+      if (job->links[i].link.page < 0 || (size_t)job->links[i].link.page > (job->num_pages + 1))
+        in.error = 1;
+
+      if ((s = cache_get_string(&in)) != NULL)
+        strlcpy((char *)job->links[i].link.name, (char *)s, sizeof(job->links[i].link.name));
+    }
+  }
+
+#undef GET_VALUE
+#undef GET_NODE
+
+  free(data);
+
+  if (in.error || in.ptr != in.end)
+  {
+    // Bad cache file, free everything and format the chapter instead...
+    for (i = 0, p = job->pages; i < job->num_pages; i ++, p ++)
+    {
+      for (r = p->start; r; r = p->start)
+      {
+        p->start = r->next;
+        free(r);
+      }
+    }
+
+    free(job->pages);
+    free(job->heading_pages);
+    free(job->heading_tops);
+    free(job->links);
+
+    job->num_pages     = 0;
+    job->pages         = NULL;
+    job->num_headings  = 0;
+    job->heading_pages = NULL;
+    job->heading_tops  = NULL;
+    job->num_links     = 0;
+    job->alloc_links   = 0;
+    job->links         = NULL;
+
+    return (0);
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'save_chapter()' - Save the layout of a chapter to the cache.
+ *
+ * Pages are stored relative to the start of the chapter, and images, heading
+ * nodes, and strings are stored by name or number so they can be found again
+ * in a later run.  Chapters that cannot be stored this way are skipped.
+ */
+
+static void
+save_chapter(chapter_job_t *job)	// I - Chapter job
+{
+  cache_buf_t	buf;			// Output buffer
+  size_t	i,			// Looping var
+		count;			// Number of renders
+  int		k;			// Looping var
+  page_t	*p;			// Current page
+  render_t	*r;			// Current render
+  nodenum_t	*sorted,		// Nodes sorted by address
+		key,			// Node to find
+		*match;			// Matching node
+  const uchar	*text;			// Text or link string
+
+
+  // Sort the nodes so that heading nodes can be saved as node numbers...
+  if ((sorted = (nodenum_t *)malloc(job->num_nodes * sizeof(nodenum_t) + 1)) == NULL)
+    return;
+
+  for (i = 0; i < job->num_nodes; i ++)
+  {
+    sorted[i].node   = job->nodes[i];
+    sorted[i].number = i + 1;
+  }
+
+  qsort(sorted, job->num_nodes, sizeof(nodenum_t), (compare_func_t)compare_nodes);
+
+  memset(&buf, 0, sizeof(buf));
+
+#define ADD_VALUE(v) cache_add_bytes(&buf, &(v), sizeof(v))
+#define ADD_NODE(v) key.node = (v); \
+  if (!key.node) \
+    cache_add_number(&buf, 0); \
+  else if ((match = (nodenum_t *)bsearch(&key, sorted, job->num_nodes, sizeof(nodenum_t), (compare_func_t)compare_nodes)) != NULL) \
+    cache_add_number(&buf, match->number); \
+  else \
+    buf.error = 1
+
+  // Final position and pages...
+  cache_add_string(&buf, (uchar *)"HDLAYOUT1\n" SVERSION);
+  ADD_VALUE(job->y);
+  ADD_VALUE(job->page);
+  ADD_VALUE(job->start_page);
+  cache_add_string(&buf, job->end_url);
+  ADD_NODE(job->heading);
+  cache_add_number(&buf, job->num_pages);
+
+  for (i = 0, p = job->pages; i < job->num_pages && !buf.error; i ++, p ++)
+  {
+    if (p->furniture || p->background_obj || p->furniture_obj)
+    {
+      buf.error = 1;
+      break;
+    }
+
+    ADD_VALUE(p->width);
+    ADD_VALUE(p->length);
+    ADD_VALUE(p->left);
+    ADD_VALUE(p->right);
+    ADD_VALUE(p->top);
+    ADD_VALUE(p->bottom);
+    ADD_VALUE(p->duplex);
+    ADD_VALUE(p->landscape);
+    ADD_VALUE(p->media_position);
+    ADD_VALUE(p->nup);
+    ADD_VALUE(p->background_color);
+
+    cache_add_string(&buf, p->url);
+    cache_add_string(&buf, p->chapter);
+    cache_add_string(&buf, p->heading);
+    ADD_NODE(p->headnode);
+
+    for (k = 0; k < 3; k ++)
+    {
+      cache_add_string(&buf, p->header[k]);
+      cache_add_string(&buf, p->header1[k]);
+      cache_add_string(&buf, p->footer[k]);
+    }
+
+    cache_add_string(&buf, (uchar *)p->media_color);
+    cache_add_string(&buf, (uchar *)p->media_type);
+    cache_add_string(&buf, (uchar *)p->page_text);
+    cache_add_string(&buf, p->background_image ? (uchar *)p->background_image->filename : NULL);
+
+    // Then the render list...
+    for (count = 0, r = p->start; r; r = r->next)
+      count ++;
+
+    cache_add_number(&buf, count);
+
+    for (r = p->start; r; r = r->next)
+    {
+      cache_add_number(&buf, (unsigned long long)r->type);
+
+      if (r->type == RENDER_TEXT || r->type == RENDER_LINK)
+      {
+        text = r->type == RENDER_TEXT ? r->data.text.buffer : r->data.link;
+        cache_add_number(&buf, strlen((char *)text) + 1);
+      }
+      else
+        text = NULL;
+
+      ADD_VALUE(r->x);
+      ADD_VALUE(r->y);
+      ADD_VALUE(r->width);
+      ADD_VALUE(r->height);
+
+      switch (r->type)
+      {
+        case RENDER_TEXT :
+            ADD_VALUE(r->data.text.typeface);
+            ADD_VALUE(r->data.text.style);
+            ADD_VALUE(r->data.text.size);
+            ADD_VALUE(r->data.text.spacing);
+            ADD_VALUE(r->data.text.rgb);
+            cache_add_bytes(&buf, text, strlen((char *)text));
+            break;
+
+        case RENDER_LINK :
+            cache_add_bytes(&buf, text, strlen((char *)text));
+            break;
+
+        case RENDER_IMAGE :
+        case RENDER_BG :
+            if (r->data.image)
+              cache_add_string(&buf, (uchar *)r->data.image->filename);
+            else
+              buf.error = 1;
+            break;
+
+        case RENDER_BOX :
+            ADD_VALUE(r->data.box);
+            break;
+      }
+    }
+  }
+
+  // The headings...
+  cache_add_number(&buf, job->num_headings);
+
+  for (i = 0; i < job->num_headings; i ++)
+  {
+    ADD_VALUE(job->heading_pages[i]);
+    ADD_VALUE(job->heading_tops[i]);
+  }
+
+  // And the named links...
+  cache_add_number(&buf, job->num_links);
+
+  for (i = 0; i < job->num_links; i ++)
+  {
+    cache_add_number(&buf, (unsigned long long)job->links[i].append);
+    ADD_VALUE(job->links[i].link.page);
+    ADD_VALUE(job->links[i].link.top);
+    cache_add_string(&buf, job->links[i].link.name);
+  }
+
+#undef ADD_VALUE
+#undef ADD_NODE
+
+  if (!buf.error)
+    cache_write(job->key, "layout", &buf, 1);
+
+  free(buf.data);
+  free(sorted);
+}
+
+
+/*
+ * 'parse_chapter()' - Format a chapter in a layout thread.
+ *
+ * Messages are saved so that parse_chapters() can show them in order.  When
+ * there is only one thread, or the conversion itself is running in a worker
+ * thread, the chapter is formatted in the calling thread, so the layout state
+ * is always saved and restored.
+ */
+
+static void
+parse_chapter(void *data,		// I - Chapter jobs
+              int  index)		// I - Chapter index
+{
+  chapter_job_t	*job = (chapter_job_t *)data + index;
+					// Chapter job
+  float		x, y;			// Current position
+  int		page = 0,		// Current page
+		needspace = 0;		// Need whitespace?
+  layout_state_t *state = NULL;		// Saved layout state
+
+
+  job->log = progress_log_new();
+  progress_log_set(job->log);
+
+  // Use the cached layout if the chapter has not changed...
+  if (job->key[0] && load_chapter(job))
+  {
+    stats_count(HD_COUNT_CACHE_HITS, 1);
+    progress_log_set(NULL);
+    return;
+  }
+
+  if ((state = (layout_state_t *)malloc(sizeof(layout_state_t))) != NULL)
+  {
+    state->current_url     = current_url;
+    state->title_page      = title_page;
+    state->chapter         = chapter;
+    state->num_headings    = num_headings;
+    state->alloc_headings  = alloc_headings;
+    state->heading_pages   = heading_pages;
+    state->heading_tops    = heading_tops;
+    state->num_pages       = num_pages;
+    state->alloc_pages     = alloc_pages;
+    state->pages           = pages;
+    state->current_heading = current_heading;
+
+    memcpy(state->chapter_starts, chapter_starts, sizeof(chapter_starts));
+    memcpy(state->chapter_ends, chapter_ends, sizeof(chapter_ends));
+    memcpy(state->list_types, list_types, sizeof(list_types));
+    memcpy(state->list_values, list_values, sizeof(list_values));
+  }
+
+  // Start with a clean slate on page 0...
+  current_job     = job;
+  title_page      = 0;
+  chapter         = job->chapter;
+  current_url     = job->url;
+  current_heading = NULL;
+  num_pages       = 0;
+  alloc_pages     = 0;
+  pages           = NULL;
+  num_headings    = 0;
+  alloc_headings  = 0;
+  heading_pages   = NULL;
+  heading_tops    = NULL;
+
+  memset(list_types, 0267, sizeof(list_types));
+  memset(list_values, 0, sizeof(list_values));
+  memset(chapter_starts, -1, sizeof(chapter_starts));
+
+  x = job->left;
+  y = job->top;
+
+  stats_begin(HD_STATS_LAYOUT);
+
+  parse_doc(job->start, &job->left, &job->right, &job->bottom, &job->top, &x, &y, &page, NULL, &needspace);
+
+  stats_chapter(-1);
+  stats_end(HD_STATS_LAYOUT);
+
+  // Save the results for parse_chapters()...
+  job->y             = y;
+  job->page          = page;
+  job->start_page    = chapter_starts[job->chapter + 1];
+  job->end_url       = current_url;
+  job->heading       = current_heading;
+  job->num_pages     = num_pages;
+  job->pages         = pages;
+  job->num_headings  = num_headings;
+  job->heading_pages = heading_pages;
+  job->heading_tops  = heading_tops;
+
+  current_job = NULL;
+
+  // Only cache chapters that were formatted without errors...
+  if (job->key[0] && progress_log_errors(job->log) == 0)
+    save_chapter(job);
+
+  progress_log_set(NULL);
+
+  if (state)
+  {
+    current_url     = state->current_url;
+    title_page      = state->title_page;
+    chapter         = state->chapter;
+    num_headings    = state->num_headings;
+    alloc_headings  = state->alloc_headings;
+    heading_pages   = state->heading_pages;
+    heading_tops    = state->heading_tops;
+    num_pages       = state->num_pages;
+    alloc_pages     = state->alloc_pages;
+    pages           = state->pages;
+    current_heading = state->current_heading;
+
+    memcpy(chapter_starts, state->chapter_starts, sizeof(chapter_starts));
+    memcpy(chapter_ends, state->chapter_ends, sizeof(chapter_ends));
+    memcpy(list_types, state->list_types, sizeof(list_types));
+    memcpy(list_values, state->list_values, sizeof(list_values));
 
-    r = new_render(*page, RENDER_TEXT, right - width + x, *y, 0, 0, number);
-    r->data.text.typeface = t->typeface;
-    r->data.text.style    = t->style;
-    r->data.text.size     = (float)_htmlSizes[t->size];
-    memcpy(r->data.text.rgb, rgb, sizeof(rgb));
+    free(state);
   }
 }
 
 
 /*
- * 'count_headings()' - Count the number of headings in the TOC.
+ * 'parse_chapters()' - Format the chapters of a book in parallel.
+ *
+ * Each chapter is formatted starting on page 0 by a separate thread, and the
+ * pages, headings, and links are then merged in document order exactly as
+ * parse_doc() would have produced them.
  */
 
-static int
-count_headings(tree_t *t)		// I - Tree to count
+static int				// O - 1 if formatted, 0 to use parse_doc()
+parse_chapters(tree_t *t,		// I - Document tree
+               float  left,		// I - Left margin
+               float  right,		// I - Right margin
+               float  bottom,		// I - Bottom margin
+               float  top,		// I - Top margin
+               int    *page)		// IO - Current page
 {
-  tree_t	*doc = t;		// Top of tree
-  int		count;			// Number of headings...
+  int		i,			// Looping var
+		count;			// Number of chapters
+  size_t	j;			// Looping var
+  chapter_job_t	*jobs,			// Chapter jobs
+		*job;			// Current job
+  int		start;			// Starting page of chapter
+  size_t	old_pages;		// Number of existing pages
+  page_t	*p;			// Current page
+  int		*temp;			// Temporary heading array
 
 
-  count = 0;
+  if (OutputType != OUTPUT_BOOK || NumberUp != 1 || (hd_thread_count() < 2 && !CacheDir[0]))
+    return (0);
 
-  while (t != NULL)
+#ifdef HAVE_LIBFLTK
+  if (BookGUI != NULL)
+    return (0);
+#endif // HAVE_LIBFLTK
+
+  if ((jobs = (chapter_job_t *)calloc(MAX_CHAPTERS, sizeof(chapter_job_t))) == NULL)
+    return (0);
+
+  if ((count = find_chapters(t, jobs)) < 2)
   {
-    switch (t->markup)
-    {
-      case MARKUP_B :
-      case MARKUP_LI :
-          count ++;
-	  break;
+    free(jobs);
+    return (0);
+  }
 
-      default :
-          break;
-    }
+  // The first job also handles anything before the first chapter heading...
+  jobs[0].start   = t;
+  jobs[0].url     = current_url;
+  jobs[0].chapter = 0;
 
-    t = htmlWalkNext(doc, t);
+  for (i = 0, job = jobs; i < count; i ++, job ++)
+  {
+    job->left   = left;
+    job->right  = right;
+    job->bottom = bottom;
+    job->top    = top;
+
+    // Compute the layout cache keys before any chapters are formatted...
+    if (CacheDir[0])
+      hash_chapter(job);
   }
 
-  return (count);
-}
+  hd_parallel(count, parse_chapter, jobs);
 
+  // Merge the chapters in order...
+  for (i = 0, job = jobs, start = *page; i < count; i ++, job ++)
+  {
+    progress_log_flush(job->log);
+    free(job->nodes);
 
-/*
- * 'parse_contents()' - Parse the table of contents and produce a
- *                      rendering list...
- */
+    if (i > 0)
+    {
+      // Start a new page for the chapter just like parse_doc()...
+      start = job[-1].page + start;
+      if (job[-1].y < top)
+        start ++;
+      if (PageDuplex && (start & 1))
+        start ++;
 
-static void
-parse_contents(tree_t *t,		/* I - Tree to parse */
-               float  left,		/* I - Left margin */
-               float  right,		/* I - Printable width */
-               float  bottom,		/* I - Bottom margin */
-               float  top,		/* I - Printable top */
-               float  *y,		/* IO - Y position */
-               int    *page,		/* IO - Page # */
-               int    *heading,		/* IO - Heading # */
-	       tree_t *chap)		/* I - Chapter heading */
-{
-  bool	descend;			/* Descend? */
+      chapter_ends[i] = start - 1;
 
+      chapter     = i;
+      current_url = job->url;
 
-  DEBUG_printf(("parse_contents(t=%p, left=%.1f, right=%.1f, bottom=%.1f, top=%.1f, y=%.1f, page=%d, heading=%d, chap=%p)\n",
-                (void *)t, left, right, bottom, top, *y, *page, *heading, (void *)chap));
+      check_pages(start);
 
-  while (t != NULL)
-  {
-    DEBUG_printf(("parse_contents: t=%p(%s)\n", (void *)t, t->markup == MARKUP_NONE ? (char *)t->data : t->markup < MARKUP_NONE ? "--" : _htmlMarkups[t->markup]));
+      memcpy(pages[start].header, Header, sizeof(pages[start].header));
+      memcpy(pages[start].header1, Header1, sizeof(pages[start].header1));
+      memcpy(pages[start].footer, Footer, sizeof(pages[start].footer));
+    }
 
-    descend = false;
+    // Make room for the new pages...
+    old_pages = num_pages;
 
-    switch (t->markup)
+    if (((size_t)start + job->num_pages) > alloc_pages)
     {
-      case MARKUP_B :	/* Top-level TOC */
-          if (t->prev != NULL)	/* Advance one line prior to top-levels... */
-            *y -= _htmlSpacings[SIZE_P];
-
-          if (*y < (bottom + _htmlSpacings[SIZE_P] * 3))
-	    *y = 0; // Force page break
+      alloc_pages = (size_t)start + job->num_pages + ALLOC_PAGES;
 
-          chap = t;
+      if ((p = (page_t *)realloc(pages, sizeof(page_t) * alloc_pages)) == NULL)
+      {
+	progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d pages.", (int)alloc_pages);
+	break;
+      }
 
-      case MARKUP_LI :	/* Lower-level TOC */
-          DEBUG_printf(("parse_contents: heading=%d, page = %d\n", *heading,
-                        heading_pages[*heading]));
+      memset(p + num_pages, 0, (alloc_pages - num_pages) * sizeof(page_t));
 
-         /*
-          * Put the text unless the author has flagged it otherwise...
-          */
+      pages = p;
+    }
 
-          if (htmlGetVariable(t, (uchar *)"_HD_OMIT_TOC") == NULL)
-	  {
-            render_contents(t, left, right, bottom, top, y, page, *heading, chap);
+    for (j = 0, p = pages + start; j < job->num_pages; j ++, p ++)
+    {
+      if (((size_t)start + j) < old_pages)
+      {
+        // Page already exists, so append the chapter's content...
+        if (job->pages[j].start)
+        {
+          if (p->end)
+          {
+            p->end->next              = job->pages[j].start;
+            job->pages[j].start->prev = p->end;
+          }
+          else
+            p->start = job->pages[j].start;
 
-           /*
-	    * Update current headings for header/footer strings in TOC.
-	    */
+          p->end = job->pages[j].end;
+        }
 
-	    check_pages(*page);
+        if (j == 0 && i > 0)
+        {
+          p->chapter  = job->pages[0].chapter;
+          p->heading  = job->pages[0].heading;
+          p->headnode = job->pages[0].headnode;
+        }
+      }
+      else
+        memcpy(p, job->pages + j, sizeof(page_t));
+    }
 
-	    if (t->markup == MARKUP_B && pages[*page].chapter == pages[*page - 1].chapter)
-	    {
-	      uchar *tchapter = htmlGetText(t->child->child);
-	      pages[*page].chapter = (uchar *)hd_strdup((char *)tchapter);
-	      free(tchapter);
+    if (((size_t)start + job->num_pages) > num_pages)
+      num_pages = (size_t)start + job->num_pages;
 
-              for (int i = *page + 1; i < (int)num_pages; i ++)
-                pages[i].chapter = pages[*page].chapter;
-            }
+    free(job->pages);
 
-	    if (pages[*page].heading == pages[*page - 1].heading)
-	    {
-	      uchar *theading = htmlGetText(t->child->child);
-	      pages[*page].heading = (uchar *)hd_strdup((char *)theading);
-	      free(theading);
+    // Copy the headings...
+    if (job->num_headings > 0)
+    {
+      if ((num_headings + job->num_headings) > alloc_headings)
+      {
+        alloc_headings = num_headings + job->num_headings + ALLOC_HEADINGS;
 
-              for (int i = *page + 1; i < (int)num_pages; i ++)
-                pages[i].heading = pages[*page].heading;
-	    }
+        if ((temp = (int *)realloc(heading_pages, sizeof(int) * alloc_headings)) == NULL)
+        {
+	  progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d headings.", (int)alloc_headings);
+	  break;
+        }
 
-           /*
-            * Next heading...
-            */
+        heading_pages = temp;
 
-            (*heading) ++;
+        if ((temp = (int *)realloc(heading_tops, sizeof(int) * alloc_headings)) == NULL)
+        {
+	  progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d headings.", (int)alloc_headings);
+	  break;
+        }
 
-            descend = true;
-          }
-	  else if (t->next != NULL && t->next->markup == MARKUP_UL)
-	  {
-	   /*
-	    * Skip children of omitted heading...
-	    */
+        heading_tops = temp;
+      }
 
-	    t = t->next;
+      for (j = 0; j < job->num_headings; j ++, num_headings ++)
+      {
+        heading_pages[num_headings] = job->heading_pages[j] + start;
+        heading_tops[num_headings]  = job->heading_tops[j];
+      }
+    }
 
-	    (*heading) += count_headings(t->child) + 1;
-	  }
-	  else
-	  {
-	    (*heading) ++;
-          }
-          break;
+    free(job->heading_pages);
+    free(job->heading_tops);
 
-      default :
-          descend = true;
-          break;
+    // Add the links...
+    for (j = 0; j < job->num_links; j ++)
+    {
+      job->links[j].link.page = (short)(job->links[j].link.page + start);
+      insert_link(&(job->links[j].link), job->links[j].append);
     }
 
-    t = htmlWalkNext(NULL, t, descend);
+    free(job->links);
+
+    chapter_starts[i + 1] = start + job->start_page;
+    current_url           = job->end_url;
+
+    if (job->heading)
+      current_heading = job->heading;
   }
+
+  job = jobs + count - 1;
+
+  *page   = start + job->page;
+  chapter = count;
+
+  if (chapter > TocDocCount)
+    TocDocCount = chapter;
+
+  free(jobs);
+
+  return (1);
 }
 
 
@@ -4045,7 +5865,8 @@ parse_doc(tree_t *t,		/* I - Tree to parse */
 		height,		/* Height of rule */
 		rgb[3];		/* RGB color of rule */
   bool		descend;	/* Descend into children when walking to the next node? */
-  static int	levels = 0;	/* Number of levels of nested elements */
+  static HD_THREAD_LOCAL int levels = 0;
+				/* Number of levels of nested elements */
 
 
   DEBUG_printf(("parse_doc(t=%p(%s), left=%.1f, right=%.1f, bottom=%.1f, top=%.1f, x=%.1f, y=%.1f, page=%d, cpara=%p, needspace=%d\n",
@@ -4061,6 +5882,9 @@ parse_doc(tree_t *t,		/* I - Tree to parse */
 
   levels ++;
 
+  if (current_job && levels == 1)
+    doc = NULL;				// Walk past the end of the starting file
+
   if (cpara == NULL)
     para = htmlNewTree(NULL, MARKUP_P, NULL);
   else
@@ -4068,6 +5892,9 @@ parse_doc(tree_t *t,		/* I - Tree to parse */
 
   while (t != NULL)
   {
+    if (current_job && t == current_job->stop)
+      break;				// Stop at the start of the next chapter
+
     DEBUG_printf(("parse_doc: t=%p(%s)\n", (void *)t, t->markup == MARKUP_NONE ? (char *)t->data : t->markup < MARKUP_NONE ? "--" : _htmlMarkups[t->markup]));
 
     if (t->markup == MARKUP_FILE)
@@ -4115,9 +5942,12 @@ parse_doc(tree_t *t,		/* I - Tree to parse */
         chapter = MAX_CHAPTERS - 1;
       }
       else
+      {
         chapter_starts[chapter] = *page;
+        stats_chapter(chapter);
+      }
 
-      if (chapter > TocDocCount)
+      if (chapter > TocDocCount && !current_job)
 	TocDocCount = chapter;
 
       *y         = *top;
@@ -8730,6 +10560,13 @@ write_background(int  page,	/* I - Page we are writing for */
     page_length = pages[page].length;
   }
 
+  if (PSLevel == 0 && pages[page].background_obj)
+  {
+    // Use the shared background form...
+    flate_printf(out, "/X%d Do\n", pages[page].background_obj);
+    return;
+  }
+
   if (background_color[0] != 1.0 ||
       background_color[1] != 1.0 ||
       background_color[2] != 1.0)
@@ -8809,7 +10646,8 @@ new_render(int      page,		/* I - Page number (0-n) */
 {
   render_t		*r;		/* New render primitive */
   size_t		datalen = 0;	/* Length of data */
-  static render_t	dummy;		/* Dummy var for errors... */
+  static HD_THREAD_LOCAL render_t dummy;
+					/* Dummy var for errors... */
 
 
   DEBUG_printf(("new_render(page=%d, type=%d, x=%.1f, y=%.1f, width=%.1f, height=%.1f, data=%p, insert=%p)\n",
@@ -8843,6 +10681,8 @@ new_render(int      page,		/* I - Page number (0-n) */
     return (&dummy);
   }
 
+  stats_count(HD_COUNT_RENDERS, 1);
+
   r->type   = type;
   r->x      = (float)x;
   r->y      = (float)y;
@@ -8969,8 +10809,9 @@ check_pages(int page)	// I - Current page
       else
       {
 	memcpy(temp, temp - 1, sizeof(page_t));
-	temp->start = NULL;
-	temp->end   = NULL;
+	temp->start     = NULL;
+	temp->end       = NULL;
+	temp->furniture = NULL;
       }
 
       temp->url = current_url;
@@ -8995,42 +10836,147 @@ check_pages(int page)	// I - Current page
 	}
       }
 
-      memcpy(temp->background_color, background_color,
-             sizeof(temp->background_color));
-      temp->background_image = background_image;
+      memcpy(temp->background_color, background_color,
+             sizeof(temp->background_color));
+      temp->background_image = background_image;
+    }
+  }
+}
+
+
+/*
+ * 'add_link()' - Add a named link...
+ */
+
+static void
+add_link(tree_t *html,		/* I - HTML node */
+         uchar  *name,		/* I - Name of link */
+         int    page,		/* I - Page # */
+         int    top)		/* I - Y position */
+{
+  link_t	link;		/* New link */
+  char		*nameptr;	/* Pointer into name */
+
+
+  if (name == NULL)
+    return;
+
+  DEBUG_printf(("add_link(name=\"%s\", page=%d, top=%d)\n", name, page, top));
+
+  if ((nameptr = strrchr((char *)name, '/')) != NULL)
+    name = (uchar *)nameptr + 1;
+  else if ((nameptr = strrchr((char *)name, '\\')) != NULL)
+    name = (uchar *)nameptr + 1;
+
+  if (html)
+  {
+    uchar	*filename;		/* Filename */
+
+    if ((filename = htmlGetVariable(html->parent, (uchar *)"_HD_URL")) != NULL)
+      snprintf((char *)link.name, sizeof(link.name), "%s#%s", (char *)filename, (char *)name);
+    else
+      strlcpy((char *)link.name, (char *)name, sizeof(link.name));
+  }
+  else
+  {
+    strlcpy((char *)link.name, (char *)name, sizeof(link.name));
+  }
+
+  link.page = (short)page;
+  link.top  = (short)top;
+
+  if (current_job)
+  {
+   /*
+    * Save links from layout threads so they can be added in document order
+    * after all of the chapters are formatted...
+    */
+
+    joblink_t	*temp;		/* New deferred link */
+
+    if (current_job->num_links >= current_job->alloc_links)
+    {
+      current_job->alloc_links += ALLOC_LINKS;
+
+      if ((temp = (joblink_t *)realloc(current_job->links, sizeof(joblink_t) * current_job->alloc_links)) == NULL)
+      {
+	progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate memory for %d links.", (int)current_job->alloc_links);
+	current_job->alloc_links -= ALLOC_LINKS;
+	return;
+      }
+
+      current_job->links = temp;
+    }
+
+    temp = current_job->links + current_job->num_links;
+    current_job->num_links ++;
+
+    temp->append = html != NULL;
+    temp->link   = link;
+  }
+  else
+    insert_link(&link, html != NULL);
+}
+
+
+/*
+ * 'find_link()' - Find a named link...
+ */
+
+static link_t *				/* O - Matching link */
+find_link(uchar *name)			/* I - Name to find */
+{
+  char		*nameptr;		/* Pointer into name */
+  link_t	key,			/* Search key */
+		*match;			/* Matching name entry */
+
+
+  if (name == NULL || num_links == 0)
+    return (NULL);
+
+  if (name[0] == '#')
+    name ++;
+  else if ((nameptr = strrchr((char *)name, '/')) != NULL)
+    name = (uchar *)nameptr + 1;
+  else if ((nameptr = strrchr((char *)name, '\\')) != NULL)
+    name = (uchar *)nameptr + 1;
+
+  strlcpy((char *)key.name, (char *)name, sizeof(key.name));
+  match = (link_t *)bsearch(&key, links, num_links, sizeof(link_t), (compare_func_t)compare_links);
+
+  if (!match)
+  {
+    uchar *target = (uchar *)strchr((char *)name, '#');
+
+    if (target)
+    {
+      strlcpy((char *)key.name, (char *)target + 1, sizeof(key.name));
+      match = (link_t *)bsearch(&key, links, num_links, sizeof(link_t), (compare_func_t)compare_links);
     }
   }
+
+  return (match);
 }
 
 
 /*
- * 'add_link()' - Add a named link...
+ * 'insert_link()' - Insert a named link into the sorted list of links.
  */
 
 static void
-add_link(tree_t *html,		/* I - HTML node */
-         uchar  *name,		/* I - Name of link */
-         int    page,		/* I - Page # */
-         int    top)		/* I - Y position */
+insert_link(link_t *link,		/* I - Link to add */
+            int    append)		/* I - 1 to always add, 0 to replace */
 {
-  link_t	*temp;		/* New name */
-  char		*nameptr;	/* Pointer into name */
-
-
-  if (name == NULL)
-    return;
-
-  DEBUG_printf(("add_link(name=\"%s\", page=%d, top=%d)\n", name, page, top));
+  link_t	*temp;			/* New name */
+  size_t	left,			/* Left side of search */
+		right,			/* Right side of search */
+		mid;			/* Middle of search */
 
-  if ((nameptr = strrchr((char *)name, '/')) != NULL)
-    name = (uchar *)nameptr + 1;
-  else if ((nameptr = strrchr((char *)name, '\\')) != NULL)
-    name = (uchar *)nameptr + 1;
 
-  if (!html && (temp = find_link(name)) != NULL)
+  if (!append && (temp = find_link(link->name)) != NULL)
   {
-    temp->page = (short)page;
-    temp->top  = (short)top;
+    temp->page = link->page;
+    temp->top  = link->top;
     return;
   }
 
@@ -9055,69 +11001,68 @@ add_link(tree_t *html,		/* I - HTML node */
     links = temp;
   }
 
-  // Add a new link...
-  temp = links + num_links;
-  num_links ++;
-
-  if (html)
+  // Add a new link after any with the same name, keeping the array sorted...
+  for (left = 0, right = num_links; left < right;)
   {
-    uchar	*filename;		/* Filename */
+    mid = (left + right) / 2;
 
-    if ((filename = htmlGetVariable(html->parent, (uchar *)"_HD_URL")) != NULL)
-      snprintf((char *)temp->name, sizeof(temp->name), "%s#%s", (char *)filename, (char *)name);
+    if (compare_links(link, links + mid) < 0)
+      right = mid;
     else
-      strlcpy((char *)temp->name, (char *)name, sizeof(temp->name));
+      left = mid + 1;
   }
-  else
-  {
-    strlcpy((char *)temp->name, (char *)name, sizeof(temp->name));
-  }
-
-  temp->page = (short)page;
-  temp->top  = (short)top;
 
-  if (num_links > 1)
-    qsort(links, num_links, sizeof(link_t), (compare_func_t)compare_links);
+  memmove(links + left + 1, links + left, (num_links - left) * sizeof(link_t));
+  links[left] = *link;
+  num_links ++;
 }
 
 
 /*
- * 'find_link()' - Find a named link...
+ * 'compare_hfitems()' - Compare two header/footer elements.
  */
 
-static link_t *				/* O - Matching link */
-find_link(uchar *name)			/* I - Name to find */
+static int				/* O - Result of comparison */
+compare_hfitems(hfitem_t **a,		/* I - First element */
+                hfitem_t **b)		/* I - Second element */
 {
-  char		*nameptr;		/* Pointer into name */
-  link_t	key,			/* Search key */
-		*match;			/* Matching name entry */
+  int	result;				/* Result of comparison */
 
 
-  if (name == NULL || num_links == 0)
-    return (NULL);
+  if ((result = strcmp((*a)->key, (*b)->key)) != 0)
+    return (result);
+  else
+    return ((*a)->page - (*b)->page);
+}
 
-  if (name[0] == '#')
-    name ++;
-  else if ((nameptr = strrchr((char *)name, '/')) != NULL)
-    name = (uchar *)nameptr + 1;
-  else if ((nameptr = strrchr((char *)name, '\\')) != NULL)
-    name = (uchar *)nameptr + 1;
 
-  strlcpy((char *)key.name, (char *)name, sizeof(key.name));
-  match = (link_t *)bsearch(&key, links, num_links, sizeof(link_t), (compare_func_t)compare_links);
+/*
+ * 'compare_hfsets()' - Compare the shared header/footer elements of two pages.
+ *
+ * Pages without shared elements sort last, and pages with the same elements
+ * stay in page order.
+ */
 
-  if (!match)
-  {
-    uchar *target = (uchar *)strchr((char *)name, '#');
+static int				/* O - Result of comparison */
+compare_hfsets(hfset_t *a,		/* I - First page */
+               hfset_t *b)		/* I - Second page */
+{
+  int	result;				/* Result of comparison */
 
-    if (target)
-    {
-      strlcpy((char *)key.name, (char *)target + 1, sizeof(key.name));
-      match = (link_t *)bsearch(&key, links, num_links, sizeof(link_t), (compare_func_t)compare_links);
-    }
-  }
 
-  return (match);
+  if (a->set && b->set)
+    result = strcmp(a->set, b->set);
+  else if (a->set)
+    result = -1;
+  else if (b->set)
+    result = 1;
+  else
+    result = 0;
+
+  if (result)
+    return (result);
+  else
+    return (a->page - b->page);
 }
 
 
@@ -9133,6 +11078,23 @@ compare_links(link_t *n1,	/* I - First name */
 }
 
 
+/*
+ * 'compare_nodes()' - Compare two node numbers by node address.
+ */
+
+static int				/* O - Result of comparison */
+compare_nodes(nodenum_t *a,		/* I - First node */
+              nodenum_t *b)		/* I - Second node */
+{
+  if (a->node < b->node)
+    return (-1);
+  else if (a->node > b->node)
+    return (1);
+  else
+    return (0);
+}
+
+
 #ifdef TABLE_DEBUG
 #  undef DEBUG_printf
 #  undef DEBUG_puts
@@ -9882,7 +11844,7 @@ get_width(uchar *s,		/* I - String to scan */
   if (s == NULL)
     return (0.0);
 
-  if (!_htmlWidthsLoaded[typeface][style])
+  if (!hd_atomic_get(&_htmlWidthsLoaded[typeface][style]))
     htmlLoadFontWidths(typeface, style);
 
   for (width = 0, ptr = s; *ptr != '\0'; ptr ++)
@@ -9926,29 +11888,379 @@ open_file(void)
   char	filename[255];	/* Filename */
 
 
-  if (OutputFiles && PSLevel > 0)
+  if (OutputFiles && PSLevel > 0)
+  {
+    if (chapter == -1)
+      snprintf(filename, sizeof(filename), "%s/cover.ps", OutputPath);
+    else if (chapter == 0)
+      snprintf(filename, sizeof(filename), "%s/contents.ps", OutputPath);
+    else
+      snprintf(filename, sizeof(filename), "%s/doc%d.ps", OutputPath, chapter);
+
+    return (fopen(filename, "wb+"));
+  }
+  else if (OutputFiles)
+  {
+    snprintf(filename, sizeof(filename), "%s/doc.pdf", OutputPath);
+
+    return (fopen(filename, "wb+"));
+  }
+  else if (OutputPath[0] != '\0')
+    return (fopen(OutputPath, "wb+"));
+#ifdef HTMLDOC_STREAMING
+  else if (PSLevel == 0 || OutputFunc)
+  {
+    // PostScript is only sent through the sink for the output callback, and
+    // doesn't need to seek so it is written immediately...
+    fflush(stdout);
+    return (sink_open(1, PSLevel > 0));
+  }
+#else
+  else if (PSLevel == 0)
+    return (file_temp(stdout_filename, sizeof(stdout_filename)));
+#endif // HTMLDOC_STREAMING
+  else
+    return (stdout);
+}
+
+
+#ifdef HTMLDOC_STREAMING
+/*
+ * 'sink_open()' - Open a streaming output file for a pipe or socket.
+ *
+ * PDF output needs to seek back to fill in stream lengths and needs the
+ * offset of each object for the cross-reference table.  The sink keeps
+ * the current object in memory so that the stream length can be updated,
+ * counts the bytes that have been written, and sends each object to the
+ * file descriptor or output callback as soon as it is finished (see
+ * 'sink_commit()').  PostScript output never seeks, so "direct" sinks send
+ * the data as it is written.
+ */
+
+static FILE *				// O - File pointer
+sink_open(int fd,			// I - File descriptor
+          int direct)			// I - Write data immediately?
+{
+  FILE			*fp;		// File pointer
+#  ifdef HAVE_FOPENCOOKIE
+  cookie_io_functions_t	funcs;		// Stream functions
+#  endif // HAVE_FOPENCOOKIE
+
+
+  memset(&stdout_sink, 0, sizeof(stdout_sink));
+  stdout_sink.fd     = fd;
+  stdout_sink.direct = direct;
+
+#  ifdef HAVE_FOPENCOOKIE
+  funcs.read  = NULL;
+  funcs.write = sink_write_cb;
+  funcs.seek  = sink_seek_cb;
+  funcs.close = sink_close;
+
+  fp = fopencookie(&stdout_sink, "wb", funcs);
+#  else
+  fp = funopen(&stdout_sink, NULL, sink_write_cb, sink_seek_cb, sink_close);
+#  endif // HAVE_FOPENCOOKIE
+
+  stdout_sink_active = fp != NULL;
+
+  return (fp);
+}
+
+
+/*
+ * 'sink_commit()' - Write pending data to the sink's file descriptor.
+ */
+
+static void
+sink_commit(FILE *out)			// I - Output file
+{
+  fflush(out);
+
+  if (!sink_write(&stdout_sink, stdout_sink.buffer, stdout_sink.used))
+    progress_error(HD_ERROR_WRITE_ERROR, "Unable to write document file - %s", strerror(errno));
+
+  stdout_sink.offset += (hdoff_t)stdout_sink.used;
+  stdout_sink.used   = 0;
+  stdout_sink.pos    = 0;
+}
+
+
+/*
+ * 'sink_close()' - Flush and close the sink.
+ */
+
+static int				// O - 0 on success
+sink_close(void *ptr)			// I - Sink
+{
+  sink_t	*sink = (sink_t *)ptr;	// Sink
+
+
+  sink_write(sink, sink->buffer, sink->used);
+
+  free(sink->buffer);
+  memset(sink, 0, sizeof(sink_t));
+
+  stdout_sink_active = 0;
+
+  return (0);
+}
+
+
+/*
+ * 'sink_seek()' - Seek within the pending data of the sink.
+ *
+ * Only positions that have not yet been committed can be reached.
+ */
+
+static hdoff_t				// O - New position or -1 on error
+sink_seek(sink_t  *sink,		// I - Sink
+          hdoff_t offset,		// I - Offset
+	  int     whence)		// I - SEEK_SET, SEEK_CUR, or SEEK_END
+{
+  hdoff_t	pos;			// New position
+
+
+  switch (whence)
+  {
+    case SEEK_SET :
+        pos = offset;
+        break;
+    case SEEK_CUR :
+        pos = sink->offset + (hdoff_t)sink->pos + offset;
+        break;
+    case SEEK_END :
+        pos = sink->offset + (hdoff_t)sink->used + offset;
+        break;
+    default :
+        errno = EINVAL;
+        return (-1);
+  }
+
+  if (pos < sink->offset || pos > (sink->offset + (hdoff_t)sink->used))
+  {
+    errno = ESPIPE;
+    return (-1);
+  }
+
+  sink->pos = (size_t)(pos - sink->offset);
+
+  return (pos);
+}
+
+
+/*
+ * 'sink_write()' - Send data to the output callback or file descriptor.
+ */
+
+static int				// O - 1 on success, 0 on error
+sink_write(sink_t      *sink,		// I - Sink
+           const uchar *buffer,		// I - Data
+           size_t      bytes)		// I - Number of bytes
+{
+  ssize_t	written;		// Bytes written by last write()
+
+
+  if (bytes == 0)
+    return (1);
+
+  if (OutputFunc)
+    return ((*OutputFunc)(OutputData, buffer, bytes));
+
+  while (bytes > 0)
+  {
+    if ((written = write(sink->fd, buffer, bytes)) < 0)
+    {
+      if (errno == EINTR || errno == EAGAIN)
+        continue;
+
+      return (0);
+    }
+
+    buffer += written;
+    bytes  -= (size_t)written;
+  }
+
+  return (1);
+}
+
+
+#  ifdef HAVE_FOPENCOOKIE
+/*
+ * 'sink_seek_cb()' - Seek callback for fopencookie().
+ */
+
+static int				// O - 0 on success, -1 on error
+sink_seek_cb(void    *ptr,		// I  - Sink
+             off64_t *offset,		// IO - Offset
+	     int     whence)		// I  - SEEK_SET, SEEK_CUR, or SEEK_END
+{
+  hdoff_t	pos;			// New position
+
+
+  if ((pos = sink_seek((sink_t *)ptr, (hdoff_t)*offset, whence)) < 0)
+    return (-1);
+
+  *offset = pos;
+
+  return (0);
+}
+
+
+/*
+ * 'sink_write_cb()' - Write callback for fopencookie().
+ */
+
+static ssize_t				// O - Number of bytes written
+sink_write_cb(void       *ptr,		// I - Sink
+              const char *buf,		// I - Data
+	      size_t     size)		// I - Number of bytes
+#  else
+/*
+ * 'sink_seek_cb()' - Seek callback for funopen().
+ */
+
+static fpos_t				// O - New position or -1 on error
+sink_seek_cb(void   *ptr,		// I - Sink
+             fpos_t offset,		// I - Offset
+	     int    whence)		// I - SEEK_SET, SEEK_CUR, or SEEK_END
+{
+  return ((fpos_t)sink_seek((sink_t *)ptr, (hdoff_t)offset, whence));
+}
+
+
+/*
+ * 'sink_write_cb()' - Write callback for funopen().
+ */
+
+static int				// O - Number of bytes written
+sink_write_cb(void       *ptr,		// I - Sink
+              const char *buf,		// I - Data
+	      int        size)		// I - Number of bytes
+#  endif // HAVE_FOPENCOOKIE
+{
+  sink_t	*sink = (sink_t *)ptr;	// Sink
+
+
+  if (sink->direct)
+  {
+    if (!sink_write(sink, (const uchar *)buf, (size_t)size))
+      return (-1);
+
+    sink->offset += (hdoff_t)size;
+
+    return (size);
+  }
+
+  if ((sink->pos + (size_t)size) > sink->alloc)
+  {
+    size_t	alloc;			// New allocation size
+    uchar	*buffer;		// New buffer
+
+
+    for (alloc = sink->alloc ? sink->alloc : 65536; alloc < (sink->pos + (size_t)size); alloc *= 2);
+
+    if ((buffer = (uchar *)realloc(sink->buffer, alloc)) == NULL)
+    {
+      errno = ENOMEM;
+      return (-1);
+    }
+
+    sink->buffer = buffer;
+    sink->alloc  = alloc;
+  }
+
+  memcpy(sink->buffer + sink->pos, buf, (size_t)size);
+
+  sink->pos += (size_t)size;
+  if (sink->pos > sink->used)
+    sink->used = sink->pos;
+
+  return (size);
+}
+#endif // HTMLDOC_STREAMING
+
+
+/*
+ * 'format_float()' - Format a number for a content stream.
+ *
+ * This produces the same output as "%.Nf" with trailing zeros and decimal
+ * points removed, including the rounding of halfway values to even digits,
+ * without the overhead of snprintf().  The buffer must hold at least 32
+ * characters.
+ */
+
+static char *				/* O - Pointer to nul at end of string */
+format_float(char  *s,			/* I - String buffer */
+             float number,		/* I - Number to format */
+             int   digits)		/* I - Number of decimal places (0-3) */
+{
+  static const int scales[] = { 1, 10, 100, 1000 };
+					/* Scaling for decimal places */
+  long long	value;			/* Scaled value */
+  int		scale,			/* Scale for decimal places */
+		fraction;		/* Fractional part */
+  char		temp[32],		/* Temporary digits */
+		*tptr;			/* Pointer into digits */
+
+
+  if (digits < 0)
+    digits = 0;
+  else if (digits > 3)
+    digits = 3;
+
+  if (fabs(number) >= 1.0e9)
+  {
+    // Out of range, use snprintf...
+    snprintf(s, 32, "%.*f", digits, number);
+
+    for (tptr = s + strlen(s) - 1; digits > 0 && *tptr == '0'; tptr --)
+      *tptr = '\0';
+
+    if (*tptr == '.')
+      *tptr-- = '\0';
+
+    return (tptr + 1);
+  }
+
+  // The scaled value is exact in double precision, so rint() rounds halfway
+  // cases to even just like printf()...
+  scale = scales[digits];
+  value = (long long)rint(fabs((double)number) * scale);
+
+  if (signbit(number))
+    *s++ = '-';
+
+  fraction = (int)(value % scale);
+  value    /= scale;
+
+  // Integer part (digits are generated in reverse order)...
+  tptr = temp;
+  do
+  {
+    *tptr++ = (char)('0' + value % 10);
+    value   /= 10;
+  }
+  while (value > 0);
+
+  while (tptr > temp)
+    *s++ = *--tptr;
+
+  // Fractional part without trailing zeros...
+  if (fraction > 0)
   {
-    if (chapter == -1)
-      snprintf(filename, sizeof(filename), "%s/cover.ps", OutputPath);
-    else if (chapter == 0)
-      snprintf(filename, sizeof(filename), "%s/contents.ps", OutputPath);
-    else
-      snprintf(filename, sizeof(filename), "%s/doc%d.ps", OutputPath, chapter);
+    *s++ = '.';
 
-    return (fopen(filename, "wb+"));
+    for (scale /= 10; fraction > 0; scale /= 10)
+    {
+      *s++     = (char)('0' + fraction / scale);
+      fraction %= scale;
+    }
   }
-  else if (OutputFiles)
-  {
-    snprintf(filename, sizeof(filename), "%s/doc.pdf", OutputPath);
 
-    return (fopen(filename, "wb+"));
-  }
-  else if (OutputPath[0] != '\0')
-    return (fopen(OutputPath, "wb+"));
-  else if (PSLevel == 0)
-    return (file_temp(stdout_filename, sizeof(stdout_filename)));
-  else
-    return (stdout);
+  *s = '\0';
+
+  return (s);
 }
 
 
@@ -9960,6 +12272,10 @@ static void
 set_color(FILE  *out,	/* I - File to write to */
           float *rgb)	/* I - RGB color */
 {
+  char	buffer[255],	/* Operator buffer */
+	*bufptr;	/* Pointer into buffer */
+
+
   if (rgb[0] == render_rgb[0] &&
       rgb[1] == render_rgb[1] &&
       rgb[2] == render_rgb[2])
@@ -9973,19 +12289,34 @@ set_color(FILE  *out,	/* I - File to write to */
   {
     // Output RGB color...
     if (PSLevel > 0)
+    {
       fprintf(out, "%.2f %.2f %.2f C ", rgb[0], rgb[1], rgb[2]);
+    }
     else
-      flate_printf(out, "%.2f %.2f %.2f rg ", rgb[0], rgb[1], rgb[2]);
+    {
+      bufptr    = format_float(buffer, rgb[0], 2);
+      *bufptr++ = ' ';
+      bufptr    = format_float(bufptr, rgb[1], 2);
+      *bufptr++ = ' ';
+      bufptr    = format_float(bufptr, rgb[2], 2);
+      strlcpy(bufptr, " rg ", sizeof(buffer) - (size_t)(bufptr - buffer));
+      flate_puts(buffer, out);
+    }
   }
   else
   {
     // Output grayscale...
     if (PSLevel > 0)
+    {
       fprintf(out, "%.2f G ",
               rgb[0] * 0.31f + rgb[1] * 0.61f + rgb[2] * 0.08f);
+    }
     else
-      flate_printf(out, "%.2f g ",
-                   rgb[0] * 0.31f + rgb[1] * 0.61f + rgb[2] * 0.08f);
+    {
+      bufptr = format_float(buffer, rgb[0] * 0.31f + rgb[1] * 0.61f + rgb[2] * 0.08f, 2);
+      strlcpy(bufptr, " g ", sizeof(buffer) - (size_t)(bufptr - buffer));
+      flate_puts(buffer, out);
+    }
   }
 }
 
@@ -10000,8 +12331,7 @@ set_font(FILE  *out,			/* I - File to write to */
          int   style,			/* I - Style code */
          float size)			/* I - Size */
 {
-  char	sizes[255],	/* Formatted string for size... */
-	*s;		/* Pointer to end of string */
+  char	sizes[255];	/* Formatted string for size... */
 
 
   if (typeface == render_typeface &&
@@ -10010,16 +12340,10 @@ set_font(FILE  *out,			/* I - File to write to */
     return;
 
  /*
-  * Format size and strip trailing 0's and decimals...
+  * Format size without trailing 0's and decimals...
   */
 
-  snprintf(sizes, sizeof(sizes), "%.1f", size);
-
-  for (s = sizes + strlen(sizes) - 1; s > sizes && *s == '0'; s --)
-    *s = '\0';
-
-  if (*s == '.')
-    *s = '\0';
+  format_float(sizes, size, 1);
 
  /*
   * Set the new typeface, style, and size.
@@ -10050,51 +12374,42 @@ set_pos(FILE  *out,			/* I - File to write to */
         float x,			/* I - X position */
         float y)			/* I - Y position */
 {
-  char	xs[255],			/* Formatted string for X... */
-	ys[255],			/* Formatted string for Y... */
-	*s;				/* Pointer to end of string */
+  char	buffer[255],			/* Formatted X and Y... */
+	*bufptr;			/* Pointer into buffer */
 
 
   if (fabs(render_x - x) < 0.1 && fabs(render_y - y) < 0.1)
     return;
 
  /*
-  * Format X and Y...
+  * Format X and Y without trailing 0's and decimals...
   */
 
   if (PSLevel > 0 || render_x == -1.0)
   {
-    snprintf(xs, sizeof(xs), "%.3f", x);
-    snprintf(ys, sizeof(ys), "%.3f", y);
+    bufptr    = format_float(buffer, x, 3);
+    *bufptr++ = ' ';
+    bufptr    = format_float(bufptr, y, 3);
   }
   else
   {
-    snprintf(xs, sizeof(xs), "%.3f", x - render_startx);
-    snprintf(ys, sizeof(ys), "%.3f", y - render_y);
+    bufptr    = format_float(buffer, x - render_startx, 3);
+    *bufptr++ = ' ';
+    bufptr    = format_float(bufptr, y - render_y, 3);
   }
 
- /*
-  * Strip trailing 0's and decimals...
-  */
-
-  for (s = xs + strlen(xs) - 1; s > xs && *s == '0'; s --)
-    *s = '\0';
-
-  if (*s == '.')
-    *s = '\0';
-
-  for (s = ys + strlen(ys) - 1; s > ys && *s == '0'; s --)
-    *s = '\0';
-
-  if (*s == '.')
-    *s = '\0';
-
   if (PSLevel > 0)
-    fprintf(out, "%s %s M", xs, ys);
+  {
+    fputs(buffer, out);
+    fputs(" M", out);
+  }
   else
-    flate_printf(out, "%s %s Td", xs, ys);
+  {
+    strlcpy(bufptr, " Td", sizeof(buffer) - (size_t)(bufptr - buffer));
+    flate_puts(buffer, out);
+  }
 
-  render_x = render_startx = x;
+  render_x = render_startx = render_textx = x;
   render_y = y;
 }
 
@@ -10104,35 +12419,48 @@ set_pos(FILE  *out,			/* I - File to write to */
  */
 
 static void
-ps_hex(FILE  *out,			/* I - File to print to */
-       uchar *data,			/* I - Data to print */
-       int   length)			/* I - Number of bytes to print */
+ps_hex(FILE   *out,			/* I - File to print to */
+       uchar  *data,			/* I - Data to print */
+       size_t length)			/* I - Number of bytes to print */
 {
-  int		col;
+  int		col;			/* Current column */
+  uchar		outbuf[16384],		/* Output buffer */
+		*outptr,		/* Pointer into output buffer */
+		*outend;		/* End of output buffer */
   static const char *hex = "0123456789ABCDEF";
 
 
-  col = 0;
-  while (length > 0)
-  {
-   /*
-    * Put the hex uchars out to the file; note that we don't use fprintf()
-    * for speed reasons...
-    */
+ /*
+  * Encode into a large buffer rather than calling putc() for every
+  * character; each line holds 40 bytes of data...
+  */
 
-    putc(hex[*data >> 4], out);
-    putc(hex[*data & 15], out);
+  outptr = outbuf;
+  outend = outbuf + sizeof(outbuf) - 3;
+
+  for (col = 0; length > 0; data ++, length --)
+  {
+    if (outptr >= outend)
+    {
+      fwrite(outbuf, 1, (size_t)(outptr - outbuf), out);
+      outptr = outbuf;
+    }
 
-    data ++;
-    length --;
+    *outptr++ = (uchar)hex[*data >> 4];
+    *outptr++ = (uchar)hex[*data & 15];
 
-    col = (col + 1) % 40;
-    if (col == 0)
-      putc('\n', out);
+    if (++ col == 40)
+    {
+      *outptr++ = '\n';
+      col       = 0;
+    }
   }
 
   if (col > 0)
-    putc('\n', out);
+    *outptr++ = '\n';
+
+  if (outptr > outbuf)
+    fwrite(outbuf, 1, (size_t)(outptr - outbuf), out);
 }
 
 
@@ -10140,116 +12468,171 @@ ps_hex(FILE  *out,			/* I - File to print to */
 #ifdef HTMLDOC_ASCII85
 /*
  * 'ps_ascii85()' - Print binary data as a series of base-85 numbers.
+ *
+ * The encoder state holds the output column and any partial 4-byte group
+ * between calls, so one stream can be written in several pieces.
  */
 
 static void
-ps_ascii85(FILE  *out,			/* I - File to print to */
-	   uchar *data,			/* I - Data to print */
-	   int   length,		/* I - Number of bytes to print */
-	   int   eod)			/* I - 1 = end-of-data */
+ps_ascii85(FILE      *out,		/* I - File to print to */
+           ascii85_t *state,		/* I - Encoder state */
+	   uchar     *data,		/* I - Data to print */
+	   size_t    length,		/* I - Number of bytes to print */
+	   int       eod)		/* I - 1 = end-of-data */
 {
-  unsigned	b = 0;			/* Current 32-bit word */
-  uchar		c[5];			/* Base-85 encoded characters */
-  static int	col = 0;		/* Column */
-  static uchar	leftdata[4];		/* Leftover data at the end */
-  static int	leftcount = 0;		/* Size of leftover data */
+  unsigned	b;			/* Current 32-bit word */
+  int		col;			/* Current column */
+  uchar		outbuf[16384],		/* Output buffer */
+		*outptr,		/* Pointer into output buffer */
+		*outend;		/* End of output buffer */
 
 
-  length += leftcount;
+  col    = state->col;
+  outptr = outbuf;
+  outend = outbuf + sizeof(outbuf) - 6;
 
-  while (length > 3)
+  // Complete the group left over from the last call...
+  if (state->leftcount > 0)
   {
-    switch (leftcount)
+    while (state->leftcount < 4 && length > 0)
     {
-      case 0 :
-          b = (unsigned)((((((data[0] << 8) | data[1]) << 8) | data[2]) << 8) | data[3]);
-	  break;
-      case 1 :
-          b = (unsigned)((((((leftdata[0] << 8) | data[0]) << 8) | data[1]) << 8) | data[2]);
-	  break;
-      case 2 :
-          b = (unsigned)((((((leftdata[0] << 8) | leftdata[1]) << 8) | data[0]) << 8) | data[1]);
-	  break;
-      case 3 :
-          b = (unsigned)((((((leftdata[0] << 8) | leftdata[1]) << 8) | leftdata[2]) << 8) | data[0]);
-	  break;
+      state->leftdata[state->leftcount ++] = *data++;
+      length --;
+    }
+
+    if (state->leftcount == 4)
+    {
+      b = (unsigned)((((((state->leftdata[0] << 8) | state->leftdata[1]) << 8) | state->leftdata[2]) << 8) | state->leftdata[3]);
+
+      if (col >= 76)
+      {
+        *outptr++ = '\n';
+        col       = 0;
+      }
+
+      if (b == 0)
+      {
+        *outptr++ = 'z';
+        col ++;
+      }
+      else
+      {
+        outptr[4] = (uchar)(b % 85 + '!');
+        b /= 85;
+        outptr[3] = (uchar)(b % 85 + '!');
+        b /= 85;
+        outptr[2] = (uchar)(b % 85 + '!');
+        b /= 85;
+        outptr[1] = (uchar)(b % 85 + '!');
+        b /= 85;
+        outptr[0] = (uchar)(b + '!');
+
+        outptr += 5;
+        col    += 5;
+      }
+
+      state->leftcount = 0;
+    }
+  }
+
+  // Then encode as many whole groups as possible...
+  for (; length > 3; data += 4, length -= 4)
+  {
+    if (outptr >= outend)
+    {
+      fwrite(outbuf, 1, (size_t)(outptr - outbuf), out);
+      outptr = outbuf;
     }
 
+    b = (unsigned)((((((data[0] << 8) | data[1]) << 8) | data[2]) << 8) | data[3]);
+
     if (col >= 76)
     {
-      col = 0;
-      putc('\n', out);
+      *outptr++ = '\n';
+      col       = 0;
     }
 
     if (b == 0)
     {
-      putc('z', out);
+      *outptr++ = 'z';
       col ++;
     }
     else
     {
-      c[4] = (b % 85) + '!';
+      outptr[4] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[3] = (b % 85) + '!';
+      outptr[3] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[2] = (b % 85) + '!';
+      outptr[2] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[1] = (b % 85) + '!';
+      outptr[1] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[0] = (uchar)(b + '!');
+      outptr[0] = (uchar)(b + '!');
 
-      fwrite(c, 1, 5, out);
-      col += 5;
+      outptr += 5;
+      col    += 5;
     }
-
-    data      += 4 - leftcount;
-    length    -= 4 - leftcount;
-    leftcount = 0;
   }
 
+  // Save any remainder for the next call...
   if (length > 0)
   {
-    // Copy any remainder into the leftdata array...
-    if ((length - leftcount) > 0)
-      memcpy(leftdata + leftcount, data, (size_t)(length - leftcount));
-
-    memset(leftdata + length, 0, (size_t)(4 - length));
-
-    leftcount = length;
+    memcpy(state->leftdata + state->leftcount, data, length);
+    state->leftcount += length;
   }
 
   if (eod)
   {
-    // Do the end-of-data dance...
+    // Do the end-of-data dance, making room for the newline and final
+    // partial group...
+    if (outptr >= outend)
+    {
+      fwrite(outbuf, 1, (size_t)(outptr - outbuf), out);
+      outptr = outbuf;
+    }
+
     if (col >= 76)
     {
-      col = 0;
-      putc('\n', out);
+      *outptr++ = '\n';
+      col       = 0;
     }
 
-    if (leftcount > 0)
+    if (state->leftcount > 0)
     {
+      uchar	group[5];		// Encoded group
+
       // Write the remaining bytes as needed...
-      b = (unsigned)((((((leftdata[0] << 8) | leftdata[1]) << 8) | leftdata[2]) << 8) | leftdata[3]);
+      memset(state->leftdata + state->leftcount, 0, 4 - state->leftcount);
 
-      c[4] = (b % 85) + '!';
+      b = (unsigned)((((((state->leftdata[0] << 8) | state->leftdata[1]) << 8) | state->leftdata[2]) << 8) | state->leftdata[3]);
+
+      group[4] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[3] = (b % 85) + '!';
+      group[3] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[2] = (b % 85) + '!';
+      group[2] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[1] = (b % 85) + '!';
+      group[1] = (uchar)(b % 85 + '!');
       b /= 85;
-      c[0] = (uchar)(b + '!');
+      group[0] = (uchar)(b + '!');
 
-      fwrite(c, (size_t)(leftcount + 1), 1, out);
+      memcpy(outptr, group, state->leftcount + 1);
+      outptr += state->leftcount + 1;
 
-      leftcount = 0;
+      state->leftcount = 0;
     }
 
+    fwrite(outbuf, 1, (size_t)(outptr - outbuf), out);
     fputs("~>\n", out);
-    col = 0;
+
+    outptr = outbuf;
+    col    = 0;
   }
+
+  if (outptr > outbuf)
+    fwrite(outbuf, 1, (size_t)(outptr - outbuf), out);
+
+  state->col = col;
 }
 #endif // HTMLDOC_ASCII85
 
@@ -10290,7 +12673,7 @@ jpg_empty(j_compress_ptr cinfo)		/* I - Compressor info */
 
   if (PSLevel > 0)
 #ifdef HTMLDOC_ASCII85
-    ps_ascii85(jpg_file, jpg_buf, sizeof(jpg_buf));
+    ps_ascii85(jpg_file, &ascii85_state, jpg_buf, sizeof(jpg_buf));
 #else
     ps_hex(jpg_file, jpg_buf, sizeof(jpg_buf));
 #endif // HTMLDOC_ASCII85
@@ -10320,7 +12703,7 @@ jpg_term(j_compress_ptr cinfo)		/* I - Compressor info */
 
   if (PSLevel > 0)
 #ifdef HTMLDOC_ASCII85
-    ps_ascii85(jpg_file, jpg_buf, nbytes);
+    ps_ascii85(jpg_file, &ascii85_state, jpg_buf, nbytes);
 #else
     ps_hex(jpg_file, jpg_buf, nbytes);
 #endif // HTMLDOC_ASCII85
@@ -10389,6 +12772,39 @@ compare_rgb(unsigned *rgb1,		/* I - First color */
 }
 
 
+/*
+ * 'decode_images()' - Decode the images in a list of render elements.
+ *
+ * The images are decoded in parallel before the page is written, and
+ * write_image() frees them as usual.
+ */
+
+static void
+decode_images(render_t *start)		/* I - First render element */
+{
+  render_t	*r;			/* Current render element */
+  int		num_imgs;		/* Number of images */
+  image_t	**imgs;			/* Images */
+
+
+  for (r = start, num_imgs = 0; r != NULL; r = r->next)
+    if (r->type == RENDER_IMAGE && !r->data.image->pixels && !r->data.image->obj)
+      num_imgs ++;
+
+  if (num_imgs < 2 || (imgs = (image_t **)malloc((size_t)num_imgs * sizeof(image_t *))) == NULL)
+    return;
+
+  for (r = start, num_imgs = 0; r != NULL; r = r->next)
+    if (r->type == RENDER_IMAGE && !r->data.image->pixels && !r->data.image->obj &&
+        r->width > 0.01f && r->height > 0.01f)
+      imgs[num_imgs ++] = r->data.image;
+
+  image_decode(num_imgs, imgs, !OutputColor, NULL, NULL);
+
+  free(imgs);
+}
+
+
 /*
  * 'write_image()' - Write an image to the given output file...
  */
@@ -10795,10 +13211,10 @@ write_image(FILE     *out,		/* I - Output file */
           pdf_start_stream(out);
           flate_open_stream(out);
 	  if (img->maskscale == 8)
-  	    flate_write(out, img->mask, img->width * img->height);
+  	    flate_write(out, img->mask, (size_t)img->width * (size_t)img->height);
 	  else
   	    flate_write(out, img->mask,
-	                img->maskwidth * img->height * img->maskscale);
+	                (size_t)img->maskwidth * (size_t)img->height * (size_t)img->maskscale);
 	  flate_close_stream(out);
 
           pdf_end_object(out);
@@ -10880,10 +13296,10 @@ write_image(FILE     *out,		/* I - Output file */
           else
 	  {
 	    if (ncolors > 0)
-   	      flate_write(out, indices, indwidth * img->height);
+   	      flate_write(out, indices, (size_t)indwidth * (size_t)img->height);
 	    else
   	      flate_write(out, img->pixels,
-	                  img->width * img->height * img->depth);
+	                  (size_t)img->width * (size_t)img->height * (size_t)img->depth);
           }
 
           flate_close_stream(out);
@@ -10915,7 +13331,7 @@ write_image(FILE     *out,		/* I - Output file */
 	  if (ncolors > 0)
 	  {
   	    flate_puts(" ID\n", out);
-  	    flate_write(out, indices, indwidth * img->height, 1);
+  	    flate_write(out, indices, (size_t)indwidth * (size_t)img->height, 1);
 	  }
 	  else if (OutputJPEG)
 	  {
@@ -10934,7 +13350,7 @@ write_image(FILE     *out,		/* I - Output file */
 	  else
 	  {
   	    flate_puts(" ID\n", out);
-  	    flate_write(out, img->pixels, img->width * img->height * img->depth, 1);
+  	    flate_write(out, img->pixels, (size_t)img->width * (size_t)img->height * (size_t)img->depth, 1);
           }
 
 	  flate_write(out, (uchar *)"\nEI\nQ\n", 6, 1);
@@ -10962,7 +13378,7 @@ write_image(FILE     *out,		/* I - Output file */
         	  img->width, -img->height,
         	  img->height);
 
-	ps_hex(out, img->pixels, img->width * img->height * img->depth);
+	ps_hex(out, img->pixels, (size_t)img->width * (size_t)img->height * (size_t)img->depth);
 
 	fputs("GR\n", out);
         break;
@@ -11069,7 +13485,7 @@ write_image(FILE     *out,		/* I - Output file */
 	      }
 	    }
 	    else
-	      flate_write(out, indices, indwidth * img->height);
+	      flate_write(out, indices, (size_t)indwidth * (size_t)img->height);
 
 	    flate_close_stream(out);
           }
@@ -11168,7 +13584,7 @@ write_image(FILE     *out,		/* I - Output file */
 	    }
 	    else
 	      flate_write(out, img->pixels,
-	                  img->width * img->height * img->depth);
+	                  (size_t)img->width * (size_t)img->height * (size_t)img->depth);
 
 	    flate_close_stream(out);
           }
@@ -11217,11 +13633,11 @@ write_image(FILE     *out,		/* I - Output file */
 #ifdef HTMLDOC_ASCII85
 	  fputs("/DataSource currentfile/ASCII85Decode filter>>image\n", out);
 
-          ps_ascii85(out, indices, indwidth * img->height, 1);
+          ps_ascii85(out, &ascii85_state, indices, (size_t)indwidth * (size_t)img->height, 1);
 #else
 	  fputs("/DataSource currentfile/ASCIIHexDecode filter>>image\n", out);
 
-          ps_hex(out, indices, indwidth * img->height);
+          ps_hex(out, indices, (size_t)indwidth * (size_t)img->height);
 	  // End of data marker...
 	  fputs(">\n", out);
 #endif /* HTMLDOC_ASCII85 */
@@ -11267,7 +13683,7 @@ write_image(FILE     *out,		/* I - Output file */
 	  jpeg_destroy_compress(&cinfo);
 
 #ifdef HTMLDOC_ASCII85
-          ps_ascii85(out, (uchar *)"", 0, 1);
+          ps_ascii85(out, &ascii85_state, (uchar *)"", 0, 1);
 #else
 	  // End of data marker...
 	  fputs(">\n", out);
@@ -11299,13 +13715,13 @@ write_image(FILE     *out,		/* I - Output file */
           fputs("/DataSource currentfile/ASCII85Decode filter"
 	        ">>image\n", out);
 
-	  ps_ascii85(out, img->pixels, img->width * img->height *
-	                               img->depth, 1);
+	  ps_ascii85(out, &ascii85_state, img->pixels,
+	             (size_t)img->width * (size_t)img->height * (size_t)img->depth, 1);
 #else
           fputs("/DataSource currentfile/ASCIIHexDecode filter"
 	        ">>image\n", out);
 
-          ps_hex(out, img->pixels, img->width * img->depth * img->height);
+          ps_hex(out, img->pixels, (size_t)img->width * (size_t)img->depth * (size_t)img->height);
 	  // End of data marker...
 	  fputs(">\n", out);
 #endif // HTMLDOC_ASCII85
@@ -11728,6 +14144,8 @@ write_prolog(FILE  *out,		/* I - Output file */
     * Embed fonts?
     */
 
+    stats_begin(HD_STATS_FONTS);
+
     for (i = 0; i < TYPE_MAX; i ++)
     {
       if (EmbedFonts || !_htmlStandardFonts[i])
@@ -11736,6 +14154,8 @@ write_prolog(FILE  *out,		/* I - Output file */
 	    write_type1(out, (typeface_t)i, (style_t)j);
     }
 
+    stats_end(HD_STATS_FONTS);
+
    /*
     * Procedures used throughout the document...
     */
@@ -11751,6 +14171,16 @@ write_prolog(FILE  *out,		/* I - Output file */
     fputs("/DF{findfont dup length dict begin{1 index/FID ne{def}{pop pop}\n"
           "ifelse}forall/Encoding fontencoding def currentdict end definefont pop}BD\n", out);
     fputs("/F{dup 0 exch rlineto exch 0 rlineto neg 0 exch rlineto closepath fill}BD\n", out);
+    if (PSLevel > 2 && PSCompression && Compression)
+    {
+#ifdef HTMLDOC_ASCII85
+      fputs("/FP{currentfile/ASCII85Decode filter", out);
+#else
+      fputs("/FP{currentfile/ASCIIHexDecode filter", out);
+#endif // HTMLDOC_ASCII85
+      fputs(" dup/FlateDecode filter cvx exec\n"
+            "{dup read{pop}{exit}ifelse}loop closefile}BD\n", out);
+    }
     fputs("/FS{/hdFontSize exch def}BD", out);
     fputs("/G{setgray}BD\n", out);
     fputs("/GS{gsave}BD", out);
@@ -12143,12 +14573,16 @@ write_prolog(FILE  *out,		/* I - Output file */
     * Build font descriptors for the EmbedFonts fonts...
     */
 
+    stats_begin(HD_STATS_FONTS);
+
     for (i = 0; i < TYPE_MAX; i ++)
       if (EmbedFonts || !_htmlStandardFonts[i])
 	for (j = 0; j < STYLE_MAX; j ++)
           if (fonts_used[i][j])
 	    font_desc[i][j] = write_type1(out, (typeface_t )i, (style_t)j);
 
+    stats_end(HD_STATS_FONTS);
+
     for (i = 0; i < TYPE_MAX; i ++)
       for (j = 0; j < STYLE_MAX; j ++)
         if (fonts_used[i][j])
@@ -12177,6 +14611,24 @@ write_prolog(FILE  *out,		/* I - Output file */
 }
 
 
+/*
+ * 'write_stdout()' - Write data to the standard output or output callback.
+ */
+
+static int				// O - 1 on success, 0 on error
+write_stdout(const void *buffer,	// I - Data
+             size_t     bytes)		// I - Number of bytes
+{
+  if (OutputFunc)
+    return ((*OutputFunc)(OutputData, buffer, bytes));
+
+  if (fwrite(buffer, 1, bytes, stdout) < bytes)
+    return (0);
+
+  return (!fflush(stdout));
+}
+
+
 /*
  * 'write_string()' - Write a text entity.
  */
@@ -12232,27 +14684,49 @@ write_string(FILE  *out,		/* I - Output file */
 
     while (*s != '\0')
     {
+      if (compress)
+      {
+        uchar	buffer[1024],		// Escaped string
+		*bufptr;		// Pointer into buffer
+
+       /*
+        * Escape a block of characters at a time...
+	*/
+
+        for (bufptr = buffer; *s && bufptr < (buffer + sizeof(buffer) - 4); s ++)
+	{
+	  if (*s == nbsp)
+	  {
+	    *bufptr++ = ' ';
+	  }
+	  else if (*s < 32 || *s > 126)
+	  {
+	    *bufptr++ = '\\';
+	    *bufptr++ = (uchar)('0' + (*s >> 6));
+	    *bufptr++ = (uchar)('0' + ((*s >> 3) & 7));
+	    *bufptr++ = (uchar)('0' + (*s & 7));
+	  }
+	  else
+	  {
+	    if (*s == '(' || *s == ')' || *s == '\\')
+	      *bufptr++ = '\\';
+
+	    *bufptr++ = *s;
+	  }
+	}
+
+        flate_write(out, buffer, (size_t)(bufptr - buffer));
+	continue;
+      }
+
       if (*s == nbsp)
       {
        /* &nbsp; */
-	if (compress)
-	  flate_write(out, (uchar *)" ", 1);
-	else
-	  putc(' ', out);
+	putc(' ', out);
       }
       else if (*s < 32 || *s > 126)
       {
-	if (compress)
-	  flate_printf(out, "\\%o", *s);
-	else
-	  fprintf(out, "\\%o", *s);
-      }
-      else if (compress)
-      {
-	if (*s == '(' || *s == ')' || *s == '\\')
-	  flate_write(out, (uchar *)"\\", 1);
-
-	flate_write(out, s, 1);
+	fprintf(out, "\\%o", *s);
       }
       else
       {
@@ -12275,13 +14749,26 @@ write_string(FILE  *out,		/* I - Output file */
 
 /*
  * 'write_text()' - Write a text entity.
+ *
+ * For PDF output, any following text entities on the same baseline with the
+ * same font, color, and spacing are written in the same TJ array, using
+ * offsets for the gaps between them.  The return value is the first entity
+ * that was not written.
  */
 
-static void
+static render_t *		/* O - Next entity to write */
 write_text(FILE     *out,	/* I - Output file */
            render_t *r)		/* I - Text entity */
 {
-  uchar	*ptr;			/* Pointer into text */
+  uchar		*ptr;		/* Pointer into text */
+  render_t	*next,		/* Next entity */
+		*end;		/* End of TJ array */
+  float		gap;		/* Gap between text entities */
+  char		buffer[255],	/* Operator buffer */
+		*bufptr;	/* Pointer into buffer */
+  uchar		*string = NULL,	/* Text between gaps */
+		*strptr = NULL;	/* Pointer into text */
+  size_t	length;		/* Size of text buffer */
 
 
   // Quick optimization - don't output spaces...
@@ -12290,7 +14777,7 @@ write_text(FILE     *out,	/* I - Output file */
       break;
 
   if (!*ptr)
-    return;
+    return (r->next);
 
   // Not just whitespace - send it out...
   set_color(out, r->data.text.rgb);
@@ -12303,21 +14790,198 @@ write_text(FILE     *out,	/* I - Output file */
       fprintf(out, " %.3f", r->data.text.spacing);
   }
   else if (r->data.text.spacing != render_spacing)
-    flate_printf(out, " %.3f Tc", render_spacing = r->data.text.spacing);
-
-  write_string(out, r->data.text.buffer, PSLevel == 0);
+  {
+    buffer[0] = ' ';
+    bufptr    = format_float(buffer + 1, render_spacing = r->data.text.spacing, 3);
+    strlcpy(bufptr, " Tc", sizeof(buffer) - (size_t)(bufptr - buffer));
+    flate_puts(buffer, out);
+  }
 
   if (PSLevel > 0)
   {
+    write_string(out, r->data.text.buffer, 0);
+
     if (r->data.text.spacing > 0.0f)
       fputs("J\n", out);
     else
       fputs("S\n", out);
+
+    render_x += r->width;
+
+    return (r->next);
   }
-  else
+
+ /*
+  * Find any following text that can be written in the same TJ array...
+  */
+
+  for (next = r->next, end = NULL; next; next = next->next)
+  {
+    if (next->type != RENDER_TEXT)
+      continue;				// Already written
+
+    for (ptr = next->data.text.buffer; *ptr; ptr ++)
+      if (!isspace(*ptr) && *ptr != 0xa0)
+        break;
+
+    if (!*ptr)
+      continue;				// Not written
+
+    if (next->y != r->y ||
+        next->data.text.typeface != r->data.text.typeface ||
+        next->data.text.style != r->data.text.style ||
+        next->data.text.size != r->data.text.size ||
+        next->data.text.spacing != r->data.text.spacing ||
+        memcmp(next->data.text.rgb, r->data.text.rgb, sizeof(r->data.text.rgb)))
+      break;
+
+    end = next;
+  }
+
+ /*
+  * render_x tracks the layout position, which decides when text needs to be
+  * moved, while render_textx tracks where the viewer leaves the current
+  * point, which is needed to compute the TJ offsets...
+  */
+
+  if (!end)
+  {
+    write_string(out, r->data.text.buffer, 1);
     flate_puts("Tj\n", out);
 
-  render_x += r->width;
+    render_x     += r->width;
+    render_textx += write_text_width(r);
+
+    return (r->next);
+  }
+
+  // Text between gaps is written as a single string...
+  for (next = r, length = 1; next != end->next; next = next->next)
+    if (next->type == RENDER_TEXT)
+      length += strlen((char *)next->data.text.buffer);
+
+  if ((string = (uchar *)malloc(length)) == NULL)
+  {
+    progress_error(HD_ERROR_OUT_OF_MEMORY, "Unable to allocate %d bytes for text.", (int)length);
+    length = 0;
+  }
+  else
+  {
+    strlcpy((char *)string, (char *)r->data.text.buffer, length);
+    strptr = string + strlen((char *)string);
+  }
+
+  flate_write(out, (uchar *)"[", 1);
+
+  if (!string)
+    write_string(out, r->data.text.buffer, 1);
+
+  render_x     += r->width;
+  render_textx += write_text_width(r);
+
+  for (next = r->next; next != end->next; next = next->next)
+  {
+    if (next->type != RENDER_TEXT)
+      continue;
+
+    for (ptr = next->data.text.buffer; *ptr; ptr ++)
+      if (!isspace(*ptr) && *ptr != 0xa0)
+        break;
+
+    if (!*ptr)
+      continue;
+
+    if (fabs(next->x - render_x) >= 0.1)
+    {
+     /*
+      * TJ offsets are in thousandths of the font size and move to the left.
+      * Offsets that round to 0 are not written...
+      */
+
+      gap = next->x - render_textx;
+
+      format_float(buffer, -gap * 1000.0f / text_size(r), 1);
+
+      if (strcmp(buffer, "0") && strcmp(buffer, "-0"))
+      {
+        if (string)
+        {
+          write_string(out, string, 1);
+          strptr = string;
+        }
+
+        flate_puts(buffer, out);
+      }
+
+      render_x = render_textx = next->x;
+    }
+
+    if (string)
+    {
+      strlcpy((char *)strptr, (char *)next->data.text.buffer, length - (size_t)(strptr - string));
+      strptr += strlen((char *)strptr);
+    }
+    else
+      write_string(out, next->data.text.buffer, 1);
+
+    render_x     += next->width;
+    render_textx += write_text_width(next);
+  }
+
+  if (string)
+  {
+    write_string(out, string, 1);
+    free(string);
+  }
+
+  flate_puts("]TJ\n", out);
+
+  return (end->next);
+}
+
+
+/*
+ * 'text_size()' - Get the font size of written text.
+ *
+ * Sizes are written with one decimal place, so the viewer uses the rounded
+ * size for the width of the text.
+ */
+
+static float				/* O - Font size in points */
+text_size(render_t *r)			/* I - Text entity */
+{
+  return ((float)floor(r->data.text.size * 10.0f + 0.5f) * 0.1f);
+}
+
+
+/*
+ * 'write_text_width()' - Compute the width of written text.
+ *
+ * This is the distance the current point moves when the text is shown,
+ * including character spacing and with non-breaking spaces written as
+ * spaces.
+ */
+
+static float				/* O - Width in points */
+write_text_width(render_t *r)		/* I - Text entity */
+{
+  uchar		*ptr,			/* Pointer into text */
+		nbsp;			/* Non-breaking space char */
+  short		*widths;		/* Character widths */
+  int		width,			/* Width in font units */
+		count;			/* Number of characters */
+
+
+  if (!hd_atomic_get(&_htmlWidthsLoaded[r->data.text.typeface][r->data.text.style]))
+    htmlLoadFontWidths(r->data.text.typeface, r->data.text.style);
+
+  widths = _htmlWidths[r->data.text.typeface][r->data.text.style];
+  nbsp   = _htmlUTF8 ? _htmlCharacters[160] : 160;
+
+  for (ptr = r->data.text.buffer, width = 0, count = 0; *ptr; ptr ++, count ++)
+    width += widths[*ptr == nbsp ? ' ' : *ptr];
+
+  return (width * text_size(r) * 0.001f + count * r->data.text.spacing);
 }
 
 
@@ -12332,8 +14996,8 @@ write_trailer(FILE  *out,		/* I - Output file */
 {
   int		i, j, k,		/* Looping vars */
 		type,			/* Type of number */
-		offset,			/* Offset to xref table in PDF file */
 		start;			/* Start page number */
+  hdoff_t	offset;			/* Offset to xref table in PDF file */
   page_t	*page;			/* Start page of chapter */
   char		prefix[64],		/* Prefix string */
 		*prefptr;		/* Pointer into prefix string */
@@ -12508,13 +15172,15 @@ write_trailer(FILE  *out,		/* I - Output file */
 
     pdf_end_object(out);
 
-    offset = ftell(out);
+    offset = ftello(out);
+
+    stats_count(HD_COUNT_OBJECTS, (long long)num_objects);
 
     fputs("xref\n", out);
     fprintf(out, "0 %d \n", (int)num_objects + 1);
     fputs("0000000000 65535 f \n", out);
     for (i = 1; i <= (int)num_objects; i ++)
-      fprintf(out, "%010d 00000 n \n", objects[i]);
+      fprintf(out, "%010lld 00000 n \n", (long long)objects[i]);
 
     fputs("trailer\n", out);
     fputs("<<", out);
@@ -12534,7 +15200,7 @@ write_trailer(FILE  *out,		/* I - Output file */
 
     fputs(">>\n", out);
     fputs("startxref\n", out);
-    fprintf(out, "%d\n", offset);
+    fprintf(out, "%lld\n", (long long)offset);
     fputs("%%EOF\n", out);
   }
 }
@@ -13001,23 +15667,26 @@ flate_close_stream(FILE *out)		/* I - Output file */
   {
 #ifdef HTMLDOC_ASCII85
     if (PSLevel)
-      ps_ascii85(out, (uchar *)"", 0, 1);
+      ps_ascii85(out, &ascii85_state, (uchar *)"", 0, 1);
 #endif // HTMLDOC_ASCII85
 
     return;
   }
 
+  stats_begin(HD_STATS_COMPRESS);
+
   while ((status = deflate(&compressor, Z_FINISH)) != Z_STREAM_END)
   {
     if (status < Z_OK && status != Z_BUF_ERROR)
     {
       progress_error(HD_ERROR_OUT_OF_MEMORY, "deflate() failed (%d)", status);
+      stats_end(HD_STATS_COMPRESS);
       return;
     }
 
     if (PSLevel)
 #ifdef HTMLDOC_ASCII85
-      ps_ascii85(out, comp_buffer,
+      ps_ascii85(out, &ascii85_state, comp_buffer,
                  (uchar *)compressor.next_out - (uchar *)comp_buffer);
 #else
       ps_hex(out, comp_buffer,
@@ -13040,7 +15709,7 @@ flate_close_stream(FILE *out)		/* I - Output file */
   {
     if (PSLevel)
 #ifdef HTMLDOC_ASCII85
-      ps_ascii85(out, comp_buffer,
+      ps_ascii85(out, &ascii85_state, comp_buffer,
                  (uchar *)compressor.next_out - (uchar *)comp_buffer);
 #else
       ps_hex(out, comp_buffer,
@@ -13059,11 +15728,13 @@ flate_close_stream(FILE *out)		/* I - Output file */
 
   deflateEnd(&compressor);
 
+  stats_end(HD_STATS_COMPRESS);
+
   compressor_active = 0;
 
 #ifdef HTMLDOC_ASCII85
   if (PSLevel)
-    ps_ascii85(out, (uchar *)"", 0, 1);
+    ps_ascii85(out, &ascii85_state, (uchar *)"", 0, 1);
 #else
   if (PSLevel)
   {
@@ -13113,26 +15784,35 @@ flate_printf(FILE       *out,		/* I - Output file */
  */
 
 static void
-flate_write(FILE  *out,			/* I - Output file */
-            uchar *buf,			/* I - Buffer */
-            int   length,		/* I - Number of bytes to write */
-	    int   flush)		/* I - Flush when writing data? */
+flate_write(FILE   *out,			/* I - Output file */
+            uchar  *buf,		/* I - Buffer */
+            size_t length,		/* I - Number of bytes to write */
+	    int    flush)		/* I - Flush when writing data? */
 {
   int	status;				/* Deflate status */
 
 
   if (compressor_active)
   {
+    stats_begin(HD_STATS_COMPRESS);
+
     compressor.next_in  = buf;
-    compressor.avail_in = (unsigned)length;
+    compressor.avail_in = 0;
 
-    while (compressor.avail_in > 0)
+    while (compressor.avail_in > 0 || length > 0)
     {
+      if (compressor.avail_in == 0)
+      {
+        // zlib only takes 32-bit lengths, so feed large buffers in chunks...
+        compressor.avail_in = length > 0x40000000 ? 0x40000000 : (uInt)length;
+        length -= compressor.avail_in;
+      }
+
       if (compressor.avail_out < (int)(sizeof(comp_buffer) / 8))
       {
 	if (PSLevel)
 #ifdef HTMLDOC_ASCII85
-	  ps_ascii85(out, comp_buffer,
+	  ps_ascii85(out, &ascii85_state, comp_buffer,
                      (uchar *)compressor.next_out - (uchar *)comp_buffer);
 #else
 	  ps_hex(out, comp_buffer,
@@ -13156,34 +15836,37 @@ flate_write(FILE  *out,			/* I - Output file */
       if (status < Z_OK && status != Z_BUF_ERROR)
       {
 	progress_error(HD_ERROR_OUT_OF_MEMORY, "deflate() failed (%d)", status);
+	stats_end(HD_STATS_COMPRESS);
 	return;
       }
 
       flush = 0;
     }
+
+    stats_end(HD_STATS_COMPRESS);
   }
   else if (Encryption && !PSLevel)
   {
-    int		i,		// Looping var
+    size_t	i,		// Looping var
 		bytes;		// Number of bytes to encrypt/write
     uchar	newbuf[1024];	// New encrypted data buffer
 
 
     for (i = 0; i < length; i += sizeof(newbuf))
     {
-      if ((bytes = length - i) > (int)sizeof(newbuf))
+      if ((bytes = length - i) > sizeof(newbuf))
         bytes = sizeof(newbuf);
 
-      rc4_encrypt(&encrypt_state, buf + i, newbuf, (size_t)bytes);
-      fwrite(newbuf, (size_t)bytes, 1, out);
+      rc4_encrypt(&encrypt_state, buf + i, newbuf, bytes);
+      fwrite(newbuf, bytes, 1, out);
     }
   }
   else if (PSLevel)
 #ifdef HTMLDOC_ASCII85
-    ps_ascii85(out, buf, length);
+    ps_ascii85(out, &ascii85_state, buf, length);
 #else
     ps_hex(out, buf, length);
 #endif // HTMLDOC_ASCII85
   else
-    fwrite(buf, (size_t)length, 1, out);
+    fwrite(buf, length, 1, out);
 }
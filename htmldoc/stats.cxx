@@ -0,0 +1,343 @@
+/*
+ * Statistics functions for HTMLDOC, a HTML document processing program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+/*
+ * Include necessary headers.
+ */
+
+#include "htmldoc.h"
+#include <time.h>
+
+#ifndef WIN32
+#  include <sys/time.h>
+#  include <sys/resource.h>
+#endif // !WIN32
+
+
+/*
+ * Local globals...
+ */
+
+static int	stats_enabled = 0;	// Collect statistics?
+static int	stats_active[HD_STATS_MAX];
+					// Number of threads in each phase
+static long	stats_calls[HD_STATS_MAX];
+					// Number of times each phase ran
+static double	stats_start_wall[HD_STATS_MAX],
+					// Start of current phase
+		stats_wall[HD_STATS_MAX],
+					// Total time in each phase
+		stats_cpu[HD_STATS_MAX];
+static long long stats_counters[HD_COUNT_MAX];
+					// Counters
+static int	stats_max_chapter = -1;	// Highest chapter formatted
+static double	stats_chapter_wall[MAX_CHAPTERS],
+					// Layout time for each chapter
+		stats_chapter_cpu[MAX_CHAPTERS];
+static hd_mutex_t stats_mutex = HD_MUTEX_INITIALIZER;
+					// Lock for counters and chapter times
+
+// Phases and chapters can run on several threads at once...
+static HD_THREAD_LOCAL int stats_depth[HD_STATS_MAX];
+					// Nesting depth of each phase
+static HD_THREAD_LOCAL double stats_start_cpu[HD_STATS_MAX];
+					// Thread CPU time at start of phase
+static HD_THREAD_LOCAL int stats_cur_chapter = -1;
+					// Current chapter being formatted
+static HD_THREAD_LOCAL double stats_chapter_start_wall,
+					// Start of current chapter
+		stats_chapter_start_cpu;
+
+static const char * const stats_phases[HD_STATS_MAX] =
+{					// Phase names
+  "fetch",
+  "parse",
+  "toc",
+  "layout",
+  "images",
+  "fonts",
+  "compress",
+  "write"
+};
+static const char * const stats_names[HD_COUNT_MAX] =
+{					// Counter names
+  "nodes",
+  "renders",
+  "pages",
+  "objects",
+  "bytes_in",
+  "bytes_out",
+  "cache_hits"
+};
+
+
+/*
+ * Local functions...
+ */
+
+static double	stats_cpu_time(void);
+static void	stats_end_chapter(void);
+static long	stats_max_rss(void);
+static double	stats_thread_time(void);
+static double	stats_wall_time(void);
+
+
+/*
+ * 'stats_begin()' - Start timing a phase.
+ *
+ * Phases can be nested, e.g. image decoding happens during layout, so the
+ * reported times overlap.  Recursive calls for the same phase are only
+ * counted once.
+ *
+ * A phase can run on several threads at once.  The wall clock time is the
+ * time during which at least one thread was in the phase, and the CPU time
+ * is the sum of the CPU time each thread spent in it.
+ */
+
+void
+stats_begin(HDstats phase)		// I - Phase
+{
+  if (!stats_enabled || stats_depth[phase] ++ > 0)
+    return;
+
+  stats_start_cpu[phase] = stats_thread_time();
+
+  hd_mutex_lock(&stats_mutex);
+  stats_calls[phase] ++;
+  if (stats_active[phase] ++ == 0)
+    stats_start_wall[phase] = stats_wall_time();
+  hd_mutex_unlock(&stats_mutex);
+}
+
+
+/*
+ * 'stats_chapter()' - Start timing the layout of a chapter.
+ *
+ * Chapter times are tracked separately for each thread.  Pass -1 to stop
+ * timing the current chapter.
+ */
+
+void
+stats_chapter(int chapter)		// I - Chapter number (0 for the TOC)
+{
+  if (!stats_enabled)
+    return;
+
+  stats_end_chapter();
+
+  if (chapter < 0 || chapter >= MAX_CHAPTERS)
+    return;
+
+  stats_cur_chapter        = chapter;
+  stats_chapter_start_wall = stats_wall_time();
+  stats_chapter_start_cpu  = stats_thread_time();
+
+  hd_mutex_lock(&stats_mutex);
+  if (chapter > stats_max_chapter)
+    stats_max_chapter = chapter;
+  hd_mutex_unlock(&stats_mutex);
+}
+
+
+/*
+ * 'stats_count()' - Add to a counter.
+ */
+
+void
+stats_count(HDcount   counter,		// I - Counter
+            long long value)		// I - Value to add
+{
+  if (!stats_enabled)
+    return;
+
+  hd_mutex_lock(&stats_mutex);
+  stats_counters[counter] += value;
+  hd_mutex_unlock(&stats_mutex);
+}
+
+
+/*
+ * 'stats_enable()' - Enable collection of statistics.
+ */
+
+void
+stats_enable(void)
+{
+  stats_enabled = 1;
+}
+
+
+/*
+ * 'stats_end()' - Stop timing a phase.
+ */
+
+void
+stats_end(HDstats phase)		// I - Phase
+{
+  double	cpu;			// CPU time used by this thread
+
+
+  if (!stats_enabled || stats_depth[phase] <= 0 || -- stats_depth[phase] > 0)
+    return;
+
+  cpu = stats_thread_time() - stats_start_cpu[phase];
+
+  hd_mutex_lock(&stats_mutex);
+  stats_cpu[phase] += cpu;
+  if (-- stats_active[phase] == 0)
+    stats_wall[phase] += stats_wall_time() - stats_start_wall[phase];
+  hd_mutex_unlock(&stats_mutex);
+
+  if (phase == HD_STATS_LAYOUT)
+    stats_end_chapter();
+}
+
+
+/*
+ * 'stats_write()' - Write the collected statistics as a JSON file.
+ */
+
+int					// O - 1 on success, 0 on failure
+stats_write(const char *filename,	// I - JSON filename
+            double     elapsed)		// I - Total elapsed time in seconds
+{
+  FILE	*fp;				// JSON file
+  int	i;				// Looping var
+
+
+  if (!stats_enabled)
+    return (0);
+
+  if ((fp = fopen(filename, "w")) == NULL)
+  {
+    progress_error(HD_ERROR_WRITE_ERROR, "Unable to create statistics file '%s': %s", filename, strerror(errno));
+    return (0);
+  }
+
+  fputs("{\n", fp);
+  fputs("  \"version\": \"" SVERSION "\",\n", fp);
+  fprintf(fp, "  \"total\": { \"wall\": %.6f, \"cpu\": %.6f, \"max_rss\": %ld },\n", elapsed, stats_cpu_time(), stats_max_rss());
+
+  fputs("  \"phases\": {\n", fp);
+  for (i = 0; i < HD_STATS_MAX; i ++)
+    fprintf(fp, "    \"%s\": { \"wall\": %.6f, \"cpu\": %.6f, \"calls\": %ld }%s\n", stats_phases[i], stats_wall[i], stats_cpu[i], stats_calls[i], i < (HD_STATS_MAX - 1) ? "," : "");
+  fputs("  },\n", fp);
+
+  fputs("  \"chapters\": [\n", fp);
+  for (i = 0; i <= stats_max_chapter; i ++)
+    fprintf(fp, "    { \"chapter\": %d, \"wall\": %.6f, \"cpu\": %.6f }%s\n", i, stats_chapter_wall[i], stats_chapter_cpu[i], i < stats_max_chapter ? "," : "");
+  fputs("  ],\n", fp);
+
+  fputs("  \"counters\": {\n", fp);
+  for (i = 0; i < HD_COUNT_MAX; i ++)
+    fprintf(fp, "    \"%s\": %lld%s\n", stats_names[i], stats_counters[i], i < (HD_COUNT_MAX - 1) ? "," : "");
+  fputs("  }\n", fp);
+  fputs("}\n", fp);
+
+  if (fclose(fp))
+  {
+    progress_error(HD_ERROR_WRITE_ERROR, "Unable to write statistics file '%s': %s", filename, strerror(errno));
+    return (0);
+  }
+
+  return (1);
+}
+
+
+/*
+ * 'stats_cpu_time()' - Get the CPU time used by the process in seconds.
+ */
+
+static double				// O - Number of seconds
+stats_cpu_time(void)
+{
+  return ((double)clock() / CLOCKS_PER_SEC);
+}
+
+
+/*
+ * 'stats_end_chapter()' - Finish timing the current chapter, if any.
+ */
+
+static void
+stats_end_chapter(void)
+{
+  if (stats_cur_chapter < 0)
+    return;
+
+  hd_mutex_lock(&stats_mutex);
+  stats_chapter_wall[stats_cur_chapter] += stats_wall_time() - stats_chapter_start_wall;
+  stats_chapter_cpu[stats_cur_chapter]  += stats_thread_time() - stats_chapter_start_cpu;
+  hd_mutex_unlock(&stats_mutex);
+
+  stats_cur_chapter = -1;
+}
+
+
+/*
+ * 'stats_max_rss()' - Get the peak resident set size in kilobytes.
+ */
+
+static long				// O - Peak RSS in kilobytes or 0 if unknown
+stats_max_rss(void)
+{
+#ifdef WIN32
+  return (0);
+#else
+  struct rusage	usage;			// Resource usage
+
+
+  if (getrusage(RUSAGE_SELF, &usage))
+    return (0);
+
+#  ifdef __APPLE__
+  return ((long)(usage.ru_maxrss / 1024));
+#  else
+  return ((long)usage.ru_maxrss);
+#  endif // __APPLE__
+#endif // WIN32
+}
+
+
+/*
+ * 'stats_thread_time()' - Get the CPU time used by the current thread in
+ *                         seconds.
+ */
+
+static double				// O - Number of seconds
+stats_thread_time(void)
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+  struct timespec	curtime;	// Current time
+
+  if (!clock_gettime(CLOCK_THREAD_CPUTIME_ID, &curtime))
+    return (curtime.tv_sec + curtime.tv_nsec * 0.000000001);
+#endif // CLOCK_THREAD_CPUTIME_ID
+
+  return (stats_cpu_time());
+}
+
+
+/*
+ * 'stats_wall_time()' - Get the current fractional time in seconds.
+ */
+
+static double				// O - Number of seconds
+stats_wall_time(void)
+{
+#ifdef WIN32
+  return (GetTickCount() * 0.001);
+#else
+  struct timeval	curtime;	// Current time
+
+  gettimeofday(&curtime, NULL);
+
+  return (curtime.tv_sec + curtime.tv_usec * 0.000001);
+#endif // WIN32
+}
@@ -0,0 +1,69 @@
+/*
+ * Statistics function definitions for HTMLDOC, a HTML document processing
+ * program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+#ifndef _STATS_H_
+#  define _STATS_H_
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif /* __cplusplus */
+
+
+/*
+ * Timed phases...
+ */
+
+typedef enum
+{
+  HD_STATS_FETCH,			/* Finding/downloading files */
+  HD_STATS_PARSE,			/* Parsing HTML/Markdown files */
+  HD_STATS_TOC,				/* Building the table of contents */
+  HD_STATS_LAYOUT,			/* Formatting pages */
+  HD_STATS_IMAGES,			/* Decoding images */
+  HD_STATS_FONTS,			/* Embedding fonts */
+  HD_STATS_COMPRESS,			/* Compressing streams */
+  HD_STATS_WRITE,			/* Writing output files */
+  HD_STATS_MAX
+} HDstats;
+
+
+/*
+ * Counters...
+ */
+
+typedef enum
+{
+  HD_COUNT_NODES,			/* Document tree nodes */
+  HD_COUNT_RENDERS,			/* Render primitives */
+  HD_COUNT_PAGES,			/* Output pages */
+  HD_COUNT_OBJECTS,			/* PDF objects */
+  HD_COUNT_BYTES_IN,			/* Bytes read from input files */
+  HD_COUNT_BYTES_OUT,			/* Bytes written to output files */
+  HD_COUNT_CACHE_HITS,			/* Image/web/tree cache hits */
+  HD_COUNT_MAX
+} HDcount;
+
+
+/*
+ * Prototypes...
+ */
+
+extern void	stats_begin(HDstats phase);
+extern void	stats_chapter(int chapter);
+extern void	stats_count(HDcount counter, long long value);
+extern void	stats_enable(void);
+extern void	stats_end(HDstats phase);
+extern int	stats_write(const char *filename, double elapsed);
+
+#  ifdef __cplusplus
+}
+#  endif /* __cplusplus */
+
+#endif /* !_STATS_H_ */
@@ -9,6 +9,7 @@
 //
 
 #include "hdstring.h"
+#include "thread.h"
 
 
 //
@@ -18,12 +19,15 @@
 size_t	num_strings = 0,		// Number of active strings
 	alloc_strings = 0;		// Number of allocated pointers
 char	**strings = NULL;		// String pool
+static hd_mutex_t strings_mutex = HD_MUTEX_INITIALIZER;
+					// Lock for string pool
 
 
 //
 // Local functions...
 //
 
+static char	*add_string(const char *s);
 static size_t	find_string(const char *s, int *rdiff);
 
 
@@ -113,66 +117,17 @@ hd_strcpy(char       *dst,		// I - Destination string
 char *					// O - New string pointer
 hd_strdup(const char *s)		// I - String to duplicate
 {
-  char		*news;			// New string
-  size_t	idx;			// Index into strings
-  int		diff;			// Different
+  char	*news;				// New string
 
 
   // Range check input...
   if (!s)
     return (NULL);
 
-  // See if the string has already been added...
-  if (num_strings > 0)
-  {
-    idx = find_string(s, &diff);
-    if (diff == 0)
-      return (strings[idx]);
-  }
-  else
-  {
-    idx  = 0;
-    diff = -1;
-  }
-
-  // Not already added, so add it...
-#ifdef HAVE_STRDUP
-  if ((news = strdup(s)) == NULL)
-    return (NULL);
-
-#else
-  size_t slen = strlen(s);		// Length of string
-
-  if ((news = malloc(slen + 1)) == NULL)
-    return (NULL);
-
-  memcpy(news, s, slen + 1);
-#endif // HAVE_STRDUP
-
-  if (num_strings >= alloc_strings)
-  {
-    // Expand the string array...
-    char **temp = (char **)realloc(strings, (alloc_strings + 128) * sizeof(char *));
-
-    if (!temp)
-    {
-      free(news);
-      return (NULL);
-    }
-
-    strings       = temp;
-    alloc_strings += 128;
-  }
-
-  // Insert the string...
-  if (diff > 0)
-    idx ++;
-
-  if (idx < num_strings)
-    memmove(strings + idx + 1, strings + idx, (num_strings - idx) * sizeof(char *));
-
-  strings[idx] = news;
-  num_strings ++;
+  // The pool is shared by all layout threads...
+  hd_mutex_lock(&strings_mutex);
+  news = add_string(s);
+  hd_mutex_unlock(&strings_mutex);
 
   return (news);
 }
@@ -290,6 +245,74 @@ hd_strlcpy(char       *dst,		// O - Destination string
 #endif // !HAVE_STRLCPY
 
 
+//
+// 'add_string()' - Add a string to the string pool.
+//
+
+static char *				// O - New string pointer
+add_string(const char *s)		// I - String to add
+{
+  char		*news;			// New string
+  size_t	idx;			// Index into strings
+  int		diff;			// Different
+
+
+  // See if the string has already been added...
+  if (num_strings > 0)
+  {
+    idx = find_string(s, &diff);
+    if (diff == 0)
+      return (strings[idx]);
+  }
+  else
+  {
+    idx  = 0;
+    diff = -1;
+  }
+
+  // Not already added, so add it...
+#ifdef HAVE_STRDUP
+  if ((news = strdup(s)) == NULL)
+    return (NULL);
+
+#else
+  size_t slen = strlen(s);		// Length of string
+
+  if ((news = malloc(slen + 1)) == NULL)
+    return (NULL);
+
+  memcpy(news, s, slen + 1);
+#endif // HAVE_STRDUP
+
+  if (num_strings >= alloc_strings)
+  {
+    // Expand the string array...
+    char **temp = (char **)realloc(strings, (alloc_strings + 128) * sizeof(char *));
+
+    if (!temp)
+    {
+      free(news);
+      return (NULL);
+    }
+
+    strings       = temp;
+    alloc_strings += 128;
+  }
+
+  // Insert the string...
+  if (diff > 0)
+    idx ++;
+
+  if (idx < num_strings)
+    memmove(strings + idx + 1, strings + idx, (num_strings - idx) * sizeof(char *));
+
+  strings[idx] = news;
+  num_strings ++;
+
+  return (news);
+}
+
+
 //
 // 'find_string()' - Find an element in the array.
 //
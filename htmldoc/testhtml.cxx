@@ -15,11 +15,14 @@
 
 #define _HTMLDOC_CXX_
 #include "htmldoc.h"
+#include <time.h>
 
 
 void	prefs_load(void) { }
 void	prefs_save(void) { }
 
+static void	benchmark(FILE *fp, const char *filename, int count);
+static FILE	*dense_file(void);
 static void     show_tree(tree_t *t, int indent);
 
 
@@ -38,6 +41,7 @@ main(int  argc,			/* I - Number of command-line arguments */
 		*toc;		/* Table of contents */
   char		base[1024];	/* Base directory */
   int           tree = 0;       /* Show parsing tree */
+  int		bench = 0;	/* Number of benchmark iterations */
 
 
 #ifdef DEBUG
@@ -126,20 +130,34 @@ main(int  argc,			/* I - Number of command-line arguments */
 
   if (argc < 2)
   {
-    fputs("Usage: testhtml [--tree] filename.html\n", stderr);
+    fputs("Usage: testhtml [--bench count] [--tree] filename.html\n", stderr);
     return (1);
   };
 
   for (i = 1, doc = NULL; i < argc; i ++)
   {
-    if (!strcmp(argv[i], "--tree"))
+    if (!strcmp(argv[i], "--bench"))
+    {
+      i ++;
+      if (i >= argc || (bench = atoi(argv[i])) <= 0)
+      {
+        fputs("testhtml: Expected benchmark count after '--bench'.\n", stderr);
+        return (1);
+      }
+    }
+    else if (!strcmp(argv[i], "--tree"))
       tree = 1;
     else if (argv[i][0] == '-')
     {
       fprintf(stderr, "Unknown option '%s'.\n", argv[i]);
-      fputs("Usage: testhtml [--tree] filename.html\n", stderr);
+      fputs("Usage: testhtml [--bench count] [--tree] filename.html\n", stderr);
       return (1);
     }
+    else if (bench && (fp = fopen(file_find("", argv[i]), "rb")) != NULL)
+    {
+      benchmark(fp, argv[i], bench);
+      fclose(fp);
+    }
     else if ((fp = fopen(file_find("", argv[i]), "r")) != NULL)
     {
       strlcpy(base, argv[i], sizeof(base));
@@ -170,6 +188,18 @@ main(int  argc,			/* I - Number of command-line arguments */
     }
   }
 
+  if (bench)
+  {
+    // Without input files, time a generated entity- and tag-dense document...
+    if (doc == NULL && (fp = dense_file()) != NULL)
+    {
+      benchmark(fp, "(generated)", bench);
+      fclose(fp);
+    }
+
+    return (0);
+  }
+
   if (doc != NULL)
   {
     toc = toc_build(doc);
@@ -192,6 +222,69 @@ main(int  argc,			/* I - Number of command-line arguments */
 }
 
 
+/*
+ * 'benchmark()' - Time repeated parsing of a file.
+ */
+
+static void
+benchmark(FILE       *fp,		/* I - Input file */
+          const char *filename,		/* I - Name of file */
+          int        count)		/* I - Number of iterations */
+{
+  int		i;			/* Looping var */
+  clock_t	start;			/* Start time */
+  double	secs;			/* Elapsed CPU time */
+  tree_t	*t;			/* HTML markup tree */
+
+
+  start = clock();
+
+  for (i = 0; i < count; i ++)
+  {
+    rewind(fp);
+
+    if ((t = htmlReadFile(NULL, fp, ".")) != NULL)
+      htmlDeleteTree(t);
+
+    hd_strfreeall();
+  }
+
+  secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+  printf("%s: %d iterations, %.3f seconds, %.3f ms per iteration\n", filename, count, secs, 1000.0 * secs / count);
+}
+
+
+/*
+ * 'dense_file()' - Create a temporary entity- and tag-dense document.
+ */
+
+static FILE *				/* O - Temporary file or NULL */
+dense_file(void)
+{
+  int		i;			/* Looping var */
+  FILE		*fp;			/* Temporary file */
+
+
+  if ((fp = tmpfile()) == NULL)
+  {
+    perror("testhtml: Unable to create temporary file");
+    return (NULL);
+  }
+
+  fputs("<HTML><HEAD><TITLE>Dense</TITLE></HEAD><BODY>\n<TABLE>\n", fp);
+
+  for (i = 0; i < 20000; i ++)
+    fputs("<TR><TD><B>1</B> &lt;&amp;&gt; &copy;&eacute;&Eacute;&nbsp;&mdash;</TD>"
+          "<TD><FONT COLOR=\"navy\"><I>caf&eacute;</I></FONT><BR><SPAN>&alpha;&beta;</SPAN></TD>"
+          "<td><a href=\"#r\">&raquo;</a><em>x</em><tt>&quot;y&quot;</tt></td></TR>\n", fp);
+
+  fputs("</TABLE>\n</BODY></HTML>\n", fp);
+
+  return (fp);
+}
+
+
 /*
  * 'show_tree()' - Show the parsing tree...
  */
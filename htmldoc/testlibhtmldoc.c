@@ -0,0 +1,246 @@
+/*
+ * Test program for the conversion library of HTMLDOC, a HTML document
+ * processing program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ *
+ * Usage:
+ *
+ *   ./testlibhtmldoc
+ *
+ * Set the HTMLDOC_DATA environment variable to the top-level source directory
+ * to run the tests without installing HTMLDOC.
+ */
+
+/*
+ * Include necessary headers.
+ */
+
+#include "libhtmldoc.h"
+#include "thread.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+/*
+ * Local types...
+ */
+
+typedef struct				/* Thread test data */
+{
+  hd_mutex_t	mutex;			/* Lock for errors */
+  int		errors;			/* Number of errors */
+} thread_data_t;
+
+
+/*
+ * Local globals...
+ */
+
+static const char	*test_html =	/* HTML document */
+"<html><head><title>Test</title></head><body>\n"
+"<h1>Chapter One</h1>\n"
+"<p>Hello from the conversion library.</p>\n"
+"<h1>Chapter Two</h1>\n"
+"<p>See <a href=\"#one\">the first chapter</a>.</p>\n"
+"</body></html>\n";
+static const char	*test_md =	/* Markdown document */
+"# Heading\n"
+"\n"
+"Some *emphasized* text.\n";
+
+
+/*
+ * Local functions...
+ */
+
+static int	convert(const char *name, const char *options, const char *doc, const char *prefix, const char *suffix, size_t *datalen);
+static void	convert_thread(void *data, int index);
+
+
+/*
+ * 'main()' - Main entry for test program.
+ */
+
+int					/* O - Exit status */
+main(void)
+{
+  int		errors = 0;		/* Number of errors */
+  size_t	datalen,		/* Length of output */
+		datalen2;		/* Length of second output */
+  hd_job_t	*job;			/* Conversion job */
+  void		*data;			/* Output data */
+  thread_data_t	tdata = { HD_MUTEX_INITIALIZER, 0 };
+					/* Thread test data */
+
+
+  /* PDF, PostScript, HTML, and EPUB output... */
+  errors += convert("test.html", NULL, test_html, "%PDF-1.4", "%%EOF\n", &datalen);
+  errors += convert("test.html", "-t ps2", test_html, "%!PS-Adobe-3.0", "%%EOF\n", NULL);
+  errors += convert("test.html", "-t html", test_html, "<!DOCTYPE", "</HTML>\n", NULL);
+  errors += convert("test.html", "-t epub", test_html, "PK", NULL, NULL);
+  errors += convert("test.md", "--webpage -t pdf", test_md, "%PDF-", "%%EOF\n", NULL);
+
+  /* Every conversion starts from the default options... */
+  errors += convert("test.html", NULL, test_html, "%PDF-1.4", "%%EOF\n", &datalen2);
+
+  fputs("hdConvert(repeat): ", stdout);
+  if (datalen != datalen2)
+  {
+    printf("FAIL (%lu bytes, expected %lu)\n", (unsigned long)datalen2, (unsigned long)datalen);
+    errors ++;
+  }
+  else
+    puts("PASS");
+
+  /* Conversions from multiple threads... */
+  fputs("hdConvert(threads): ", stdout);
+  fflush(stdout);
+
+  hd_thread_set_count(4);
+  hd_parallel(8, convert_thread, &tdata);
+
+  if (tdata.errors)
+  {
+    printf("FAIL (%d errors)\n", tdata.errors);
+    errors ++;
+  }
+  else
+    puts("PASS");
+
+  /* Errors... */
+  fputs("hdConvert(no files): ", stdout);
+  if ((job = hdCreateJob()) == NULL)
+  {
+    puts("FAIL (unable to create job)");
+    return (1);
+  }
+
+  if (hdConvert(job, &data, &datalen) || data || datalen)
+  {
+    puts("FAIL (conversion did not fail)");
+    errors ++;
+  }
+  else
+    puts("PASS");
+
+  fputs("hdConvert(htmlsep): ", stdout);
+  hdAddBuffer(job, "test.html", test_html, strlen(test_html));
+  hdSetOptions(job, "-t htmlsep");
+
+  if (hdConvert(job, &data, &datalen) || data || datalen)
+  {
+    puts("FAIL (conversion did not fail)");
+    errors ++;
+  }
+  else
+    puts("PASS");
+
+  hdDeleteJob(job);
+
+  if (errors)
+    printf("%d test(s) failed.\n", errors);
+  else
+    puts("All tests passed.");
+
+  return (errors > 0);
+}
+
+
+/*
+ * 'convert()' - Convert a document and check the output.
+ */
+
+static int				/* O - 0 on success, 1 on failure */
+convert(const char *name,		/* I - Document name */
+        const char *options,		/* I - Options or NULL */
+        const char *doc,		/* I - Document data */
+        const char *prefix,		/* I - Expected start of output */
+        const char *suffix,		/* I - Expected end of output or NULL */
+        size_t     *datalen)		/* O - Length of output or NULL */
+{
+  int		status = 1;		/* Return status */
+  hd_job_t	*job;			/* Conversion job */
+  void		*data;			/* Output data */
+  size_t	length;			/* Length of output */
+  size_t	prefixlen = strlen(prefix),
+					/* Length of prefix */
+		suffixlen = suffix ? strlen(suffix) : 0;
+					/* Length of suffix */
+
+
+  printf("hdConvert(%s): ", options ? options : "defaults");
+  fflush(stdout);
+
+  if ((job = hdCreateJob()) == NULL)
+  {
+    puts("FAIL (unable to create job)");
+    return (1);
+  }
+
+  if (!hdAddBuffer(job, name, doc, strlen(doc)) || !hdSetOptions(job, options))
+    puts("FAIL (unable to add document or set options)");
+  else if (!hdConvert(job, &data, &length))
+    puts("FAIL (conversion failed)");
+  else
+  {
+    if (length < prefixlen || memcmp(data, prefix, prefixlen))
+      printf("FAIL (output does not start with \"%s\")\n", prefix);
+    else if (length < suffixlen || memcmp((char *)data + length - suffixlen, suffix, suffixlen))
+      printf("FAIL (output does not end with \"%s\")\n", suffix);
+    else
+    {
+      printf("PASS (%lu bytes)\n", (unsigned long)length);
+      status = 0;
+
+      if (datalen)
+        *datalen = length;
+    }
+
+    free(data);
+  }
+
+  hdDeleteJob(job);
+
+  return (status);
+}
+
+
+/*
+ * 'convert_thread()' - Convert a document from a worker thread.
+ */
+
+static void
+convert_thread(void *data,		/* I - Thread test data */
+               int  index)		/* I - Thread number */
+{
+  thread_data_t	*tdata = (thread_data_t *)data;
+					/* Thread test data */
+  hd_job_t	*job;			/* Conversion job */
+  void		*output = NULL;		/* Output data */
+  size_t	outputlen = 0;		/* Length of output */
+  int		error = 1;		/* Did the conversion fail? */
+
+
+  (void)index;
+
+  if ((job = hdCreateJob()) != NULL)
+  {
+    if (hdAddBuffer(job, "test.html", test_html, strlen(test_html)) && hdConvert(job, &output, &outputlen) && outputlen > 5 && !memcmp(output, "%PDF-", 5))
+      error = 0;
+
+    free(output);
+    hdDeleteJob(job);
+  }
+
+  if (error)
+  {
+    hd_mutex_lock(&tdata->mutex);
+    tdata->errors ++;
+    hd_mutex_unlock(&tdata->mutex);
+  }
+}
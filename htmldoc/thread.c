@@ -0,0 +1,467 @@
+/*
+ * Threading functions for HTMLDOC, a HTML document processing program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+/*
+ * Include necessary headers.
+ */
+
+#include "thread.h"
+#include <stdlib.h>
+
+#ifndef WIN32
+#  include <unistd.h>
+#endif /* !WIN32 */
+
+
+/*
+ * Constants...
+ */
+
+#define HD_THREAD_MAX	64		/* Maximum number of worker threads */
+#define HD_THREAD_STACK	(8 * 1024 * 1024)
+					/* Stack size for worker threads */
+
+
+/*
+ * Types...
+ */
+
+#ifdef WIN32
+typedef CONDITION_VARIABLE hd_cond_t;	/* Condition variable */
+#  define HD_COND_INITIALIZER	CONDITION_VARIABLE_INIT
+#elif defined(HAVE_PTHREAD_H)
+typedef pthread_cond_t hd_cond_t;	/* Condition variable */
+#  define HD_COND_INITIALIZER	PTHREAD_COND_INITIALIZER
+#endif /* WIN32 */
+
+typedef struct hd_work_s		/**** Parallel work queue ****/
+{
+  struct hd_work_s *prev,		/* Previous queue in pool */
+		*next_work;		/* Next queue in pool */
+  int		next,			/* Next work item */
+		count,			/* Number of work items */
+		done,			/* Number of finished work items */
+		workers,		/* Number of threads working on queue */
+		max_workers;		/* Maximum number of threads to use */
+  hd_work_cb_t	cb;			/* Work function */
+  void		*data;			/* Work function data */
+} hd_work_t;
+
+
+/*
+ * Local globals...
+ */
+
+static int			thread_count = 0;
+					/* Number of threads, 0 = automatic */
+static HD_THREAD_LOCAL int	thread_worker = 0;
+					/* Non-zero in worker threads */
+
+#if defined(WIN32) || defined(HAVE_PTHREAD_H)
+static hd_mutex_t		pool_mutex = HD_MUTEX_INITIALIZER;
+					/* Lock for the worker pool */
+static hd_cond_t		pool_cond = HD_COND_INITIALIZER,
+					/* Signaled when work is queued */
+				pool_done = HD_COND_INITIALIZER;
+					/* Signaled when a queue is finished */
+static int			pool_threads = 0;
+					/* Number of worker threads */
+static hd_work_t		*pool_first = NULL,
+					/* First queue in pool */
+				*pool_last = NULL;
+					/* Last queue in pool */
+#endif /* WIN32 || HAVE_PTHREAD_H */
+
+
+/*
+ * Local functions...
+ */
+
+#if defined(WIN32) || defined(HAVE_PTHREAD_H)
+static void		hd_cond_broadcast(hd_cond_t *cond);
+static void		hd_cond_wait(hd_cond_t *cond, hd_mutex_t *mutex);
+#  ifdef WIN32
+static DWORD WINAPI	hd_worker(LPVOID arg);
+#  else
+static void		hd_pool_reset(void);
+static void		*hd_worker(void *arg);
+#  endif /* WIN32 */
+#endif /* WIN32 || HAVE_PTHREAD_H */
+
+
+/*
+ * 'hd_mutex_lock()' - Lock a mutex.
+ */
+
+void
+hd_mutex_lock(hd_mutex_t *mutex)	/* I - Mutex */
+{
+#ifdef WIN32
+  AcquireSRWLockExclusive(mutex);
+#elif defined(HAVE_PTHREAD_H)
+  pthread_mutex_lock(mutex);
+#else
+  (void)mutex;
+#endif /* WIN32 */
+}
+
+
+/*
+ * 'hd_mutex_unlock()' - Unlock a mutex.
+ */
+
+void
+hd_mutex_unlock(hd_mutex_t *mutex)	/* I - Mutex */
+{
+#ifdef WIN32
+  ReleaseSRWLockExclusive(mutex);
+#elif defined(HAVE_PTHREAD_H)
+  pthread_mutex_unlock(mutex);
+#else
+  (void)mutex;
+#endif /* WIN32 */
+}
+
+
+/*
+ * 'hd_parallel()' - Run a function for a range of work items in parallel.
+ *
+ * The callback is called once for each index from 0 to count-1 using a pool
+ * of worker threads, and this function returns once all of the work items
+ * have been processed.  Work items are always run in worker threads (never
+ * the calling thread) when more than one thread is available so that
+ * callbacks can safely use thread-local storage.  Otherwise the work items
+ * are run sequentially in the calling thread.
+ *
+ * The worker threads are started on first use and then wait for more work,
+ * so callers can use this function for small batches of work.
+ */
+
+void
+hd_parallel(int          count,		/* I - Number of work items */
+            hd_work_cb_t cb,		/* I - Work function */
+            void         *data)		/* I - Work function data */
+{
+  int		i,			/* Looping var */
+		num_threads;		/* Number of threads to use */
+
+
+  if (count <= 0 || !cb)
+    return;
+
+  if ((num_threads = hd_thread_count()) > count)
+    num_threads = count;
+
+#if defined(WIN32) || defined(HAVE_PTHREAD_H)
+  if (num_threads > 1 && !thread_worker)
+  {
+    hd_work_t	work;			/* Work queue */
+#  ifdef HAVE_PTHREAD_H
+    pthread_t	thread;			/* Worker thread */
+    pthread_attr_t attr;		/* Thread attributes */
+    static int	atfork = 0;		/* Fork handler registered? */
+#  endif /* HAVE_PTHREAD_H */
+
+
+    hd_mutex_lock(&pool_mutex);
+
+    if (pool_threads < num_threads)
+    {
+      // Start more worker threads...
+#  ifdef HAVE_PTHREAD_H
+      if (!atfork)
+      {
+        // Child processes of a FastCGI server start with an empty pool...
+        pthread_atfork(NULL, NULL, hd_pool_reset);
+        atfork = 1;
+      }
+
+      pthread_attr_init(&attr);
+      pthread_attr_setstacksize(&attr, HD_THREAD_STACK);
+#  endif /* HAVE_PTHREAD_H */
+
+      while (pool_threads < num_threads)
+      {
+#  ifdef WIN32
+	HANDLE	thread;			/* Worker thread */
+
+	if ((thread = CreateThread(NULL, HD_THREAD_STACK, hd_worker, NULL, 0, NULL)) == NULL)
+	  break;
+
+	CloseHandle(thread);
+#  else
+	if (pthread_create(&thread, &attr, hd_worker, NULL))
+	  break;
+
+	pthread_detach(thread);
+#  endif /* WIN32 */
+
+	pool_threads ++;
+      }
+
+#  ifdef HAVE_PTHREAD_H
+      pthread_attr_destroy(&attr);
+#  endif /* HAVE_PTHREAD_H */
+    }
+
+    if (pool_threads > 0)
+    {
+      // Queue the work and wait for the workers to finish it...
+      work.prev        = pool_last;
+      work.next_work   = NULL;
+      work.next        = 0;
+      work.count       = count;
+      work.done        = 0;
+      work.workers     = 0;
+      work.max_workers = num_threads;
+      work.cb          = cb;
+      work.data        = data;
+
+      if (pool_last)
+        pool_last->next_work = &work;
+      else
+        pool_first = &work;
+
+      pool_last = &work;
+
+      hd_cond_broadcast(&pool_cond);
+
+      while (work.done < work.count)
+        hd_cond_wait(&pool_done, &pool_mutex);
+
+      if (work.prev)
+        work.prev->next_work = work.next_work;
+      else
+        pool_first = work.next_work;
+
+      if (work.next_work)
+        work.next_work->prev = work.prev;
+      else
+        pool_last = work.prev;
+
+      hd_mutex_unlock(&pool_mutex);
+      return;
+    }
+
+    hd_mutex_unlock(&pool_mutex);
+  }
+#endif /* WIN32 || HAVE_PTHREAD_H */
+
+  // Run everything in the current thread...
+  for (i = 0; i < count; i ++)
+    (*cb)(data, i);
+}
+
+
+/*
+ * 'hd_thread_count()' - Get the number of threads to use.
+ */
+
+int					/* O - Number of threads */
+hd_thread_count(void)
+{
+#if defined(WIN32) || defined(HAVE_PTHREAD_H)
+  int	count;				/* Number of threads */
+
+
+  if ((count = hd_atomic_get(&thread_count)) > 0)
+    return (count);
+
+  // Choose the number of threads once, even when called from several
+  // threads at the same time...
+  hd_mutex_lock(&pool_mutex);
+
+  if ((count = thread_count) <= 0)
+  {
+    const char	*value;			/* HTMLDOC_THREADS env variable */
+
+    count = 1;
+
+    if ((value = getenv("HTMLDOC_THREADS")) != NULL && atoi(value) > 0)
+    {
+      count = atoi(value);
+    }
+    else
+    {
+#  ifdef WIN32
+      SYSTEM_INFO	info;		/* System information */
+
+      GetSystemInfo(&info);
+      count = (int)info.dwNumberOfProcessors;
+#  elif defined(_SC_NPROCESSORS_ONLN)
+      count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#  endif /* WIN32 */
+    }
+
+    if (count < 1)
+      count = 1;
+    else if (count > HD_THREAD_MAX)
+      count = HD_THREAD_MAX;
+
+    hd_atomic_set(&thread_count, count);
+  }
+
+  hd_mutex_unlock(&pool_mutex);
+
+  return (count);
+
+#else
+  return (1);
+#endif /* WIN32 || HAVE_PTHREAD_H */
+}
+
+
+/*
+ * 'hd_thread_set_count()' - Set the number of threads to use.
+ *
+ * A count of 0 selects the number of processors (or the value of the
+ * HTMLDOC_THREADS environment variable) and a count of 1 disables threading.
+ */
+
+void
+hd_thread_set_count(int count)		/* I - Number of threads */
+{
+  if (count < 0)
+    count = 0;
+  else if (count > HD_THREAD_MAX)
+    count = HD_THREAD_MAX;
+
+  hd_atomic_set(&thread_count, count);
+}
+
+
+/*
+ * 'hd_thread_worker()' - Determine whether the current thread is a worker.
+ */
+
+int					/* O - 1 for a worker thread, 0 otherwise */
+hd_thread_worker(void)
+{
+  return (thread_worker);
+}
+
+
+#if defined(WIN32) || defined(HAVE_PTHREAD_H)
+/*
+ * 'hd_cond_broadcast()' - Wake up all threads waiting on a condition.
+ */
+
+static void
+hd_cond_broadcast(hd_cond_t *cond)	/* I - Condition variable */
+{
+#  ifdef WIN32
+  WakeAllConditionVariable(cond);
+#  else
+  pthread_cond_broadcast(cond);
+#  endif /* WIN32 */
+}
+
+
+/*
+ * 'hd_cond_wait()' - Wait for a condition.
+ */
+
+static void
+hd_cond_wait(hd_cond_t  *cond,		/* I - Condition variable */
+             hd_mutex_t *mutex)		/* I - Locked mutex */
+{
+#  ifdef WIN32
+  SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+#  else
+  pthread_cond_wait(cond, mutex);
+#  endif /* WIN32 */
+}
+
+
+#  ifdef HAVE_PTHREAD_H
+/*
+ * 'hd_pool_reset()' - Reset the worker pool in a child process.
+ *
+ * Only the forking thread exists in the child, so the pool is emptied and new
+ * worker threads are started on the next call to hd_parallel().
+ */
+
+static void
+hd_pool_reset(void)
+{
+  pthread_mutex_init(&pool_mutex, NULL);
+  pthread_cond_init(&pool_cond, NULL);
+  pthread_cond_init(&pool_done, NULL);
+
+  pool_threads = 0;
+  pool_first   = NULL;
+  pool_last    = NULL;
+}
+#  endif /* HAVE_PTHREAD_H */
+
+
+/*
+ * 'hd_worker()' - Process work items as they are queued.
+ */
+
+#  ifdef WIN32
+static DWORD WINAPI			/* O - Exit status */
+hd_worker(LPVOID arg)			/* I - Unused */
+#  else
+static void *				/* O - Exit status */
+hd_worker(void *arg)			/* I - Unused */
+#  endif /* WIN32 */
+{
+  hd_work_t	*work;			/* Work queue */
+  int		index;			/* Current work item */
+
+
+  (void)arg;
+
+  thread_worker = 1;
+
+  hd_mutex_lock(&pool_mutex);
+
+  for (;;)
+  {
+    // Find a queue that needs another thread...
+    for (work = pool_first; work; work = work->next_work)
+    {
+      if (work->next < work->count && work->workers < work->max_workers)
+        break;
+    }
+
+    if (!work)
+    {
+      hd_cond_wait(&pool_cond, &pool_mutex);
+      continue;
+    }
+
+    // Process work items until the queue is empty...
+    work->workers ++;
+
+    while (work->next < work->count)
+    {
+      index = work->next ++;
+
+      hd_mutex_unlock(&pool_mutex);
+      (*work->cb)(work->data, index);
+      hd_mutex_lock(&pool_mutex);
+
+      work->done ++;
+    }
+
+    work->workers --;
+
+    // The queue belongs to the caller of hd_parallel() and must not be used
+    // after the last work item is finished and the pool is unlocked...
+    if (work->done == work->count)
+      hd_cond_broadcast(&pool_done);
+  }
+
+  hd_mutex_unlock(&pool_mutex);
+
+  return (0);
+}
+#endif /* WIN32 || HAVE_PTHREAD_H */
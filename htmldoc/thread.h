@@ -0,0 +1,102 @@
+/*
+ * Threading function definitions for HTMLDOC, a HTML document processing
+ * program.
+ *
+ * Copyright 2026 by Michael R Sweet.
+ *
+ * This program is free software.  Distribution and use rights are outlined in
+ * the file "COPYING".
+ */
+
+#ifndef _THREAD_H_
+#  define _THREAD_H_
+
+#  include "config.h"
+
+#  ifdef WIN32
+#    include <windows.h>
+#  elif defined(HAVE_PTHREAD_H)
+#    include <pthread.h>
+#  endif /* WIN32 */
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif /* __cplusplus */
+
+
+/*
+ * Thread-local storage class for per-thread globals...
+ */
+
+#  ifdef _MSC_VER
+#    define HD_THREAD_LOCAL	__declspec(thread)
+#  else
+#    define HD_THREAD_LOCAL	__thread
+#  endif /* _MSC_VER */
+
+
+/*
+ * Mutexes...
+ */
+
+#  ifdef WIN32
+typedef SRWLOCK hd_mutex_t;		/* Mutual exclusion lock */
+#    define HD_MUTEX_INITIALIZER	SRWLOCK_INIT
+#  elif defined(HAVE_PTHREAD_H)
+typedef pthread_mutex_t hd_mutex_t;	/* Mutual exclusion lock */
+#    define HD_MUTEX_INITIALIZER	PTHREAD_MUTEX_INITIALIZER
+#  else
+typedef int hd_mutex_t;			/* Mutual exclusion lock (unused) */
+#    define HD_MUTEX_INITIALIZER	0
+#  endif /* WIN32 */
+
+
+/*
+ * Atomic flags for shared data that is loaded on demand...
+ */
+
+static inline int			/* O - Flag value */
+hd_atomic_get(const int *flag)		/* I - Flag */
+{
+#  ifdef _MSC_VER
+  return ((int)InterlockedCompareExchange((volatile LONG *)flag, 0, 0));
+#  else
+  return (__atomic_load_n(flag, __ATOMIC_ACQUIRE));
+#  endif /* _MSC_VER */
+}
+
+static inline void
+hd_atomic_set(int *flag,		/* I - Flag */
+              int value)		/* I - Flag value */
+{
+#  ifdef _MSC_VER
+  InterlockedExchange((volatile LONG *)flag, (LONG)value);
+#  else
+  __atomic_store_n(flag, value, __ATOMIC_RELEASE);
+#  endif /* _MSC_VER */
+}
+
+
+/*
+ * Work function for hd_parallel()...
+ */
+
+typedef void (*hd_work_cb_t)(void *data, int index);
+
+
+/*
+ * Prototypes...
+ */
+
+extern void	hd_mutex_lock(hd_mutex_t *mutex);
+extern void	hd_mutex_unlock(hd_mutex_t *mutex);
+extern void	hd_parallel(int count, hd_work_cb_t cb, void *data);
+extern int	hd_thread_count(void);
+extern void	hd_thread_set_count(int count);
+extern int	hd_thread_worker(void);
+
+#  ifdef __cplusplus
+}
+#  endif /* __cplusplus */
+
+#endif /* !_THREAD_H_ */
@@ -9,6 +9,7 @@
 //
 
 #include "htmldoc.h"
+#include "hash.h"
 #include <ctype.h>
 
 
@@ -59,7 +60,8 @@ format_number(int  n,			// I - Number
 		  "MM",  "MMC",  "MMCC",  "MMCCC",  "MMCD",
 		  "MMD", "MMDC", "MMDCC", "MMDCCC", "MMCM"
 		};
-  static char	buffer[1024];		// String buffer
+  static HD_THREAD_LOCAL char buffer[1024];
+					// String buffer
 
 
   switch (f)
@@ -121,14 +123,15 @@ get_color(const uchar *color,	// I - Color attribute
 	  int         defblack)	// I - Default color is black?
 {
   int		i;		// Looping vars
-  static uchar	tempcolor[8];	// Temporary holding place for hex colors
+  static HD_THREAD_LOCAL uchar tempcolor[8];
+				// Temporary holding place for hex colors
   static struct
   {
     const char	*name;		// Color name
     uchar	red,		// Red value
 		green,		// Green value
 		blue;		// Blue value
-  }		colors[] =	// Color "database"
+  }		colors[] =	// Color "database" (see "tools/makehash.py")
   {
     { "aqua",		0,   255, 255 }, // AKA Cyan
     { "black",		0,   0,   0 },
@@ -150,6 +153,7 @@ get_color(const uchar *color,	// I - Color attribute
     { "white",		255, 255, 255 },
     { "yellow",		255, 255, 0 }
   };
+  static_assert(sizeof(colors) / sizeof(colors[0]) == HD_COLOR_COUNT, "Run \"tools/makehash.py\" to update \"hash.h\".");
 
 
   // First, see if this is a hex color with a missing # in front...
@@ -213,11 +217,9 @@ get_color(const uchar *color,	// I - Color attribute
   }
   else
   {
-    for (i = 0; i < (int)(sizeof(colors) / sizeof(colors[0])); i ++)
-      if (strcasecmp(colors[i].name, (char *)color) == 0)
-	break;
+    i = hd_hash_lookup((char *)color, hd_color_disp, HD_COLOR_BUCKETS, hd_color_slots, HD_COLOR_SLOTS, 1);
 
-    if (i >= (int)(sizeof(colors) / sizeof(colors[0])))
+    if (i < 0 || strcasecmp(colors[i].name, (char *)color))
     {
       if (defblack)
         i = 1; // Black
@@ -63,6 +63,8 @@
 #define ZIPC_FILE_VERSION  0x0014	/* Version needed: 2.0 */
 
 #define ZIPC_FLAG_CMAX     0x0002	/* Maximum compression */
+#define ZIPC_FLAG_CFAST    0x0004	/* Fast compression */
+#define ZIPC_FLAG_CSUPER   0x0006	/* Super fast compression */
 #define ZIPC_FLAG_MASK     0x7fff       /* Mask for "standard" flags we want to write */
 #define ZIPC_FLAG_STREAMED 0x8000       /* Internal bit used to flag when we need to update the CRC and length fields */
 
@@ -77,6 +79,9 @@
 
 #define ZIPC_READ_SIZE     8192         /* Size of buffered read buffer */
 
+#define ZIPC_CHUNK_SIZE    131072	/* Size of parallel deflate chunks */
+#define ZIPC_CHUNK_DICT    32768	/* Size of parallel deflate dictionary */
+
 
 /*
  * Local types...
@@ -94,6 +99,16 @@ struct _zipc_s
   z_stream	stream;			/* Deflate stream for current file */
   unsigned int	modtime;		/* MS-DOS modification date/time */
   char		buffer[16384];		/* Deflate buffer */
+#ifndef ZIPC_ONLY_READ
+  int		level;			/* Compression level */
+  int		parallel;		/* Deflate large files in parallel? */
+  zipc_parallel_cb_t parallel_cb;	/* Function to run work in parallel */
+  unsigned char	*pbuffer;		/* Parallel deflate input buffer */
+  size_t	pused,			/* Bytes in parallel buffer */
+		palloc;			/* Size of parallel buffer */
+  unsigned char	pdict[ZIPC_CHUNK_DICT];	/* Tail of previous chunk */
+  size_t	pdictlen;		/* Length of previous chunk tail */
+#endif /* !ZIPC_ONLY_READ */
 #ifndef ZIPC_ONLY_WRITE
   char          *readbuffer,            /* Read buffer */
                 *readptr,               /* Current character in read buffer */
@@ -116,8 +131,30 @@ struct _zipc_file_s
   size_t        local_size;             /* Size of local header */
   size_t        compressed_pos;         /* Current read position in stream */
   size_t        uncompressed_pos;       /* Current read position in file */
+#ifndef ZIPC_ONLY_READ
+  int		buffered;		/* Buffered in memory? */
+  z_stream	*stream;		/* Deflate stream for buffered file */
+  unsigned char	*data;			/* Buffered (compressed) data */
+  size_t	data_alloc;		/* Allocated size of buffered data */
+  const char	*error;			/* Error for buffered file */
+#endif /* !ZIPC_ONLY_READ */
 };
 
+#ifndef ZIPC_ONLY_READ
+typedef struct _zipc_chunk_s		/* Parallel deflate chunk */
+{
+  const unsigned char *data;		/* Uncompressed data */
+  size_t	length;			/* Length of uncompressed data */
+  const unsigned char *dict;		/* Preset dictionary or NULL */
+  size_t	dictlen;		/* Length of dictionary */
+  int		level;			/* Compression level */
+  int		last;			/* Last chunk of file? */
+  unsigned char	*out;			/* Compressed data */
+  size_t	outlen;			/* Length of compressed data */
+  int		zstatus;		/* Deflate status */
+} zipc_chunk_t;
+#endif /* !ZIPC_ONLY_READ */
+
 
 /*
  * Local functions...
@@ -133,6 +170,11 @@ static void             zipc_xml_unescape(char *buffer);
 #endif /* !ZIPC_ONLY_WRITE */
 #ifndef ZIPC_ONLY_READ
 static zipc_file_t	*zipc_add_file(zipc_t *zc, const char *filename, int compression);
+static int		zipc_buffer_deflate(zipc_file_t *zf, int flush);
+static int		zipc_buffer_write(zipc_file_t *zf, const void *data, size_t bytes);
+static unsigned		zipc_compression_flags(int level);
+static void		zipc_deflate_chunk(void *data, int index);
+static int		zipc_deflate_chunks(zipc_file_t *zf, int last);
 static int		zipc_write(zipc_t *zc, const void *buffer, size_t bytes);
 static int		zipc_write_dir_header(zipc_t *zc, zipc_file_t *zf);
 static int		zipc_write_local_header(zipc_t *zc, zipc_file_t *zf);
@@ -192,6 +234,11 @@ zipcClose(zipc_t *zc)			/* I - ZIP container */
     free(zc->readbuffer);
 #endif /* !ZIPC_ONLY_WRITE */
 
+#ifndef ZIPC_ONLY_READ
+  if (zc->pbuffer)
+    free(zc->pbuffer);
+#endif /* !ZIPC_ONLY_READ */
+
   if (fclose(zc->fp))
     status = -1;
 
@@ -366,6 +413,69 @@ zipcCreateFile(
 }
 
 
+/*
+ * 'zipcCreateFileBuffer()' - Create a ZIP container file in memory.
+ *
+ * The "filename" value is the path within the ZIP container.  Directories are
+ * separated by the forward slash ("/").
+ *
+ * The "compressed" value determines whether the file is compressed within the
+ * container.
+ *
+ * Buffered files are written and compressed in memory using the normal
+ * @link zipcFileWrite@ and @link zipcFileFinish@ functions, which do not touch
+ * the container or any other file so different buffered files can be written
+ * concurrently from different threads.  Call @link zipcFileCommit@ to add the
+ * finished file to the container.
+ */
+
+zipc_file_t *				/* I - ZIP container file */
+zipcCreateFileBuffer(
+    zipc_t     *zc,			/* I - ZIP container */
+    const char *filename,		/* I - Filename in container */
+    int        compressed)		/* I - 0 for uncompressed, 1 for compressed */
+{
+  zipc_file_t	*zf;    		/* ZIP container file */
+
+
+  if (zc->mode != 'w')
+  {
+    zc->error = "Not opened for writing.";
+    return (NULL);
+  }
+
+  if ((zf = calloc(1, sizeof(zipc_file_t))) == NULL)
+  {
+    zc->error = strerror(errno);
+    return (NULL);
+  }
+
+  strncpy(zf->filename, filename, sizeof(zf->filename) - 1);
+
+  zf->zc             = zc;
+  zf->crc32          = crc32(0, NULL, 0);
+  zf->external_attrs = ZIPC_EXTERNAL_FILE;
+  zf->buffered       = 1;
+
+  if (compressed)
+  {
+    zf->method = ZIPC_COMP_DEFLATE;
+
+    zf->flags  = zipc_compression_flags(zc->level);
+
+    if ((zf->stream = calloc(1, sizeof(z_stream))) == NULL || deflateInit2(zf->stream, zc->level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) < 0)
+    {
+      free(zf->stream);
+      free(zf);
+      zc->error = strerror(ENOMEM);
+      return (NULL);
+    }
+  }
+
+  return (zf);
+}
+
+
 /*
  * 'zipcCreateFileWithString()' - Add a file whose contents are a string.
  *
@@ -422,6 +532,70 @@ zipcError(zipc_t *zc)			/* I - ZIP container */
 }
 
 
+#ifndef ZIPC_ONLY_READ
+/*
+ * 'zipcFileCommit()' - Add a finished buffered file to a ZIP container.
+ *
+ * The "zf" value is the one returned by the @link zipcCreateFileBuffer@
+ * function, after @link zipcFileFinish@ has been called.  The buffered file is
+ * freed, even on error.
+ */
+
+int					/* O - 0 on success, -1 on error */
+zipcFileCommit(zipc_file_t *zf)		/* I - Buffered ZIP container file */
+{
+  int		status = 0;		/* Return status */
+  zipc_t	*zc = zf->zc;		/* ZIP container */
+  zipc_file_t	*temp;			/* File in container */
+
+
+  if (!zf->buffered)
+  {
+    zc->error = "Not a buffered file.";
+    return (-1);
+  }
+
+  if (zf->error)
+  {
+    zc->error = zf->error;
+    status    = -1;
+  }
+  else if (zf->stream)
+  {
+    zc->error = "File not finished.";
+    status    = -1;
+  }
+  else if ((temp = zipc_add_file(zc, zf->filename, 0)) != NULL)
+  {
+    temp->flags             = zf->flags;
+    temp->method            = zf->method;
+    temp->crc32             = zf->crc32;
+    temp->compressed_size   = zf->compressed_size;
+    temp->uncompressed_size = zf->uncompressed_size;
+    temp->internal_attrs    = zf->internal_attrs;
+    temp->external_attrs    = zf->external_attrs;
+
+    status |= zipc_write_local_header(zc, temp);
+    if (zf->compressed_size > 0)
+      status |= zipc_write(zc, zf->data, zf->compressed_size);
+  }
+  else
+    status = -1;
+
+  if (zf->stream)
+  {
+    deflateEnd(zf->stream);
+    free(zf->stream);
+  }
+
+  free(zf->data);
+  free(zf);
+
+  return (status);
+}
+#endif /* !ZIPC_ONLY_READ */
+
+
 /*
  * 'zipcFileFinish()' - Finish writing to a file in a ZIP container.
  */
@@ -434,9 +608,27 @@ zipcFileFinish(zipc_file_t *zf)		/* I - ZIP container file */
 
 
 #ifndef ZIPC_ONLY_READ
-  if (zc->mode == 'w')
+  if (zf->buffered)
   {
-    if (zf->method != ZIPC_COMP_STORE)
+    if (zf->stream)
+    {
+      status = zipc_buffer_deflate(zf, Z_FINISH);
+
+      deflateEnd(zf->stream);
+      free(zf->stream);
+      zf->stream = NULL;
+    }
+
+    if (zf->error)
+      status = -1;
+  }
+  else if (zc->mode == 'w')
+  {
+    if (zf->method != ZIPC_COMP_STORE && zc->parallel)
+    {
+      status |= zipc_deflate_chunks(zf, 1);
+    }
+    else if (zf->method != ZIPC_COMP_STORE)
     {
       int zstatus;			/* Deflate status */
 
@@ -671,7 +863,23 @@ zipcFileWrite(zipc_file_t *zf,		/* I - ZIP container file */
   zf->uncompressed_size += bytes;
   zf->crc32             = crc32(zf->crc32, (const Bytef *)data, (unsigned)bytes);
 
-  if (zf->method == ZIPC_COMP_STORE)
+  if (zf->buffered)
+  {
+   /*
+    * Add the contents to the memory buffer...
+    */
+
+    if (zf->stream)
+    {
+      zf->stream->next_in  = (Bytef *)data;
+      zf->stream->avail_in = (uInt)bytes;
+
+      status = zipc_buffer_deflate(zf, Z_NO_FLUSH);
+    }
+    else
+      status = zipc_buffer_write(zf, data, bytes);
+  }
+  else if (zf->method == ZIPC_COMP_STORE)
   {
    /*
     * Store the contents as literal data...
@@ -680,6 +888,34 @@ zipcFileWrite(zipc_file_t *zf,		/* I - ZIP container file */
     status = zipc_write(zc, data, bytes);
     zf->compressed_size += bytes;
   }
+  else if (zc->parallel)
+  {
+   /*
+    * Buffer the contents and deflate whole chunks in parallel...
+    */
+
+    const unsigned char	*dataptr = (const unsigned char *)data;
+					/* Pointer into data */
+    size_t		count;		/* Number of bytes to copy */
+
+    while (bytes > 0)
+    {
+      if ((count = zc->palloc - zc->pused) > bytes)
+        count = bytes;
+
+      memcpy(zc->pbuffer + zc->pused, dataptr, count);
+
+      zc->pused += count;
+      dataptr   += count;
+      bytes     -= count;
+
+      if (zc->pused == zc->palloc && zipc_deflate_chunks(zf, 0))
+      {
+        status = -1;
+        break;
+      }
+    }
+  }
   else
   {
    /*
@@ -997,6 +1233,9 @@ zipcOpen(const char *filename,		/* I - Filename of container */
     return (NULL);
 
   zc->mode = *mode;
+#ifndef ZIPC_ONLY_READ
+  zc->level = Z_BEST_COMPRESSION;
+#endif /* !ZIPC_ONLY_READ */
 
 #ifndef ZIPC_ONLY_WRITE
   if (zc->mode == 'r')
@@ -1362,6 +1601,65 @@ zipcXMLGetAttribute(
 #endif /* !ZIPC_ONLY_WRITE */
 
 
+#ifndef ZIPC_ONLY_READ
+/*
+ * 'zipcSetCompression()' - Set the compression level and mode for new files.
+ *
+ * The "level" value is a zlib compression level from 0 (no compression) to 9
+ * (best compression), or -1 for the zlib default.  The default level is 9.
+ *
+ * The "threads" value specifies the number of threads that compress files.
+ * When it is greater than 1, files are compressed in 128k chunks, "threads"
+ * times two at a time, by calling the "parallel_cb" function.  The callback
+ * must call the work function once for each index from 0 to count - 1 and
+ * return when all calls have finished; the calls may run concurrently.  Each
+ * chunk is compressed independently using the end of the previous chunk as a
+ * preset dictionary and the chunks are joined with sync flushes, so the output
+ * is a single valid deflate stream that does not depend on the number of
+ * threads and is only slightly larger than a serial deflate stream.  Files
+ * smaller than a chunk produce the same output in either mode.
+ */
+
+int					/* O - 0 on success, -1 on error */
+zipcSetCompression(
+    zipc_t             *zc,		/* I - ZIP container */
+    int                level,		/* I - Compression level (0-9, -1 for default) */
+    int                threads,		/* I - Number of threads to compress with */
+    zipc_parallel_cb_t parallel_cb)	/* I - Function to run work in parallel */
+{
+  if (zc->mode != 'w')
+  {
+    zc->error = "Not opened for writing.";
+    return (-1);
+  }
+
+  if (level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION)
+  {
+    zc->error = "Bad compression level.";
+    return (-1);
+  }
+
+  zc->level = level;
+
+  if (threads > 1 && parallel_cb && !zc->pbuffer)
+  {
+    zc->palloc = (size_t)(2 * threads) * ZIPC_CHUNK_SIZE;
+
+    if ((zc->pbuffer = malloc(zc->palloc)) == NULL)
+    {
+      zc->error = strerror(errno);
+      return (-1);
+    }
+  }
+
+  zc->parallel    = threads > 1 && parallel_cb && zc->pbuffer;
+  zc->parallel_cb = parallel_cb;
+
+  return (0);
+}
+#endif /* !ZIPC_ONLY_READ */
+
+
 #ifndef ZIPC_ONLY_READ
 /*
  * 'zipc_add_file()' - Add a file to the ZIP container.
@@ -1410,14 +1708,23 @@ zipc_add_file(zipc_t     *zc,		/* I - ZIP container */
 
   if (compression)
   {
-    temp->flags  = ZIPC_FLAG_CMAX;
+    temp->flags = zipc_compression_flags(zc->level);
+
     temp->method = ZIPC_COMP_DEFLATE;
 
+    if (zc->parallel)
+    {
+      zc->pused    = 0;
+      zc->pdictlen = 0;
+
+      return (temp);
+    }
+
     zc->stream.zalloc = (alloc_func)0;
     zc->stream.zfree  = (free_func)0;
     zc->stream.opaque = (voidpf)0;
 
-    if (deflateInit2(&zc->stream, Z_BEST_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) < 0)
+    if (deflateInit2(&zc->stream, zc->level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) < 0)
     {
       zc->num_files --;
       zc->error = strerror(ENOMEM);
@@ -1430,6 +1737,256 @@ zipc_add_file(zipc_t     *zc,		/* I - ZIP container */
 
   return (temp);
 }
+
+
+/*
+ * 'zipc_buffer_deflate()' - Deflate pending data into a buffered file.
+ */
+
+static int				/* O - 0 on success, -1 on error */
+zipc_buffer_deflate(zipc_file_t *zf,	/* I - Buffered ZIP container file */
+                    int         flush)	/* I - Z_NO_FLUSH or Z_FINISH */
+{
+  int	zstatus;			/* Deflate status */
+
+
+  for (;;)
+  {
+    if (zf->data_alloc - zf->compressed_size < 1024)
+    {
+      size_t		newalloc;	/* New buffer size */
+      unsigned char	*newdata;	/* New buffer */
+
+      newalloc = zf->data_alloc ? 2 * zf->data_alloc : 16384;
+
+      if ((newdata = realloc(zf->data, newalloc)) == NULL)
+      {
+        zf->error = strerror(ENOMEM);
+        return (-1);
+      }
+
+      zf->data       = newdata;
+      zf->data_alloc = newalloc;
+    }
+
+    zf->stream->next_out  = (Bytef *)zf->data + zf->compressed_size;
+    zf->stream->avail_out = (uInt)(zf->data_alloc - zf->compressed_size);
+
+    zstatus = deflate(zf->stream, flush);
+
+    zf->compressed_size = (size_t)((unsigned char *)zf->stream->next_out - zf->data);
+
+    if (zstatus == Z_STREAM_END)
+      break;
+    else if (zstatus < Z_OK && zstatus != Z_BUF_ERROR)
+    {
+      zf->error = zipc_zlib_status(zstatus);
+      return (-1);
+    }
+    else if (flush == Z_NO_FLUSH && zf->stream->avail_in == 0 && zf->stream->avail_out > 0)
+      break;
+  }
+
+  return (0);
+}
+
+
+/*
+ * 'zipc_buffer_write()' - Append uncompressed data to a buffered file.
+ */
+
+static int				/* O - 0 on success, -1 on error */
+zipc_buffer_write(zipc_file_t *zf,	/* I - Buffered ZIP container file */
+                  const void  *data,	/* I - Data to write */
+                  size_t      bytes)	/* I - Number of bytes */
+{
+  if (zf->compressed_size + bytes > zf->data_alloc)
+  {
+    size_t		newalloc;	/* New buffer size */
+    unsigned char	*newdata;	/* New buffer */
+
+    for (newalloc = zf->data_alloc ? zf->data_alloc : 16384; newalloc < (zf->compressed_size + bytes); newalloc *= 2);
+
+    if ((newdata = realloc(zf->data, newalloc)) == NULL)
+    {
+      zf->error = strerror(ENOMEM);
+      return (-1);
+    }
+
+    zf->data       = newdata;
+    zf->data_alloc = newalloc;
+  }
+
+  memcpy(zf->data + zf->compressed_size, data, bytes);
+  zf->compressed_size += bytes;
+
+  return (0);
+}
+
+
+/*
+ * 'zipc_compression_flags()' - Get the general purpose flags for a
+ *                              compression level.
+ */
+
+static unsigned				/* O - Flags */
+zipc_compression_flags(int level)	/* I - Compression level (-1 for default) */
+{
+  if (level == Z_DEFAULT_COMPRESSION)
+    level = 6;
+
+  if (level >= 8)
+    return (ZIPC_FLAG_CMAX);
+  else if (level >= 3)
+    return (0);
+  else if (level == 2)
+    return (ZIPC_FLAG_CFAST);
+  else
+    return (ZIPC_FLAG_CSUPER);
+}
+
+
+/*
+ * 'zipc_deflate_chunk()' - Deflate a single chunk for parallel compression.
+ */
+
+static void
+zipc_deflate_chunk(void *data,		/* I - Array of chunks */
+                   int  index)		/* I - Chunk to deflate */
+{
+  zipc_chunk_t	*chunk = (zipc_chunk_t *)data + index;
+					/* Chunk to deflate */
+  z_stream	stream;			/* Deflate stream */
+
+
+  memset(&stream, 0, sizeof(stream));
+
+  if ((chunk->zstatus = deflateInit2(&stream, chunk->level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY)) < Z_OK)
+    return;
+
+  if (chunk->dictlen > 0 && (chunk->zstatus = deflateSetDictionary(&stream, chunk->dict, (uInt)chunk->dictlen)) < Z_OK)
+  {
+    deflateEnd(&stream);
+    return;
+  }
+
+ /*
+  * The output buffer is big enough for the worst case plus the sync flush
+  * marker, so a single call compresses the whole chunk...
+  */
+
+  stream.next_in   = (Bytef *)chunk->data;
+  stream.avail_in  = (uInt)chunk->length;
+  stream.next_out  = (Bytef *)chunk->out;
+  stream.avail_out = (uInt)(compressBound((uLong)chunk->length) + 64);
+
+  chunk->zstatus = deflate(&stream, chunk->last ? Z_FINISH : Z_SYNC_FLUSH);
+  chunk->outlen  = (size_t)((unsigned char *)stream.next_out - chunk->out);
+
+  if (chunk->zstatus == Z_STREAM_END || (!chunk->last && chunk->zstatus == Z_OK && stream.avail_in == 0 && stream.avail_out > 0))
+    chunk->zstatus = Z_OK;
+  else if (chunk->zstatus >= Z_OK)
+    chunk->zstatus = Z_BUF_ERROR;
+
+  deflateEnd(&stream);
+}
+
+
+/*
+ * 'zipc_deflate_chunks()' - Deflate the buffered data in parallel.
+ */
+
+static int				/* O - 0 on success, -1 on error */
+zipc_deflate_chunks(zipc_file_t *zf,	/* I - ZIP container file */
+                    int         last)	/* I - 1 if this is the end of the file */
+{
+  int		status = 0;		/* Return status */
+  zipc_t	*zc = zf->zc;		/* ZIP container */
+  int		i,			/* Looping var */
+		num_chunks;		/* Number of chunks */
+  zipc_chunk_t	*chunks,		/* Chunks */
+		*chunk;			/* Current chunk */
+  size_t	offset;			/* Offset in buffer */
+
+
+  if ((num_chunks = (int)((zc->pused + ZIPC_CHUNK_SIZE - 1) / ZIPC_CHUNK_SIZE)) == 0)
+    num_chunks = 1;			/* Empty final block */
+
+  if ((chunks = calloc((size_t)num_chunks, sizeof(zipc_chunk_t))) == NULL)
+  {
+    zc->error = strerror(errno);
+    return (-1);
+  }
+
+  for (i = 0, chunk = chunks, offset = 0; i < num_chunks; i ++, chunk ++, offset += ZIPC_CHUNK_SIZE)
+  {
+    chunk->data   = zc->pbuffer + offset;
+    chunk->length = zc->pused - offset;
+    chunk->level  = zc->level;
+    chunk->last   = last && i == (num_chunks - 1);
+
+    if (chunk->length > ZIPC_CHUNK_SIZE)
+      chunk->length = ZIPC_CHUNK_SIZE;
+
+    if (i > 0)
+    {
+      chunk->dict    = chunk->data - ZIPC_CHUNK_DICT;
+      chunk->dictlen = ZIPC_CHUNK_DICT;
+    }
+    else if (zc->pdictlen > 0)
+    {
+      chunk->dict    = zc->pdict;
+      chunk->dictlen = zc->pdictlen;
+    }
+
+    if ((chunk->out = malloc(compressBound((uLong)chunk->length) + 64)) == NULL)
+    {
+      zc->error = strerror(errno);
+      status    = -1;
+      goto cleanup;
+    }
+  }
+
+  (zc->parallel_cb)(num_chunks, zipc_deflate_chunk, chunks);
+
+ /*
+  * Write the compressed chunks in order...
+  */
+
+  for (i = 0, chunk = chunks; i < num_chunks; i ++, chunk ++)
+  {
+    if (chunk->zstatus < Z_OK)
+    {
+      zc->error = zipc_zlib_status(chunk->zstatus);
+      status    = -1;
+      break;
+    }
+
+    status |= zipc_write(zc, chunk->out, chunk->outlen);
+    zf->compressed_size += chunk->outlen;
+  }
+
+ /*
+  * Save the end of the data as the dictionary for the next chunk...
+  */
+
+  if (zc->pused >= ZIPC_CHUNK_DICT)
+  {
+    memcpy(zc->pdict, zc->pbuffer + zc->pused - ZIPC_CHUNK_DICT, ZIPC_CHUNK_DICT);
+    zc->pdictlen = ZIPC_CHUNK_DICT;
+  }
+
+  zc->pused = 0;
+
+  cleanup:
+
+  for (i = 0; i < num_chunks; i ++)
+    free(chunks[i].out);
+
+  free(chunks);
+
+  return (status);
+}
 #endif /* !ZIPC_ONLY_READ */
 
 
@@ -49,6 +49,10 @@ typedef __int64 ssize_t;
 
 typedef struct _zipc_s zipc_t;		/* ZIP container */
 typedef struct _zipc_file_s zipc_file_t;/* File/directory in ZIP container */
+typedef void (*zipc_work_cb_t)(void *data, int index);
+					/* Work function for parallel callback */
+typedef void (*zipc_parallel_cb_t)(int count, zipc_work_cb_t cb, void *data);
+					/* Run work function "count" times */
 
 
 /*
@@ -63,8 +67,10 @@ extern int		zipcClose(zipc_t *zc);
 extern int              zipcCopyFile(zipc_t *zc, const char *dstname, const char *srcname, int text, int compressed);
 extern int		zipcCreateDirectory(zipc_t *zc, const char *filename);
 extern zipc_file_t	*zipcCreateFile(zipc_t *zc, const char *filename, int compressed);
+extern zipc_file_t	*zipcCreateFileBuffer(zipc_t *zc, const char *filename, int compressed);
 extern int		zipcCreateFileWithString(zipc_t *zc, const char *filename, const char *contents);
 extern const char	*zipcError(zipc_t *zc);
+extern int		zipcFileCommit(zipc_file_t *zf);
 extern int		zipcFileFinish(zipc_file_t *zf);
 extern int              zipcFileGets(zipc_file_t *zf, char *line, size_t linesize);
 extern int		zipcFilePrintf(zipc_file_t *zf, const char *format, ...)
@@ -83,6 +89,7 @@ __attribute__ ((__format__ (__printf__, 2, 3)))
 ;
 extern zipc_t		*zipcOpen(const char *filename, const char *mode);
 extern zipc_file_t      *zipcOpenFile(zipc_t *zc, const char *filename);
+extern int		zipcSetCompression(zipc_t *zc, int level, int threads, zipc_parallel_cb_t parallel_cb);
 extern const char       *zipcXMLGetAttribute(const char *element, const char *attrname, char *buffer, size_t bufsize);
 
 #  ifdef __cplusplus
@@ -0,0 +1,108 @@
+#!/bin/sh
+#
+# Script to test the ASCII85 encoding of PostScript image data...
+#
+# Usage:
+#
+#   ./ascii85.sh [path-to-htmldoc]
+#
+# The script generates a 67x67 RGB image whose 13467 bytes (4 * 3366 + 3) of
+# pixel data, including a run of black pixels, fill the 16k output buffer of
+# the ASCII85 encoder right up to the final partial group, converts a page
+# with the image to Level 2 PostScript, and checks that the ASCII85 data
+# decodes to the original pixels.  Run it with an AddressSanitizer build of
+# HTMLDOC to check for buffer overflows.
+#
+# The test is skipped when Python 3 is not available.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if ! python3 -c "" 2>/dev/null; then
+	echo "SKIP: Python 3 is not available."
+	exit 0
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-ascii85-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the image...
+echo "Generating image..."
+cat >pixels.py <<EOF2
+def pixels():
+    data = bytearray()
+    for y in range(67):
+        for x in range(67):
+            if y * 67 + x < 218:
+                data += bytes([0, 0, 0])
+            else:
+                data += bytes([x, y, (x * y) % 255 + 1])
+    return bytes(data)
+EOF2
+
+python3 - <<EOF2
+import struct
+from pixels import pixels
+
+data = pixels()
+bmp  = bytearray()
+for y in range(66, -1, -1):
+    for x in range(67):
+        r, g, b = data[(y * 67 + x) * 3:(y * 67 + x) * 3 + 3]
+        bmp += bytes([b, g, r])
+    bmp += bytes(3)  # Pad row to a multiple of 4 bytes
+
+with open('image.bmp', 'wb') as f:
+    f.write(b'BM' + struct.pack('<IHHI', 54 + len(bmp), 0, 0, 54))
+    f.write(struct.pack('<IiiHHIIiiII', 40, 67, 67, 1, 24, 0, len(bmp), 2835, 2835, 0, 0))
+    f.write(bmp)
+EOF2
+
+echo '<html><body><img src="image.bmp"></body></html>' >image.html
+
+# Convert to PostScript...
+echo "Converting to PostScript..."
+$htmldoc --quiet --webpage -t ps2 -f image.ps image.html
+status=$?
+if test $status != 0; then
+	echo "FAIL: htmldoc exited with status $status."
+	exit 1
+fi
+
+# Decode the image data...
+python3 - <<EOF2 || exit 1
+import base64, sys
+from pixels import pixels
+
+with open('image.ps', 'rb') as f:
+    ps = f.read()
+
+start = b'/DataSource currentfile/ASCII85Decode filter>>image\n'
+if start not in ps:
+    sys.exit('FAIL: No ASCII85 image data in the PostScript file.')
+
+data = ps[ps.index(start) + len(start):]
+data = data[:data.index(b'~>')].replace(b'\n', b'')
+
+if base64.a85decode(data) != pixels():
+    sys.exit('FAIL: ASCII85 image data does not match the image.')
+EOF2
+
+echo "PASS"
+exit 0
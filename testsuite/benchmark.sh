@@ -1,26 +1,210 @@
 #!/bin/sh
 #
-# Script to benchmark the run time of HTMLDOC with various test files...
+# Script to benchmark HTMLDOC with a synthetic corpus...
 #
 # Usage:
 #
-#   ./benchmark.sh [path-to-htmldoc]
+#   ./benchmark.sh [options] [path-to-htmldoc]
 #
+# Options:
+#
+#   -b baseline.csv   Compare against CSV results saved from an earlier run
+#   -c directory      Corpus directory (default "bench-corpus")
+#   -f "formats"      Output formats to test (default "pdf ps epub html")
+#   -j                Report results as JSON instead of CSV
+#   -n iterations     Number of runs for each test (default 5)
+#   -o filename       Save results to a file instead of the standard output
+#   -s scale          Size of the generated corpus (default 1)
+#
+# Each document in the corpus is converted to each output format the given
+# number of times.  The median elapsed time, the peak resident set size, and
+# the output size are reported for every combination.  Times and memory usage
+# come from the "--stats-json" option, so no external timing program is
+# required.
+#
+# To compare two versions, save the CSV output of one run and pass it to the
+# other with the "-b" option - the change in median time is then reported as
+# a percentage, with negative numbers being faster.  The baseline must be in
+# CSV format, so do not use the "-j" option when saving it:
+#
+#   ./benchmark.sh -o base.csv /path/to/old/htmldoc
+#   ./benchmark.sh -b base.csv
+#
+
+baseline=""
+corpus="bench-corpus"
+formats="pdf ps epub html"
+json=0
+iterations=5
+output=""
+scale=1
+
+while test $# -gt 0; do
+	case "$1" in
+		-b)
+			shift
+			baseline="$1"
+			;;
+		-c)
+			shift
+			corpus="$1"
+			;;
+		-f)
+			shift
+			formats="$1"
+			;;
+		-j)
+			json=1
+			;;
+		-n)
+			shift
+			iterations="$1"
+			;;
+		-o)
+			shift
+			output="$1"
+			;;
+		-s)
+			shift
+			scale="$1"
+			;;
+		-*)
+			echo "Usage: ./benchmark.sh [-b baseline.csv] [-c directory] [-f \"formats\"] [-j] [-n iterations] [-o filename] [-s scale] [path-to-htmldoc]"
+			exit 1
+			;;
+		*)
+			break
+			;;
+	esac
+
+	shift
+done
 
 if test $# -gt 0; then
-	htmldoc="$1"
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
 else
-	htmldoc="../htmldoc/htmldoc"
+	htmldoc="`pwd`/../htmldoc/htmldoc"
 fi
 
-HTMLDOC_DATA=".."; export HTMLDOC_DATA
+if test -n "$baseline" -a ! -f "$baseline"; then
+	echo "Baseline file \"$baseline\" not found."
+	exit 1
+fi
 
-for file in *.html; do
-	echo "$file,`/usr/bin/time -p $htmldoc --quiet --webpage -f t.pdf $file 2>&1 | grep real | awk '{print $2}'`"
-done
+if test -n "$baseline" && test "`head -1 "$baseline" | cut -d, -f1-6`" != "case,format,iterations,median,max_rss,bytes"; then
+	echo "Baseline file \"$baseline\" is not a CSV report from benchmark.sh."
+	exit 1
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+
+# Generate the corpus as needed...
+if test ! -f "$corpus/scale" || test "`cat $corpus/scale`" != "$scale"; then
+	./mkcorpus.sh "$corpus" "$scale" >&2 || exit 1
+	echo "$scale" >"$corpus/scale"
+fi
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-bench-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+# Run the tests...
+echo "case,format,iterations,median,max_rss,bytes" >"$tmpdir/results.csv"
 
-for file in *.md; do
-	echo "$file,`/usr/bin/time -p $htmldoc --quiet --charset utf-8 --webpage -f t.pdf $file 2>&1 | grep real | awk '{print $2}'`"
+for file in prose.html table.html nested.html links.html images.html markdown.md; do
+	name="`basename $file | sed -e '1,$s/\.[a-z]*$//'`"
+
+	case "$file" in
+		prose.html | markdown.md)
+			mode="--book --toclevels 2"
+			;;
+		*)
+			mode="--webpage"
+			;;
+	esac
+
+	for format in $formats; do
+		case "$format" in
+			pdf)
+				type="pdf14"
+				;;
+			ps)
+				type="ps3"
+				;;
+			*)
+				type="$format"
+				;;
+		esac
+
+		echo "Testing $name ($format)..." >&2
+
+		i=0
+		rm -f "$tmpdir/times"
+		while test $i -lt $iterations; do
+			if ! (cd "$corpus"; $htmldoc --quiet --charset utf-8 $mode -t $type -f "$tmpdir/out.$format" --stats-json "$tmpdir/stats.json" $file); then
+				echo "$name ($format) failed." >&2
+				exit 1
+			fi
+
+			grep '"total"' "$tmpdir/stats.json" | sed -e '1,$s/.*"wall": \([0-9.]*\).*"max_rss": \([0-9]*\).*/\1 \2/' >>"$tmpdir/times"
+			i=`expr $i + 1`
+		done
+
+		bytes=`wc -c <"$tmpdir/out.$format" | tr -d ' '`
+
+		sort -n "$tmpdir/times" | awk -v name="$name" -v format="$format" -v bytes="$bytes" '
+{ t[NR] = $1; if ($2 > rss) rss = $2 }
+END {
+  if (NR % 2) median = t[(NR + 1) / 2];
+  else median = (t[NR / 2] + t[NR / 2 + 1]) / 2;
+  printf("%s,%s,%d,%.6f,%d,%d\n", name, format, NR, median, rss, bytes);
+}' >>"$tmpdir/results.csv"
+	done
 done
 
-echo "htmldoc.book,`/usr/bin/time -p $htmldoc --quiet --batch ../doc/htmldoc.book -f t.pdf 2>&1 | grep real | awk '{print $2}'`"
+# Compare against the baseline as needed...
+if test -n "$baseline"; then
+	awk -F, '
+FNR == 1 { next }
+NR == FNR { base[$1 "," $2] = $4; next }
+{ key = $1 "," $2 }
+key in base && base[key] > 0 { printf("%s,%.6f,%.1f\n", $0, base[key], ($4 - base[key]) * 100.0 / base[key]); next }
+{ printf("%s,,\n", $0) }' "$baseline" "$tmpdir/results.csv" | (echo "case,format,iterations,median,max_rss,bytes,baseline,change"; cat) >"$tmpdir/report.csv"
+else
+	cp "$tmpdir/results.csv" "$tmpdir/report.csv"
+fi
+
+# Write the report...
+if test $json = 1; then
+	awk -F, '
+NR == 1 { n = split($0, names, ","); print "["; next }
+{
+  if (NR > 2) print ",";
+  printf("  {");
+  for (i = 1; i <= n; i ++) {
+    if (i > 1) printf(", ");
+    if (i <= 2) printf("\"%s\": \"%s\"", names[i], $i);
+    else if ($i == "") printf("\"%s\": null", names[i]);
+    else printf("\"%s\": %s", names[i], $i);
+  }
+  printf("}");
+}
+END { print ""; print "]" }' "$tmpdir/report.csv" >"$tmpdir/report.out"
+else
+	cp "$tmpdir/report.csv" "$tmpdir/report.out"
+fi
+
+if test -n "$output"; then
+	cp "$tmpdir/report.out" "$output"
+else
+	cat "$tmpdir/report.out"
+fi
+
+exit 0
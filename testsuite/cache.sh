@@ -0,0 +1,109 @@
+#!/bin/sh
+#
+# Script to test the parsed document and layout cache...
+#
+# Usage:
+#
+#   ./cache.sh [path-to-htmldoc]
+#
+# The script converts two UTF-8 documents, one with Greek text and one with
+# Cyrillic text, to PDF using an empty cache directory.  The characters of
+# both documents are assigned 8-bit values in the order they are seen, so the
+# Cyrillic document then gets different values when it is converted on its
+# own.  Converting it on its own from the cache must produce the same PDF as
+# converting it without the cache.  The same is done for ISO-8859-1 documents
+# with character references outside of ISO-8859-1, and each check is done in
+# web page and book mode.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-cache-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the documents...
+LC_ALL=C awk 'function utf8(cp) {
+  return sprintf("%c%c", 192 + int(cp / 64), 128 + cp % 64);
+}
+BEGIN {
+  printf("<html><head><meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\"><title>Greek</title></head><body>\n<h1>Greek</h1>\n<p>") >"greek.html";
+  for (cp = 945; cp < 970; cp ++)
+    printf("%s ", utf8(cp)) >"greek.html";
+  printf("</p>\n</body></html>\n") >"greek.html";
+
+  printf("<html><head><meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\"><title>Cyrillic</title></head><body>\n<h1>Cyrillic</h1>\n<p>") >"cyrillic.html";
+  for (cp = 1072; cp < 1104; cp ++)
+    printf("%s ", utf8(cp)) >"cyrillic.html";
+  printf("</p>\n</body></html>\n") >"cyrillic.html";
+
+  printf("<html><head><title>Latin</title></head><body>\n<h1>Latin</h1>\n<p>&#945; &#946; &#8364; &#8212;</p>\n</body></html>\n") >"latin1.html";
+  printf("<html><head><title>Latin</title></head><body>\n<h1>Latin</h1>\n<p>&#8212; &#8364; &#946; &#945;</p>\n</body></html>\n") >"latin2.html";
+}'
+
+mkdir expected actual cache
+
+# Check one document...
+#
+#   check type charset first-files... -- files...
+check() {
+	type="$1"
+	charset="$2"
+	shift
+	shift
+
+	first=""
+	while test "$1" != "--"; do
+		first="$first $1"
+		shift
+	done
+	shift
+
+	echo "Converting$first ($type) with the cache..."
+	rm -rf cache/*
+	(cd actual; $htmldoc --quiet --charset $charset --cache ../cache --$type -t pdf -f first.pdf `for f in $first; do echo ../$f; done`)
+
+	echo "Converting $* ($type) without and with the cache..."
+	(cd expected; $htmldoc --quiet --charset $charset --$type -t pdf -f book.pdf `for f in $*; do echo ../$f; done`)
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	(cd actual; $htmldoc --quiet --charset $charset --cache ../cache --$type -t pdf -f book.pdf `for f in $*; do echo ../$f; done`)
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	if ! cmp -s expected/book.pdf actual/book.pdf; then
+		echo "FAIL: PDF file from the cache differs."
+		exit 1
+	fi
+}
+
+for type in webpage book; do
+	check $type utf-8 greek.html cyrillic.html -- cyrillic.html
+	check $type iso-8859-1 latin1.html latin2.html -- latin2.html
+done
+
+echo "PASS"
+exit 0
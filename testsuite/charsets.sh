@@ -0,0 +1,134 @@
+#!/bin/sh
+#
+# Script to test the built-in character sets and character set files...
+#
+# Usage:
+#
+#   ./charsets.sh [path-to-htmldoc]
+#
+# The script converts a page with all 8-bit characters to PostScript with each
+# shipped character set, once with the built-in glyph names and character sets
+# and once with HTMLDOC_CHARSETS pointing to the "data" directory so that the
+# files are loaded instead.  The output must be the same.
+#
+# It then puts changed "iso-8859-1" and "psglyphs" files in a data directory
+# and checks that they are only used from the HTMLDOC_CHARSETS directory, and
+# that character sets which are not built in are loaded from the data
+# directory.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+topdir="`pwd`/.."
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-charsets-$$"
+mkdir -p "$tmpdir/datadir/data" "$tmpdir/charsets" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+ln -s "$topdir/fonts" "$tmpdir/datadir/fonts"
+cp "$topdir/data/prolog.ps" "$tmpdir/datadir/data"
+
+charsets="`cd $topdir/data; ls cp-* iso-* koi8-r`"
+
+cd "$tmpdir"
+
+# Generate a page with all 8-bit characters...
+LC_ALL=C awk 'BEGIN {
+  printf("<html><head><title>Character Sets</title></head><body>\n");
+  for (ch = 128; ch < 256; ch ++) {
+    printf("%c ", ch);
+    if ((ch % 16) == 15)
+      printf("<br>\n");
+  }
+  printf("</body></html>\n");
+}' >chars.html
+
+# Convert with the built-in tables and the data files...
+convert() {
+	if test -n "$2"; then
+		HTMLDOC_CHARSETS="$2"; export HTMLDOC_CHARSETS
+	else
+		unset HTMLDOC_CHARSETS
+	fi
+
+	HTMLDOC_DATA="$1"; export HTMLDOC_DATA
+	$htmldoc --quiet --no-embedfonts --no-pscompression --charset $3 --webpage -t ps2 -f $4 chars.html
+}
+
+for charset in $charsets; do
+	echo "Converting with $charset..."
+
+	if ! convert "$tmpdir/datadir" "" $charset builtin.ps || ! convert "$tmpdir/datadir" "$topdir/data" $charset files.ps; then
+		echo "FAIL: Unable to convert with $charset."
+		exit 1
+	fi
+
+	if ! cmp -s files.ps builtin.ps; then
+		echo "FAIL: Built-in $charset differs from the data file."
+		exit 1
+	fi
+done
+
+# Check that changed data files are only used from the HTMLDOC_CHARSETS
+# directory...
+echo "Converting with changed data files..."
+
+sed -e '/^0xe9 /s/0x00e9/0x0152/' "$topdir/data/iso-8859-1" >datadir/data/iso-8859-1
+sed -e '/^00e8 /s/egrave/egrave.alt/' "$topdir/data/psglyphs" >datadir/data/psglyphs
+
+if ! convert "$tmpdir/datadir" "" iso-8859-1 data.ps; then
+	echo "FAIL: Unable to convert with changed data files."
+	exit 1
+fi
+
+if ! grep -q "/egrave/eacute/ecircumflex" data.ps; then
+	echo "FAIL: Changed data files were used instead of the built-in tables."
+	grep "/ecircumflex" data.ps
+	exit 1
+fi
+
+echo "Converting with HTMLDOC_CHARSETS..."
+
+cp datadir/data/iso-8859-1 datadir/data/psglyphs charsets
+
+if ! convert "$tmpdir/datadir" "$tmpdir/charsets" iso-8859-1 override.ps; then
+	echo "FAIL: Unable to convert with HTMLDOC_CHARSETS."
+	exit 1
+fi
+
+if ! grep -q "/egrave.alt/OE/ecircumflex" override.ps; then
+	echo "FAIL: Changed files in HTMLDOC_CHARSETS were not used."
+	grep "/ecircumflex" override.ps
+	exit 1
+fi
+
+# Check that other character sets are loaded from the data directory...
+echo "Converting with a custom character set..."
+
+cp datadir/data/iso-8859-1 datadir/data/custom-1
+
+if ! convert "$tmpdir/datadir" "" custom-1 custom.ps; then
+	echo "FAIL: Unable to convert with a custom character set."
+	exit 1
+fi
+
+if ! grep -q "/egrave/OE/ecircumflex" custom.ps; then
+	echo "FAIL: Custom character set was not loaded from the data directory."
+	grep "/ecircumflex" custom.ps
+	exit 1
+fi
+
+echo "PASS"
+exit 0
@@ -0,0 +1,196 @@
+#!/bin/sh
+#
+# Script to test the HTMLDOC FastCGI responder...
+#
+# Usage:
+#
+#   ./fastcgi.sh [path-to-htmldoc]
+#
+# The script serves a generated document with a local web server, starts
+# HTMLDOC with "--fastcgi", and sends requests to it with a small FastCGI
+# client.  The PDF response must arrive in full FCGI_STDOUT records of 65535
+# bytes (except the last), must be identical to the CGI mode output for the
+# same page, and must be the same when requested again on the same connection.  A request for a missing
+# page must get a "404 Not Found" response.
+#
+# The test is skipped when HTMLDOC is built without FastCGI support (which
+# requires the CUPS library) or Python 3 is not available.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if ! python3 -c "" 2>/dev/null; then
+	echo "SKIP: Python 3 is not available."
+	exit 0
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-fastcgi-$$"
+mkdir -p "$tmpdir/www" || exit 1
+
+pids=""
+trap 'test -n "$pids" && kill $pids 2>/dev/null; rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the document and the server-side options...
+echo "Generating document..."
+LC_ALL=C awk 'BEGIN {
+  printf("<html><head><title>FastCGI Test</title></head><body>\n");
+  for (c = 1; c <= 20; c ++) {
+    printf("<h1>Section %d</h1>\n", c);
+    for (p = 0; p < 20; p ++)
+      printf("<p>Paragraph %d of section %d with <a href=\"#s%d\">a link</a> and some more text to fill the line.</p>\n", p, c, c);
+  }
+  printf("</body></html>\n");
+}' >www/doc.html
+
+cat >.book <<EOF
+#HTMLDOC 1.9
+-t pdf --no-compression --header .t. --footer h.1
+EOF
+
+# Pick two free ports...
+ports="`python3 -c '
+import socket
+s1 = socket.socket(); s1.bind(("127.0.0.1", 0))
+s2 = socket.socket(); s2.bind(("127.0.0.1", 0))
+print(s1.getsockname()[1], s2.getsockname()[1])'`"
+webport="`echo $ports | awk '{print $1}'`"
+fcgiport="`echo $ports | awk '{print $2}'`"
+
+# Start the web server and FastCGI responder...
+(cd www; exec python3 -m http.server --bind 127.0.0.1 $webport) >web.log 2>&1 &
+pids="$!"
+
+# Wait for the web server to start...
+python3 -c '
+import socket, sys, time
+for i in range(50):
+    try:
+        socket.create_connection(("127.0.0.1", int(sys.argv[1]))).close()
+        break
+    except OSError:
+        time.sleep(0.1)' $webport
+
+$htmldoc --fastcgi 127.0.0.1:$fcgiport --fastcgi-workers 1 2>fastcgi.log &
+pids="$pids $!"
+
+# Get the reference output from CGI mode...
+echo "Converting in CGI mode..."
+GATEWAY_INTERFACE="CGI/1.1" SERVER_SOFTWARE="test" SERVER_NAME="127.0.0.1" SERVER_PORT="$webport" PATH_INFO="/doc.html" QUERY_STRING="" $htmldoc >cgi.out 2>cgi.log
+
+# Then send the FastCGI requests...
+echo "Converting in FastCGI mode..."
+python3 - $fcgiport $webport <<EOF
+import socket, struct, sys, time
+
+fcgiport = int(sys.argv[1])
+webport  = sys.argv[2]
+
+def record(type, id, content=b''):
+    return struct.pack('>BBHHBB', 1, type, id, len(content), 0, 0) + content
+
+def pairs(params):
+    data = b''
+    for name, value in params.items():
+        name  = name.encode()
+        value = value.encode()
+        for s in (name, value):
+            if len(s) < 128:
+                data += bytes([len(s)])
+            else:
+                data += struct.pack('>I', len(s) | 0x80000000)
+        data += name + value
+    return data
+
+def read_bytes(s, length):
+    data = b''
+    while len(data) < length:
+        buffer = s.recv(length - len(data))
+        if not buffer:
+            return None
+        data += buffer
+    return data
+
+def request(s, id, path):
+    params = { 'GATEWAY_INTERFACE': 'CGI/1.1', 'SERVER_NAME': '127.0.0.1', 'SERVER_PORT': webport, 'PATH_INFO': path, 'QUERY_STRING': '' }
+    s.sendall(record(1, id, struct.pack('>HB5x', 1, 1)) + record(4, id, pairs(params)) + record(4, id) + record(5, id))
+    output  = b''
+    records = 0
+    while True:
+        header = read_bytes(s, 8)
+        if header is None:
+            sys.exit('FAIL: Connection closed before the end of the request.')
+        version, type, rid, clength, plength, reserved = struct.unpack('>BBHHBB', header)
+        content = read_bytes(s, clength + plength)[:clength]
+        if rid != id:
+            sys.exit('FAIL: Got record for request %d, expected %d.' % (rid, id))
+        if type == 6:
+            if clength > 0:
+                output  += content
+                records += 1
+        elif type == 3:
+            return output, struct.unpack('>IB3x', content), records
+
+# Wait for the responder to start...
+for i in range(50):
+    try:
+        s = socket.create_connection(('127.0.0.1', fcgiport))
+        break
+    except OSError:
+        time.sleep(0.1)
+else:
+    sys.exit(2)
+
+cgi = open('cgi.out', 'rb').read()
+
+output, status, records = request(s, 1, '/doc.html')
+if not output.startswith(b'Content-Type: application/pdf') or not output.endswith(b'%%EOF\n'):
+    sys.exit('FAIL: Bad PDF response: %r' % output[:80])
+if status != (0, 0):
+    sys.exit('FAIL: Bad end of request status %r.' % (status,))
+if records != (len(output) + 65534) // 65535:
+    sys.exit('FAIL: PDF response (%d bytes) was sent in %d FCGI_STDOUT records.' % (len(output), records))
+if output != cgi:
+    sys.exit('FAIL: PDF response (%d bytes) differs from the CGI output (%d bytes).' % (len(output), len(cgi)))
+print('PDF response: %d bytes in %d records' % (len(output), records))
+
+again, status, records = request(s, 2, '/doc.html')
+if again != output:
+    sys.exit('FAIL: Second PDF response differs from the first.')
+
+output, status, records = request(s, 3, '/missing.html')
+if not output.startswith(b'Status: 404'):
+    sys.exit('FAIL: Bad response for a missing page: %r' % output[:80])
+EOF
+status=$?
+
+if test $status = 2; then
+	if grep -q "not supported" fastcgi.log; then
+		echo "SKIP: HTMLDOC was built without FastCGI support."
+		exit 0
+	fi
+
+	echo "FAIL: Unable to connect to the FastCGI responder."
+	cat fastcgi.log
+	exit 1
+elif test $status != 0; then
+	exit 1
+fi
+
+echo "PASS"
+exit 0
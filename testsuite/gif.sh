@@ -0,0 +1,235 @@
+#!/bin/sh
+#
+# Script to test the GIF image decoder...
+#
+# Usage:
+#
+#   ./gif.sh [path-to-htmldoc]
+#
+# The script generates an interlaced GIF image, a 256 color GIF image with a
+# transparent color whose LZW string table fills up and is reset, and a GIF
+# image whose LZW data ends partway through, converts a page with each image
+# to Level 1 PostScript, and checks that the hex image data and clipping mask
+# match the original pixels.  Pixels after the end of the truncated data use
+# the first color in the colormap.
+#
+# The test is skipped when Python 3 is not available.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if ! python3 -c "" 2>/dev/null; then
+	echo "SKIP: Python 3 is not available."
+	exit 0
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-gif-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the images...
+echo "Generating images..."
+cat >images.py <<EOF2
+import struct
+
+# name: (width, height, bits, interlace, transparent, truncate)
+IMAGES = {
+    'interlaced':  (61, 37, 4, True, None, None),
+    'transparent': (90, 70, 8, False, 5, None),
+    'truncated':   (40, 30, 4, False, None, 300),
+}
+
+
+def colormap(bits):
+    return [(i * 37 % 256, 255 - i, i * 7 % 256) for i in range(1 << bits)]
+
+
+def indices(width, height, bits):
+    # Runs of a single color followed by pseudo-random noise...
+    data = []
+    seed = width * height
+    for y in range(height):
+        for x in range(width):
+            if y < 3 or x < y:
+                data.append((x // 5 + y) % (1 << bits))
+            else:
+                seed = (seed * 1103515245 + 12345) & 0x7fffffff
+                data.append((seed >> 16) % (1 << bits))
+    return data
+
+
+def lzw(data, bits):
+    # Return the LZW bytes and a list of (end bit, pixels decoded) for each code
+    clear  = 1 << bits
+    codes  = []
+    size   = bits + 1
+    table  = {}
+    next   = clear + 2
+    pixels = 0
+    prefix = None
+
+    codes.append((clear, size, 0))
+
+    for index in data:
+        if prefix is None:
+            prefix = (index,)
+        elif prefix + (index,) in table:
+            prefix += (index,)
+        else:
+            pixels += len(prefix)
+            codes.append((table.get(prefix, prefix[0]), size, pixels))
+            if next < 4096:
+                table[prefix + (index,)] = next
+                next += 1
+                if next > (1 << size) and size < 12:
+                    size += 1
+            else:
+                codes.append((clear, size, pixels))
+                size  = bits + 1
+                table = {}
+                next  = clear + 2
+            prefix = (index,)
+
+    pixels += len(prefix)
+    codes.append((table.get(prefix, prefix[0]), size, pixels))
+    codes.append((clear + 1, size, pixels))
+
+    value  = 0
+    nbits  = 0
+    out    = bytearray()
+    counts = []
+    for code, size, pixels in codes:
+        value |= code << nbits
+        nbits += size
+        counts.append((len(out) * 8 + nbits, pixels))
+        while nbits >= 8:
+            out.append(value & 255)
+            value >>= 8
+            nbits -= 8
+    if nbits:
+        out.append(value & 255)
+
+    return bytes(out), counts
+
+
+def gif(name):
+    width, height, bits, interlace, transparent, truncate = IMAGES[name]
+    data = indices(width, height, bits)
+    rows = list(range(height))
+    if interlace:
+        rows = list(range(0, height, 8)) + list(range(4, height, 8)) + list(range(2, height, 4)) + list(range(1, height, 2))
+
+    stream, counts = lzw([data[y * width + x] for y in rows for x in range(width)], bits)
+
+    out = bytearray(b'GIF89a')
+    out += struct.pack('<HHBBB', width, height, 0x80 | (bits - 1), 0, 0)
+    for rgb in colormap(bits):
+        out += bytes(rgb)
+    if transparent is not None:
+        out += bytes([0x21, 0xf9, 4, 1, 0, 0, transparent, 0])
+    out += b',' + struct.pack('<HHHHB', 0, 0, width, height, 0x40 if interlace else 0)
+    out.append(bits)
+
+    if truncate:
+        stream = stream[:truncate]
+    for i in range(0, len(stream), 255):
+        out.append(len(stream[i:i + 255]))
+        out += stream[i:i + 255]
+
+    if truncate:
+        # Pixels that come after the last complete code use the first color...
+        count = max(pixels for end, pixels in counts if end <= truncate * 8)
+        order = [y * width + x for y in rows for x in range(width)]
+        for i in order[count:]:
+            data[i] = 0
+    else:
+        out += b'\0;'
+
+    return bytes(out), data
+EOF2
+
+python3 - <<EOF2 || exit 1
+from images import IMAGES, gif
+
+for name in IMAGES:
+    with open(name + '.gif', 'wb') as f:
+        f.write(gif(name)[0])
+    with open(name + '.html', 'w') as f:
+        f.write('<html><body><img src="%s.gif"></body></html>\n' % name)
+EOF2
+
+for name in interlaced transparent truncated; do
+	# Convert to PostScript...
+	echo "Converting $name.gif to PostScript..."
+	$htmldoc --quiet --webpage -t ps1 -f $name.ps $name.html
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	# Check the image data and mask...
+	python3 - $name <<EOF2 || exit 1
+import re, sys
+from images import IMAGES, colormap, gif
+
+name = sys.argv[1]
+width, height, bits, interlace, transparent, truncate = IMAGES[name]
+cmap = colormap(bits)
+data = gif(name)[1]
+
+with open(name + '.ps', 'r') as f:
+    ps = f.read()
+
+start = 'false 3 colorimage\n'
+if start not in ps:
+    sys.exit('FAIL: No image data in the PostScript file for %s.gif.' % name)
+
+pixels = ps[ps.index(start) + len(start):]
+pixels = bytes.fromhex(re.sub('[^0-9A-Fa-f]', '', pixels[:pixels.index('GR')]))
+
+expected = bytearray()
+for index in data:
+    expected += bytes((255, 255, 255) if index == transparent else cmap[index])
+
+if pixels != expected:
+    offset = next(i for i in range(min(len(pixels), len(expected)) + 1) if i == len(pixels) or i == len(expected) or pixels[i] != expected[i])
+    sys.exit('FAIL: Image data for %s.gif does not match at pixel (%d, %d).' % (name, offset // 3 % width, offset // 3 // width))
+
+# The clipping mask is a list of rectangles for each run of opaque pixels,
+# starting with the bottom row...
+opaque = set()
+if 'clip\n' in ps:
+    for x, y, w in re.findall(r'([0-9.]+) ([0-9.]+) ([0-9.]+) [0-9.]+ re\n', ps[ps.index('newpath\n'):ps.index('clip\n')]):
+        x = round(float(x) * width)
+        y = height - 1 - round(float(y) * height)
+        for i in range(round(float(w) * width)):
+            opaque.add((x + i, y))
+elif transparent is not None:
+    sys.exit('FAIL: No clipping mask for %s.gif.' % name)
+
+if transparent is not None:
+    for i, index in enumerate(data):
+        if ((i % width, i // width) in opaque) != (index != transparent):
+            sys.exit('FAIL: Clipping mask for %s.gif does not match at pixel (%d, %d).' % (name, i % width, i // width))
+EOF2
+done
+
+echo "PASS"
+exit 0
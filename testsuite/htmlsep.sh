@@ -0,0 +1,84 @@
+#!/bin/sh
+#
+# Script to test separated HTML output...
+#
+# Usage:
+#
+#   ./htmlsep.sh [path-to-htmldoc]
+#
+# The script converts a small document with an empty heading to separated
+# HTML files with 1 and 4 threads.  Each non-empty heading must start its own
+# file, the content after an empty heading must stay in the previous file,
+# links must point to the file containing their target, and both conversions
+# must produce the same files.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-htmlsep-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+cat >doc.html <<EOF
+<html><head><title>Sections</title></head><body>
+<h1>Introduction</h1>
+<p>Intro text.</p>
+<h1></h1>
+<p>Text after the empty heading.</p>
+<h1>Details</h1>
+<p>See the <a href="#summary">summary</a>.</p>
+<h2><a name="summary">Summary</a></h2>
+<p>Summary text.</p>
+</body></html>
+EOF
+
+for threads in 1 4; do
+	echo "Converting to separated HTML with $threads thread(s)..."
+	mkdir out$threads
+	$htmldoc --quiet --threads $threads -t htmlsep -d out$threads doc.html
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+done
+
+files="`cd out1; echo *.html`"
+if test "$files" != "Details.html Introduction.html Summary.html index.html toc.html"; then
+	echo "FAIL: Unexpected files: $files"
+	exit 1
+fi
+
+if ! grep -q "Text after the empty heading" out1/Introduction.html; then
+	echo "FAIL: Content after the empty heading is not in Introduction.html."
+	exit 1
+fi
+
+if ! grep -q 'href="Summary.html#summary"' out1/Details.html; then
+	echo "FAIL: Link in Details.html does not point to Summary.html."
+	exit 1
+fi
+
+if ! diff -r out1 out4 >/dev/null; then
+	echo "FAIL: Output with 4 threads differs from output with 1 thread."
+	diff -r out1 out4 | head -20
+	exit 1
+fi
+
+echo "PASS"
+exit 0
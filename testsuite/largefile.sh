@@ -0,0 +1,110 @@
+#!/bin/sh
+#
+# Script to stress test PDF output larger than 4GB...
+#
+# Usage:
+#
+#   ./largefile.sh [path-to-htmldoc] [number-of-images]
+#
+# The script generates a 4096x4096 24-bit BMP image, references it under
+# different names so that every copy is written as a separate image object,
+# and then checks that every cross-reference table entry in the resulting
+# PDF points at the right object.  The default of 96 images produces a PDF
+# of about 4.5GB, so make sure you have enough free disk space in $TMPDIR.
+#
+
+if test $# -gt 0; then
+	htmldoc="$1"
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if test $# -gt 1; then
+	count="$2"
+else
+	count=96
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-largefile-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Write a 32-bit little-endian integer...
+le32() {
+	printf "\\`printf %03o $(($1 & 255))`"
+	printf "\\`printf %03o $((($1 >> 8) & 255))`"
+	printf "\\`printf %03o $((($1 >> 16) & 255))`"
+	printf "\\`printf %03o $((($1 >> 24) & 255))`"
+}
+
+# Generate the image...
+echo "Generating 4096x4096 image..."
+size=`expr 4096 \* 4096 \* 3`
+(printf "BM"; le32 `expr $size + 54`; le32 0; le32 54;
+ le32 40; le32 4096; le32 4096; printf "\001\000\030\000"; le32 0; le32 $size;
+ le32 2835; le32 2835; le32 0; le32 0;
+ head -c $size /dev/urandom) >image.bmp
+
+# Generate the HTML file...
+echo "Generating HTML file with $count images..."
+(echo "<html><head><title>Large File Test</title></head><body>"
+ i=0
+ while test $i -lt $count; do
+	ln -s image.bmp image$i.bmp
+	echo "<p><img src=\"image$i.bmp\" width=\"100%\"></p><!-- PAGE BREAK -->"
+	i=`expr $i + 1`
+ done
+ echo "</body></html>") >large.html
+
+# Generate the PDF file...
+echo "Generating PDF file..."
+$htmldoc --quiet --webpage --no-compression --jpeg=0 -t pdf -f large.pdf large.html
+status=$?
+if test $status != 0; then
+	echo "FAIL: htmldoc exited with status $status."
+	exit 1
+fi
+
+bytes=`wc -c <large.pdf`
+echo "PDF file is $bytes bytes."
+if test $bytes -le 4294967296; then
+	echo "FAIL: PDF file is not larger than 4GB, try more images."
+	exit 1
+fi
+
+# Check the cross-reference table...
+echo "Checking cross-reference table..."
+xref=`tail -c 64 large.pdf | awk '/startxref/ {getline; print}'`
+if test "`dd if=large.pdf bs=4096 iflag=skip_bytes skip=$xref count=1 2>/dev/null | head -1`" != "xref"; then
+	echo "FAIL: startxref $xref does not point to the xref table."
+	exit 1
+fi
+
+dd if=large.pdf bs=65536 iflag=skip_bytes skip=$xref 2>/dev/null | awk '
+NR == 2 { count = $2 }
+NR > 3 && NR <= count + 2 { o = $1; sub(/^0+/, "", o); print NR - 3, o }' >offsets.txt
+
+errors=0
+while read object offset; do
+	obj="`dd if=large.pdf bs=64 iflag=skip_bytes skip=$offset count=1 2>/dev/null | head -1 | cut -c1-32`"
+	case "$obj" in
+		"$object 0 obj"*)
+			;;
+		*)
+			echo "FAIL: Object $object at offset $offset is \"$obj\"."
+			errors=`expr $errors + 1`
+			;;
+	esac
+done <offsets.txt
+
+if test $errors -gt 0; then
+	echo "FAIL: $errors bad cross-reference entries."
+	exit 1
+fi
+
+echo "PASS: `wc -l <offsets.txt` objects, $bytes bytes."
+exit 0
@@ -0,0 +1,100 @@
+#!/bin/sh
+#
+# Script to benchmark HTMLDOC with a large Markdown file...
+#
+# Usage:
+#
+#   ./largemarkdown.sh [path-to-htmldoc] [megabytes]
+#
+# The script generates a changelog-style Markdown document of the given size
+# (default 20MB) with a chapter for each release, a bulleted list of changes
+# with reference links to issues and commits, and the reference definitions
+# at the end of each section.  The document is then converted to HTML, which
+# is dominated by the Markdown parsing time, and to PDF.  The elapsed time and
+# peak resident set size of each conversion come from the "--stats-json"
+# option.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if test $# -gt 1; then
+	megabytes="$2"
+else
+	megabytes=20
+fi
+
+case "$megabytes" in
+	"" | *[!0-9]* | 0)
+		echo "Usage: ./largemarkdown.sh [path-to-htmldoc] [megabytes]"
+		exit 1
+		;;
+esac
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-largemarkdown-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the Markdown file...
+echo "Generating ${megabytes}MB Markdown file..."
+awk -v bytes=`expr $megabytes \* 1048576` 'BEGIN {
+  split("fixed crash when loading truncated images,improved table layout performance,added support for new page sizes,updated translations,corrected handling of nested lists,reduced memory usage for large documents", what, ",");
+  print "---";
+  print "title: Large Markdown Benchmark";
+  print "...";
+  print "";
+  print "Changes in every release, newest first.  See the [issue tracker][issues]";
+  print "for details.";
+  print "";
+  total = 200; seed = 1; issue = 1;
+  for (r = 0; total < bytes; r ++) {
+    line = sprintf("# Version %d.%d.%d\n\n", 100 - int(r / 100), int(r / 10) % 10, r % 10);
+    printf("%s", line); total += length(line);
+    for (c = 0; c < 40; c ++) {
+      seed = (seed * 1103515245 + 12345) % 2147483648;
+      line = sprintf("- The code now %s, thanks to *contributor %d* (Issue [#%d][i%d], commit [%08x][c%d])\n", what[int(seed / 65536) % 6 + 1], seed % 997, issue, issue, seed, issue);
+      printf("%s", line); total += length(line);
+      issue ++;
+    }
+    print ""; total ++;
+    for (c = issue - 40; c < issue; c ++) {
+      line = sprintf("[i%d]: https://github.com/michaelrsweet/htmldoc/issues/%d\n[c%d]: https://github.com/michaelrsweet/htmldoc/commit/%d\n", c, c, c, c);
+      printf("%s", line); total += length(line);
+    }
+    print ""; total ++;
+  }
+  print "[issues]: https://github.com/michaelrsweet/htmldoc/issues";
+}' >large.md
+
+bytes=`wc -c <large.md | tr -d ' '`
+links=`grep -c '^\[[ic][0-9]*\]:' large.md`
+echo "Markdown file is $bytes bytes with $links reference links."
+
+# Convert the file...
+for format in html pdf; do
+	echo "Converting to $format..."
+	$htmldoc --quiet --charset utf-8 --book --toclevels 1 -t $format -f large.$format --stats-json stats.json large.md
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	grep '"total"' stats.json | sed -e '1,$s/.*"wall": \([0-9.]*\).*"max_rss": \([0-9]*\).*/\1 \2/' | awk -v format=$format '{ printf("%s: %.3f seconds, %d kbytes\n", format, $1, $2) }'
+done
+
+exit 0
@@ -0,0 +1,74 @@
+#!/bin/sh
+#
+# Script to test Markdown front matter...
+#
+# Usage:
+#
+#   ./markdown.sh [path-to-htmldoc]
+#
+# The script converts Markdown files with front matter to HTML.  The title in
+# the front matter must end up in the HTML title, and the text right after the
+# closing "---" line must end up in a paragraph in the body, with or without a
+# blank line in between.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-markdown-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the Markdown files...
+printf -- '---\ntitle: Front Matter\n---\nHello world\n' >text.md
+printf -- '---\ntitle: Front Matter\n---\n\nHello world\n' >blank.md
+printf -- '---\ntitle: Front Matter\n---\n: def\nmore\n' >colon.md
+
+# Convert them and check the results...
+for file in text blank colon; do
+	echo "Converting $file.md..."
+	$htmldoc --quiet --webpage -t html -f $file.html $file.md
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	if ! grep -q "<TITLE>Front Matter</TITLE>" $file.html; then
+		echo "FAIL: Missing title in $file.html."
+		exit 1
+	fi
+
+	case $file in
+		colon)
+			paragraph="<p>: def more</p>"
+			;;
+		*)
+			paragraph="<p>Hello world</p>"
+			;;
+	esac
+
+	if ! grep -q "$paragraph" $file.html; then
+		echo "FAIL: Missing \"$paragraph\" in $file.html."
+		sed -n '/<BODY/,/<\/BODY>/p' $file.html
+		exit 1
+	fi
+done
+
+echo "PASS"
+exit 0
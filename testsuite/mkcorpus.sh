@@ -0,0 +1,137 @@
+#!/bin/sh
+#
+# Script to generate a synthetic benchmark corpus for HTMLDOC...
+#
+# Usage:
+#
+#   ./mkcorpus.sh [directory] [scale]
+#
+# The scale (default 1) multiplies the size of every generated document, so a
+# scale of 10 produces 100,000 table rows, 50,000 links, and so forth.  The
+# output is deterministic so that runs on different machines and different
+# versions of HTMLDOC can be compared.
+#
+
+if test $# -gt 0; then
+	dir="$1"
+else
+	dir="corpus"
+fi
+
+if test $# -gt 1; then
+	scale="$2"
+else
+	scale=1
+fi
+
+case "$scale" in
+	"" | *[!0-9]* | 0)
+		echo "Usage: ./mkcorpus.sh [directory] [scale]"
+		exit 1
+		;;
+esac
+
+srcdir="`pwd`"
+
+mkdir -p "$dir" || exit 1
+cd "$dir" || exit 1
+
+# Long prose with chapters, sections, and inline markup...
+echo "Generating prose.html..."
+awk -v n=`expr 2000 \* $scale` 'BEGIN {
+  split("lorem ipsum dolor sit amet consectetur adipiscing elit sed do eiusmod tempor incididunt ut labore et dolore magna aliqua enim ad minim veniam quis nostrud exercitation ullamco laboris nisi aliquip ex ea commodo consequat", w, " ");
+  nw = 0; for (i in w) nw ++;
+  seed = 1;
+  print "<html><head><title>Prose Benchmark</title></head><body>";
+  for (p = 0; p < n; p ++) {
+    if ((p % 200) == 0) printf("<h1>Chapter %d</h1>\n", p / 200 + 1);
+    else if ((p % 20) == 0) printf("<h2>Section %d</h2>\n", p / 20 + 1);
+    printf("<p>");
+    for (i = 0; i < 120; i ++) {
+      seed = (seed * 1103515245 + 12345) % 2147483648;
+      word = w[int(seed / 65536) % nw + 1];
+      if ((i % 37) == 5) printf("<b>%s</b> ", word);
+      else if ((i % 41) == 9) printf("<i>%s</i> ", word);
+      else printf("%s ", word);
+    }
+    print "</p>";
+  }
+  print "</body></html>";
+}' >prose.html
+
+# Large table...
+echo "Generating table.html..."
+awk -v n=`expr 10000 \* $scale` 'BEGIN {
+  print "<html><head><title>Table Benchmark</title></head><body>";
+  print "<table border=\"1\" cellpadding=\"2\" width=\"100%\">";
+  print "<tr><th>Row</th><th>Name</th><th>Description</th><th align=\"right\">Amount</th></tr>";
+  for (r = 1; r <= n; r ++)
+    printf("<tr><td>%d</td><td>Item %d</td><td>Description of item number %d in the table</td><td align=\"right\">%d.%02d</td></tr>\n", r, r, r, (r * 37) % 10000, r % 100);
+  print "</table></body></html>";
+}' >table.html
+
+# Deeply nested tables...
+echo "Generating nested.html..."
+awk -v n=`expr 20 \* $scale` 'BEGIN {
+  print "<html><head><title>Nested Table Benchmark</title></head><body>";
+  for (t = 0; t < n; t ++) {
+    for (d = 0; d < 16; d ++)
+      printf("<table border=\"1\" cellpadding=\"2\" width=\"100%%\"><tr><td>Level %d</td><td>\n", d);
+    printf("<p>Innermost cell of nested table %d.</p>\n", t + 1);
+    for (d = 0; d < 16; d ++)
+      printf("</td></tr><tr><td colspan=\"2\">Footer %d</td></tr></table>\n", d);
+  }
+  print "</body></html>";
+}' >nested.html
+
+# Thousands of anchors and links...
+echo "Generating links.html..."
+awk -v n=`expr 5000 \* $scale` 'BEGIN {
+  print "<html><head><title>Link Benchmark</title></head><body>";
+  print "<h1>Index</h1><p>";
+  for (a = 1; a <= n; a ++)
+    printf("<a href=\"#anchor%d\">Link %d</a>\n", a, a);
+  print "</p><h1>Targets</h1>";
+  for (a = 1; a <= n; a ++)
+    printf("<p><a name=\"anchor%d\">Anchor %d</a> refers back to <a href=\"#anchor%d\">anchor %d</a>.</p>\n", a, a, (a * 7) % n + 1, (a * 7) % n + 1);
+  print "</body></html>";
+}' >links.html
+
+# Image-heavy pages...
+echo "Generating images.html..."
+for image in ducks.jpg firefox.gif logo.gif center.gif; do
+	cp "$srcdir/$image" . || exit 1
+done
+awk -v n=`expr 500 \* $scale` 'BEGIN {
+  split("ducks.jpg firefox.gif logo.gif center.gif", img, " ");
+  print "<html><head><title>Image Benchmark</title></head><body>";
+  for (i = 0; i < n; i ++)
+    printf("<p><img src=\"%s\" width=\"%d\"> Image %d</p>\n", img[i % 4 + 1], 50 + (i % 10) * 25, i + 1);
+  print "</body></html>";
+}' >images.html
+
+# Large Markdown document...
+echo "Generating markdown.md..."
+awk -v n=`expr 2000 \* $scale` 'BEGIN {
+  print "---";
+  print "title: Markdown Benchmark";
+  print "...";
+  print "";
+  for (p = 0; p < n; p ++) {
+    if ((p % 100) == 0) printf("# Chapter %d\n\n", p / 100 + 1);
+    else if ((p % 10) == 0) printf("## Section %d\n\n", p / 10 + 1);
+    if ((p % 5) == 1) {
+      printf("- First item with *emphasis* and `code`\n- Second item with a [link][ref%d]\n- Third item\n\n", p);
+    } else if ((p % 5) == 3) {
+      printf("| Column A | Column B | Column C |\n| -------- | -------- | -------- |\n| %d | %d | %d |\n| %d | %d | %d |\n\n", p, p + 1, p + 2, p + 3, p + 4, p + 5);
+    } else {
+      printf("Paragraph %d contains **strong text**, *emphasized text*, and a reference [link][ref%d] to keep the parser busy.  ", p, p);
+      printf("The quick brown fox jumps over the lazy dog while the five boxing wizards jump quickly.\n\n");
+    }
+  }
+  for (p = 0; p < n; p ++)
+    printf("[ref%d]: https://www.msweet.org/htmldoc/#ref%d\n", p, p);
+}' >markdown.md
+
+echo "Corpus generated in $dir."
+exit 0
@@ -0,0 +1,182 @@
+#!/bin/sh
+#
+# Script to test HTTP range requests for remote images...
+#
+# Usage:
+#
+#   ./range.sh [path-to-htmldoc]
+#
+# The script serves a page with a large JPEG image and a small GIF image from
+# a local web server and converts it to PDF three times.  Each time the server
+# handles range requests differently:
+#
+# - "206" honors them with "206 Partial Content";
+# - "200" ignores them and sends the whole file with "200 OK";
+# - "416" rejects them with "416 Range Not Satisfiable".
+#
+# The server logs each image request.  For each mode the script checks that:
+#
+# - layout asks for the start of each image;
+# - the JPEG data is fetched in full when the PDF is written, unless the
+#   first response already had the whole file;
+# - the GIF, which fits in the range, is only requested once when the server
+#   honors the range;
+# - a rejected range is retried once without the range.
+#
+# The three PDF files must be identical.
+#
+# The test is skipped when HTMLDOC is built without HTTP support (which
+# requires the CUPS library) or Python 3 is not available.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if ! python3 -c "" 2>/dev/null; then
+	echo "SKIP: Python 3 is not available."
+	exit 0
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-range-$$"
+mkdir -p "$tmpdir/www" || exit 1
+
+pid=""
+trap 'test -n "$pid" && kill $pid 2>/dev/null; rm -rf "$tmpdir"' 0
+
+cp ducks.jpg logo.gif "$tmpdir/www"
+cd "$tmpdir"
+
+cat >www/page.html <<EOF
+<html><head><title>Range Test</title></head><body>
+<h1>Remote Images</h1>
+<p><img src="ducks.jpg"></p>
+<p><img src="logo.gif"></p>
+</body></html>
+EOF
+
+# Start the web server...
+cat >server.py <<EOF
+import http.server, os, re, sys
+
+class Handler(http.server.BaseHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def do_GET(self):
+        mode, name = self.path.split('/')[1:3]
+        try:
+            with open(os.path.join('www', name), 'rb') as f:
+                data = f.read()
+        except OSError:
+            self.send_error(404)
+            return
+
+        drange = self.headers.get('Range')
+        status = 200
+        first  = 0
+        last   = len(data) - 1
+
+        if drange and mode == '206':
+            m = re.match(r'bytes=(\d+)-(\d*)$', drange)
+            first = int(m.group(1))
+            if m.group(2):
+                last = min(last, int(m.group(2)))
+            status = 206
+        elif drange and mode == '416':
+            status = 416
+
+        if name != 'page.html':
+            with open('requests.log', 'a') as log:
+                log.write('%s %s %s %d\n' % (mode, name, 'range' if drange else 'full', status))
+
+        self.send_response(status)
+        if status == 416:
+            self.send_header('Content-Range', 'bytes */%d' % len(data))
+            self.send_header('Content-Length', '0')
+            self.end_headers()
+            return
+
+        if status == 206:
+            self.send_header('Content-Range', 'bytes %d-%d/%d' % (first, last, len(data)))
+        self.send_header('Content-Length', str(last - first + 1))
+        self.end_headers()
+        self.wfile.write(data[first:last + 1])
+
+    def log_message(self, format, *args):
+        pass
+
+server = http.server.HTTPServer(('127.0.0.1', 0), Handler)
+with open('port', 'w') as f:
+    f.write('%d\n' % server.server_address[1])
+server.serve_forever()
+EOF
+
+python3 server.py &
+pid="$!"
+
+i=0
+while test ! -s port -a $i -lt 50; do
+	sleep 1
+	i=`expr $i + 1`
+done
+port="`cat port`"
+
+# Convert the page with each server mode...
+touch requests.log
+
+for mode in 206 200 416; do
+	echo "Converting with $mode responses to range requests..."
+	mkdir $mode
+	(cd $mode; $htmldoc --quiet --webpage -t pdf -f out.pdf http://127.0.0.1:$port/$mode/page.html) >htmldoc.log 2>&1
+	status=$?
+
+	if test ! -s requests.log; then
+		echo "SKIP: HTMLDOC was built without HTTP support."
+		exit 0
+	fi
+
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		cat htmldoc.log
+		exit 1
+	fi
+done
+
+# Check the requests...
+cat >expected.log <<EOF
+206 ducks.jpg range 206
+206 logo.gif range 206
+206 ducks.jpg full 200
+200 ducks.jpg range 200
+200 logo.gif range 200
+416 ducks.jpg range 416
+416 ducks.jpg full 200
+416 logo.gif range 416
+416 logo.gif full 200
+EOF
+
+if ! diff expected.log requests.log >/dev/null; then
+	echo "FAIL: Unexpected image requests."
+	diff expected.log requests.log
+	exit 1
+fi
+
+if ! cmp -s 206/out.pdf 200/out.pdf || ! cmp -s 206/out.pdf 416/out.pdf; then
+	echo "FAIL: PDF files differ."
+	exit 1
+fi
+
+echo "PASS"
+exit 0
@@ -0,0 +1,56 @@
+#!/bin/sh
+#
+# Script to test the HTMLDOC statistics file...
+#
+# Usage:
+#
+#   ./stats.sh [path-to-htmldoc]
+#
+# The script converts the same files with the "--stats-json" option before
+# and after the filenames.  Both statistics files must report the same,
+# non-zero number of bytes read.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-stats-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+files="basic.html table-long.html"
+
+echo "Converting with --stats-json before the files..."
+$htmldoc --quiet --stats-json "$tmpdir/first.json" --webpage -t pdf -f "$tmpdir/first.pdf" $files || exit 1
+
+echo "Converting with --stats-json after the files..."
+$htmldoc --quiet --webpage $files --stats-json "$tmpdir/last.json" -t pdf -f "$tmpdir/last.pdf" || exit 1
+
+first="`grep '"bytes_in"' "$tmpdir/first.json" | tr -dc 0-9`"
+last="`grep '"bytes_in"' "$tmpdir/last.json" | tr -dc 0-9`"
+
+if test -z "$first" -o "$first" = 0; then
+	echo "FAIL: No bytes read reported."
+	exit 1
+fi
+
+if test "$first" != "$last"; then
+	echo "FAIL: Got $last bytes read with --stats-json after the files, expected $first."
+	exit 1
+fi
+
+echo "PASS"
+exit 0
@@ -0,0 +1,83 @@
+#!/bin/sh
+#
+# Script to test inline STYLE properties...
+#
+# Usage:
+#
+#   ./style.sh [path-to-htmldoc]
+#
+# The script converts "style.html" to PostScript and checks the position and
+# color of each string:
+#
+# - "text-align: right" and "text-align: center" move the text to the right;
+# - "vertical-align: top" and "vertical-align: bottom" place the text at the
+#   top and bottom of a table cell;
+# - "background-color: red" does not change the text color.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-style-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+echo "Converting to PostScript..."
+$htmldoc --quiet --webpage -t ps2 -f "$tmpdir/style.ps" style.html
+status=$?
+if test $status != 0; then
+	echo "FAIL: htmldoc exited with status $status."
+	exit 1
+fi
+
+# Get the position and color of each string, which are written as
+# "[r g b C] [x y M](string)S"...
+LC_ALL=C awk '/\)S$/ {
+  for (i = 1; i < NF; i ++) {
+    if ($(i + 1) == "C") color = $(i - 2) " " $(i - 1) " " $i;
+    else if ($(i + 2) ~ /^M\(/) { x = $i; y = $(i + 1); }
+  }
+  text = $0;
+  sub(/^.*\(/, "", text);
+  sub(/\)S$/, "", text);
+  sub(/^ /, "", text);
+  print text "|" x "|" y "|" color;
+}' "$tmpdir/style.ps" >"$tmpdir/strings"
+
+LC_ALL=C awk -F'|' '
+{ x[$1] = $2; y[$1] = $3; color[$1] = $4; }
+END {
+  status = 0;
+  if (x["Right aligned"] <= x["Centered"] || x["Centered"] <= x["Left aligned"]) {
+    print "FAIL: text-align not honored (right=" x["Right aligned"] ", center=" x["Centered"] ", left=" x["Left aligned"] ").";
+    status = 1;
+  }
+  if (y["Top of cell"] <= y["Bottom of cell"]) {
+    print "FAIL: vertical-align not honored (top=" y["Top of cell"] ", bottom=" y["Bottom of cell"] ").";
+    status = 1;
+  }
+  if (color["Red text"] != "1.00 0.00 0.00") {
+    print "FAIL: color not honored (" color["Red text"] ").";
+    status = 1;
+  }
+  if (color["Black text"] != "0.00 0.00 0.00") {
+    print "FAIL: background-color changed the text color (" color["Black text"] ").";
+    status = 1;
+  }
+  exit status;
+}' "$tmpdir/strings" || exit 1
+
+echo "PASS"
+exit 0
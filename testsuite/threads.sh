@@ -0,0 +1,163 @@
+#!/bin/sh
+#
+# Script to test HTMLDOC output with multiple threads...
+#
+# Usage:
+#
+#   ./threads.sh [path-to-htmldoc] [iterations]
+#
+# The script generates a book of ISO-8859-1 chapters full of accented
+# characters and converts it to EPUB with 8 threads the given number of times
+# (default 5).  Every EPUB file must pass "unzip -t", which checks the CRC-32
+# of each file in the container, and must contain the same files as the EPUB
+# produced with a single thread (except for the modification time).
+#
+# It then generates a book of UTF-8 chapters with Greek and Cyrillic text and
+# converts it to PDF with 8 threads the same number of times.  Every PDF file
+# must be identical to the PDF produced with a single thread.
+#
+
+if test $# -gt 0; then
+	case "$1" in
+		/*)
+			htmldoc="$1"
+			;;
+		*)
+			htmldoc="`pwd`/$1"
+			;;
+	esac
+else
+	htmldoc="`pwd`/../htmldoc/htmldoc"
+fi
+
+if test $# -gt 1; then
+	iterations="$2"
+else
+	iterations=5
+fi
+
+HTMLDOC_DATA="`pwd`/.."; export HTMLDOC_DATA
+SOURCE_DATE_EPOCH=1700000000; export SOURCE_DATE_EPOCH
+
+tmpdir="${TMPDIR:-/tmp}/htmldoc-threads-$$"
+mkdir -p "$tmpdir" || exit 1
+trap 'rm -rf "$tmpdir"' 0
+
+cd "$tmpdir"
+
+# Generate the ISO-8859-1 chapters...
+echo "Generating ISO-8859-1 chapters..."
+LC_ALL=C awk 'BEGIN {
+  for (c = 1; c <= 16; c ++) {
+    file = sprintf("latin%02d.html", c);
+    printf("<html><head><meta http-equiv=\"Content-Type\" content=\"text/html; charset=iso-8859-1\"><title>Chapter %d</title></head><body>\n<h1>Chapter %d</h1>\n", c, c) >file;
+    for (p = 0; p < 400; p ++) {
+      printf("<p>") >file;
+      for (w = 0; w < 12; w ++) {
+        printf("%c%c%c%c ", 192 + (c + p + w) % 64, 97 + w, 224 + (c * p + w) % 32, 161 + (p + w) % 31) >file;
+      }
+      printf("</p>\n") >file;
+    }
+    printf("</body></html>\n") >file;
+    close(file);
+  }
+}'
+
+# Convert to EPUB with one thread to get the expected files...
+echo "Converting to EPUB with 1 thread..."
+mkdir expected
+$htmldoc --quiet --threads 1 --book --toclevels 1 -t epub -f expected/book.epub latin*.html
+status=$?
+if test $status != 0; then
+	echo "FAIL: htmldoc exited with status $status."
+	exit 1
+fi
+
+(cd expected; unzip -q book.epub; rm -f book.epub) || exit 1
+
+# Then convert with 8 threads and check the results...
+i=0
+while test $i -lt $iterations; do
+	i=`expr $i + 1`
+	echo "Converting to EPUB with 8 threads ($i of $iterations)..."
+
+	rm -rf actual
+	mkdir actual
+	$htmldoc --quiet --threads 8 --book --toclevels 1 -t epub -f actual/book.epub latin*.html
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	if ! unzip -tq actual/book.epub >/dev/null; then
+		echo "FAIL: Bad CRC-32 in EPUB file."
+		exit 1
+	fi
+
+	(cd actual; unzip -q book.epub; rm -f book.epub) || exit 1
+
+	if ! diff -r -I dcterms:modified expected actual >/dev/null; then
+		echo "FAIL: EPUB contents differ from the single-threaded output."
+		diff -r -I dcterms:modified expected actual | head -20
+		exit 1
+	fi
+done
+
+# Generate the UTF-8 chapters...
+echo "Generating UTF-8 chapters..."
+LC_ALL=C awk 'function utf8(cp) {
+  return sprintf("%c%c", 192 + int(cp / 64), 128 + cp % 64);
+}
+BEGIN {
+  for (c = 1; c <= 8; c ++) {
+    file = sprintf("utf8-%02d.html", c);
+    printf("<html><head><meta http-equiv=\"Content-Type\" content=\"text/html; charset=utf-8\"><title>Chapter %d</title></head><body>\n<h1>Chapter %d</h1>\n", c, c) >file;
+    for (p = 0; p < 200; p ++) {
+      printf("<p>") >file;
+      for (w = 0; w < 12; w ++) {
+        if ((c + w) % 2)
+          base = 945;			# Greek small alpha
+        else
+          base = 1072;			# Cyrillic small a
+        printf("%s%s%s ", utf8(base + (c + p + w) % 24), utf8(base + (c * p + w) % 24), utf8(base + (p * w + c) % 24)) >file;
+      }
+      printf("</p>\n") >file;
+    }
+    printf("</body></html>\n") >file;
+    close(file);
+  }
+}'
+
+# Convert to PDF with one thread to get the expected file...
+echo "Converting to PDF with 1 thread..."
+rm -rf expected actual
+mkdir expected actual
+(cd expected; $htmldoc --quiet --charset utf-8 --threads 1 --book --toclevels 1 -t pdf -f book.pdf ../utf8-*.html)
+status=$?
+if test $status != 0; then
+	echo "FAIL: htmldoc exited with status $status."
+	exit 1
+fi
+
+# Then convert with 8 threads and check the results...
+i=0
+while test $i -lt $iterations; do
+	i=`expr $i + 1`
+	echo "Converting to PDF with 8 threads ($i of $iterations)..."
+
+	(cd actual; $htmldoc --quiet --charset utf-8 --threads 8 --book --toclevels 1 -t pdf -f book.pdf ../utf8-*.html)
+	status=$?
+	if test $status != 0; then
+		echo "FAIL: htmldoc exited with status $status."
+		exit 1
+	fi
+
+	if ! cmp -s expected/book.pdf actual/book.pdf; then
+		echo "FAIL: PDF file differs from the single-threaded output."
+		exit 1
+	fi
+done
+
+echo "PASS"
+exit 0
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#
+# makecharsets.py - generate the built-in character set tables in
+#                   "htmldoc/charsets.h".
+#
+# Copyright 2026 by Michael R Sweet.
+#
+# This program is free software.  Distribution and use rights are outlined in
+# the file "COPYING".
+#
+# Usage:
+#
+#   tools/makecharsets.py >htmldoc/charsets.h
+#
+# Run this from the top-level source directory, or "make charsets" in the
+# "htmldoc" directory, whenever the PostScript glyph names in "data/psglyphs"
+# or the character set files in "data" change.  "make test" checks that
+# "htmldoc/charsets.h" matches the output of this script.  The glyph names are
+# stored in a single string pool that is indexed by offset, and each character
+# set is stored as an array of 256 Unicode values, with 0 for unused
+# characters.
+#
+
+import glob
+import os
+import re
+import sys
+
+
+def read_pairs(filename):
+    """Read the pairs of hex numbers in a data file, like fscanf("%x%x")."""
+
+    pairs = []
+
+    with open(filename) as f:
+        for line in f:
+            fields = line.split()
+
+            if len(fields) < 2:
+                break
+
+            pairs.append((int(fields[0], 16), fields[1]))
+
+    return pairs
+
+
+def write_values(values, fmt):
+    """Write an array initializer, 8 values per line."""
+
+    print('{')
+    for i in range(0, len(values), 8):
+        line = ', '.join(fmt % v for v in values[i:i + 8])
+        print('  ' + line + (',' if i + 8 < len(values) else ''))
+    print('};')
+
+
+# Load the glyph names...
+glyphs = {}
+
+for unicode, name in read_pairs('data/psglyphs'):
+    glyphs[unicode] = name
+
+pool    = ''
+offsets = {}
+
+for unicode in sorted(glyphs):
+    name = glyphs[unicode]
+
+    if name not in offsets:
+        offsets[name] = len(pool)
+        pool += name + '\0'
+
+if len(pool) > 65535:
+    sys.exit('makecharsets: Glyph name pool is too large.')
+
+# Load the character sets...
+charsets = []
+
+for filename in glob.glob('data/cp-*') + glob.glob('data/iso-8859-*') + ['data/koi8-r']:
+    name  = os.path.basename(filename)
+    chars = [0] * 256
+
+    for ch, unicode in read_pairs(filename):
+        if ch < 0 or ch > 255:
+            sys.exit('makecharsets: Bad character %d in "%s".' % (ch, filename))
+
+        chars[ch] = int(unicode, 16)
+
+    charsets.append((name, chars))
+
+charsets.sort(key=lambda cs: [int(p) if p.isdigit() else p for p in re.split(r'(\d+)', cs[0])])
+
+print('//')
+print('// Built-in character set tables for HTMLDOC, an HTML document processing')
+print('// program.')
+print('//')
+print('// This file is generated by "tools/makecharsets.py" - do not edit!')
+print('//')
+print('// Copyright 2026 by Michael R Sweet.')
+print('//')
+print('// This program is free software.  Distribution and use rights are outlined in')
+print('// the file "COPYING".')
+print('//')
+print('')
+print('#ifndef _HTMLDOC_CHARSETS_H_')
+print('#  define _HTMLDOC_CHARSETS_H_')
+print('')
+print('')
+print('//')
+print('// Types...')
+print('//')
+print('')
+print('typedef struct hd_glyph_s		// Glyph name for a Unicode character')
+print('{')
+print('  unsigned short	unicode,		// Unicode character')
+print('			name;			// Offset of name in hd_glyph_names[]')
+print('} hd_glyph_t;')
+print('')
+print('typedef struct hd_charset_s		// Built-in character set')
+print('{')
+print('  const char		*name;			// Name of character set')
+print('  const unsigned short	*unicode;		// Unicode value for each character')
+print('} hd_charset_t;')
+print('')
+print('')
+print('// Glyph names from "data/psglyphs" (%d glyphs, %d bytes)' % (len(glyphs), len(pool)))
+print('static const char hd_glyph_names[] =')
+names = pool.split('\0')[:-1]
+for i in range(0, len(names), 6):
+    print('  ' + ' '.join('"%s\\0"' % n for n in names[i:i + 6]) + (';' if i + 6 >= len(names) else ''))
+print('')
+print('static const hd_glyph_t hd_glyphs[%d] =' % len(glyphs))
+write_values([(unicode, offsets[glyphs[unicode]]) for unicode in sorted(glyphs)], '{ 0x%04x, %d }')
+
+for name, chars in charsets:
+    print('')
+    print('')
+    print('// Character set from "data/%s"' % name)
+    print('static const unsigned short hd_charset_%s[256] =' % name.replace('-', '_'))
+    write_values(chars, '0x%04x')
+
+print('')
+print('')
+print('// Built-in character sets')
+print('static const hd_charset_t hd_charsets[%d] =' % len(charsets))
+print('{')
+for i, (name, chars) in enumerate(charsets):
+    print('  { "%s", hd_charset_%s }%s' % (name, name.replace('-', '_'), ',' if i + 1 < len(charsets) else ''))
+print('};')
+print('')
+print('#endif // !_HTMLDOC_CHARSETS_H_')
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+#
+# makehash.py - generate the perfect hash tables in "htmldoc/hash.h".
+#
+# Copyright 2026 by Michael R Sweet.
+#
+# This program is free software.  Distribution and use rights are outlined in
+# the file "COPYING".
+#
+# Usage:
+#
+#   tools/makehash.py >htmldoc/hash.h
+#
+# Run this from the top-level source directory, or "make hash" in the
+# "htmldoc" directory, whenever the element names in "htmldoc/htmllib.cxx", the
+# character entities in "htmldoc/iso8859.cxx", or the color names in
+# "htmldoc/util.cxx" change.  The sources check the number of names in each
+# table when they are compiled, and "make test" checks that "htmldoc/hash.h"
+# matches the output of this script.
+#
+# Each table uses a "hash and displace" scheme: the first hash of a name
+# selects a bucket, the bucket's displacement seeds a second hash, and the
+# second hash selects the slot holding the index of the name in the original
+# array.
+#
+
+import re
+import sys
+
+
+def hd_hash(name, seed, nocase):
+    """Hash a name the same way as hd_hash() in "htmldoc/hash.h"."""
+
+    h = (2166136261 ^ seed) & 0xffffffff
+
+    for ch in name.encode('ascii'):
+        if nocase and ch >= 0x41 and ch <= 0x5a:
+            ch += 0x20
+
+        h = ((h ^ ch) * 16777619) & 0xffffffff
+
+    return (h ^ (h >> 15)) & 0xffffffff
+
+
+def make_table(names, nocase):
+    """Find bucket displacements and slots for a list of names."""
+
+    keys = [name.lower() if nocase else name for name in names]
+
+    if len(set(keys)) != len(keys):
+        sys.exit('makehash: Duplicate names in table.')
+
+    nslots   = 1
+    while nslots < len(names) * 5 // 4:
+        nslots *= 2
+
+    nbuckets = max(1, len(names) // 3)
+    buckets  = [[] for _ in range(nbuckets)]
+
+    for i, name in enumerate(names):
+        buckets[hd_hash(name, 0, nocase) % nbuckets].append(i)
+
+    disp  = [0] * nbuckets
+    slots = [-1] * nslots
+
+    for b in sorted(range(nbuckets), key=lambda b: -len(buckets[b])):
+        if not buckets[b]:
+            continue
+
+        for d in range(1, 65536):
+            used = [hd_hash(names[i], d, nocase) & (nslots - 1) for i in buckets[b]]
+
+            if len(set(used)) == len(used) and all(slots[s] < 0 for s in used):
+                break
+        else:
+            sys.exit('makehash: Unable to find a displacement.')
+
+        disp[b] = d
+        for i, s in zip(buckets[b], used):
+            slots[s] = i
+
+    return (disp, slots)
+
+
+def write_table(prefix, comment, names, nocase):
+    """Write the arrays for a table."""
+
+    disp, slots = make_table(names, nocase)
+
+    print('')
+    print('')
+    print('// %s (%d names, %s)' % (comment, len(names), 'case-insensitive' if nocase else 'case-sensitive'))
+    print('#define HD_%s_COUNT %d' % (prefix.upper(), len(names)))
+    print('#define HD_%s_BUCKETS %d' % (prefix.upper(), len(disp)))
+    print('#define HD_%s_SLOTS %d' % (prefix.upper(), len(slots)))
+    print('')
+    print('static const unsigned short hd_%s_disp[HD_%s_BUCKETS] =' % (prefix, prefix.upper()))
+    write_values(disp)
+    print('static const short hd_%s_slots[HD_%s_SLOTS] =' % (prefix, prefix.upper()))
+    write_values(slots)
+
+
+def write_values(values):
+    """Write an array initializer, 12 values per line."""
+
+    print('{')
+    for i in range(0, len(values), 12):
+        line = ', '.join('%d' % v for v in values[i:i + 12])
+        print('  ' + line + (',' if i + 12 < len(values) else ''))
+    print('};')
+
+
+def read_names(filename, start, pattern):
+    """Read the quoted names of an array in a source file."""
+
+    with open(filename) as f:
+        text = f.read()
+
+    text = text[text.index(start):]
+    text = text[:text.index('};')]
+
+    return re.findall(pattern, text, re.M)
+
+
+markups  = read_names('htmldoc/htmllib.cxx', '_htmlMarkups[] =', r'^\s*"([^"]*)"')
+entities = read_names('htmldoc/iso8859.cxx', 'iso8859_numbers[] =', r'\{\s*"([^"]+)",')
+colors   = read_names('htmldoc/util.cxx', 'colors[] =', r'\{\s*"([^"]+)",')
+
+print('//')
+print('// Perfect hash tables for HTMLDOC, an HTML document processing program.')
+print('//')
+print('// This file is generated by "tools/makehash.py" - do not edit!')
+print('//')
+print('// Copyright 2026 by Michael R Sweet.')
+print('//')
+print('// This program is free software.  Distribution and use rights are outlined in')
+print('// the file "COPYING".')
+print('//')
+print('')
+print('#ifndef _HTMLDOC_HASH_H_')
+print('#  define _HTMLDOC_HASH_H_')
+print('')
+print('')
+print('//')
+print('// \'hd_hash()\' - Hash a name, optionally ignoring the case of ASCII letters.')
+print('//')
+print('')
+print('static inline unsigned			// O - Hash value')
+print('hd_hash(const char *name,		// I - Name')
+print('        unsigned   seed,		// I - Seed (bucket displacement)')
+print('        int        nocase)		// I - Ignore case?')
+print('{')
+print('  unsigned h = 2166136261U ^ seed;	// Hash value')
+print('')
+print('')
+print('  for (; *name; name ++)')
+print('  {')
+print('    unsigned ch = (unsigned)*name & 255;	// Current character')
+print('')
+print('    if (nocase && ch >= \'A\' && ch <= \'Z\')')
+print('      ch += \'a\' - \'A\';')
+print('')
+print('    h = (h ^ ch) * 16777619U;')
+print('  }')
+print('')
+print('  return (h ^ (h >> 15));')
+print('}')
+print('')
+print('')
+print('//')
+print('// \'hd_hash_lookup()\' - Look up the array index of a name.')
+print('//')
+print('// The caller must compare the name at the returned index, since names that')
+print('// are not in the table also map to a slot.')
+print('//')
+print('')
+print('static inline int			// O - Array index or -1')
+print('hd_hash_lookup(const char           *name,	// I - Name')
+print('               const unsigned short *disp,	// I - Bucket displacements')
+print('               int                  nbuckets,	// I - Number of buckets')
+print('               const short          *slots,	// I - Slots')
+print('               int                  nslots,	// I - Number of slots (power of 2)')
+print('               int                  nocase)	// I - Ignore case?')
+print('{')
+print('  unsigned d = disp[hd_hash(name, 0, nocase) % (unsigned)nbuckets];')
+print('					// Displacement for bucket')
+print('')
+print('')
+print('  return (slots[hd_hash(name, d, nocase) & (unsigned)(nslots - 1)]);')
+print('}')
+
+write_table('markup', 'Element names from _htmlMarkups[] in "htmllib.cxx"', markups, True)
+write_table('entity', 'Character entities from iso8859_numbers[] in "iso8859.cxx"', entities, False)
+write_table('color', 'Color names from get_color() in "util.cxx"', colors, True)
+
+print('')
+print('#endif // !_HTMLDOC_HASH_H_')
@@ -115,6 +115,13 @@
 #define HAVE_VSNPRINTF 1
 
 
+/*
+ * Have the <pthread.h> header file?
+ */
+
+#define HAVE_PTHREAD_H 1
+
+
 /*
  * Does the "tm" structure contain the "tm_gmtoff" member?
  */